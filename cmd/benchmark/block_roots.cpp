@@ -0,0 +1,160 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/common/endian.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/trie/vector_root.hpp>
+#include <silkworm/types/bloom.hpp>
+#include <silkworm/types/receipt.hpp>
+#include <silkworm/types/transaction.hpp>
+
+using namespace silkworm;
+using namespace evmc::literals;
+
+// Roots & blooms checked when validating a block, on a synthetic block shaped like recent mainnet ones: 200 EIP-1559
+// transactions, 70% of them ERC-20 transfers among 20 tokens, each emitting a Transfer log.
+
+static constexpr size_t kTxsPerBlock{200};
+static constexpr size_t kTokens{20};
+static constexpr auto kTransferTopic{0xddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef_bytes32};
+
+static evmc::address make_address(uint8_t kind, uint64_t n) {
+    evmc::address address{};
+    address.bytes[0] = kind;
+    endian::store_big_u64(&address.bytes[12], n);
+    return address;
+}
+
+static evmc::bytes32 address_topic(const evmc::address& address) {
+    evmc::bytes32 topic{};
+    std::copy_n(address.bytes, kAddressLength, topic.bytes + kHashLength - kAddressLength);
+    return topic;
+}
+
+struct SyntheticBlock {
+    std::vector<Transaction> transactions;
+    std::vector<Receipt> receipts;
+};
+
+static const SyntheticBlock& synthetic_block() {
+    static const SyntheticBlock block{[] {
+        SyntheticBlock b;
+        uint64_t cumulative_gas_used{0};
+        for (size_t i{0}; i < kTxsPerBlock; ++i) {
+            const bool transfer{i % 10 < 7};
+            Transaction& txn{b.transactions.emplace_back()};
+            txn.type = Transaction::Type::kEip1559;
+            txn.chain_id = 1;
+            txn.nonce = i;
+            txn.max_priority_fee_per_gas = 2 * kGiga;
+            txn.max_fee_per_gas = 100 * kGiga;
+            txn.gas_limit = transfer ? 60'000 : 21'000;
+            txn.to = transfer ? make_address(0x70, i % kTokens) : make_address(0x7e, i);
+            txn.value = transfer ? 0 : kEther;
+            if (transfer) {
+                txn.data = *from_hex("a9059cbb" + to_hex(address_topic(make_address(0x7e, i))) +
+                                     "0000000000000000000000000000000000000000000000000de0b6b3a7640000");
+            }
+            txn.odd_y_parity = i % 2;
+            txn.r = intx::from_string<intx::uint256>("0x" + std::string(64, "0123456789abcdef"[i % 16]));
+            txn.s = intx::from_string<intx::uint256>("0x" + std::string(63, "fedcba9876543210"[i % 16]));
+
+            Receipt& receipt{b.receipts.emplace_back()};
+            receipt.type = txn.type;
+            receipt.success = true;
+            cumulative_gas_used += transfer ? 51'000 : 21'000;
+            receipt.cumulative_gas_used = cumulative_gas_used;
+            if (transfer) {
+                receipt.logs.push_back(Log{*txn.to,
+                                           {kTransferTopic, address_topic(make_address(0x5e, i)),
+                                            address_topic(make_address(0x7e, i))},
+                                           Bytes(32, '\x01')});
+            }
+            receipt.bloom = logs_bloom(receipt.logs);
+        }
+        return b;
+    }()};
+    return block;
+}
+
+static constexpr auto kTxnEncoder = [](Bytes& to, const Transaction& txn) {
+    rlp::encode(to, txn, /*for_signing=*/false, /*wrap_eip2718_into_array=*/false);
+};
+static constexpr auto kReceiptEncoder = [](Bytes& to, const Receipt& r) { rlp::encode(to, r); };
+
+// Generic trie building: unpacked keys fed to a HashBuilder
+template <class Value, typename Encoder>
+static evmc::bytes32 hash_builder_root(const std::vector<Value>& v, Encoder value_encoder) {
+    Bytes index_rlp;
+    Bytes value_rlp;
+    trie::HashBuilder hb;
+    for (size_t j{0}; j < v.size(); ++j) {
+        const size_t index{trie::adjust_index_for_rlp(j, v.size())};
+        index_rlp.clear();
+        rlp::encode(index_rlp, index);
+        value_rlp.clear();
+        value_encoder(value_rlp, v[index]);
+        hb.add_leaf(trie::unpack_nibbles(index_rlp), value_rlp);
+    }
+    return hb.root_hash();
+}
+
+static void transactions_root(benchmark::State& state, bool ordered) {
+    const SyntheticBlock& block{synthetic_block()};
+    for (auto _ : state) {
+        const evmc::bytes32 root{ordered ? trie::root_hash(block.transactions, kTxnEncoder)
+                                         : hash_builder_root(block.transactions, kTxnEncoder)};
+        benchmark::DoNotOptimize(root);
+    }
+}
+
+static void receipts_root(benchmark::State& state, bool ordered) {
+    const SyntheticBlock& block{synthetic_block()};
+    for (auto _ : state) {
+        const evmc::bytes32 root{ordered ? trie::root_hash(block.receipts, kReceiptEncoder)
+                                         : hash_builder_root(block.receipts, kReceiptEncoder)};
+        benchmark::DoNotOptimize(root);
+    }
+}
+
+// Blooms of the receipts of a block, as in ExecutionProcessor
+static void receipt_blooms(benchmark::State& state, bool batched) {
+    const SyntheticBlock& block{synthetic_block()};
+    for (auto _ : state) {
+        BloomBuilder builder;
+        Bloom block_bloom{};
+        for (const Receipt& receipt : block.receipts) {
+            join(block_bloom, batched ? builder.logs_bloom(receipt.logs) : logs_bloom(receipt.logs));
+        }
+        benchmark::DoNotOptimize(block_bloom);
+    }
+}
+
+BENCHMARK_CAPTURE(transactions_root, hash_builder, false);
+BENCHMARK_CAPTURE(transactions_root, ordered, true);
+BENCHMARK_CAPTURE(receipts_root, hash_builder, false);
+BENCHMARK_CAPTURE(receipts_root, ordered, true);
+BENCHMARK_CAPTURE(receipt_blooms, scalar, false);
+BENCHMARK_CAPTURE(receipt_blooms, batched, true);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,180 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/chain/difficulty.hpp>
+#include <silkworm/common/endian.hpp>
+#include <silkworm/consensus/blockchain.hpp>
+#include <silkworm/execution/processor.hpp>
+#include <silkworm/rlp/encode.hpp>
+#include <silkworm/state/in_memory_state.hpp>
+#include <silkworm/trie/vector_root.hpp>
+
+using namespace silkworm;
+
+// Synthetic chain of value transfers near the tip: every fork_interval heights a sibling competes with the canonical
+// block and loses on total difficulty, except every other time when it is extended by one block and takes over.
+
+static constexpr ChainConfig kConfig{
+    1,  // chain_id
+    SealEngineType::kNoProof,
+    {
+        0,  // Homestead
+        0,  // Tangerine Whistle
+        0,  // Spurious Dragon
+        0,  // Byzantium
+        0,  // Constantinople
+        0,  // Petersburg
+        0,  // Istanbul
+    },
+};
+
+static constexpr uint64_t kChainLength{200};
+static constexpr size_t kTxsPerBlock{50};
+
+static evmc::address make_address(uint8_t kind, uint64_t n) {
+    evmc::address address{};
+    address.bytes[0] = kind;
+    endian::store_big_u64(&address.bytes[12], n);
+    return address;
+}
+
+static void prefund(State& state) {
+    state.begin_block(0);
+    for (size_t i{0}; i < kTxsPerBlock; ++i) {
+        state.update_account(make_address(0x5e, i), std::nullopt, Account{0, kEther});
+    }
+}
+
+struct SyntheticChain {
+    Block genesis;
+    std::vector<Block> blocks;  // in order of insertion
+};
+
+// Builds a valid child of parent, executing it on top of state
+static Block make_block(const BlockHeader& parent, uint8_t branch, consensus::IConsensusEngine& engine,
+                        InMemoryState& state) {
+    Block block;
+    BlockHeader& header{block.header};
+    header.parent_hash = parent.hash();
+    header.ommers_hash = kEmptyListHash;
+    header.number = parent.number + 1;
+    header.beneficiary = make_address(0xbe, header.number * 2 + branch);
+    header.gas_limit = parent.gas_limit;
+    header.timestamp = parent.timestamp + 15;
+    header.difficulty = canonical_difficulty(header.number, header.timestamp, parent.difficulty, parent.timestamp,
+                                             /*parent_has_uncles=*/false, kConfig);
+
+    // Every sender has one transaction per block, so nonces don't depend on the branch
+    for (size_t i{0}; i < kTxsPerBlock; ++i) {
+        Transaction& txn{block.transactions.emplace_back()};
+        txn.nonce = header.number - 1;
+        txn.max_priority_fee_per_gas = kGiga;
+        txn.max_fee_per_gas = kGiga;
+        txn.gas_limit = 21'000;
+        txn.to = make_address(0x7e, (header.number * 2 + branch) * kTxsPerBlock + i);
+        txn.value = 1;
+        txn.r = 1;
+        txn.s = 1;
+        txn.from = make_address(0x5e, i);
+    }
+    static constexpr auto kTxnEncoder = [](Bytes& to, const Transaction& txn) {
+        rlp::encode(to, txn, /*for_signing=*/false, /*wrap_eip2718_into_array=*/false);
+    };
+    header.transactions_root = trie::root_hash(block.transactions, kTxnEncoder);
+
+    ExecutionProcessor processor{block, engine, state, kConfig};
+    std::vector<Receipt> receipts;
+    for (const Transaction& txn : block.transactions) {
+        receipts.push_back(processor.execute_transaction(txn));
+    }
+    engine.finalize(processor.evm().state(), block, processor.evm().revision());
+    processor.evm().state().write_to_db(header.number);
+
+    static constexpr auto kReceiptEncoder = [](Bytes& to, const Receipt& r) { rlp::encode(to, r); };
+    header.gas_used = processor.cumulative_gas_used();
+    header.receipts_root = trie::root_hash(receipts, kReceiptEncoder);
+    header.state_root = state.state_root_hash();
+    return block;
+}
+
+// fork_interval 0 means no forks
+static SyntheticChain make_chain(uint64_t fork_interval) {
+    SyntheticChain chain;
+    chain.genesis.header.ommers_hash = kEmptyListHash;
+    chain.genesis.header.difficulty = 131'072;
+    chain.genesis.header.gas_limit = 10'000'000;
+
+    InMemoryState state;
+    prefund(state);
+    const auto engine{consensus::engine_factory(kConfig)};
+
+    BlockHeader parent{chain.genesis.header};
+    while (parent.number < kChainLength) {
+        const uint64_t block_number{parent.number + 1};
+        if (fork_interval == 0 || block_number % fork_interval != 0) {
+            chain.blocks.push_back(make_block(parent, 0, *engine, state));
+            parent = chain.blocks.back().header;
+            continue;
+        }
+
+        const bool reorg{(block_number / fork_interval) % 2 == 0};
+        Block canonical{make_block(parent, 0, *engine, state)};
+        state.unwind_state_changes(block_number);
+        Block sibling{make_block(parent, 1, *engine, state)};
+        if (reorg) {
+            Block child{make_block(sibling.header, 1, *engine, state)};
+            parent = child.header;
+            chain.blocks.push_back(std::move(canonical));
+            chain.blocks.push_back(std::move(sibling));
+            chain.blocks.push_back(std::move(child));
+        } else {
+            state.unwind_state_changes(block_number);
+            canonical = make_block(parent, 0, *engine, state);
+            parent = canonical.header;
+            chain.blocks.push_back(std::move(canonical));
+            chain.blocks.push_back(std::move(sibling));
+        }
+    }
+    return chain;
+}
+
+static void insert_chain(benchmark::State& state, uint64_t fork_interval) {
+    const SyntheticChain chain{make_chain(fork_interval)};
+    for (auto _ : state) {
+        state.PauseTiming();
+        InMemoryState db;
+        prefund(db);
+        consensus::Blockchain blockchain{db, kConfig, chain.genesis};
+        std::vector<Block> blocks{chain.blocks};
+        state.ResumeTiming();
+
+        for (Block& block : blocks) {
+            if (blockchain.insert_block(block, /*check_state_root=*/true) != ValidationResult::kOk) {
+                state.SkipWithError("Invalid block");
+                return;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(chain.blocks.size()));
+}
+
+BENCHMARK_CAPTURE(insert_chain, linear, 0)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(insert_chain, reorg_heavy, 4)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(insert_chain, reorg_every_block, 1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,133 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/db/bloom_bits.hpp>
+
+using namespace silkworm;
+using namespace evmc::literals;
+using namespace db::bloom_bits;
+
+// Log filter over a million blocks (245 sections) of synthetic blooms, each with the bits of 3 random logs plus the
+// target log every 500 blocks: matching compressed bit vectors against scanning every bloom, which is what filtering
+// by headers comes down to once they are read.
+
+static constexpr uint64_t kSections{245};
+static constexpr uint64_t kBlocks{kSections * kSectionSize};
+
+static const auto kAddress{0x06012c8cf97bead5deae237070f9587f8e7a266d_address};
+static const auto kTopic{0xddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef_bytes32};
+
+struct Chain {
+    std::vector<Bloom> blooms;
+    std::vector<std::vector<Bytes>> sections;  // compressed vectors by section then bit
+};
+
+static const Chain& chain() {
+    static const Chain chain{[] {
+        Chain c;
+        c.blooms.resize(kBlocks);
+        const Bloom target{logs_bloom({Log{kAddress, {kTopic}}})};
+        std::mt19937_64 rng{42};
+        for (uint64_t n{0}; n < kBlocks; ++n) {
+            Bloom& bloom{c.blooms[n]};
+            for (size_t i{0}; i < 3 * 3; ++i) {  // 3 bits per address
+                const size_t bit{rng() % kBitLength};
+                bloom[kBloomByteLength - 1 - bit / 8] |= static_cast<uint8_t>(1u << (bit % 8));
+            }
+            if (n % 500 == 0) {
+                join(bloom, target);
+            }
+        }
+        for (uint64_t section{0}; section < kSections; ++section) {
+            SectionGenerator generator;
+            for (uint64_t i{0}; i < kSectionSize; ++i) {
+                generator.add_bloom(i, c.blooms[section * kSectionSize + i]);
+            }
+            std::vector<Bytes>& vectors{c.sections.emplace_back()};
+            for (size_t bit{0}; bit < kBitLength; ++bit) {
+                vectors.push_back(compress({generator.vector(bit).data(), kVectorLength}));
+            }
+        }
+        return c;
+    }()};
+    return chain;
+}
+
+static void bloom_bits_match(benchmark::State& state) {
+    const Chain& c{chain()};
+    const Matcher matcher{{kAddress}, {{kTopic}}};
+    std::vector<BitVector> vectors(matcher.bits().size());
+    std::vector<const BitVector*> pointers;
+    for (const BitVector& vector : vectors) {
+        pointers.push_back(&vector);
+    }
+    for (auto _ : state) {
+        size_t candidates{0};
+        for (const std::vector<Bytes>& section : c.sections) {
+            for (size_t i{0}; i < vectors.size(); ++i) {
+                const Bytes data{decompress(section[matcher.bits()[i]], kVectorLength)};
+                std::copy(data.begin(), data.end(), vectors[i].begin());
+            }
+            for (uint8_t byte : matcher.match(pointers)) {
+                candidates += static_cast<size_t>(__builtin_popcount(byte));
+            }
+        }
+        benchmark::DoNotOptimize(candidates);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kBlocks));
+}
+
+static void bloom_scan(benchmark::State& state) {
+    const Chain& c{chain()};
+    const Matcher matcher{{kAddress}, {{kTopic}}};
+    for (auto _ : state) {
+        size_t candidates{0};
+        for (const Bloom& bloom : c.blooms) {
+            candidates += matcher.matches(bloom);
+        }
+        benchmark::DoNotOptimize(candidates);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kBlocks));
+}
+
+static void bloom_bits_generate(benchmark::State& state) {
+    const Chain& c{chain()};
+    for (auto _ : state) {
+        SectionGenerator generator;
+        for (uint64_t i{0}; i < kSectionSize; ++i) {
+            generator.add_bloom(i, c.blooms[i]);
+        }
+        size_t size{0};
+        for (size_t bit{0}; bit < kBitLength; ++bit) {
+            size += compress({generator.vector(bit).data(), kVectorLength}).length();
+        }
+        benchmark::DoNotOptimize(size);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kSectionSize));
+}
+
+BENCHMARK(bloom_bits_match)->Unit(benchmark::kMillisecond);
+BENCHMARK(bloom_scan)->Unit(benchmark::kMillisecond);
+BENCHMARK(bloom_bits_generate)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
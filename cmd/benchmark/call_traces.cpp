@@ -0,0 +1,85 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/chain/config.hpp>
+#include <silkworm/common/endian.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/execution/evm.hpp>
+#include <silkworm/state/in_memory_state.hpp>
+
+using namespace silkworm;
+
+// Overhead of recording call traces on execution: a block of transactions from distinct senders to a router
+// contract, which calls kCallees contracts in turn (kCallees + 1 calls per transaction).
+
+static constexpr size_t kTxsPerBlock{200};
+static constexpr size_t kCallees{8};
+
+static evmc::address make_address(uint8_t kind, uint64_t n) {
+    evmc::address address{};
+    address.bytes[0] = kind;
+    endian::store_big_u64(&address.bytes[12], n);
+    return address;
+}
+
+static void execute_block(benchmark::State& state, bool trace_calls) {
+    Block block{};
+    block.header.number = 13'000'000;
+
+    const evmc::address router{make_address(0xc0, 0)};
+    std::string router_code;
+    for (size_t i{0}; i < kCallees; ++i) {
+        // CALL(gas, callee, 0, 0, 0, 0, 0) & POP
+        router_code += "60008080808073" + to_hex(make_address(0xca, i)) + "5af150";
+    }
+
+    InMemoryState db;
+    IntraBlockState ibs{db};
+    ibs.set_code(router, *from_hex(router_code));
+    for (size_t i{0}; i < kCallees; ++i) {
+        ibs.set_code(make_address(0xca, i), *from_hex("00"));
+    }
+
+    std::vector<Transaction> txns(kTxsPerBlock);
+    for (size_t i{0}; i < kTxsPerBlock; ++i) {
+        txns[i].from = make_address(0x5e, i);
+        txns[i].to = router;
+    }
+
+    EVM evm{block, ibs, kMainnetConfig};
+    CallTraces traces;
+    evm.call_traces = trace_calls ? &traces : nullptr;
+
+    for (auto _ : state) {
+        for (const Transaction& txn : txns) {
+            const CallResult res{evm.execute(txn, 1'000'000)};
+            benchmark::DoNotOptimize(res.gas_left);
+            ibs.clear_journal_and_substate();
+        }
+        traces.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kTxsPerBlock));
+}
+
+BENCHMARK_CAPTURE(execute_block, untraced, false);
+BENCHMARK_CAPTURE(execute_block, traced, true);
+
+BENCHMARK_MAIN();
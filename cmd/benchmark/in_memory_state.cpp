@@ -0,0 +1,275 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/common/endian.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/state/in_memory_state.hpp>
+
+using namespace silkworm;
+
+// InMemoryState vs the node based layout it had before (nested std::unordered_maps), on what state tests and fuzzing
+// mostly do: account, storage & code writes recorded per block, then reads. Besides ops/s, bytes_per_entry gives the
+// heap growth per entry written, as seen by the global operator new below.
+
+static std::atomic<int64_t> live_bytes{0};
+
+// Every allocation is prefixed by its size, so that unsized deletes can be accounted for
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"  // free() of what malloc() returned in operator new
+#endif
+static constexpr size_t kAllocHeader{alignof(std::max_align_t)};
+
+void* operator new(size_t size) {
+    void* ptr{std::malloc(size + kAllocHeader)};
+    if (!ptr) {
+        throw std::bad_alloc{};
+    }
+    *static_cast<size_t*>(ptr) = size;
+    live_bytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+    return static_cast<uint8_t*>(ptr) + kAllocHeader;
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+void operator delete(void* ptr) noexcept {
+    if (ptr) {
+        void* base{static_cast<uint8_t*>(ptr) - kAllocHeader};
+        live_bytes.fetch_sub(static_cast<int64_t>(*static_cast<size_t*>(base)), std::memory_order_relaxed);
+        std::free(base);
+    }
+}
+
+void operator delete[](void* ptr) noexcept { operator delete(ptr); }
+void operator delete(void* ptr, size_t) noexcept { operator delete(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { operator delete(ptr); }
+
+namespace {
+
+    // The write & read paths of InMemoryState as they were, with their bookkeeping for unwinds & tries
+    class NodeMapState {
+      public:
+        void begin_block(uint64_t block_number) { block_number_ = block_number; }
+
+        std::optional<Account> read_account(const evmc::address& address) const noexcept {
+            auto it{accounts_.find(address)};
+            if (it == accounts_.end()) {
+                return std::nullopt;
+            }
+            return it->second;
+        }
+
+        ByteView read_code(const evmc::bytes32& code_hash) const noexcept {
+            auto it{code_.find(code_hash)};
+            if (it == code_.end()) {
+                return {};
+            }
+            return it->second;
+        }
+
+        evmc::bytes32 read_storage(const evmc::address& address, uint64_t incarnation,
+                                   const evmc::bytes32& location) const noexcept {
+            auto it1{storage_.find(address)};
+            if (it1 == storage_.end()) {
+                return {};
+            }
+            auto it2{it1->second.find(incarnation)};
+            if (it2 == it1->second.end()) {
+                return {};
+            }
+            auto it3{it2->second.find(location)};
+            if (it3 == it2->second.end()) {
+                return {};
+            }
+            return it3->second;
+        }
+
+        void update_account(const evmc::address& address, std::optional<Account> initial,
+                            std::optional<Account> current) {
+            account_changes_[block_number_][address] = initial;
+            dirty_accounts_.insert(address);
+            if (current.has_value()) {
+                accounts_[address] = current.value();
+            } else {
+                accounts_.erase(address);
+            }
+        }
+
+        void update_account_code(const evmc::address&, uint64_t, const evmc::bytes32& code_hash, ByteView code) {
+            code_.try_emplace(code_hash, code);
+        }
+
+        void update_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
+                            const evmc::bytes32& initial, const evmc::bytes32& current) {
+            storage_changes_[block_number_][address][incarnation][location] = initial;
+            dirty_storage_[address][incarnation].insert(location);
+            if (is_zero(current)) {
+                storage_[address][incarnation].erase(location);
+            } else {
+                storage_[address][incarnation][location] = current;
+            }
+        }
+
+      private:
+        template <class T>
+        using Storage = std::unordered_map<evmc::address, std::unordered_map<uint64_t, T>>;
+
+        std::unordered_map<evmc::address, Account> accounts_;
+        std::unordered_map<evmc::bytes32, Bytes> code_;
+        Storage<std::unordered_map<evmc::bytes32, evmc::bytes32>> storage_;
+        std::unordered_map<uint64_t, std::unordered_map<evmc::address, std::optional<Account>>> account_changes_;
+        std::unordered_map<uint64_t, Storage<std::unordered_map<evmc::bytes32, evmc::bytes32>>> storage_changes_;
+        std::unordered_set<evmc::address> dirty_accounts_;
+        Storage<std::unordered_set<evmc::bytes32>> dirty_storage_;
+        uint64_t block_number_{0};
+    };
+
+    constexpr size_t kAccounts{10'000};
+    constexpr size_t kSlotsPerAccount{10};
+    constexpr size_t kBlocks{100};
+    constexpr size_t kContracts{1'000};
+
+    evmc::address make_address(uint64_t n) {
+        evmc::address address{};
+        endian::store_big_u64(&address.bytes[kAddressLength - 8], n * 0x9e3779b97f4a7c15);
+        return address;
+    }
+
+    evmc::bytes32 make_word(uint64_t n) {
+        evmc::bytes32 word{};
+        endian::store_big_u64(&word.bytes[kHashLength - 8], n);
+        return word;
+    }
+
+    // Slots written in random order, spread over blocks
+    std::vector<std::pair<size_t, size_t>> slot_writes() {
+        std::vector<std::pair<size_t, size_t>> writes;
+        for (size_t i{0}; i < kAccounts; ++i) {
+            for (size_t j{0}; j < kSlotsPerAccount; ++j) {
+                writes.emplace_back(i, j);
+            }
+        }
+        std::shuffle(writes.begin(), writes.end(), std::mt19937{42});
+        return writes;
+    }
+
+    template <class S>
+    void fill_storage(S& state, const std::vector<std::pair<size_t, size_t>>& writes) {
+        const size_t writes_per_block{writes.size() / kBlocks};
+        for (size_t i{0}; i < writes.size(); ++i) {
+            if (i % writes_per_block == 0) {
+                state.begin_block(i / writes_per_block + 1);
+            }
+            const auto [account, slot]{writes[i]};
+            state.update_storage(make_address(account), 1, make_word(slot), {}, make_word(account + slot + 1));
+        }
+    }
+
+}  // namespace
+
+template <class S>
+static void update_accounts(benchmark::State& state) {
+    int64_t bytes{0};
+    for (auto _ : state) {
+        const int64_t before{live_bytes.load()};
+        S s;
+        for (size_t i{0}; i < kAccounts; ++i) {
+            if (i % (kAccounts / kBlocks) == 0) {
+                s.begin_block(i / (kAccounts / kBlocks) + 1);
+            }
+            s.update_account(make_address(i), std::nullopt, Account{0, i, kEmptyHash, 1});
+        }
+        for (size_t i{0}; i < kAccounts; ++i) {
+            benchmark::DoNotOptimize(s.read_account(make_address(i)));
+        }
+        bytes = live_bytes.load() - before;
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kAccounts * 2));
+    state.counters["bytes_per_entry"] = static_cast<double>(bytes) / kAccounts;
+}
+
+template <class S>
+static void update_storage(benchmark::State& state) {
+    const auto writes{slot_writes()};
+    int64_t bytes{0};
+    for (auto _ : state) {
+        const int64_t before{live_bytes.load()};
+        S s;
+        fill_storage(s, writes);
+        bytes = live_bytes.load() - before;
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(writes.size()));
+    state.counters["bytes_per_entry"] = static_cast<double>(bytes) / static_cast<double>(writes.size());
+}
+
+template <class S>
+static void read_storage(benchmark::State& state) {
+    const auto writes{slot_writes()};
+    S s;
+    fill_storage(s, writes);
+    for (auto _ : state) {
+        for (const auto& [account, slot] : writes) {
+            benchmark::DoNotOptimize(s.read_storage(make_address(account), 1, make_word(slot)));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(writes.size()));
+}
+
+template <class S>
+static void update_code(benchmark::State& state) {
+    std::vector<Bytes> codes;
+    std::vector<evmc::bytes32> hashes;
+    std::mt19937 rng{42};
+    for (size_t i{0}; i < kContracts; ++i) {
+        codes.emplace_back(100 + rng() % 5'000, static_cast<uint8_t>(i));
+        hashes.push_back(make_word(i));
+    }
+    int64_t bytes{0};
+    for (auto _ : state) {
+        const int64_t before{live_bytes.load()};
+        S s;
+        for (size_t i{0}; i < kContracts; ++i) {
+            s.update_account_code(make_address(i), 1, hashes[i], codes[i]);
+        }
+        for (const evmc::bytes32& hash : hashes) {
+            benchmark::DoNotOptimize(s.read_code(hash));
+        }
+        bytes = live_bytes.load() - before;
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kContracts * 2));
+    state.counters["bytes_per_entry"] = static_cast<double>(bytes) / kContracts;
+}
+
+BENCHMARK_TEMPLATE(update_accounts, NodeMapState);
+BENCHMARK_TEMPLATE(update_accounts, InMemoryState);
+BENCHMARK_TEMPLATE(update_storage, NodeMapState);
+BENCHMARK_TEMPLATE(update_storage, InMemoryState);
+BENCHMARK_TEMPLATE(read_storage, NodeMapState);
+BENCHMARK_TEMPLATE(read_storage, InMemoryState);
+BENCHMARK_TEMPLATE(update_code, NodeMapState);
+BENCHMARK_TEMPLATE(update_code, InMemoryState);
+
+BENCHMARK_MAIN();
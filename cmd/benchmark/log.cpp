@@ -0,0 +1,79 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/common/log.hpp>
+
+using namespace silkworm;
+
+// Cost of one log call on the calling thread. Output goes to null_stream(), so the synchronous figures leave out the
+// console itself and understate what the caller saves in asynchronous mode.
+
+static void log_line(benchmark::State& state, bool async) {
+    SILKWORM_LOG_STREAMS(null_stream(), null_stream());
+    SILKWORM_LOG_VERBOSITY(LogLevel::Info);
+    SILKWORM_LOG_ASYNC(async);
+    uint64_t block_num{13'000'000};
+    for (auto _ : state) {
+        SILKWORM_LOG(LogLevel::Info) << "Executed" << log_kv("block", ++block_num) << log_kv("txs", 210)
+                                     << log_kv("gas", 14'998'421) << std::endl;
+    }
+}
+
+static void log_sync(benchmark::State& state) { log_line(state, /*async=*/false); }
+static void log_async(benchmark::State& state) { log_line(state, /*async=*/true); }
+
+// Below verbosity : a branch on a global
+static void log_filtered(benchmark::State& state) {
+    SILKWORM_LOG_VERBOSITY(LogLevel::Info);
+    uint64_t block_num{13'000'000};
+    for (auto _ : state) {
+        SILKWORM_LOG(LogLevel::Debug) << "Executed" << log_kv("block", ++block_num) << std::endl;
+        benchmark::DoNotOptimize(block_num);
+    }
+}
+
+// Rate limited : a clock read and an atomic load
+static void log_every(benchmark::State& state) {
+    SILKWORM_LOG_STREAMS(null_stream(), null_stream());
+    SILKWORM_LOG_VERBOSITY(LogLevel::Info);
+    uint64_t block_num{13'000'000};
+    for (auto _ : state) {
+        SILKWORM_LOG_EVERY(LogLevel::Info, 1'000) << "Executed" << log_kv("block", ++block_num) << std::endl;
+        benchmark::DoNotOptimize(block_num);
+    }
+}
+
+// Below compile time level : nothing left
+#undef SILKWORM_LOG_COMPILE_LEVEL
+#define SILKWORM_LOG_COMPILE_LEVEL silkworm::LogLevel::Info
+static void log_compiled_out(benchmark::State& state) {
+    SILKWORM_LOG_VERBOSITY(LogLevel::Trace);
+    uint64_t block_num{13'000'000};
+    for (auto _ : state) {
+        SILKWORM_LOG(LogLevel::Debug) << "Executed" << log_kv("block", ++block_num) << std::endl;
+        benchmark::DoNotOptimize(block_num);
+    }
+}
+
+BENCHMARK(log_sync)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(log_async)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(log_filtered);
+BENCHMARK(log_every)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(log_compiled_out);
+
+BENCHMARK_MAIN();
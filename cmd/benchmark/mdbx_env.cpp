@@ -0,0 +1,153 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <ethash/keccak.hpp>
+
+#include <silkworm/common/directories.hpp>
+#include <silkworm/db/mdbx.hpp>
+#include <silkworm/db/util.hpp>
+
+// Compares MDBX environment settings (see db::EnvConfig) under the access patterns of the two heaviest stages:
+// Execution does random upserts into plain state with a commit every batch, while HashState scans plain state
+// sequentially and appends the sorted hashed keys into a fresh table.
+
+using namespace silkworm;
+
+struct Profile {
+    size_t page_size{4_Kibi};
+    bool write_map{false};
+    db::SyncMode sync_mode{db::SyncMode::kDurable};
+};
+
+static constexpr db::MapConfig kPlainTable{"Plain"};
+static constexpr db::MapConfig kHashedTable{"Hashed"};
+
+static constexpr size_t kRecords{200'000};
+static constexpr size_t kRecordsPerCommit{20'000};
+
+static db::EnvConfig make_config(const TemporaryDirectory& dir, const Profile& profile) {
+    db::EnvConfig config{dir.path().string(), /*create=*/true};
+    config.max_size = 16_Gibi;
+    config.growth_size = 256_Mebi;
+    config.page_size = profile.page_size;
+    config.write_map = profile.write_map;
+    config.sync_mode = profile.sync_mode;
+    return config;
+}
+
+// Address-like keys with account-like values
+static std::vector<std::pair<Bytes, Bytes>> random_records(size_t count) {
+    std::mt19937_64 rng{42};
+    std::vector<std::pair<Bytes, Bytes>> records(count);
+    for (auto& [key, value] : records) {
+        key.resize(kAddressLength);
+        for (auto& b : key) {
+            b = static_cast<uint8_t>(rng());
+        }
+        value.assign(rng() % 64 + 8, static_cast<uint8_t>(rng()));
+    }
+    return records;
+}
+
+static void execution_like(benchmark::State& state, Profile profile) {
+    const auto records{random_records(kRecords)};
+    for (auto _ : state) {
+        state.PauseTiming();
+        TemporaryDirectory dir;
+        auto env{db::open_env(make_config(dir, profile))};
+        state.ResumeTiming();
+
+        auto txn{env.start_write()};
+        auto cursor{db::open_cursor(txn, kPlainTable)};
+        for (size_t i{0}; i < records.size(); ++i) {
+            cursor.upsert(db::to_slice(records[i].first), db::to_slice(records[i].second));
+            if ((i + 1) % kRecordsPerCommit == 0) {
+                cursor.close();
+                txn.commit();
+                txn = env.start_write();
+                cursor = db::open_cursor(txn, kPlainTable);
+            }
+        }
+        cursor.close();
+        txn.commit();
+        db::checkpoint(env);
+
+        state.PauseTiming();
+        env.close();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kRecords));
+}
+
+static void hashstate_like(benchmark::State& state, Profile profile) {
+    TemporaryDirectory dir;
+    auto env{db::open_env(make_config(dir, profile))};
+    {
+        auto txn{env.start_write()};
+        auto cursor{db::open_cursor(txn, kPlainTable)};
+        for (const auto& [key, value] : random_records(kRecords)) {
+            cursor.upsert(db::to_slice(key), db::to_slice(value));
+        }
+        cursor.close();
+        txn.commit();
+    }
+
+    for (auto _ : state) {
+        auto txn{env.start_write()};
+        txn.clear_map(db::open_map(txn, kHashedTable));
+
+        std::vector<std::pair<Bytes, Bytes>> hashed;
+        hashed.reserve(kRecords);
+        auto source{db::open_cursor(txn, kPlainTable)};
+        for (auto data{source.to_first(/*throw_notfound=*/false)}; data.done;
+             data = source.to_next(/*throw_notfound=*/false)) {
+            const ethash::hash256 hash{ethash::keccak256(data.key.byte_ptr(), data.key.length())};
+            hashed.emplace_back(Bytes{hash.bytes, kHashLength}, Bytes{db::from_slice(data.value)});
+        }
+        source.close();
+        std::sort(hashed.begin(), hashed.end());
+
+        auto target{db::open_cursor(txn, kHashedTable)};
+        for (const auto& [key, value] : hashed) {
+            mdbx::slice v{db::to_slice(value)};
+            target.put(db::to_slice(key), &v, MDBX_put_flags_t::MDBX_APPEND);
+        }
+        target.close();
+        txn.commit();
+        db::checkpoint(env);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kRecords));
+}
+
+#define SILKWORM_MDBX_PROFILES(workload)                                                                       \
+    BENCHMARK_CAPTURE(workload, default, Profile{})->Unit(benchmark::kMillisecond);                            \
+    BENCHMARK_CAPTURE(workload, page_16k, Profile{16_Kibi})->Unit(benchmark::kMillisecond);                    \
+    BENCHMARK_CAPTURE(workload, writemap, Profile{4_Kibi, true})->Unit(benchmark::kMillisecond);               \
+    BENCHMARK_CAPTURE(workload, safe_nosync, Profile{4_Kibi, false, db::SyncMode::kSafeNoSync})                \
+        ->Unit(benchmark::kMillisecond);                                                                       \
+    BENCHMARK_CAPTURE(workload, writemap_utterly_nosync, Profile{4_Kibi, true, db::SyncMode::kUtterlyNoSync}) \
+        ->Unit(benchmark::kMillisecond)
+
+SILKWORM_MDBX_PROFILES(execution_like);
+SILKWORM_MDBX_PROFILES(hashstate_like);
+
+BENCHMARK_MAIN();
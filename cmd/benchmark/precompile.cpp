@@ -17,19 +17,85 @@
 #include <benchmark/benchmark.h>
 
 #include <silkworm/common/util.hpp>
+#include <silkworm/execution/precompile_cache.hpp>
 #include <silkworm/execution/precompiled.hpp>
 
+using namespace silkworm;
+
+static const Bytes kEcrecInput{
+    *from_hex("18c547e4f7b0f325ad1e56f57e26c745b09a3e503d86e00e5255ff7f715d3d1c0000000000000000000000000000"
+              "00000000000000000000000000000000001c73b1693892219d736caba55bdb67216e485557ea6b6af75f37096c9a"
+              "a6a5a75feeb940b1d03b21e36b0e47e79769f095fe2ab855bd91e3a38756b7d75a9c4549")};
+
+// Base and modulus of the given length, 32-byte exponent
+static Bytes expmod_input(size_t length) {
+    Bytes in(96, '\0');
+    in[31] = static_cast<uint8_t>(length);
+    in[63] = 32;
+    in[95] = static_cast<uint8_t>(length);
+    in += Bytes(length, 0x5a);
+    in += Bytes(32, 0xa5);
+    in += Bytes(length, 0xf3);
+    return in;
+}
+
+static const Bytes kBnMulInput{
+    *from_hex("1a87b0584ce92f4593d161480614f2989035225609f08058ccfa3d0f940febe31a2f3c951f6dadcc7ee"
+              "9007dff81504b0fcd6d7cf59996efdc33d92bf7f9f8f600000000000000000000000000000000000000"
+              "00000000000000000000000009")};
+
+static const Bytes kSnarkvInput{
+    *from_hex("0f25929bcb43d5a57391564615c9e70a992b10eafa4db109709649cf48c50dd216da2f5cb6be7a0aa72c440c53c9"
+              "bbdfec6c36c7d515536431b3a865468acbba2e89718ad33c8bed92e210e81d1853435399a271913a6520736a4729"
+              "cf0d51eb01a9e2ffa2e92599b68e44de5bcf354fa2642bd4f26b259daa6f7ce3ed57aeb314a9a87b789a58af499b"
+              "314e13c3d65bede56c07ea2d418d6874857b70763713178fb49a2d6cd347dc58973ff49613a20757d0fcc22079f9"
+              "abd10c3baee245901b9e027bd5cfc2cb5db82d4dc9677ac795ec500ecd47deee3b5da006d6d049b811d7511c7815"
+              "8de484232fc68daf8a45cf217d1c2fae693ff5871e8752d73b21198e9393920d483a7260bfb731fb5d25f1aa4933"
+              "35a9e71297e485b7aef312c21800deef121f1e76426a00665e5c4479674322d4f75edadd46debd5cd992f6ed0906"
+              "89d0585ff075ec9e99ad690c3395bc4b313370b38ef355acdadcd122975b12c85ea5db8c6deb4aab71808dcb408f"
+              "e3d1e7690c43d37b4ce6cc0166fa7daa")};
+
 static void ec_recovery(benchmark::State& state) {
-    using namespace silkworm;
-    Bytes in{
-        *from_hex("18c547e4f7b0f325ad1e56f57e26c745b09a3e503d86e00e5255ff7f715d3d1c0000000000000000000000000000"
-                  "00000000000000000000000000000000001c73b1693892219d736caba55bdb67216e485557ea6b6af75f37096c9a"
-                  "a6a5a75feeb940b1d03b21e36b0e47e79769f095fe2ab855bd91e3a38756b7d75a9c4549")};
     for (auto _ : state) {
-        precompiled::ecrec_run(in);
+        benchmark::DoNotOptimize(precompiled::ecrec_run(kEcrecInput));
+    }
+}
+
+static void expmod(benchmark::State& state) {
+    const Bytes in{expmod_input(static_cast<size_t>(state.range(0)))};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(precompiled::expmod_run(in));
+    }
+}
+
+static void bn_mul(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(precompiled::bn_mul_run(kBnMulInput));
+    }
+}
+
+static void snarkv(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(precompiled::snarkv_run(kSnarkvInput));
+    }
+}
+
+// Same input over and over, i.e. every run but the first one is served by the cache
+static void cached(benchmark::State& state, uint8_t num, const Bytes& in) {
+    PrecompileCache cache;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cache.run(num, in));
     }
 }
 
 BENCHMARK(ec_recovery);
+BENCHMARK(expmod)->Arg(32)->Arg(64)->Arg(128);
+BENCHMARK(bn_mul);
+BENCHMARK(snarkv);
+
+BENCHMARK_CAPTURE(cached, ec_recovery, 0x01, kEcrecInput);
+BENCHMARK_CAPTURE(cached, expmod_64, 0x05, expmod_input(64));
+BENCHMARK_CAPTURE(cached, bn_mul, 0x07, kBnMulInput);
+BENCHMARK_CAPTURE(cached, snarkv, 0x08, kSnarkvInput);
 
 BENCHMARK_MAIN();
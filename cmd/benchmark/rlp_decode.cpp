@@ -0,0 +1,106 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/common/test_util.hpp>
+#include <silkworm/db/util.hpp>
+#include <silkworm/types/transaction_view.hpp>
+
+using namespace silkworm;
+
+// Transaction with 1KiB of call data and a couple of access list entries
+static Bytes sample_transaction_rlp(Transaction::Type type) {
+    Transaction txn{test::sample_transactions()[1]};
+    txn.type = type;
+    txn.data = Bytes(1024, 0xab);
+    if (type == Transaction::Type::kLegacy) {
+        static_cast<void>(txn.set_v(37));
+    } else {
+        txn.access_list = {
+            {0xde0b295669a9fd93d5f28d9ec85e40f4cb697bae_address,
+             {0x0000000000000000000000000000000000000000000000000000000000000003_bytes32,
+              0x0000000000000000000000000000000000000000000000000000000000000007_bytes32}},
+            {0xbb9bc244d798123fde783fcc1c72d3bb8c189413_address, {}},
+        };
+    }
+    Bytes rlp{};
+    rlp::encode(rlp, txn);
+    return rlp;
+}
+
+static void decode_transaction(benchmark::State& state, Transaction::Type type) {
+    const Bytes rlp{sample_transaction_rlp(type)};
+    for (auto _ : state) {
+        ByteView view{rlp};
+        Transaction txn;
+        benchmark::DoNotOptimize(rlp::decode(view, txn));
+        // What senders' recovery needs
+        Bytes for_signing{};
+        rlp::encode(for_signing, txn, /*for_signing=*/true, /*wrap_eip2718_into_array=*/false);
+        benchmark::DoNotOptimize(keccak256(for_signing));
+    }
+}
+
+static void decode_transaction_view(benchmark::State& state, Transaction::Type type) {
+    const Bytes rlp{sample_transaction_rlp(type)};
+    for (auto _ : state) {
+        ByteView view{rlp};
+        TransactionView txn;
+        benchmark::DoNotOptimize(rlp::decode(view, txn));
+        TransactionView::Signature signature;
+        benchmark::DoNotOptimize(txn.decode_signature(signature));
+        benchmark::DoNotOptimize(txn.signing_hash(signature.chain_id));
+    }
+}
+
+BENCHMARK_CAPTURE(decode_transaction, legacy, Transaction::Type::kLegacy);
+BENCHMARK_CAPTURE(decode_transaction_view, legacy, Transaction::Type::kLegacy);
+BENCHMARK_CAPTURE(decode_transaction, eip1559, Transaction::Type::kEip1559);
+BENCHMARK_CAPTURE(decode_transaction_view, eip1559, Transaction::Type::kEip1559);
+
+static Bytes sample_stored_body_rlp() {
+    BlockHeader ommer;
+    ommer.number = 4'000'000;
+    ommer.gas_limit = 8'000'000;
+    ommer.extra_data = Bytes(32, 0x01);
+    db::detail::BlockBodyForStorage body;
+    body.base_txn_id = 1'000'000'000;
+    body.txn_count = 200;
+    body.ommers = {ommer, ommer};
+    return body.encode();
+}
+
+static void decode_stored_block_body(benchmark::State& state) {
+    const Bytes rlp{sample_stored_body_rlp()};
+    for (auto _ : state) {
+        ByteView view{rlp};
+        benchmark::DoNotOptimize(db::detail::decode_stored_block_body(view));
+    }
+}
+
+static void decode_stored_block_body_view(benchmark::State& state) {
+    const Bytes rlp{sample_stored_body_rlp()};
+    for (auto _ : state) {
+        ByteView view{rlp};
+        benchmark::DoNotOptimize(db::detail::decode_stored_block_body_view(view));
+    }
+}
+
+BENCHMARK(decode_stored_block_body);
+BENCHMARK(decode_stored_block_body_view);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,141 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/common/test_util.hpp>
+#include <silkworm/rlp/encode.hpp>
+#include <silkworm/types/block.hpp>
+#include <silkworm/types/receipt.hpp>
+
+using namespace silkworm;
+
+static constexpr size_t kNumBlocks{10'000};
+static constexpr size_t kTxnsPerBlock{20};
+
+// Synthetic mainnet-like corpus: London headers, a mix of legacy and EIP-1559 transactions
+static const std::vector<Block>& sample_blocks() {
+    static const std::vector<Block> blocks{[] {
+        const std::vector<Transaction> templates{test::sample_transactions()};
+        std::vector<Block> res(kNumBlocks);
+        for (size_t i{0}; i < kNumBlocks; ++i) {
+            Block& block{res[i]};
+            block.header.number = 13'000'000 + i;
+            block.header.difficulty = 11'000'000'000'000'000 + i;
+            block.header.gas_limit = 30'000'000;
+            block.header.gas_used = 15'000'000 + i;
+            block.header.timestamp = 1'630'000'000 + 13 * i;
+            block.header.base_fee_per_gas = 50 * kGiga + i;
+            block.header.extra_data = Bytes(32, 0x01);
+            block.transactions.reserve(kTxnsPerBlock);
+            for (size_t j{0}; j < kTxnsPerBlock; ++j) {
+                Transaction txn{templates[j % templates.size()]};
+                txn.nonce = i * kTxnsPerBlock + j;
+                txn.data = Bytes(68 + j * 8, static_cast<uint8_t>(j));
+                block.transactions.push_back(std::move(txn));
+            }
+        }
+        return res;
+    }()};
+    return blocks;
+}
+
+static void encode_blocks(benchmark::State& state) {
+    const std::vector<Block>& blocks{sample_blocks()};
+    size_t bytes{0};
+    for (auto _ : state) {
+        for (const Block& block : blocks) {
+            Bytes rlp;
+            rlp::encode(rlp, block);
+            bytes += rlp.length();
+            benchmark::DoNotOptimize(rlp.data());
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+static void encode_transactions(benchmark::State& state) {
+    const std::vector<Block>& blocks{sample_blocks()};
+    for (auto _ : state) {
+        for (const Block& block : blocks) {
+            for (const Transaction& txn : block.transactions) {
+                Bytes rlp;
+                rlp::encode(rlp, txn);
+                benchmark::DoNotOptimize(rlp.data());
+            }
+        }
+    }
+}
+
+// As done for the receipt root of every block
+static void encode_receipts(benchmark::State& state) {
+    const std::vector<Receipt> receipts{test::sample_receipts()};
+    for (auto _ : state) {
+        for (size_t i{0}; i < kNumBlocks * kTxnsPerBlock; ++i) {
+            Bytes rlp;
+            rlp::encode(rlp, receipts[i % receipts.size()]);
+            benchmark::DoNotOptimize(rlp.data());
+        }
+    }
+}
+
+static void header_hash(benchmark::State& state, bool cached) {
+    std::vector<BlockHeader> headers;
+    headers.reserve(kNumBlocks);
+    for (const Block& block : sample_blocks()) {
+        headers.push_back(block.header);
+        if (cached) {
+            headers.back().cache_hashes();
+        }
+    }
+    for (auto _ : state) {
+        // Header validation needs both the hash and the seal hash of the header, then the hash of its parent
+        for (const BlockHeader& header : headers) {
+            benchmark::DoNotOptimize(header.hash());
+            benchmark::DoNotOptimize(header.hash(/*for_sealing=*/true));
+            benchmark::DoNotOptimize(header.hash());
+        }
+    }
+}
+
+static void transaction_hash(benchmark::State& state, bool cached) {
+    std::vector<Transaction> txns;
+    for (const Block& block : sample_blocks()) {
+        for (const Transaction& txn : block.transactions) {
+            txns.push_back(txn);
+            if (cached) {
+                txns.back().cache_hash();
+            }
+        }
+    }
+    for (auto _ : state) {
+        // e.g. TxLookup followed by a receipt lookup
+        for (const Transaction& txn : txns) {
+            benchmark::DoNotOptimize(txn.hash());
+            benchmark::DoNotOptimize(txn.hash());
+        }
+    }
+}
+
+BENCHMARK(encode_blocks)->Unit(benchmark::kMillisecond);
+BENCHMARK(encode_transactions)->Unit(benchmark::kMillisecond);
+BENCHMARK(encode_receipts)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(header_hash, uncached, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(header_hash, cached, true)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(transaction_hash, uncached, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(transaction_hash, cached, true)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -47,6 +47,7 @@ int main(int argc, char* argv[]) {
         stagedsync::TransactionManager tm{env};
         auto result_code{stagedsync::stage_blockhashes(tm, data_dir.etl().path())};
         check_stagedsync_error(result_code);
+        db::checkpoint(env);
     } catch (const std::exception& ex) {
         SILKWORM_LOG(LogLevel::Error) << ex.what() << std::endl;
         return -5;
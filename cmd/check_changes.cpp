@@ -14,14 +14,15 @@
    limitations under the License.
 */
 
+#include <fstream>
+
 #include <CLI/CLI.hpp>
 #include <absl/container/flat_hash_set.h>
 
 #include <silkworm/common/directories.hpp>
 #include <silkworm/common/log.hpp>
 #include <silkworm/db/access_layer.hpp>
-#include <silkworm/db/buffer.hpp>
-#include <silkworm/execution/processor.hpp>
+#include <silkworm/execution/historical_replay.hpp>
 
 using namespace evmc::literals;
 using namespace silkworm;
@@ -59,49 +60,52 @@ int main(int argc, char* argv[]) {
     uint64_t to{UINT64_MAX};
     app.add_option("--to", to, "check up to block number (exclusive)");
 
+    HistoricalReplay::Config replay_config;
+    replay_config.compare_with_db = true;
+    app.add_option("--threads", replay_config.num_workers, "Number of blocks executed concurrently", true)
+        ->check(CLI::Range(1u, 1024u));
+
+    std::string profile_file;
+    app.add_option("--profile", profile_file, "Profile EVM execution and write the report to this file");
+    std::string profile_sort{"time"};
+    app.add_option("--profile-sort", profile_sort, "Sort the profile report by time, gas or count", true)
+        ->check(CLI::IsMember({"time", "gas", "count"}));
+    size_t profile_top{100};
+    app.add_option("--profile-top", profile_top, "Number of contracts in the profile report", true);
+
     CLI11_PARSE(app, argc, argv);
+    replay_config.profile = !profile_file.empty();
 
     absl::Time t1{absl::Now()};
 
     SILKWORM_LOG(LogLevel::Info) << " Checking change sets in " << chaindata << "\n";
 
-    uint64_t block_num{from};
+    uint64_t end_block{from};
 
     try {
         auto data_dir{DataDirectory::from_chaindata(chaindata)};
         data_dir.deploy();
         db::EnvConfig db_config{data_dir.chaindata().path().string()};
         auto env{db::open_env(db_config)};
-        auto txn{env.start_read()};
-        auto chain_config{db::read_chain_config(txn)};
+        std::optional<ChainConfig> chain_config;
+        {
+            auto txn{env.start_read()};
+            chain_config = db::read_chain_config(txn);
+        }
         if (!chain_config.has_value()) {
             throw std::runtime_error("Unable to retrieve chain config");
         }
 
-        AnalysisCache analysis_cache;
-        ExecutionStatePool state_pool;
-        std::vector<Receipt> receipts;
-        auto engine{consensus::engine_factory(chain_config.value())};
-        for (; block_num < to; ++block_num) {
-            txn.renew_reading();
-            std::optional<BlockWithHash> bh{db::read_block(txn, block_num, /*read_senders=*/true)};
-            if (!bh) {
-                break;
-            }
-
-            db::Buffer buffer{txn, block_num};
-
-            ExecutionProcessor processor{bh->block, *engine, buffer, *chain_config};
-            processor.evm().advanced_analysis_cache = &analysis_cache;
-            processor.evm().state_pool = &state_pool;
-
-            if (const auto res{processor.execute_and_write_block(receipts)}; res != ValidationResult::kOk) {
+        HistoricalReplay replay{env, *chain_config, replay_config};
+        end_block = replay.run(from, to, [&t1](ReplayResult& result) {
+            const uint64_t block_num{result.block_number};
+            if (result.validation != ValidationResult::kOk) {
                 SILKWORM_LOG(LogLevel::Error) << "Failed to execute block " << block_num << std::endl;
-                continue;
+                return true;
             }
 
-            db::AccountChanges db_account_changes{db::read_account_changes(txn, block_num)};
-            const db::AccountChanges& calculated_account_changes{buffer.account_changes().at(block_num)};
+            const db::AccountChanges& db_account_changes{result.db_account_changes};
+            const db::AccountChanges& calculated_account_changes{result.account_changes};
             if (calculated_account_changes != db_account_changes) {
                 bool mismatch{false};
 
@@ -132,16 +136,15 @@ int main(int argc, char* argv[]) {
                 }
             }
 
-            db::StorageChanges db_storage_changes{db::read_storage_changes(txn, block_num)};
-            db::StorageChanges calculated_storage_changes{};
-            if (buffer.storage_changes().contains(block_num)) {
-                calculated_storage_changes = buffer.storage_changes().at(block_num);
-            }
-            if (calculated_storage_changes != db_storage_changes) {
+            if (result.storage_changes != result.db_storage_changes) {
                 SILKWORM_LOG(LogLevel::Error) << "Storage change mismatch for block " << block_num << " 😲" << std::endl;
-                print_storage_changes(calculated_storage_changes);
+                print_storage_changes(result.storage_changes);
                 std::cout << "vs\n";
-                print_storage_changes(db_storage_changes);
+                print_storage_changes(result.db_storage_changes);
+            }
+
+            if (result.receipts_match.has_value() && !*result.receipts_match) {
+                SILKWORM_LOG(LogLevel::Error) << "Receipts mismatch for block " << block_num << " 😲" << std::endl;
             }
 
             if (block_num % 1000 == 0) {
@@ -150,6 +153,13 @@ int main(int argc, char* argv[]) {
                                              << absl::ToDoubleSeconds(t2 - t1) << " s" << std::endl;
                 t1 = t2;
             }
+            return true;
+        });
+
+        if (replay_config.profile) {
+            std::ofstream profile_stream{profile_file};
+            replay.profiler().write_report(profile_stream, *EvmProfiler::parse_sort_key(profile_sort), profile_top);
+            SILKWORM_LOG(LogLevel::Info) << " EVM profile written to " << profile_file << "\n";
         }
     } catch (const std::exception& ex) {
         SILKWORM_LOG(LogLevel::Error) << ex.what() << std::endl;
@@ -157,6 +167,6 @@ int main(int argc, char* argv[]) {
     }
 
     t1 = absl::Now();
-    SILKWORM_LOG(LogLevel::Info) << " Blocks [" << from << "; " << block_num << ") have been checked\n";
+    SILKWORM_LOG(LogLevel::Info) << " Blocks [" << from << "; " << end_block << ") have been checked\n";
     return 0;
 }
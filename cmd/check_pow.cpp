@@ -14,18 +14,19 @@
    limitations under the License.
 */
 
+#include <algorithm>
 #include <csignal>
 #include <filesystem>
 #include <string>
+#include <thread>
 
 #include <CLI/CLI.hpp>
 #include <ethash/ethash.hpp>
-#include <ethash/keccak.hpp>
 
 #include <silkworm/chain/config.hpp>
 #include <silkworm/common/directories.hpp>
-#include <silkworm/common/endian.hpp>
 #include <silkworm/common/log.hpp>
+#include <silkworm/consensus/seal_verifier.hpp>
 #include <silkworm/db/access_layer.hpp>
 #include <silkworm/db/stages.hpp>
 #include <silkworm/db/util.hpp>
@@ -40,6 +41,9 @@ struct app_options_t {
     std::string datadir{};          // Provided database path
     uint32_t block_from{1u};        // Initial block number to start from
     uint32_t block_to{UINT32_MAX};  // Final block number to process
+    uint32_t batch_size{10'000};    // Number of headers verified in parallel at once
+    uint32_t max_workers{std::max(std::thread::hardware_concurrency(), 1u) - 1};  // Besides main thread
+    bool full_dag{false};           // Whether to verify the current epoch against the full dataset
     bool debug{false};              // Whether to display some debug info
 };
 
@@ -63,6 +67,14 @@ int main(int argc, char* argv[]) {
     app.add_option("--to", options.block_to, "Final block number to process (inclusive)", true)
         ->check(CLI::Range(1u, UINT32_MAX));
 
+    app.add_option("--batch", options.batch_size, "Number of headers verified in parallel at once", true)
+        ->check(CLI::Range(1u, 1'000'000u));
+    app.add_option("--workers", options.max_workers, "Max number of worker threads", true)
+        ->check(CLI::Range(0u, std::max(1u, std::thread::hardware_concurrency())));
+    app.add_flag("--full-dag", options.full_dag,
+                 "Compute (lazily) and keep in memory the full dataset of the current epoch rather than "
+                 "recomputing the accessed items from the light cache every time");
+
     app.add_flag("--debug", options.debug, "May print some debug/trace info.");
 
     CLI11_PARSE(app, argc, argv);
@@ -99,55 +111,59 @@ int main(int argc, char* argv[]) {
         auto max_headers_height{db::stages::read_stage_progress(txn, db::stages::kSendersKey)};
         options.block_to = std::min(options.block_to, static_cast<uint32_t>(max_headers_height));
 
-        // Initialize epoch
-        auto epoch_num{options.block_from / ethash::epoch_length};
-        SILKWORM_LOG(LogLevel::Info) << "Initializing Light Cache for DAG epoch " << epoch_num << std::endl;
-        auto epoch_context{ethash::create_epoch_context(static_cast<int>(epoch_num))};
+        consensus::SealVerifier verifier{options.max_workers, options.full_dag};
+        SILKWORM_LOG(LogLevel::Info) << "Verifying seals with " << verifier.num_workers() + 1 << " threads"
+                                     << (options.full_dag ? " (full DAG)" : "") << std::endl;
 
         auto canonical_hashes{db::open_cursor(txn, db::table::kCanonicalHashes)};
 
-        // Loop blocks
-        for (uint32_t block_num{options.block_from}; block_num <= options.block_to && !g_should_stop; block_num++) {
-            if (epoch_context->epoch_number != static_cast<int>(block_num / ethash::epoch_length)) {
-                epoch_num = (block_num / ethash::epoch_length);
-                SILKWORM_LOG(LogLevel::Info) << "Initializing Light Cache for DAG epoch " << epoch_num << std::endl;
-                epoch_context = ethash::create_epoch_context(static_cast<int>(epoch_num));
-            }
+        std::vector<BlockHeader> headers;
+        headers.reserve(options.batch_size);
 
-            auto block_key{db::block_key(block_num)};
-            auto data{canonical_hashes.find(db::to_slice(block_key), /*throw_notfound*/ false)};
-            if (!data) {
-                throw std::runtime_error("Can't retrieve canonical hash for block " + std::to_string(block_num));
-            }
-
-            auto header_key{to_bytes32(db::from_slice(data.value))};
-            auto header{db::read_header(txn, block_num, header_key.bytes)};
-            if (!header.has_value()) {
-                throw std::runtime_error("Can't retrieve header for block " + std::to_string(block_num));
+        // Loop blocks
+        for (uint32_t batch_start{options.block_from}; batch_start <= options.block_to && !g_should_stop;) {
+            headers.clear();
+            for (uint32_t block_num{batch_start};
+                 block_num <= options.block_to && headers.size() < options.batch_size; ++block_num) {
+                auto block_key{db::block_key(block_num)};
+                auto data{canonical_hashes.find(db::to_slice(block_key), /*throw_notfound*/ false)};
+                if (!data) {
+                    throw std::runtime_error("Can't retrieve canonical hash for block " + std::to_string(block_num));
+                }
+
+                auto header_key{to_bytes32(db::from_slice(data.value))};
+                auto header{db::read_header(txn, block_num, header_key.bytes)};
+                if (!header.has_value()) {
+                    throw std::runtime_error("Can't retrieve header for block " + std::to_string(block_num));
+                }
+                headers.push_back(std::move(*header));
             }
 
             // Verify Proof of Work
-            uint64_t nonce{endian::load_big_u64(header->nonce.data())};
-
-            auto boundary256{header->boundary()};
-            auto seal_hash(header->hash(/*for_sealing =*/true));
-            ethash::hash256 sealh256{*reinterpret_cast<ethash::hash256*>(seal_hash.bytes)};
-            ethash::hash256 mixh256{*reinterpret_cast<ethash::hash256*>(header->mix_hash.bytes)};
-            if (!ethash::verify(*epoch_context, sealh256, mixh256, nonce, boundary256)) {
-                auto result{ethash::hash(*epoch_context, sealh256, nonce)};
-                auto b{to_bytes32({boundary256.bytes, 32})};
+            const std::vector<ValidationResult> results{verifier.verify(headers)};
+            const auto invalid{std::find(results.begin(), results.end(), ValidationResult::kInvalidSeal)};
+            if (invalid != results.end()) {
+                const BlockHeader& header{headers[static_cast<size_t>(invalid - results.begin())]};
+                const auto epoch_num{static_cast<int>(header.number / ethash::epoch_length)};
+                const auto epoch_context{consensus::EpochContext::create(epoch_num)};
+                if (!epoch_context) {
+                    throw std::runtime_error("Can't allocate light cache for DAG epoch " + std::to_string(epoch_num));
+                }
+                auto result{epoch_context->hash(header)};
+                auto b{to_bytes32(full_view(header.boundary().bytes))};
                 auto f{to_bytes32({result.final_hash.bytes, 32})};
                 auto m{to_bytes32({result.mix_hash.bytes, 32})};
 
-                std::cout << "\n Pow Verification error on block " << block_num << " : \n"
+                std::cout << "\n Pow Verification error on block " << header.number << " : \n"
                           << "Final hash " << to_hex(f) << " expected below " << to_hex(b) << "\n"
-                          << "Mix   hash " << to_hex(m) << " expected mix" << to_hex(m) << std::endl;
+                          << "Mix   hash " << to_hex(m) << " expected mix " << to_hex(header.mix_hash) << std::endl;
                 break;
             }
 
-            if (!(block_num % 1000)) {
-                SILKWORM_LOG(LogLevel::Info) << "At block height " << block_num << std::endl;
-            }
+            batch_start += static_cast<uint32_t>(headers.size());
+            SILKWORM_LOG(LogLevel::Info) << "At block height " << batch_start - 1 << " ("
+                                         << static_cast<uint64_t>(verifier.headers_per_second()) << " headers/s)"
+                                         << std::endl;
         }
 
         SILKWORM_LOG(LogLevel::Info) << "Complete !" << std::endl;
@@ -135,6 +135,7 @@ int main(int argc, char* argv[]) {
             if (!options.dry) {
                 SILKWORM_LOG(LogLevel::Info) << "Committing" << std::endl;
                 txn.commit();
+                db::checkpoint(env);
             } else {
                 SILKWORM_LOG(LogLevel::Info) << "Not committing (--dry)" << std::endl;
             }
@@ -82,7 +82,7 @@ int main(int argc, char* argv[]) {
         while (bodies_data) {
             auto block_number(endian::load_big_u64(static_cast<uint8_t*>(bodies_data.key.iov_base)));
             auto body_rlp{db::from_slice(bodies_data.value)};
-            auto body{db::detail::decode_stored_block_body(body_rlp)};
+            auto body{db::detail::decode_stored_block_body_view(body_rlp)};
 
             if (body.txn_count > 0) {
                 Bytes transaction_key(8, '\0');
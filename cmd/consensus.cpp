@@ -14,12 +14,21 @@
    limitations under the License.
 */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <exception>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <map>
+#include <mutex>
+#include <sstream>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <CLI/CLI.hpp>
@@ -272,7 +281,10 @@ static void check_rlp_err(rlp::DecodingResult err) {
     }
 }
 
-ExecutionStatePool state_pool;
+// Test files run in parallel, each thread has its own pool of EVM states
+// and reports failures into the buffer of the file it's running (see run_test_file)
+thread_local ExecutionStatePool state_pool;
+thread_local std::ostream* report{&std::cout};
 evmc_vm* evm{nullptr};
 
 // https://ethereum-tests.readthedocs.io/en/latest/test_types/blockchain_tests.html#pre-prestate-section
@@ -316,7 +328,7 @@ Status run_block(const nlohmann::json& json_block, Blockchain& blockchain) {
         if (invalid) {
             return Status::kPassed;
         }
-        std::cout << "Failure to read hex" << std::endl;
+        *report << "Failure to read hex" << std::endl;
         return Status::kFailed;
     }
 
@@ -326,7 +338,7 @@ Status run_block(const nlohmann::json& json_block, Blockchain& blockchain) {
         if (invalid) {
             return Status::kPassed;
         }
-        std::cout << "Failure to decode RLP" << std::endl;
+        *report << "Failure to decode RLP" << std::endl;
         return Status::kFailed;
     }
 
@@ -336,13 +348,13 @@ Status run_block(const nlohmann::json& json_block, Blockchain& blockchain) {
         if (invalid) {
             return Status::kPassed;
         }
-        std::cout << "Validation error " << magic_enum::enum_name<ValidationResult>(err) << std::endl;
+        *report << "Validation error " << magic_enum::enum_name<ValidationResult>(err) << std::endl;
         return Status::kFailed;
     }
 
     if (invalid) {
-        std::cout << "Invalid block executed successfully\n";
-        std::cout << "Expected: " << json_block["expectException"] << std::endl;
+        *report << "Invalid block executed successfully\n";
+        *report << "Expected: " << json_block["expectException"] << std::endl;
         return Status::kFailed;
     }
 
@@ -351,8 +363,8 @@ Status run_block(const nlohmann::json& json_block, Blockchain& blockchain) {
 
 bool post_check(const InMemoryState& state, const nlohmann::json& expected) {
     if (state.number_of_accounts() != expected.size()) {
-        std::cout << "Account number mismatch: " << state.number_of_accounts() << " != " << expected.size()
-                  << std::endl;
+        *report << "Account number mismatch: " << state.number_of_accounts() << " != " << expected.size()
+                << std::endl;
         return false;
     }
 
@@ -362,38 +374,38 @@ bool post_check(const InMemoryState& state, const nlohmann::json& expected) {
 
         std::optional<Account> account{state.read_account(address)};
         if (!account) {
-            std::cout << "Missing account " << entry.key() << std::endl;
+            *report << "Missing account " << entry.key() << std::endl;
             return false;
         }
 
         const Bytes balance_str{from_hex(j["balance"].get<std::string>()).value()};
         const auto expected_balance{endian::from_big_compact_u256(balance_str, /*allow_leading_zeros=*/true)};
         if (account->balance != expected_balance) {
-            std::cout << "Balance mismatch for " << entry.key() << ":\n"
-                      << to_string(account->balance, 16) << " != " << j["balance"] << std::endl;
+            *report << "Balance mismatch for " << entry.key() << ":\n"
+                    << to_string(account->balance, 16) << " != " << j["balance"] << std::endl;
             return false;
         }
 
         const Bytes nonce_str{from_hex(j["nonce"].get<std::string>()).value()};
         const auto expected_nonce{endian::from_big_compact_u64(nonce_str, /*allow_leading_zeros=*/true)};
         if (account->nonce != expected_nonce) {
-            std::cout << "Nonce mismatch for " << entry.key() << ":\n"
-                      << account->nonce << " != " << *expected_nonce << std::endl;
+            *report << "Nonce mismatch for " << entry.key() << ":\n"
+                    << account->nonce << " != " << *expected_nonce << std::endl;
             return false;
         }
 
         auto expected_code{j["code"].get<std::string>()};
         Bytes actual_code{state.read_code(account->code_hash)};
         if (actual_code != from_hex(expected_code)) {
-            std::cout << "Code mismatch for " << entry.key() << ":\n"
-                      << to_hex(actual_code) << " != " << expected_code << std::endl;
+            *report << "Code mismatch for " << entry.key() << ":\n"
+                    << to_hex(actual_code) << " != " << expected_code << std::endl;
             return false;
         }
 
         size_t storage_size{state.storage_size(address, account->incarnation)};
         if (storage_size != j["storage"].size()) {
-            std::cout << "Storage size mismatch for " << entry.key() << ":\n"
-                      << storage_size << " != " << j["storage"].size() << std::endl;
+            *report << "Storage size mismatch for " << entry.key() << ":\n"
+                    << storage_size << " != " << j["storage"].size() << std::endl;
             return false;
         }
 
@@ -402,8 +414,8 @@ bool post_check(const InMemoryState& state, const nlohmann::json& expected) {
             Bytes expected_value{from_hex(storage.value().get<std::string>()).value()};
             evmc::bytes32 actual_value{state.read_storage(address, account->incarnation, to_bytes32(key))};
             if (actual_value != to_bytes32(expected_value)) {
-                std::cout << "Storage mismatch for " << entry.key() << " at " << storage.key() << ":\n"
-                          << to_hex(actual_value) << " != " << to_hex(expected_value) << std::endl;
+                *report << "Storage mismatch for " << entry.key() << " at " << storage.key() << ":\n"
+                        << to_hex(actual_value) << " != " << to_hex(expected_value) << std::endl;
                 return false;
             }
         }
@@ -425,8 +437,8 @@ Status blockchain_test(const nlohmann::json& json_test, std::optional<ChainConfi
 
     auto consensus_engine{consensus::engine_factory(config)};
     if (!consensus_engine) {
-        std::cout << magic_enum::enum_name<SealEngineType>(config.seal_engine) << " seal engine is not supported yet"
-                  << std::endl;
+        *report << magic_enum::enum_name<SealEngineType>(config.seal_engine) << " seal engine is not supported yet"
+                << std::endl;
         return Status::kSkipped;
     }
 
@@ -447,7 +459,7 @@ Status blockchain_test(const nlohmann::json& json_test, std::optional<ChainConfi
         evmc::bytes32 state_root{state.state_root_hash()};
         std::string expected_hex{json_test["postStateHash"].get<std::string>()};
         if (state_root != to_bytes32(from_hex(expected_hex).value())) {
-            std::cout << "postStateHash mismatch:\n" << to_hex(state_root) << " != " << expected_hex << std::endl;
+            *report << "postStateHash mismatch:\n" << to_hex(state_root) << " != " << expected_hex << std::endl;
             return Status::kFailed;
         } else {
             return Status::kPassed;
@@ -462,19 +474,19 @@ Status blockchain_test(const nlohmann::json& json_test, std::optional<ChainConfi
 }
 
 static void print_test_status(std::string_view key, Status status) {
-    std::cout << key << " ";
+    *report << key << " ";
     for (size_t i{key.length() + 1}; i < kColumnWidth; ++i) {
-        std::cout << '.';
+        *report << '.';
     }
     switch (status) {
         case Status::kPassed:
-            std::cout << "\033[0;32m  Passed\033[0m" << std::endl;
+            *report << "\033[0;32m  Passed\033[0m" << std::endl;
             break;
         case Status::kFailed:
-            std::cout << "\033[1;31m  Failed\033[0m" << std::endl;
+            *report << "\033[1;31m  Failed\033[0m" << std::endl;
             break;
         case Status::kSkipped:
-            std::cout << " Skipped" << std::endl;
+            *report << " Skipped" << std::endl;
             break;
     }
 }
@@ -512,30 +524,56 @@ static constexpr RunResults kSkippedTest{
     1,  // skipped
 };
 
-RunResults run_test_file(const fs::path& file_path, Status (*runner)(const nlohmann::json&, std::optional<ChainConfig>),
+using TestRunner = Status (*)(const nlohmann::json&, std::optional<ChainConfig>);
+
+struct TestTiming {
+    std::string name;
+    Status status;
+    std::chrono::microseconds duration;
+};
+
+// Outcome of running a test file, reported once the file is done
+struct FileReport {
+    RunResults results{};
+    std::string output{};
+    std::vector<TestTiming> timings{};
+};
+
+FileReport run_test_file(const fs::path& file_path, TestRunner runner,
                          std::optional<ChainConfig> config = std::nullopt) {
+    FileReport file_report{};
+    std::ostringstream output;
+    report = &output;
+
     std::ifstream in{file_path.string()};
     nlohmann::json json;
 
     try {
         in >> json;
     } catch (nlohmann::detail::parse_error& e) {
-        std::cerr << e.what() << "\n";
+        output << e.what() << "\n";
         print_test_status(file_path.string(), Status::kSkipped);
-        return kSkippedTest;
+        report = &std::cout;
+        file_report.results = kSkippedTest;
+        file_report.output = output.str();
+        return file_report;
     }
 
-    RunResults res{};
-
     for (const auto& test : json.items()) {
+        const auto start{std::chrono::steady_clock::now()};
         Status status{runner(test.value(), config)};
-        res.add(status);
+        const auto duration{std::chrono::steady_clock::now() - start};
+        file_report.results.add(status);
+        file_report.timings.push_back(
+            {test.key(), status, std::chrono::duration_cast<std::chrono::microseconds>(duration)});
         if (status != Status::kPassed) {
             print_test_status(test.key(), status);
         }
     }
 
-    return res;
+    report = &std::cout;
+    file_report.output = output.str();
+    return file_report;
 }
 
 // https://ethereum-tests.readthedocs.io/en/latest/test_types/transaction_tests.html
@@ -560,7 +598,7 @@ Status transaction_test(const nlohmann::json& j, std::optional<ChainConfig>) {
 
         if (!decoded) {
             if (should_be_valid) {
-                std::cout << "Failed to decode valid transaction" << std::endl;
+                *report << "Failed to decode valid transaction" << std::endl;
                 return Status::kFailed;
             } else {
                 continue;
@@ -581,7 +619,7 @@ Status transaction_test(const nlohmann::json& j, std::optional<ChainConfig>) {
                 pre_validate_transaction(txn, /*block_number=*/0, config, /*base_fee_per_gas=*/std::nullopt)};
             err != ValidationResult::kOk) {
             if (should_be_valid) {
-                std::cout << "Validation error " << magic_enum::enum_name<ValidationResult>(err) << std::endl;
+                *report << "Validation error " << magic_enum::enum_name<ValidationResult>(err) << std::endl;
                 return Status::kFailed;
             } else {
                 continue;
@@ -590,13 +628,13 @@ Status transaction_test(const nlohmann::json& j, std::optional<ChainConfig>) {
 
         txn.recover_sender();
         if (should_be_valid && !txn.from.has_value()) {
-            std::cout << "Failed to recover sender" << std::endl;
+            *report << "Failed to recover sender" << std::endl;
             return Status::kFailed;
         }
 
         if (!should_be_valid && txn.from.has_value()) {
-            std::cout << entry.key() << "\n"
-                      << "Sender recovered for invalid transaction" << std::endl;
+            *report << entry.key() << "\n"
+                    << "Sender recovered for invalid transaction" << std::endl;
             return Status::kFailed;
         }
 
@@ -606,8 +644,8 @@ Status transaction_test(const nlohmann::json& j, std::optional<ChainConfig>) {
 
         std::string expected{entry.value()["sender"].get<std::string>()};
         if (to_hex(*txn.from) != expected) {
-            std::cout << "Sender mismatch for " << entry.key() << ":\n"
-                      << to_hex(*txn.from) << " != " << expected << std::endl;
+            *report << "Sender mismatch for " << entry.key() << ":\n"
+                    << to_hex(*txn.from) << " != " << expected << std::endl;
             return Status::kFailed;
         }
     }
@@ -634,8 +672,8 @@ Status difficulty_test(const nlohmann::json& j, std::optional<ChainConfig> confi
     if (calculated_difficulty == current_difficulty) {
         return Status::kPassed;
     } else {
-        std::cout << "Difficulty mismatch for block " << block_number << "\n"
-                  << hex(calculated_difficulty) << " != " << hex(current_difficulty) << std::endl;
+        *report << "Difficulty mismatch for block " << block_number << "\n"
+                << hex(calculated_difficulty) << " != " << hex(current_difficulty) << std::endl;
         return Status::kFailed;
     }
 }
@@ -645,14 +683,71 @@ bool exclude_test(const fs::path& p, const fs::path& root_dir) {
                        [&p, &root_dir](const std::filesystem::path& e) -> bool { return root_dir / e == p; });
 }
 
+// A test file to run, or to count as skipped if excluded
+struct TestFile {
+    fs::path path;
+    TestRunner runner;
+    std::optional<ChainConfig> config{std::nullopt};
+    bool excluded{false};
+};
+
+// Appends the files under dir in path order, so that runs (and shards) are reproducible
+void collect_test_files(const fs::path& dir, TestRunner runner, const fs::path& root_dir,
+                        std::vector<TestFile>& files) {
+    std::vector<TestFile> found;
+    for (auto i = fs::recursive_directory_iterator(dir); i != fs::recursive_directory_iterator{}; ++i) {
+        if (exclude_test(*i, root_dir)) {
+            found.push_back({*i, runner, std::nullopt, /*excluded=*/true});
+            i.disable_recursion_pending();
+        } else if (fs::is_regular_file(i->path())) {
+            found.push_back({*i, runner});
+        }
+    }
+    std::sort(found.begin(), found.end(), [](const TestFile& a, const TestFile& b) { return a.path < b.path; });
+    files.insert(files.end(), found.begin(), found.end());
+}
+
+// Parses "i/n" into {i, n}
+std::optional<std::pair<size_t, size_t>> parse_shard(const std::string& spec) {
+    const size_t slash{spec.find('/')};
+    if (slash == std::string::npos) {
+        return std::nullopt;
+    }
+    try {
+        const size_t index{std::stoul(spec.substr(0, slash))};
+        const size_t count{std::stoul(spec.substr(slash + 1))};
+        if (count == 0 || index >= count) {
+            return std::nullopt;
+        }
+        return std::make_pair(index, count);
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+}
+
 int main(int argc, char* argv[]) {
     CLI::App app{"Run Ethereum consensus tests"};
     std::string evm_path{};
     app.add_option("--evm", evm_path, "Path to EVMC-compliant VM");
     std::string tests_path{SILKWORM_CONSENSUS_TEST_DIR};
     app.add_option("--tests", tests_path, "Path to consensus tests", true)->check(CLI::ExistingDirectory);
+    size_t num_threads{std::max(std::thread::hardware_concurrency(), 1u)};
+    app.add_option("--threads", num_threads, "Number of test files run in parallel", true)
+        ->check(CLI::Range(1u, 1024u));
+    std::string shard_spec{"0/1"};
+    app.add_option("--shard", shard_spec, "Run only the i-th of n shards of the test files, as i/n (0-based)", true);
+    std::string timings_path{};
+    app.add_option("--timings", timings_path, "Write the duration of every test to this CSV file");
+    size_t num_slowest{0};
+    app.add_option("--slowest", num_slowest, "Print the N slowest tests", true);
     CLI11_PARSE(app, argc, argv);
 
+    const auto shard{parse_shard(shard_spec)};
+    if (!shard) {
+        std::cerr << "Invalid shard " << shard_spec << ", expected i/n with i < n" << std::endl;
+        return -1;
+    }
+
     if (!evm_path.empty()) {
         evmc_loader_error_code err;
         evm = evmc_load_and_configure(evm_path.c_str(), &err);
@@ -662,31 +757,88 @@ int main(int argc, char* argv[]) {
         }
     }
 
-    RunResults res{};
-
     const fs::path root_dir{tests_path};
 
+    std::vector<TestFile> all_files;
     for (const auto& entry : kDifficultyConfig) {
-        res += run_test_file(root_dir / kDifficultyDir / entry.first, difficulty_test, entry.second);
+        all_files.push_back({root_dir / kDifficultyDir / entry.first, difficulty_test, entry.second});
     }
+    collect_test_files(root_dir / kBlockchainDir, blockchain_test, root_dir, all_files);
+    collect_test_files(root_dir / kTransactionDir, transaction_test, root_dir, all_files);
 
-    for (auto i = fs::recursive_directory_iterator(root_dir / kBlockchainDir); i != fs::recursive_directory_iterator{};
-         ++i) {
-        if (exclude_test(*i, root_dir)) {
-            res += kSkippedTest;
-            i.disable_recursion_pending();
-        } else if (fs::is_regular_file(i->path())) {
-            res += run_test_file(*i, blockchain_test);
+    std::vector<TestFile> files;
+    for (size_t i{0}; i < all_files.size(); ++i) {
+        if (i % shard->second == shard->first) {
+            files.push_back(std::move(all_files[i]));
         }
     }
 
-    for (auto i = fs::recursive_directory_iterator(root_dir / kTransactionDir); i != fs::recursive_directory_iterator{};
-         ++i) {
-        if (exclude_test(*i, root_dir)) {
-            res += kSkippedTest;
-            i.disable_recursion_pending();
-        } else if (fs::is_regular_file(i->path())) {
-            res += run_test_file(*i, transaction_test);
+    // Workers pick files in order; reports are printed in the same order as soon as they're available,
+    // so the output does not depend on the number of threads
+    std::vector<FileReport> reports(files.size());
+    std::vector<bool> done(files.size(), false);
+    std::mutex done_mtx;
+    std::condition_variable done_cv;
+    std::atomic<size_t> next_file{0};
+
+    auto work{[&]() {
+        for (size_t i{next_file++}; i < files.size(); i = next_file++) {
+            FileReport file_report{};
+            if (files[i].excluded) {
+                file_report.results = kSkippedTest;
+            } else {
+                file_report = run_test_file(files[i].path, files[i].runner, files[i].config);
+            }
+            std::unique_lock lock{done_mtx};
+            reports[i] = std::move(file_report);
+            done[i] = true;
+            done_cv.notify_all();
+        }
+    }};
+
+    std::vector<std::thread> workers;
+    for (size_t i{0}; i < std::min(num_threads, files.size()); ++i) {
+        workers.emplace_back(work);
+    }
+
+    RunResults res{};
+    for (size_t i{0}; i < files.size(); ++i) {
+        std::unique_lock lock{done_mtx};
+        done_cv.wait(lock, [&]() { return done[i]; });
+        lock.unlock();
+        std::cout << reports[i].output << std::flush;
+        res += reports[i].results;
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    if (!timings_path.empty()) {
+        std::ofstream out{timings_path};
+        out << "file,test,status,microseconds\n";
+        for (size_t i{0}; i < files.size(); ++i) {
+            for (const TestTiming& t : reports[i].timings) {
+                out << '"' << files[i].path.string() << "\",\"" << t.name << "\"," << magic_enum::enum_name(t.status)
+                    << ',' << t.duration.count() << '\n';
+            }
+        }
+    }
+
+    if (num_slowest > 0) {
+        std::vector<std::pair<const TestTiming*, const fs::path*>> timings;
+        for (size_t i{0}; i < files.size(); ++i) {
+            for (const TestTiming& t : reports[i].timings) {
+                timings.emplace_back(&t, &files[i].path);
+            }
+        }
+        num_slowest = std::min(num_slowest, timings.size());
+        std::partial_sort(timings.begin(), timings.begin() + static_cast<std::ptrdiff_t>(num_slowest), timings.end(),
+                          [](const auto& a, const auto& b) { return a.first->duration > b.first->duration; });
+        std::cout << "Slowest tests:\n";
+        for (size_t i{0}; i < num_slowest; ++i) {
+            std::cout << "  " << timings[i].first->duration.count() / 1000 << " ms  " << timings[i].first->name
+                      << " (" << timings[i].second->filename().string() << ")\n";
         }
     }
 
@@ -0,0 +1,84 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_CMD_DB_OPTIONS_HPP_
+#define SILKWORM_CMD_DB_OPTIONS_HPP_
+
+#include <map>
+#include <stdexcept>
+#include <string>
+
+#include <CLI/CLI.hpp>
+
+#include <silkworm/common/util.hpp>
+#include <silkworm/db/mdbx.hpp>
+
+namespace silkworm::cmd {
+
+//! \brief Command line options tuning the MDBX environment (see db::EnvConfig)
+struct DbEnvOptions {
+    std::string page_size{"4KB"};
+    std::string max_size{"2TB"};
+    std::string growth_size{"2GB"};
+    std::string sync_mode{"durable"};
+    bool write_map{false};
+    bool read_ahead{false};
+
+    //! \brief Adds the options to a CLI app (or option group)
+    template <class App>
+    void add_to(App& app) {
+        app.add_option("--page-size", page_size, "Db page size (only for new databases)", true);
+        app.add_option("--max-size", max_size, "Max size of db file", true);
+        app.add_option("--growth-size", growth_size, "Increment of db file size", true);
+        app.add_option("--sync", sync_mode, "Sync of commits to disk", true)
+            ->check(CLI::IsMember({"durable", "safe-nosync", "utterly-nosync"}));
+        app.add_flag("--writemap", write_map, "Write db pages through a writable memory map");
+        app.add_flag("--readahead", read_ahead, "Let the OS read ahead db pages");
+    }
+
+    //! \brief Applies the options to an environment config
+    //! \remarks Throws std::invalid_argument on malformed sizes
+    void apply_to(db::EnvConfig& config) const {
+        config.page_size = parse(page_size, "--page-size");
+        config.max_size = parse(max_size, "--max-size");
+        config.growth_size = parse(growth_size, "--growth-size");
+        config.write_map = write_map;
+        config.read_ahead = read_ahead;
+        static const std::map<std::string, db::SyncMode> kSyncModes{
+            {"durable", db::SyncMode::kDurable},
+            {"safe-nosync", db::SyncMode::kSafeNoSync},
+            {"utterly-nosync", db::SyncMode::kUtterlyNoSync},
+        };
+        const auto it{kSyncModes.find(sync_mode)};
+        if (it == kSyncModes.end()) {
+            throw std::invalid_argument("Invalid --sync value provided : " + sync_mode);
+        }
+        config.sync_mode = it->second;
+    }
+
+  private:
+    static size_t parse(const std::string& value, const std::string& option) {
+        const auto size{parse_size(value)};
+        if (!size.has_value()) {
+            throw std::invalid_argument("Invalid " + option + " value provided : " + value);
+        }
+        return static_cast<size_t>(*size);
+    }
+};
+
+}  // namespace silkworm::cmd
+
+#endif  // SILKWORM_CMD_DB_OPTIONS_HPP_
@@ -23,6 +23,7 @@
 
 #include <silkworm/common/directories.hpp>
 #include <silkworm/common/log.hpp>
+#include <silkworm/downloader/block_downloader.hpp>
 #include <silkworm/downloader/block_provider.hpp>
 #include <silkworm/downloader/sentry_client.hpp>
 
@@ -40,6 +41,9 @@ int main(int argc, char* argv[]) {
     string db_path = DataDirectory{}.chaindata().path().string();
     string temporary_file_path = ".";
     string sentry_addr = "127.0.0.1:9091";
+    size_t provider_workers = BlockProvider::kDefaultWorkers;
+    BlockNum target_block = 0;
+    BlockDownloader::Config downloader_config;
 
     app.add_option("--chaindata", db_path, "Path to the chain database", true)
         ->check(CLI::ExistingDirectory);
@@ -49,12 +53,24 @@ int main(int argc, char* argv[]) {
         //  todo ->check?
     app.add_option("-f,--filesdir", temporary_file_path, "Path to a temp files dir", true)
         ->check(CLI::ExistingDirectory);
+    app.add_option("--provider-workers", provider_workers, "Number of threads serving block requests of peers", true)
+        ->check(CLI::Range(1u, 64u));
+    app.add_option("--target", target_block, "Download headers and bodies up to this block (0 = only serve peers)",
+                   true);
+    app.add_option("--max-requests", downloader_config.max_outstanding_requests,
+                   "Max number of requests to peers in flight", true)
+        ->check(CLI::Range(1u, 1024u));
+    app.add_option("--validation-threads", downloader_config.validation_threads,
+                   "Number of threads decoding and verifying downloaded headers and bodies", true)
+        ->check(CLI::Range(1u, 256u));
 
     CLI11_PARSE(app, argc, argv);
 
     SILKWORM_LOG_VERBOSITY(LogLevel::Trace);
 
     std::thread block_request_processing;
+    std::thread block_reply_processing;
+    std::unique_ptr<BlockDownloader> block_downloader;
     int return_value = 0;
 
     try {
@@ -72,32 +88,42 @@ int main(int argc, char* argv[]) {
              << "   genesis-hash: " << chain_identity.genesis_hash << "\n"
              << "   hard-forks: " << chain_identity.distinct_fork_numbers().size() << "\n";
 
-        // Database access
-        DbTx db{db_path};
+        // Database access, writable only if we are going to download
+        db::EnvConfig db_config{db_path};
+        db_config.readonly = target_block == 0;
+        mdbx::env_managed env = db::open_env(db_config);
+        DbTx db{env};
 
         // Node current status
         HeaderRetrieval headers(db);
         auto [head_hash, head_td] = headers.head_hash_and_total_difficulty();
         cout << "   head_hash = " << head_hash.to_hex() << "\n";
         cout << "   head_td   = " << intx::to_string(head_td) << "\n\n" << std::flush;
+        db.park();  // not to pin this snapshot while the downloader writes, renewed on use
 
         // Sentry client - connects to sentry
         SentryClient sentry{sentry_addr};
 
         // Block provider - provides headers and bodies to external peers
-        BlockProvider block_provider{sentry, db, chain_identity};
+        BlockProvider block_provider{sentry, db, chain_identity, provider_workers};
         block_request_processing = std::thread( [&block_provider]() {  // todo: join in block_provider destructor
             block_provider.execution_loop();
         });
 
-        // Stage1 - Header downloader - example code
-        //BlockNum target_block = 13'000'000; // only for test
-        //HeaderDownloader header_downloader{sentry, db, chain_identity};
-        //header_downloader.wind(target_block);
+        // Stages Headers & Bodies - downloads from peers up to the target
+        if (target_block > 0) {
+            block_downloader = std::make_unique<BlockDownloader>(sentry, env, downloader_config);
+            block_reply_processing = std::thread([&block_downloader]() {
+                block_downloader->execution_loop();
+            });
+            BlockNum reached = block_downloader->wind(target_block);
+            cout << "   downloaded up to block " << reached << " (" << block_downloader->stats() << ")\n";
+        }
 
         // Wait for user termination request
         std::cin.get();         // wait for user press "enter"
         block_provider.stop();  // signal exiting
+        if (block_downloader) block_downloader->stop();
     }
     catch(std::exception& e) {
         cerr << "Exception: " << e.what() << "\n";
@@ -106,5 +132,7 @@ int main(int argc, char* argv[]) {
 
     if (block_request_processing.joinable())
         block_request_processing.join(); // wait thread termination
+    if (block_reply_processing.joinable())
+        block_reply_processing.join();
     return return_value;
 }
@@ -14,15 +14,21 @@
    limitations under the License.
 */
 
+#include <fstream>
+
 #include <CLI/CLI.hpp>
 #include <magic_enum.hpp>
 
 #include <silkworm/common/directories.hpp>
 #include <silkworm/common/log.hpp>
+#include <silkworm/common/metrics_server.hpp>
+#include <silkworm/common/trace_span.hpp>
 #include <silkworm/db/access_layer.hpp>
 #include <silkworm/stagedsync/stagedsync.hpp>
 #include <silkworm/db/stages.hpp>
 
+#include "db_options.hpp"
+
 int main(int argc, char* argv[]) {
     using namespace silkworm;
 
@@ -43,6 +49,28 @@ int main(int argc, char* argv[]) {
 
     app.add_option("--blocks-to-keep", blocks_to_keep, "How many block to keep in pruned mode");
 
+    cmd::DbEnvOptions db_options;
+    db_options.add_to(app);
+
+    std::string metrics_endpoint;
+    app.add_option("--metrics", metrics_endpoint, "Serve Prometheus metrics at [host:]port/metrics");
+    uint32_t metrics_summary_seconds{30};
+    app.add_option("--metrics-summary", metrics_summary_seconds, "Seconds between metrics summary logs (0 = none)",
+                   true);
+
+    std::string trace_file;
+    app.add_option("--trace-spans", trace_file, "Write hot path trace spans to this file (Chrome trace-event JSON)");
+    uint32_t trace_sampling{1};
+    app.add_option("--trace-sampling", trace_sampling, "Record one outermost trace span in every N", true);
+
+    std::string profile_file;
+    app.add_option("--profile", profile_file, "Profile EVM execution and write the report to this file");
+    std::string profile_sort{"time"};
+    app.add_option("--profile-sort", profile_sort, "Sort the profile report by time, gas or count", true)
+        ->check(CLI::IsMember({"time", "gas", "count"}));
+    size_t profile_top{100};
+    app.add_option("--profile-top", profile_top, "Number of contracts in the profile report", true);
+
     CLI11_PARSE(app, argc, argv);
 
     auto batch_size{parse_size(batch_size_str)};
@@ -51,15 +79,35 @@ int main(int argc, char* argv[]) {
         return -3;
     }
 
+    metrics::MetricsServer::Config metrics_config;
+    try {
+        if (!metrics_endpoint.empty()) {
+            metrics_config = metrics::MetricsServer::parse_endpoint(metrics_endpoint);
+        }
+    } catch (const std::invalid_argument& ex) {
+        SILKWORM_LOG(LogLevel::Error) << ex.what() << std::endl;
+        return -3;
+    }
+    metrics_config.summary_interval = std::chrono::seconds(metrics_summary_seconds);
+    metrics::MetricsServer metrics_server{metrics::Registry::instance(), metrics_config};
+    metrics_server.start();
+
     SILKWORM_LOG(LogLevel::Info) << "Starting block execution. DB: " << chaindata << std::endl;
 
     SILKWORM_LOG_VERBOSITY(LogLevel::Debug);
+    SILKWORM_LOG_ASYNC(true);
 
     uint64_t prune_from{0};
     auto data_dir{DataDirectory::from_chaindata(chaindata)};
     data_dir.deploy();
     db::EnvConfig db_config{data_dir.chaindata().path().string()};
     db_config.create = false;
+    try {
+        db_options.apply_to(db_config);
+    } catch (const std::invalid_argument& ex) {
+        SILKWORM_LOG(LogLevel::Error) << ex.what() << std::endl;
+        return -3;
+    }
     auto env{db::open_env(db_config)};
     stagedsync::TransactionManager tm{env};
 
@@ -67,7 +115,39 @@ int main(int argc, char* argv[]) {
         prune_from = db::stages::read_stage_progress(*tm, db::stages::kSendersKey) - blocks_to_keep;
 
     }
+
+    if (!trace_file.empty()) {
+        if (!trace::kCompiledIn) {
+            SILKWORM_LOG(LogLevel::Warn) << "Trace spans not compiled in : rebuild with -DSILKWORM_TRACE_SPANS=ON"
+                                         << std::endl;
+        }
+        trace::set_sampling(trace_sampling);
+        trace::enable(true);
+    }
+
+    EvmProfiler profiler;
+    if (!profile_file.empty()) {
+        stagedsync::set_execution_profiler(&profiler);
+    }
+
     auto res{stagedsync::stage_execution(tm, data_dir.etl().path(), batch_size.value(), prune_from)};
+    db::checkpoint(env);
+
+    if (!profile_file.empty()) {
+        stagedsync::set_execution_profiler(nullptr);
+        std::ofstream profile_stream{profile_file};
+        profiler.write_report(profile_stream, *EvmProfiler::parse_sort_key(profile_sort), profile_top);
+        SILKWORM_LOG(LogLevel::Info) << "EVM profile written" << log_kv("file", profile_file) << std::endl;
+    }
+
+    if (!trace_file.empty()) {
+        trace::enable(false);
+        std::ofstream trace_stream{trace_file};
+        trace::write_chrome_json(trace_stream);
+        SILKWORM_LOG(LogLevel::Info) << "Trace spans written" << log_kv("file", trace_file)
+                                     << log_kv("spans", trace::recorded_count())
+                                     << log_kv("dropped", trace::dropped_count()) << std::endl;
+    }
 
     if (res != stagedsync::StageResult::kSuccess) {
         SILKWORM_LOG(LogLevel::Info) << "Execution returned : " << magic_enum::enum_name<stagedsync::StageResult>(res)
@@ -24,6 +24,8 @@
 #include <silkworm/db/stages.hpp>
 #include <silkworm/stagedsync/stagedsync.hpp>
 
+#include "db_options.hpp"
+
 using namespace silkworm;
 namespace fs = std::filesystem;
 
@@ -40,11 +42,20 @@ int main(int argc, char* argv[]) {
     app.add_flag("--full", full, "Start making lookups from block 0");
     app.add_flag("--increment", incrementally, "Use incremental method");
     app.add_flag("--reset", reset, "Reset HashState");
+
+    cmd::DbEnvOptions db_options;
+    db_options.add_to(app);
     CLI11_PARSE(app, argc, argv);
 
     auto data_dir{DataDirectory::from_chaindata(chaindata)};
     data_dir.deploy();
     db::EnvConfig db_config{data_dir.chaindata().path().string()};
+    try {
+        db_options.apply_to(db_config);
+    } catch (const std::invalid_argument& ex) {
+        SILKWORM_LOG(LogLevel::Error) << ex.what() << std::endl;
+        return -3;
+    }
     auto env{db::open_env(db_config)};
     auto txn{env.start_write()};
 
@@ -57,6 +68,7 @@ int main(int argc, char* argv[]) {
             if (reset) {
                 SILKWORM_LOG(LogLevel::Info) << "Reset Complete!" << std::endl;
                 txn.commit();
+                db::checkpoint(env);
                 return 0;
             }
         }
@@ -78,6 +90,7 @@ int main(int argc, char* argv[]) {
         db::stages::write_stage_progress(txn, db::stages::kHashStateKey,
                                        db::stages::read_stage_progress(txn, db::stages::kExecutionKey));
         txn.commit();
+        db::checkpoint(env);
         SILKWORM_LOG(LogLevel::Info) << "All Done!" << std::endl;
     } catch (const std::exception& ex) {
         SILKWORM_LOG(LogLevel::Error) << ex.what() << std::endl;
@@ -66,6 +66,7 @@ int main(int argc, char* argv[]) {
         } else {
             stagedsync::check_stagedsync_error(stagedsync::stage_account_history(tm, data_dir.etl().path()));
         }
+        db::checkpoint(env);
 
     } catch (const std::exception& ex) {
         SILKWORM_LOG(LogLevel::Error) << ex.what() << std::endl;
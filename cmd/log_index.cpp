@@ -59,6 +59,7 @@ int main(int argc, char* argv[]) {
 
         stagedsync::TransactionManager tm{env};
         stagedsync::check_stagedsync_error(stagedsync::stage_log_index(tm, data_dir.etl().path()));
+        db::checkpoint(env);
     } catch (const std::exception& ex) {
         SILKWORM_LOG(LogLevel::Error) << ex.what() << std::endl;
         return -5;
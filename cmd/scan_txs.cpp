@@ -14,16 +14,15 @@
    limitations under the License.
 */
 
+#include <cassert>
 #include <filesystem>
 #include <iostream>
 
 #include <CLI/CLI.hpp>
 
 #include <silkworm/common/directories.hpp>
-#include <silkworm/consensus/engine.hpp>
 #include <silkworm/db/access_layer.hpp>
-#include <silkworm/db/buffer.hpp>
-#include <silkworm/execution/execution.hpp>
+#include <silkworm/execution/historical_replay.hpp>
 
 int main(int argc, char* argv[]) {
     CLI::App app{"Executes Ethereum blocks and scans txs for errored txs"};
@@ -39,6 +38,10 @@ int main(int argc, char* argv[]) {
     uint64_t to{UINT64_MAX};
     app.add_option("--to", to, "check up to block number (exclusive)");
 
+    HistoricalReplay::Config replay_config;
+    app.add_option("--threads", replay_config.num_workers, "Number of blocks executed concurrently", true)
+        ->check(CLI::Range(1u, 1024u));
+
     CLI11_PARSE(app, argc, argv);
 
     if (from > to) {
@@ -50,60 +53,38 @@ int main(int argc, char* argv[]) {
 
     // Note: If Erigon is actively syncing its database (syncing), it is important not to create
     // long-running datbase reads transactions even though that may make your processing faster.
-    // Uncomment the following line (and comment the line below) only if you're certain Erigon is not
-    // running on the same machine.
-    // std::unique_ptr<lmdb::Transaction> txn{env->begin_ro_transaction()};
-
-    AnalysisCache analysis_cache;
-    ExecutionStatePool state_pool;
-    std::vector<Receipt> receipts;
+    // HistoricalReplay renews the read transaction of each worker for every block.
 
     try {
         auto data_dir{DataDirectory::from_chaindata(chaindata)};
         data_dir.deploy();
         db::EnvConfig db_config{data_dir.chaindata().path().string()};
         auto env{db::open_env(db_config)};
-        auto txn{env.start_read()};
-        auto chain_config{db::read_chain_config(txn)};
+        std::optional<ChainConfig> chain_config;
+        {
+            auto txn{env.start_read()};
+            chain_config = db::read_chain_config(txn);
+        }
         if (!chain_config) {
             throw std::runtime_error("Unable to retrieve chain config");
         }
-        auto engine{consensus::engine_factory(chain_config.value())};
-        if (!engine) {
-            throw std::runtime_error("Unable to retrieve consensus engine");
-        }
 
         // counters
         uint64_t nTxs{0}, nErrors{0};
 
-        for (uint64_t block_num{from}; block_num < to; ++block_num) {
-            // Note: See the comment above. You may uncomment that line and comment the next line if you're certain
-            // that Erigon is not syncing on the same machine. If you use a long-running transaction by doing this, and
-            // you're mistaken (Erigon is syncing), the database file may 'grow quickly' as per the LMDB docs.
-            txn.renew_reading();
-
-            // Read the block
-            std::optional<BlockWithHash> bh{db::read_block(txn, block_num, /*read_senders=*/true)};
-            if (!bh) {
-                break;
-            }
-
-            db::Buffer buffer{txn, block_num};
-
-            ExecutionProcessor processor{bh->block, *engine, buffer, *chain_config};
-            processor.evm().advanced_analysis_cache = &analysis_cache;
-            processor.evm().state_pool = &state_pool;
-
-            // Execute the block and retrieve the receipts
-            if (const auto res{processor.execute_and_write_block(receipts)}; res != ValidationResult::kOk) {
-                std::cerr << "Validation error " << static_cast<int>(res) << " at block " << block_num << "\n";
+        HistoricalReplay replay{env, *chain_config, replay_config};
+        replay.run(from, to, [&nTxs, &nErrors](ReplayResult& result) {
+            const uint64_t block_num{result.block_number};
+            if (result.validation != ValidationResult::kOk) {
+                std::cerr << "Validation error " << static_cast<int>(result.validation) << " at block " << block_num
+                          << "\n";
             }
 
             // There is one receipt per transaction
-            assert(bh->block.transactions.size() == receipts.size());
+            assert(result.validation != ValidationResult::kOk || result.transaction_count == result.receipts.size());
 
             // Erigon returns success in the receipt even for pre-Byzantium txs.
-            for (auto receipt : receipts) {
+            for (const auto& receipt : result.receipts) {
                 nTxs++;
                 nErrors += (!receipt.success);
             }
@@ -118,10 +99,8 @@ int main(int argc, char* argv[]) {
                 std::cerr << block_num << "\r";
                 std::cerr.flush();
             }
-
-            // Note: If per-block database transaction (txn) is being used, it will go out of scope here
-            // and will be reset. No need to explicitly clean up here.
-        }
+            return true;
+        });
 
     } catch (std::exception& ex) {
         std::cout << ex.what() << std::endl;
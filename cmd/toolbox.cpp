@@ -14,12 +14,22 @@
    limitations under the License.
 */
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <csignal>
+#include <deque>
+#include <exception>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <numeric>
+#include <optional>
 #include <regex>
 #include <string>
+#include <thread>
+#include <utility>
 
 #include <CLI/CLI.hpp>
 #include <boost/bind.hpp>
@@ -33,10 +43,13 @@
 #include <silkworm/common/log.hpp>
 #include <silkworm/db/access_layer.hpp>
 #include <silkworm/db/stages.hpp>
+#include <silkworm/db/util.hpp>
 #include <silkworm/stagedsync/stagedsync.hpp>
 #include <silkworm/state/in_memory_state.hpp>
 #include <silkworm/trie/hash_builder.hpp>
 
+#include "db_options.hpp"
+
 namespace fs = std::filesystem;
 using namespace silkworm;
 
@@ -518,7 +531,256 @@ void do_schema(db::EnvConfig& config) {
               << std::endl;
 }
 
-void do_compact(db::EnvConfig& config, std::string work_dir, bool replace, bool nobak) {
+// Settings of the copy engine used by copy and compact
+struct CopyOptions {
+    size_t readers{std::max(std::thread::hardware_concurrency(), 1u)};  // Tables read concurrently
+    size_t batch_size{16_Mebi};  // Bytes of records a reader hands over to the writer at once
+    size_t commit_size{2_Gibi};  // Dirty bytes in the write transaction triggering a commit
+    bool dry{false};
+};
+
+// A table to be copied
+struct CopyTable {
+    std::string name{};
+    size_t entries{0};
+    size_t size{0};  // On source
+    mdbx::key_mode key_mode{mdbx::key_mode::usual};
+    mdbx::value_mode value_mode{mdbx::value_mode::single};
+    MDBX_put_flags_t put_flags{MDBX_put_flags_t::MDBX_UPSERT};
+};
+
+// Consecutive records of a table
+struct CopyBatch {
+    size_t table{0};
+    Bytes data{};                                    // Keys and values back to back
+    std::vector<std::pair<size_t, size_t>> sizes{};  // Of each key and value
+    std::chrono::steady_clock::time_point started{};  // When reading of the table has started
+    bool last{false};                                 // Of the table
+};
+
+// Bounded queue of batches from readers to the writer
+class CopyChannel {
+  public:
+    explicit CopyChannel(size_t capacity) : capacity_{capacity} {}
+
+    // Blocks while full; returns false if closed
+    bool push(CopyBatch&& batch) {
+        std::unique_lock lock{mtx_};
+        not_full_.wait(lock, [this]() { return closed_ || queue_.size() < capacity_; });
+        if (closed_) {
+            return false;
+        }
+        queue_.push_back(std::move(batch));
+        not_empty_.notify_one();
+        return true;
+    }
+
+    // Blocks while empty; returns false once closed
+    bool pop(CopyBatch& batch) {
+        std::unique_lock lock{mtx_};
+        not_empty_.wait(lock, [this]() { return closed_ || !queue_.empty(); });
+        if (closed_) {
+            return false;
+        }
+        batch = std::move(queue_.front());
+        queue_.pop_front();
+        not_full_.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::unique_lock lock{mtx_};
+        closed_ = true;
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+
+  private:
+    std::mutex mtx_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+    std::deque<CopyBatch> queue_;
+    size_t capacity_;
+    bool closed_{false};
+};
+
+/**
+ * \brief Copies tables from source to target environment.
+ *
+ * Tables are read concurrently, each by a reader thread on its own read-only transaction, and handed over in
+ * batches to the calling thread which writes them into target, committing whenever the dirty size of the write
+ * transaction exceeds options.commit_size. A line with throughput is printed as soon as a table is done.
+ * The last write transaction is committed only if every table has been copied without errors, otherwise it is
+ * aborted: on interruption callers find shouldStop set, on any other failure an exception is thrown.
+ */
+void copy_tables(mdbx::env& src_env, mdbx::env& tgt_env, const std::vector<CopyTable>& tables,
+                 const CopyOptions& options) {
+    if (tables.empty()) {
+        return;
+    }
+
+    // Largest tables first, so that the copy does not end waiting for a large one read alone
+    std::vector<size_t> order(tables.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::sort(order.begin(), order.end(), [&tables](size_t a, size_t b) { return tables[a].size > tables[b].size; });
+
+    CopyChannel channel{std::max<size_t>(options.readers, 1) * 2};
+    std::atomic<size_t> next_table{0};
+    std::mutex error_mtx;
+    std::exception_ptr error{nullptr};
+
+    auto read{[&]() {
+        try {
+            auto txn{src_env.start_read()};
+            for (size_t i{next_table++}; i < order.size() && !shouldStop; i = next_table++) {
+                const CopyTable& table{tables[order[i]]};
+                auto crs{txn.open_cursor(txn.open_map(table.name))};
+                CopyBatch batch{order[i]};
+                batch.started = std::chrono::steady_clock::now();
+                auto data{crs.to_first(/*throw_notfound =*/false)};
+                while (data) {
+                    batch.data.append(db::from_slice(data.key));
+                    batch.data.append(db::from_slice(data.value));
+                    batch.sizes.emplace_back(data.key.length(), data.value.length());
+                    if (batch.data.length() >= options.batch_size) {
+                        const auto started{batch.started};
+                        if (shouldStop || !channel.push(std::move(batch))) {
+                            channel.close();  // Writer might be waiting
+                            return;
+                        }
+                        batch = CopyBatch{order[i]};
+                        batch.started = started;
+                    }
+                    data = crs.to_next(/*throw_notfound =*/false);
+                }
+                batch.last = true;
+                if (!channel.push(std::move(batch))) {
+                    return;
+                }
+            }
+            if (shouldStop) {
+                channel.close();
+            }
+        } catch (...) {
+            std::unique_lock lock{error_mtx};
+            if (!error) {
+                error = std::current_exception();
+            }
+            channel.close();
+        }
+    }};
+
+    std::vector<std::thread> readers;
+    for (size_t i{0}; i < std::min(std::max<size_t>(options.readers, 1), tables.size()); ++i) {
+        readers.emplace_back(read);
+    }
+
+    std::cout << boost::format(" %-24s %14s %12s %10s %10s") % "Table" % "Records" % "MB" % "Seconds" % "MB/s"
+              << std::endl;
+    std::cout << boost::format(" %-24s %14s %12s %10s %10s") % std::string(24, '-') % std::string(14, '-') %
+                     std::string(12, '-') % std::string(10, '-') % std::string(10, '-')
+              << std::endl;
+
+    // Cursors of the current write transaction, opened on first use
+    std::vector<std::optional<mdbx::cursor_managed>> cursors(tables.size());
+    std::vector<size_t> bytes(tables.size(), 0);
+    std::vector<size_t> records(tables.size(), 0);
+
+    auto end_txn{[&](mdbx::txn_managed& txn, bool commit) {
+        for (auto& crs : cursors) {
+            crs.reset();
+        }
+        if (commit && !options.dry) {
+            txn.commit();
+        } else {
+            txn.abort();
+        }
+    }};
+
+    bool complete{false};
+    try {
+        auto txn{tgt_env.start_write()};
+        size_t done{0};
+        CopyBatch batch;
+        while (done < tables.size() && !shouldStop && channel.pop(batch)) {
+            const CopyTable& table{tables[batch.table]};
+            auto& crs{cursors[batch.table]};
+            if (!crs) {
+                crs = txn.open_cursor(txn.create_map(table.name, table.key_mode, table.value_mode));
+            }
+
+            size_t offset{0};
+            for (const auto& [key_size, value_size] : batch.sizes) {
+                mdbx::slice key{&batch.data[offset], key_size};
+                mdbx::slice value{&batch.data[offset + key_size], value_size};
+                crs->put(key, &value, table.put_flags);
+                offset += key_size + value_size;
+            }
+            bytes[batch.table] += batch.data.length();
+            records[batch.table] += batch.sizes.size();
+
+            if (batch.last) {
+                ++done;
+                const double seconds{
+                    std::chrono::duration<double>(std::chrono::steady_clock::now() - batch.started).count()};
+                const double mb{static_cast<double>(bytes[batch.table]) / static_cast<double>(1_Mebi)};
+                std::cout << boost::format(" %-24s %14u %12.1f %10.1f %10.1f") % table.name % records[batch.table] %
+                                 mb % seconds % (seconds > 0 ? mb / seconds : 0.0)
+                          << std::endl;
+            }
+
+            if (txn.get_info().txn_space_dirty >= options.commit_size) {
+                end_txn(txn, /*commit=*/true);
+                txn = tgt_env.start_write();
+            }
+        }
+        if (done == tables.size()) {
+            std::unique_lock lock{error_mtx};
+            complete = !error;
+        }
+        end_txn(txn, complete);
+    } catch (...) {
+        std::unique_lock lock{error_mtx};
+        if (!error) {
+            error = std::current_exception();
+        }
+    }
+
+    channel.close();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if (!complete && !shouldStop) {
+        throw std::runtime_error("Copy of tables incomplete, last transaction aborted");
+    }
+}
+
+// Records of a table already sorted can be appended, unless target already has some
+MDBX_put_flags_t copy_put_flags(const mdbx::map_handle::info& info, bool populated_on_target) {
+    if (populated_on_target) {
+        return MDBX_put_flags_t::MDBX_UPSERT;
+    }
+    if (info.flags & MDBX_DUPSORT) {
+        return static_cast<MDBX_put_flags_t>(MDBX_put_flags_t::MDBX_APPEND | MDBX_put_flags_t::MDBX_APPENDDUP);
+    }
+    return MDBX_put_flags_t::MDBX_APPEND;
+}
+
+// A target db gets the geometry, page size and write mode given for the source, so copy/compact can also migrate
+// a db to different settings
+void inherit_tuning(const db::EnvConfig& src_config, db::EnvConfig& tgt_config) {
+    tgt_config.page_size = src_config.page_size;
+    tgt_config.max_size = src_config.max_size;
+    tgt_config.growth_size = src_config.growth_size;
+    tgt_config.write_map = src_config.write_map;
+    tgt_config.sync_mode = src_config.sync_mode;
+}
+
+void do_compact(db::EnvConfig& config, std::string work_dir, bool replace, bool nobak,
+                const CopyOptions& options) {
     fs::path work_path{work_dir};
     if (work_path.has_filename()) {
         work_path += fs::path::preferred_separator;
@@ -547,10 +809,30 @@ void do_compact(db::EnvConfig& config, std::string work_dir, bool replace, bool
         throw std::runtime_error("Insufficient disk space on working directory's partition");
     }
 
-    std::cout << "\n Compacting database from " << config.path << "\n into " << target_file_path
-              << "\n Please be patient as there is no progress report ..." << std::endl;
-    env.copy(/*destination*/ target_file_path.string(), /*compactify*/ true, /*forcedynamic*/ true);
+    // Copying all records into a new database in append mode leaves no free nor partially filled pages
+    std::vector<CopyTable> tables;
+    {
+        auto txn{env.start_read()};
+        for (const auto& table : get_tablesInfo(txn).tables) {
+            if (table.id < 2) {
+                continue;  // System tables
+            }
+            tables.push_back({table.name, table.stat.ms_entries, table.size(), table.info.key_mode(),
+                              table.info.value_mode(), copy_put_flags(table.info, /*populated_on_target=*/false)});
+        }
+    }
+
+    db::EnvConfig tgt_config{work_path.string()};
+    inherit_tuning(config, tgt_config);
+    tgt_config.create = true;
+    tgt_config.exclusive = true;
+    auto tgt_env{db::open_env(tgt_config)};
+
+    std::cout << "\n Compacting database from " << config.path << "\n into " << target_file_path << "\n"
+              << std::endl;
+    copy_tables(env, tgt_env, tables, options);
     std::cout << "\n Database compaction " << (shouldStop ? "aborted !" : "completed ...") << std::endl;
+    tgt_env.close();
     env.close();
 
     if (!shouldStop) {
@@ -585,7 +867,7 @@ void do_compact(db::EnvConfig& config, std::string work_dir, bool replace, bool
 }
 
 void do_copy(db::EnvConfig& src_config, std::string target_dir, bool create, bool noempty,
-             std::vector<std::string>& names, std::vector<std::string>& xnames, bool dry) {
+             std::vector<std::string>& names, std::vector<std::string>& xnames, const CopyOptions& options) {
     fs::path target_path{target_dir};
     if (target_path.has_filename()) {
         target_path += fs::path::preferred_separator;
@@ -603,6 +885,7 @@ void do_copy(db::EnvConfig& src_config, std::string target_dir, bool create, boo
 
     // Target config
     db::EnvConfig tgt_config{target_path.string()};
+    inherit_tuning(src_config, tgt_config);
     tgt_config.exclusive = true;
     fs::path target_file_path{target_path / fs::path(db::kDbDataFileName)};
     if (!fs::exists(target_file_path)) {
@@ -611,35 +894,30 @@ void do_copy(db::EnvConfig& src_config, std::string target_dir, bool create, boo
 
     // Source db
     auto src_env{silkworm::db::open_env(src_config)};
-    auto src_txn{src_env.start_read()};
 
     // Target db
     auto tgt_env{silkworm::db::open_env(tgt_config)};
-    auto tgt_txn{tgt_env.start_write()};
 
     // Get free info and tables from both source and target environment
-    auto src_tableInfo = get_tablesInfo(src_txn);
-    auto tgt_tableInfo = get_tablesInfo(tgt_txn);
+    dbTablesInfo src_tableInfo;
+    dbTablesInfo tgt_tableInfo;
+    {
+        auto src_txn{src_env.start_read()};
+        auto tgt_txn{tgt_env.start_read()};
+        src_tableInfo = get_tablesInfo(src_txn);
+        tgt_tableInfo = get_tablesInfo(tgt_txn);
+    }
 
     // Check source db has tables to copy besides the two system tables
     if (src_tableInfo.tables.size() < 3) {
         throw std::runtime_error("Source db has no tables to copy.");
     }
 
-    size_t bytesWritten{0};
-    std::cout << boost::format(" %-24s %=50s") % "Table" % "Progress" << std::endl;
-    std::cout << boost::format(" %-24s %=50s") % std::string(24, '-') % std::string(50, '-') << std::flush;
-
-    // Loop source tables
+    // Select source tables
+    std::vector<CopyTable> tables;
     for (auto& src_table : src_tableInfo.tables) {
-        if (shouldStop) {
-            break;
-        }
-        std::cout << "\n " << boost::format("%-24s ") % src_table.name << std::flush;
-
         // Is this a system table ?
         if (src_table.id < 2) {
-            std::cout << "Skipped (SYSTEM TABLE)" << std::flush;
             continue;
         }
 
@@ -647,7 +925,6 @@ void do_copy(db::EnvConfig& src_config, std::string target_dir, bool create, boo
         if (!names.empty()) {
             auto it = std::find(names.begin(), names.end(), src_table.name);
             if (it == names.end()) {
-                std::cout << "Skipped (no match --tables)" << std::flush;
                 continue;
             }
         }
@@ -656,113 +933,39 @@ void do_copy(db::EnvConfig& src_config, std::string target_dir, bool create, boo
         if (!xnames.empty()) {
             auto it = std::find(xnames.begin(), xnames.end(), src_table.name);
             if (it != xnames.end()) {
-                std::cout << "Skipped (match --xtables)" << std::flush;
                 continue;
             }
         }
 
         // Is table empty ?
         if (!src_table.stat.ms_entries && noempty) {
-            std::cout << "Skipped (--noempty)" << std::flush;
+            std::cout << " " << boost::format("%-24s ") % src_table.name << "Skipped (--noempty)" << std::endl;
             continue;
         }
 
-        // Is source table already present in target db ?
-        bool exists_on_target{false};
+        // Is source table already present in target db ? Then flags must match
         bool populated_on_target{false};
-        if (!tgt_tableInfo.tables.empty()) {
-            auto it = std::find_if(tgt_tableInfo.tables.begin(), tgt_tableInfo.tables.end(),
-                                   [&src_table](dbTableEntry& item) -> bool { return item.name == src_table.name; });
-            if (it != tgt_tableInfo.tables.end()) {
-                exists_on_target = true;
-                populated_on_target = (it->stat.ms_entries > 0);
-            }
-        }
-
-        // Ready to copy
-        auto src_table_map{src_txn.open_map(src_table.name)};
-        auto src_table_info{src_txn.get_handle_info(src_table_map)};
-
-        // If table does not exist on target create it with same flags as
-        // origin table. Check the info match otherwise.
-        mdbx::map_handle tgt_table_map;
-        if (!exists_on_target) {
-            tgt_table_map = tgt_txn.create_map(src_table.name, src_table_info.key_mode(), src_table_info.value_mode());
-        } else {
-            tgt_table_map = tgt_txn.open_map(src_table.name);
-            auto tgt_table_info{tgt_txn.get_handle_info(tgt_table_map)};
-            if (src_table_info.flags != tgt_table_info.flags) {
-                std::cout << "Skipped (source and target have incompatible flags)" << std::flush;
+        auto it = std::find_if(tgt_tableInfo.tables.begin(), tgt_tableInfo.tables.end(),
+                               [&src_table](dbTableEntry& item) -> bool { return item.name == src_table.name; });
+        if (it != tgt_tableInfo.tables.end()) {
+            if (src_table.info.flags != it->info.flags) {
+                std::cout << " " << boost::format("%-24s ") % src_table.name
+                          << "Skipped (source and target have incompatible flags)" << std::endl;
                 continue;
             }
+            populated_on_target = (it->stat.ms_entries > 0);
         }
 
-        // Loop source and write into target
-        Progress progress{50};
-        progress.set_task_count(src_table.stat.ms_entries);
-        size_t batch_size{progress.get_increment_count()};
-        bool batch_committed{false};
-
-        auto src_table_crs{src_txn.open_cursor(src_table_map)};
-        auto tgt_table_crs{tgt_txn.open_cursor(tgt_table_map)};
-        MDBX_put_flags_t put_flags{!populated_on_target
-                                       ? MDBX_put_flags_t::MDBX_UPSERT
-                                       : ((src_table_info.flags & MDBX_DUPSORT) ? MDBX_put_flags_t::MDBX_APPENDDUP
-                                                                                : MDBX_put_flags_t::MDBX_APPEND)};
-
-        auto data{src_table_crs.to_first(/*throw_notfound =*/false)};
-        while (data) {
-            tgt_table_crs.put(data.key, &data.value, put_flags);
-            bytesWritten += (data.key.length() + data.value.length());
-            if (bytesWritten >= 2_Gibi) {
-                tgt_table_crs.close();
-                if (!dry) {
-                    tgt_txn.commit();
-                } else {
-                    tgt_txn.abort();
-                }
-                tgt_txn = tgt_env.start_write();
-                if (dry && !exists_on_target) {
-                    tgt_table_map =
-                        tgt_txn.create_map(src_table.name, src_table_info.key_mode(), src_table_info.value_mode());
-                } else {
-                    tgt_table_map = tgt_txn.open_map(src_table.name);
-                }
-                tgt_table_crs = tgt_txn.open_cursor(tgt_table_map);
-                batch_committed = true;
-                bytesWritten = 0;
-            }
-
-            if (!--batch_size) {
-                if (shouldStop) {
-                    break;
-                }
-                progress.set_current(progress.get_current() + progress.get_increment_count());
-                std::cout << progress.print_interval(batch_committed ? 'W' : '.') << std::flush;
-                batch_committed = false;
-                batch_size = progress.get_increment_count();
-            }
-
-            data = src_table_crs.to_next(/*throw_notfound =*/false);
-        }
-
-        // Close all
-        if (!shouldStop && bytesWritten) {
-            if (!dry) {
-                tgt_txn.commit();
-            } else {
-                tgt_txn.abort();
-            }
-            tgt_txn = tgt_env.start_write();
-            batch_committed = true;
-            bytesWritten = 0;
-        }
-
-        progress.set_current(src_table.stat.ms_entries);
-        std::cout << progress.print_interval(batch_committed ? 'W' : '.') << std::flush;
+        tables.push_back({src_table.name, src_table.stat.ms_entries, src_table.size(), src_table.info.key_mode(),
+                          src_table.info.value_mode(), copy_put_flags(src_table.info, populated_on_target)});
     }
 
-    std::cout << "\n All done!" << std::endl;
+    std::cout << "\n Copying " << tables.size() << " tables with " << options.readers << " readers"
+              << (options.dry ? " (dry run)" : "") << "\n"
+              << std::endl;
+    copy_tables(src_env, tgt_env, tables, options);
+
+    std::cout << "\n " << (shouldStop ? "Aborted !" : "All done!") << std::endl;
 }
 
 /**
@@ -1102,6 +1305,9 @@ int main(int argc, char* argv[]) {
     auto chaindata_opt = db_opts_paths->add_option("--chaindata", "Path to directory for mdbx.dat");
     auto datadir_opt = db_opts_paths->add_option("--datadir", "Path to data directory")->excludes(chaindata_opt);
 
+    cmd::DbEnvOptions db_env_options;
+    db_env_options.add_to(*db_opts);
+
     /*
      * Common opts and flags
      */
@@ -1142,6 +1348,9 @@ int main(int argc, char* argv[]) {
     auto cmd_compact_replace_opt = cmd_compact->add_flag("--replace", "Replace original file with compacted");
     auto cmd_compact_nobak_opt = cmd_compact->add_flag("--nobak", "Don't create a bak copy of original when replacing")
                                      ->needs(cmd_compact_replace_opt);
+    CopyOptions cmd_compact_options;
+    cmd_compact->add_option("--threads", cmd_compact_options.readers, "Number of tables read concurrently", true)
+        ->check(CLI::Range(1u, 256u));
 
     // Copy database file or subset of tables
     auto cmd_copy = app_main.add_subcommand("copy", "Copies an entire Silkworm database or subset of tables");
@@ -1151,6 +1360,12 @@ int main(int argc, char* argv[]) {
     std::vector<std::string> cmd_copy_names, cmd_copy_xnames;
     cmd_copy->add_option("--tables", cmd_copy_names, "Copy only tables matching this list of names", true);
     cmd_copy->add_option("--xtables", cmd_copy_xnames, "Don't copy tables matching this list of names", true);
+    CopyOptions cmd_copy_options;
+    cmd_copy->add_option("--threads", cmd_copy_options.readers, "Number of tables read concurrently", true)
+        ->check(CLI::Range(1u, 256u));
+    size_t cmd_copy_commit_mb{cmd_copy_options.commit_size / 1_Mebi};
+    cmd_copy->add_option("--commit-size", cmd_copy_commit_mb, "Commit when this many MB are dirty in target", true)
+        ->check(CLI::Range(16u, 1048576u));
 
     // Stages tool
     auto cmd_stageset = app_main.add_subcommand("stage-set", "Sets a stage to a new height");
@@ -1224,6 +1439,12 @@ int main(int argc, char* argv[]) {
         db::EnvConfig src_config{data_dir.chaindata().path().string()};
         src_config.shared = *shared_opt;
         src_config.exclusive = *exclusive_opt;
+        try {
+            db_env_options.apply_to(src_config);
+        } catch (const std::invalid_argument& ex) {
+            std::cerr << "\n " << ex.what() << "\n Run with --help for usage" << std::endl;
+            return -1;
+        }
 
         // Execute subcommand actions
         if (*cmd_tables) {
@@ -1244,10 +1465,12 @@ int main(int argc, char* argv[]) {
             do_clear(src_config, *app_dry_opt, *app_yes_opt, cmd_clear_names, *cmd_clear_drop_opt);
         } else if (*cmd_compact) {
             do_compact(src_config, cmd_compact_workdir_opt->as<std::string>(), *cmd_compact_replace_opt,
-                       *cmd_compact_nobak_opt);
+                       *cmd_compact_nobak_opt, cmd_compact_options);
         } else if (*cmd_copy) {
+            cmd_copy_options.commit_size = cmd_copy_commit_mb * 1_Mebi;
+            cmd_copy_options.dry = *app_dry_opt;
             do_copy(src_config, cmd_copy_targetdir_opt->as<std::string>(), *cmd_copy_target_create_opt,
-                    *cmd_copy_target_noempty_opt, cmd_copy_names, cmd_copy_xnames, *app_dry_opt);
+                    *cmd_copy_target_noempty_opt, cmd_copy_names, cmd_copy_xnames, cmd_copy_options);
         } else if (*cmd_stageset) {
             do_stage_set(src_config, cmd_stageset_name_opt->as<std::string>(), cmd_stageset_height_opt->as<uint32_t>(),
                          *app_dry_opt);
@@ -46,6 +46,7 @@ int main(int argc, char* argv[]) {
         auto env{db::open_env(db_config)};
         stagedsync::TransactionManager tm{env};
         stagedsync::check_stagedsync_error(stagedsync::unwind_hashstate(tm, data_dir.etl().path(), unwind_to));
+        db::checkpoint(env);
 
     } catch (const std::exception& ex) {
         SILKWORM_LOG(LogLevel::Error) << ex.what() << std::endl;
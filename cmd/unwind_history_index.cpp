@@ -54,6 +54,7 @@ int main(int argc, char* argv[]) {
             stagedsync::check_stagedsync_error(
                 stagedsync::unwind_account_history(tm, data_dir.etl().path(), unwind_to));
         }
+        db::checkpoint(env);
     } catch (const std::exception& ex) {
         SILKWORM_LOG(LogLevel::Error) << ex.what() << std::endl;
         return -5;
@@ -16,6 +16,8 @@
 
 #include "test_util.hpp"
 
+#include <silkworm/common/util.hpp>
+
 namespace silkworm::test {
 
 std::vector<Transaction> sample_transactions() {
@@ -80,4 +82,22 @@ std::vector<Receipt> sample_receipts() {
     return receipts;
 }
 
+BlockHeader sample_mainnet_header() {
+    BlockHeader header;
+    header.parent_hash = 0xd4e56740f876aef8c010b86a40d5f56745a118d0906a34e69aec8c0db1cb8fa3_bytes32;
+    header.ommers_hash = kEmptyListHash;
+    header.beneficiary = 0x05a56e2d52c817161883f50c441c3228cfe54d9f_address;
+    header.state_root = 0xd67e4d450343046425ae4271474353857ab860dbc0a1dde64b41b5cd3a532bf3_bytes32;
+    header.transactions_root = kEmptyRoot;
+    header.receipts_root = kEmptyRoot;
+    header.difficulty = 17'171'480'576;
+    header.number = 1;
+    header.gas_limit = 5'000;
+    header.timestamp = 1'438'269'988;
+    header.extra_data = *from_hex("476574682f76312e302e302f6c696e75782f676f312e342e32");
+    header.mix_hash = 0x969b900de27b6ac6a67742365dd65f55a0526c41fd18e1b16f1a1215c2e66f59_bytes32;
+    header.nonce = {0x53, 0x9b, 0xd4, 0x97, 0x9f, 0xef, 0x1e, 0xc4};
+    return header;
+}
+
 }  // namespace silkworm::test
@@ -34,6 +34,9 @@ static_assert(kLondonConfig.revision(0) == EVMC_LONDON);
 std::vector<Transaction> sample_transactions();
 std::vector<Receipt> sample_receipts();
 
+/// Header of mainnet block 1, carrying a genuine Ethash seal.
+BlockHeader sample_mainnet_header();
+
 }  // namespace silkworm::test
 
 #endif  // SILKWORM_COMMON_TEST_UTIL_HPP_
@@ -0,0 +1,226 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "trace_span.hpp"
+
+#if defined(SILKWORM_TRACE_SPANS)
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace silkworm::trace {
+
+namespace {
+
+    struct Event {
+        const char* name;
+        uint64_t start;  // ns since kEpoch
+        uint64_t duration;
+    };
+
+    // Append only buffer of one thread. Events are written in chunks allocated on demand and published by
+    // a release store of the size, so the export can read them while the owning thread keeps recording.
+    class ThreadBuffer {
+      public:
+        static constexpr size_t kChunkSize{8192};
+        static constexpr size_t kMaxChunks{128};  // ~1M spans, 24 MB per thread at most
+
+        explicit ThreadBuffer(uint32_t id) : id_{id} {}
+
+        [[nodiscard]] uint32_t id() const noexcept { return id_; }
+        [[nodiscard]] size_t size() const noexcept { return size_.load(std::memory_order_acquire); }
+        [[nodiscard]] const Event& operator[](size_t i) const noexcept {
+            return chunks_[i / kChunkSize][i % kChunkSize];
+        }
+
+        bool push(const Event& event) noexcept {
+            const size_t n{size_.load(std::memory_order_relaxed)};
+            if (n == kChunkSize * kMaxChunks) {
+                return false;
+            }
+            auto& chunk{chunks_[n / kChunkSize]};
+            if (!chunk) {
+                chunk = std::make_unique<Event[]>(kChunkSize);
+            }
+            chunk[n % kChunkSize] = event;
+            size_.store(n + 1, std::memory_order_release);
+            return true;
+        }
+
+        void clear() noexcept { size_.store(0, std::memory_order_release); }
+
+      private:
+        const uint32_t id_;
+        std::array<std::unique_ptr<Event[]>, kMaxChunks> chunks_;
+        std::atomic<size_t> size_{0};
+    };
+
+    const auto kEpoch{std::chrono::steady_clock::now()};
+
+    std::atomic<bool> recording{false};
+    std::atomic<uint32_t> sampling{1};
+    std::atomic<uint64_t> dropped{0};
+
+    // Buffers outlive their threads so that spans of finished threads can still be exported
+    std::mutex buffers_mtx;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+    struct ThreadState {
+        std::shared_ptr<ThreadBuffer> buffer;
+        uint32_t depth{0};
+        uint64_t outermost{0};
+        bool sampled{false};
+    };
+
+    thread_local ThreadState thread_state;
+
+    uint64_t now() noexcept {
+        const auto elapsed{std::chrono::steady_clock::now() - kEpoch};
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    ThreadBuffer& thread_buffer() {
+        if (!thread_state.buffer) {
+            std::scoped_lock lock{buffers_mtx};
+            thread_state.buffer = std::make_shared<ThreadBuffer>(static_cast<uint32_t>(buffers.size() + 1));
+            buffers.push_back(thread_state.buffer);
+        }
+        return *thread_state.buffer;
+    }
+
+    // Trace-event timestamps are in microseconds
+    void write_micros(std::ostream& os, uint64_t ns) {
+        const char fill{os.fill('0')};
+        os << ns / 1000 << '.' << std::setw(3) << ns % 1000;
+        os.fill(fill);
+    }
+
+}  // namespace
+
+void enable(bool enabled) noexcept { recording.store(enabled, std::memory_order_relaxed); }
+
+bool enabled() noexcept { return recording.load(std::memory_order_relaxed); }
+
+void set_sampling(uint32_t n) noexcept { sampling.store(n ? n : 1, std::memory_order_relaxed); }
+
+void write_chrome_json(std::ostream& os) {
+    std::vector<std::shared_ptr<ThreadBuffer>> snapshot;
+    {
+        std::scoped_lock lock{buffers_mtx};
+        snapshot = buffers;
+    }
+
+    os << "{\"traceEvents\":[";
+    const char* separator{"\n"};
+    for (const auto& buffer : snapshot) {
+        os << separator << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << buffer->id()
+           << R"(,"args":{"name":"thread )" << buffer->id() << "\"}}";
+        separator = ",\n";
+        const size_t size{buffer->size()};
+        for (size_t i{0}; i < size; ++i) {
+            const Event& event{(*buffer)[i]};
+            os << separator << R"({"name":")" << event.name << R"(","ph":"X","pid":1,"tid":)" << buffer->id()
+               << R"(,"ts":)";
+            write_micros(os, event.start);
+            os << R"(,"dur":)";
+            write_micros(os, event.duration);
+            os << "}";
+        }
+    }
+    os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+uint64_t recorded_count() noexcept {
+    std::scoped_lock lock{buffers_mtx};
+    uint64_t count{0};
+    for (const auto& buffer : buffers) {
+        count += buffer->size();
+    }
+    return count;
+}
+
+uint64_t dropped_count() noexcept { return dropped.load(std::memory_order_relaxed); }
+
+void reset() noexcept {
+    std::scoped_lock lock{buffers_mtx};
+    for (const auto& buffer : buffers) {
+        buffer->clear();
+    }
+    dropped.store(0, std::memory_order_relaxed);
+}
+
+namespace detail {
+
+    uint64_t begin_span() noexcept {
+        if (!recording.load(std::memory_order_relaxed)) {
+            return kNotRecording;
+        }
+        ThreadState& state{thread_state};
+        if (state.depth++ == 0) {
+            state.sampled = state.outermost++ % sampling.load(std::memory_order_relaxed) == 0;
+        }
+        return state.sampled ? now() : kNotSampled;
+    }
+
+    void end_span(const char* name, uint64_t start) noexcept {
+        --thread_state.depth;
+        if (start == kNotSampled) {
+            return;
+        }
+        const uint64_t end{now()};
+        if (!thread_buffer().push({name, start, end - start})) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+}  // namespace detail
+
+}  // namespace silkworm::trace
+
+#else
+
+namespace silkworm::trace {
+
+void enable(bool) noexcept {}
+
+bool enabled() noexcept { return false; }
+
+void set_sampling(uint32_t) noexcept {}
+
+void write_chrome_json(std::ostream& os) { os << "{\"traceEvents\":[],\"displayTimeUnit\":\"ns\"}\n"; }
+
+uint64_t recorded_count() noexcept { return 0; }
+
+uint64_t dropped_count() noexcept { return 0; }
+
+void reset() noexcept {}
+
+namespace detail {
+
+    uint64_t begin_span() noexcept { return kNotRecording; }
+
+    void end_span(const char*, uint64_t) noexcept {}
+
+}  // namespace detail
+
+}  // namespace silkworm::trace
+
+#endif
@@ -0,0 +1,96 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_COMMON_TRACE_SPAN_HPP_
+#define SILKWORM_COMMON_TRACE_SPAN_HPP_
+
+#include <cstdint>
+#include <ostream>
+
+// Scoped spans around hot paths, recorded into per-thread buffers and exported as Chrome trace-event JSON
+// (chrome://tracing or https://ui.perfetto.dev) - e.g.
+//
+//	  void Buffer::write_to_db() {
+//	      SILKWORM_TRACE_SPAN("Buffer::write_to_db");
+//	      ...
+//
+// Spans are compiled out unless the build defines SILKWORM_TRACE_SPANS (cmake -DSILKWORM_TRACE_SPANS=ON). When compiled
+// in, recording still has to be switched on with trace::enable; a disabled span costs a relaxed atomic load.
+#if defined(SILKWORM_TRACE_SPANS)
+#define SILKWORM_TRACE_CONCAT_IMPL_(a_, b_) a_##b_
+#define SILKWORM_TRACE_CONCAT_(a_, b_) SILKWORM_TRACE_CONCAT_IMPL_(a_, b_)
+#define SILKWORM_TRACE_SPAN(name_) \
+    const silkworm::trace::Span SILKWORM_TRACE_CONCAT_(silkworm_trace_span_, __LINE__) { name_ }
+#else
+#define SILKWORM_TRACE_SPAN(name_) static_cast<void>(0)
+#endif
+
+namespace silkworm::trace {
+
+// Whether SILKWORM_TRACE_SPAN records anything in this build
+#if defined(SILKWORM_TRACE_SPANS)
+inline constexpr bool kCompiledIn{true};
+#else
+inline constexpr bool kCompiledIn{false};
+#endif
+
+// Starts (true) or stops (false) recording
+void enable(bool enabled) noexcept;
+[[nodiscard]] bool enabled() noexcept;
+
+// Records only one outermost span in every n per thread (with all the spans nested in it); default is 1 (all)
+void set_sampling(uint32_t n) noexcept;
+
+// Writes every recorded span in Chrome trace-event JSON format
+void write_chrome_json(std::ostream& os);
+
+// Number of spans recorded so far and number dropped because a thread's buffer was full
+[[nodiscard]] uint64_t recorded_count() noexcept;
+[[nodiscard]] uint64_t dropped_count() noexcept;
+
+// Discards recorded spans. Must not race with open spans, i.e. call it with recording stopped.
+void reset() noexcept;
+
+namespace detail {
+    inline constexpr uint64_t kNotRecording{UINT64_MAX};
+    inline constexpr uint64_t kNotSampled{UINT64_MAX - 1};
+
+    // Returns the start timestamp or one of the above
+    uint64_t begin_span() noexcept;
+    void end_span(const char* name, uint64_t start) noexcept;
+}  // namespace detail
+
+class Span {
+  public:
+    // name must be a string literal, or at least outlive the export
+    explicit Span(const char* name) noexcept : name_{name}, start_{detail::begin_span()} {}
+    ~Span() {
+        if (start_ != detail::kNotRecording) {
+            detail::end_span(name_, start_);
+        }
+    }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+  private:
+    const char* name_;
+    uint64_t start_;
+};
+
+}  // namespace silkworm::trace
+
+#endif  // SILKWORM_COMMON_TRACE_SPAN_HPP_
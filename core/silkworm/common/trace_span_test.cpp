@@ -0,0 +1,76 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "trace_span.hpp"
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm::trace {
+
+TEST_CASE("Trace spans") {
+    reset();
+
+    if (!kCompiledIn) {
+        enable(true);
+        { SILKWORM_TRACE_SPAN("compiled_out"); }
+        enable(false);
+        CHECK(recorded_count() == 0);
+        return;
+    }
+
+    SECTION("Nested spans on several threads") {
+        { SILKWORM_TRACE_SPAN("not_recording"); }
+        enable(true);
+        {
+            SILKWORM_TRACE_SPAN("outer");
+            SILKWORM_TRACE_SPAN("inner");
+        }
+        std::thread{[]() { SILKWORM_TRACE_SPAN("other_thread"); }}.join();
+        enable(false);
+        CHECK(recorded_count() == 3);
+        CHECK(dropped_count() == 0);
+
+        std::ostringstream os;
+        write_chrome_json(os);
+        const std::string json{os.str()};
+        CHECK(json.rfind("{\"traceEvents\":[", 0) == 0);
+        CHECK(json.find(R"("name":"outer","ph":"X")") != std::string::npos);
+        CHECK(json.find(R"("name":"inner","ph":"X")") != std::string::npos);
+        CHECK(json.find(R"("name":"other_thread","ph":"X")") != std::string::npos);
+        CHECK(json.find("not_recording") == std::string::npos);
+    }
+
+    SECTION("Sampling keeps nested spans with their outermost one") {
+        set_sampling(2);
+        enable(true);
+        for (int i{0}; i < 4; ++i) {
+            SILKWORM_TRACE_SPAN("outer");
+            SILKWORM_TRACE_SPAN("inner");
+        }
+        enable(false);
+        set_sampling(1);
+        CHECK(recorded_count() == 4);
+    }
+
+    reset();
+    CHECK(recorded_count() == 0);
+}
+
+}  // namespace silkworm::trace
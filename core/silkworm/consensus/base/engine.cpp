@@ -19,7 +19,6 @@
 #include <silkworm/chain/difficulty.hpp>
 #include <silkworm/chain/protocol_param.hpp>
 #include <silkworm/crypto/ecdsa.hpp>
-#include <silkworm/trie/vector_root.hpp>
 
 namespace silkworm::consensus {
 
@@ -31,20 +30,8 @@ ValidationResult ConsensusEngineBase::pre_validate_block(const silkworm::Block&
         return err;
     }
 
-    Bytes ommers_rlp;
-    rlp::encode(ommers_rlp, block.ommers);
-    ethash::hash256 ommers_hash{keccak256(ommers_rlp)};
-    if (full_view(ommers_hash.bytes) != full_view(header.ommers_hash)) {
-        return ValidationResult::kWrongOmmersHash;
-    }
-
-    static constexpr auto kEncoder = [](Bytes& to, const Transaction& txn) {
-        rlp::encode(to, txn, /*for_signing=*/false, /*wrap_eip2718_into_array=*/false);
-    };
-
-    evmc::bytes32 txn_root{trie::root_hash(block.transactions, kEncoder)};
-    if (txn_root != header.transactions_root) {
-        return ValidationResult::kWrongTransactionsRoot;
+    if (ValidationResult err{validate_body_roots(header, block)}; err != ValidationResult::kOk) {
+        return err;
     }
 
     if (block.ommers.size() > 2) {
@@ -18,6 +18,8 @@
 
 #include <cassert>
 
+#include <gsl/gsl_util>
+
 #include <silkworm/execution/processor.hpp>
 
 namespace silkworm::consensus {
@@ -43,33 +45,44 @@ ValidationResult Blockchain::insert_block(Block& block, bool check_state_root) {
         return it->second;
     }
 
-    block.recover_senders();
-
     uint64_t ancestor{canonical_ancestor(block.header, hash)};
     uint64_t current_canonical_block{state_.current_canonical_block()};
-    unwind_last_changes(ancestor, current_canonical_block);
-
     uint64_t block_number{block.header.number};
 
     std::vector<BlockWithHash> chain{intermediate_chain(block_number - 1, block.header.parent_hash, ancestor)};
     chain.push_back({block, hash});
 
-    ValidationResult err{ValidationResult::kOk};
-    size_t num_of_executed_chain_blocks{0};
-    for (const BlockWithHash& x : chain) {
-        err = execute_block(x.block, check_state_root);
-        if (err != ValidationResult::kOk) {
-            break;
-        }
-        ++num_of_executed_chain_blocks;
+    // State of the parent: the canonical chain reverted down to the common ancestor with the side chain on top
+    StateOverlay parent_state{state_};
+    for (uint64_t i{current_canonical_block}; i > ancestor; --i) {
+        parent_state.revert(overlay(*state_.canonical_hash(i)));
+    }
+    for (size_t i{0}; i + 1 < chain.size(); ++i) {
+        parent_state.merge(overlay(chain[i].hash));
     }
 
-    if (err != ValidationResult::kOk) {
+    auto changes{std::make_unique<StateOverlay>(parent_state)};
+    if (ValidationResult err{execute_block(block, *changes)}; err != ValidationResult::kOk) {
         bad_blocks_[hash] = err;
-        unwind_last_changes(ancestor, ancestor + num_of_executed_chain_blocks);
-        re_execute_canonical_chain(ancestor, current_canonical_block);
         return err;
     }
+    changes->rebase(state_);
+    overlays_[hash] = std::move(changes);
+
+    // The state root is only available on the full state, hence switch it to the new chain
+    bool switched{false};
+    if (check_state_root) {
+        unwind_last_changes(ancestor, current_canonical_block);
+        apply_chain(chain);
+        switched = true;
+        if (state_.state_root_hash() != block.header.state_root) {
+            unwind_last_changes(ancestor, block_number);
+            restore_canonical_chain(ancestor, current_canonical_block);
+            overlays_.erase(hash);
+            bad_blocks_[hash] = ValidationResult::kWrongStateRoot;
+            return ValidationResult::kWrongStateRoot;
+        }
+    }
 
     state_.insert_block(block, hash);
 
@@ -78,38 +91,34 @@ ValidationResult Blockchain::insert_block(Block& block, bool check_state_root) {
 
     if (state_.total_difficulty(block_number, hash) > current_total_difficulty) {
         // canonize the new chain
+        if (!switched) {
+            unwind_last_changes(ancestor, current_canonical_block);
+            apply_chain(chain);
+        }
         for (uint64_t i{current_canonical_block}; i > ancestor; --i) {
             state_.decanonize_block(i);
         }
         for (const BlockWithHash& x : chain) {
             state_.canonize_block(x.block.header.number, x.hash);
         }
-    } else {
-        unwind_last_changes(ancestor, ancestor + num_of_executed_chain_blocks);
-        re_execute_canonical_chain(ancestor, current_canonical_block);
+    } else if (switched) {
+        unwind_last_changes(ancestor, block_number);
+        restore_canonical_chain(ancestor, current_canonical_block);
     }
 
     return ValidationResult::kOk;
 }
 
-ValidationResult Blockchain::execute_block(const Block& block, bool check_state_root) {
-    ExecutionProcessor processor{block, *engine_, state_, config_};
+ValidationResult Blockchain::execute_block(Block& block, State& state) {
+    ExecutionProcessor processor{block, *engine_, state, config_};
     processor.evm().state_pool = state_pool;
     processor.evm().exo_evm = exo_evm;
 
-    if (const auto res{processor.execute_and_write_block(receipts_)}; res != ValidationResult::kOk) {
-        return res;
-    }
-
-    if (check_state_root) {
-        evmc::bytes32 state_root{state_.state_root_hash()};
-        if (state_root != block.header.state_root) {
-            state_.unwind_state_changes(block.header.number);
-            return ValidationResult::kWrongStateRoot;
-        }
-    }
-
-    return ValidationResult::kOk;
+    // Senders of later transactions are recovered while earlier ones execute
+    sender_recovery_.start(block.transactions);
+    const auto finish_recovery{gsl::finally([this] { sender_recovery_.finish(); })};  // however execution ends
+    processor.sender_recovery = &sender_recovery_;
+    return processor.execute_and_write_block(receipts_);
 }
 
 void Blockchain::prime_state_with_genesis(const Block& genesis_block) {
@@ -118,23 +127,25 @@ void Blockchain::prime_state_with_genesis(const Block& genesis_block) {
     state_.canonize_block(genesis_block.header.number, hash);
 }
 
-void Blockchain::re_execute_canonical_chain(uint64_t ancestor, uint64_t tip) {
+const StateOverlay& Blockchain::overlay(const evmc::bytes32& block_hash) const {
+    auto it{overlays_.find(block_hash)};
+    // Every block inserted after genesis has been executed into an overlay
+    assert(it != overlays_.end());
+    return *it->second;
+}
+
+void Blockchain::apply_chain(const std::vector<BlockWithHash>& chain) {
+    for (const BlockWithHash& x : chain) {
+        overlay(x.hash).write_to(state_);
+    }
+}
+
+void Blockchain::restore_canonical_chain(uint64_t ancestor, uint64_t tip) {
     assert(ancestor <= tip);
     for (uint64_t block_number{ancestor + 1}; block_number <= tip; ++block_number) {
         std::optional<evmc::bytes32> hash{state_.canonical_hash(block_number)};
         assert(hash != std::nullopt);
-        std::optional<BlockBody> body{state_.read_body(block_number, *hash)};
-        assert(body != std::nullopt);
-        std::optional<BlockHeader> header{state_.read_header(block_number, *hash)};
-        assert(header != std::nullopt);
-
-        Block block;
-        block.header = header.value();
-        block.transactions = body->transactions;
-        block.ommers = body->ommers;
-
-        [[maybe_unused]] ValidationResult err{execute_block(block, /*check_state_root=*/false)};
-        assert(err == ValidationResult::kOk);
+        overlay(*hash).write_to(state_);
     }
 }
 
@@ -17,12 +17,15 @@
 #ifndef SILKWORM_CONSENSUS_BLOCKCHAIN_HPP_
 #define SILKWORM_CONSENSUS_BLOCKCHAIN_HPP_
 
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
 #include <silkworm/consensus/engine.hpp>
+#include <silkworm/execution/sender_recovery.hpp>
 #include <silkworm/execution/state_pool.hpp>
 #include <silkworm/state/state.hpp>
+#include <silkworm/state/state_overlay.hpp>
 #include <silkworm/types/receipt.hpp>
 
 namespace silkworm::consensus {
@@ -30,6 +33,12 @@ namespace silkworm::consensus {
 /// Reference implementation of Ethereum blockchain logic.
 /// Used for running consensus tests; the real node will use staged sync instead
 /// (https://github.com/ledgerwatch/erigon/blob/devel/eth/stagedsync/README.md)
+///
+/// Every block is executed into a StateOverlay on top of the state of its parent, which for side chains is a view of
+/// the common ancestor with the side chain layered over it, so the canonical state is only touched by reorgs and
+/// state root checks. Either way switching branches replays recorded changes instead of re-executing blocks.
+///
+/// Senders are recovered in the background while the block executes (see SenderRecovery).
 class Blockchain {
   public:
     /// Creates a new instance of Blockchain.
@@ -54,11 +63,16 @@ class Blockchain {
     evmc_vm* exo_evm{nullptr};
 
   private:
-    ValidationResult execute_block(const Block& block, bool check_state_root);
+    ValidationResult execute_block(Block& block, State& state);
 
     void prime_state_with_genesis(const Block& genesis_block);
 
-    void re_execute_canonical_chain(uint64_t ancestor, uint64_t tip);
+    [[nodiscard]] const StateOverlay& overlay(const evmc::bytes32& block_hash) const;
+
+    // Writes the recorded changes of the chain's blocks on top of the state
+    void apply_chain(const std::vector<BlockWithHash>& chain);
+
+    void restore_canonical_chain(uint64_t ancestor, uint64_t tip);
 
     void unwind_last_changes(uint64_t ancestor, uint64_t tip);
 
@@ -72,6 +86,10 @@ class Blockchain {
     std::unique_ptr<IConsensusEngine> engine_;
     std::unordered_map<evmc::bytes32, ValidationResult> bad_blocks_;
     std::vector<Receipt> receipts_;
+    SenderRecovery sender_recovery_;
+
+    // block hash -> state changes of the block; like change sets they are kept for every inserted block
+    std::unordered_map<evmc::bytes32, std::unique_ptr<StateOverlay>> overlays_;
 };
 
 }  // namespace silkworm::consensus
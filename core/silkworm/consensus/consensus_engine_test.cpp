@@ -57,6 +57,7 @@ TEST_CASE("Consensus Engine Seal") {
         consensus::engine_factory(kMainnetConfig)};  // Ethash consensus engine
     BlockHeader fake_header{};
     CHECK(consensus_engine->validate_seal(fake_header) != ValidationResult::kOk);
+    CHECK(consensus_engine->validate_seal(test::sample_mainnet_header()) == ValidationResult::kOk);
     consensus_engine = consensus::engine_factory(test::kLondonConfig);  // Noproof consensus engine
     CHECK(consensus_engine->validate_seal(fake_header) == ValidationResult::kOk);
 }
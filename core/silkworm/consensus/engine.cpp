@@ -20,6 +20,7 @@
 #include <silkworm/consensus/ethash/engine.hpp>
 #include <silkworm/consensus/noproof/engine.hpp>
 #include <silkworm/crypto/ecdsa.hpp>
+#include <silkworm/trie/vector_root.hpp>
 
 namespace silkworm::consensus {
 
@@ -71,6 +72,26 @@ ValidationResult pre_validate_transaction(const Transaction& txn, uint64_t block
     return ValidationResult::kOk;
 }
 
+ValidationResult validate_body_roots(const BlockHeader& header, const BlockBody& body) {
+    Bytes ommers_rlp;
+    rlp::encode(ommers_rlp, body.ommers);
+    ethash::hash256 ommers_hash{keccak256(ommers_rlp)};
+    if (full_view(ommers_hash.bytes) != full_view(header.ommers_hash)) {
+        return ValidationResult::kWrongOmmersHash;
+    }
+
+    static constexpr auto kEncoder = [](Bytes& to, const Transaction& txn) {
+        rlp::encode(to, txn, /*for_signing=*/false, /*wrap_eip2718_into_array=*/false);
+    };
+
+    evmc::bytes32 txn_root{trie::root_hash(body.transactions, kEncoder)};
+    if (txn_root != header.transactions_root) {
+        return ValidationResult::kWrongTransactionsRoot;
+    }
+
+    return ValidationResult::kOk;
+}
+
 std::unique_ptr<IConsensusEngine> engine_factory(const ChainConfig& chain_config) {
     switch (chain_config.seal_engine) {
         case SealEngineType::kEthash:
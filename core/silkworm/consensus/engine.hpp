@@ -71,6 +71,11 @@ class IConsensusEngine {
 ValidationResult pre_validate_transaction(const Transaction& txn, uint64_t block_number, const ChainConfig& config,
                                           const std::optional<intx::uint256>& base_fee_per_gas);
 
+//! \brief Checks that ommers and transactions of a body are the ones committed to by the header.
+//! \return Any of kWrongOmmersHash, kWrongTransactionsRoot, or kOk.
+//! \remarks Needs neither state nor senders, so bodies can be checked as soon as they are downloaded
+ValidationResult validate_body_roots(const BlockHeader& header, const BlockBody& body);
+
 //! \brief Creates an instance of proper Consensus Engine on behalf of chain configuration
 std::unique_ptr<IConsensusEngine> engine_factory(const ChainConfig& chain_config);
 
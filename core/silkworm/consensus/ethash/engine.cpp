@@ -19,7 +19,6 @@
 #include <ethash/ethash.hpp>
 
 #include <silkworm/chain/protocol_param.hpp>
-#include <silkworm/common/endian.hpp>
 
 namespace silkworm::consensus {
 
@@ -44,19 +43,20 @@ void ConsensusEngineEthash::finalize(IntraBlockState& state, const Block& block,
     state.add_to_balance(block.header.beneficiary, miner_reward);
 }
 
+std::shared_ptr<const EpochContext> ConsensusEngineEthash::epoch_context(int epoch_number) {
+#if !defined(__wasm__)
+    std::lock_guard lock{epoch_cache_mtx_};
+#endif
+    return epoch_cache_.get(epoch_number);
+}
+
 ValidationResult ConsensusEngineEthash::validate_seal(const BlockHeader& header) {
     // Ethash ProofOfWork verification
-    auto epoch_number{header.number / ethash::epoch_length};
-    auto epoch_context{ethash::create_epoch_context(static_cast<int>(epoch_number))};
-
-    auto boundary256{header.boundary()};
-    auto seal_hash(header.hash(/*for_sealing =*/true));
-    ethash::hash256 sealh256{*reinterpret_cast<ethash::hash256*>(seal_hash.bytes)};
-    ethash::hash256 mixh256{};
-    std::memcpy(mixh256.bytes, header.mix_hash.bytes, 32);
-
-    uint64_t nonce{endian::load_big_u64(header.nonce.data())};
-    return ethash::verify(*epoch_context, sealh256, mixh256, nonce, boundary256) ? ValidationResult::kOk
-                                                                                 : ValidationResult::kInvalidSeal;
+    const auto epoch_number{static_cast<int>(header.number / ethash::epoch_length)};
+    const std::shared_ptr<const EpochContext> context{epoch_context(epoch_number)};
+    if (!context) {
+        return ValidationResult::kInvalidSeal;  // Can't be verified
+    }
+    return context->verify(header) ? ValidationResult::kOk : ValidationResult::kInvalidSeal;
 }
 }  // namespace silkworm::consensus
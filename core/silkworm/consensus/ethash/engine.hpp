@@ -18,17 +18,24 @@
 #ifndef SILKWORM_CONSENSUS_ETHASH_ENGINE_HPP_
 #define SILKWORM_CONSENSUS_ETHASH_ENGINE_HPP_
 
+#if !defined(__wasm__)
+#include <mutex>
+#endif
+
 #include <silkworm/consensus/base/engine.hpp>
+#include <silkworm/consensus/ethash/epoch_context.hpp>
 
 namespace silkworm::consensus {
 // Proof of Work implementation
+// validate_seal may be called concurrently: epoch contexts are shared through a locked cache, while seals are verified
+// outside the lock
 class ConsensusEngineEthash : public ConsensusEngineBase {
     using base = ConsensusEngineBase;
 
   public:
     explicit ConsensusEngineEthash(const ChainConfig& chain_config) : base(chain_config){};
 
-    //! \brief Validates the seal of the header
+    //! \brief Validates the seal of the header; thread-safe
     ValidationResult validate_seal(const BlockHeader& header) override;
 
     //! \brief See [YP] Section 11.3 "Reward Application".
@@ -37,6 +44,13 @@ class ConsensusEngineEthash : public ConsensusEngineBase {
     //! \param [in] revision: EVM fork.
     void finalize(IntraBlockState& state, const Block& block, const evmc_revision& revision) override;
 
+  private:
+    std::shared_ptr<const EpochContext> epoch_context(int epoch_number);
+
+#if !defined(__wasm__)
+    std::mutex epoch_cache_mtx_;
+#endif
+    EpochContextCache epoch_cache_{};
 };
 
 }  // namespace silkworm::consensus
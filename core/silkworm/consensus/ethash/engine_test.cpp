@@ -0,0 +1,55 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "engine.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/chain/config.hpp>
+#include <silkworm/common/test_util.hpp>
+
+namespace silkworm::consensus {
+
+TEST_CASE("Ethash seals validated concurrently") {
+    ConsensusEngineEthash engine{kMainnetConfig};
+
+    const BlockHeader header{test::sample_mainnet_header()};
+    BlockHeader tampered{header};
+    ++tampered.nonce[7];
+
+    // Threads share the engine, hence its epoch context cache
+    std::atomic<size_t> valid{0}, invalid{0};
+    std::vector<std::thread> threads;
+    for (size_t i{0}; i < 4; ++i) {
+        threads.emplace_back([&] {
+            for (size_t j{0}; j < 10; ++j) {
+                valid += engine.validate_seal(header) == ValidationResult::kOk;
+                invalid += engine.validate_seal(tampered) == ValidationResult::kInvalidSeal;
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    CHECK(valid == 40);
+    CHECK(invalid == 40);
+}
+
+}  // namespace silkworm::consensus
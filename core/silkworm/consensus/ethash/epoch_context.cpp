@@ -0,0 +1,90 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "epoch_context.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <silkworm/common/cast.hpp>
+#include <silkworm/common/endian.hpp>
+
+namespace silkworm::consensus {
+
+std::shared_ptr<const EpochContext> EpochContext::create(int epoch_number, bool full_dataset) {
+    ethash::epoch_context_ptr light{nullptr, ethash_destroy_epoch_context};
+    ethash::epoch_context_full_ptr full{nullptr, ethash_destroy_epoch_context_full};
+    if (full_dataset) {
+        // Dataset items are computed lazily, hence allocation is cheap while the first lookups are not
+        full = ethash::create_epoch_context_full(epoch_number);
+    }
+    if (!full) {
+        light = ethash::create_epoch_context(epoch_number);
+        if (!light) {
+            return nullptr;
+        }
+    }
+    return std::shared_ptr<const EpochContext>{new EpochContext{epoch_number, std::move(light), std::move(full)}};
+}
+
+ethash::result EpochContext::hash(const BlockHeader& header) const {
+    const auto seal_hash{bit_cast<ethash::hash256>(header.hash(/*for_sealing=*/true))};
+    const uint64_t nonce{endian::load_big_u64(header.nonce.data())};
+    return full_ ? ethash::hash(*full_, seal_hash, nonce) : ethash::hash(*light_, seal_hash, nonce);
+}
+
+bool EpochContext::verify(const BlockHeader& header) const {
+    const ethash::hash256 boundary{header.boundary()};
+    if (full_) {
+        const ethash::result res{hash(header)};
+        return std::memcmp(res.mix_hash.bytes, header.mix_hash.bytes, kHashLength) == 0 &&
+               std::memcmp(res.final_hash.bytes, boundary.bytes, kHashLength) <= 0;
+    }
+
+    const auto seal_hash{bit_cast<ethash::hash256>(header.hash(/*for_sealing=*/true))};
+    const auto mix_hash{bit_cast<ethash::hash256>(header.mix_hash)};
+    const uint64_t nonce{endian::load_big_u64(header.nonce.data())};
+    return ethash::verify(*light_, seal_hash, mix_hash, nonce, boundary);
+}
+
+std::shared_ptr<const EpochContext> EpochContextCache::get(int epoch_number) {
+    for (auto it{lru_.begin()}; it != lru_.end(); ++it) {
+        if ((*it)->epoch_number() == epoch_number) {
+            lru_.splice(lru_.begin(), lru_, it);
+            return lru_.front();
+        }
+    }
+
+    const bool full_dataset{full_dataset_ && epoch_number > highest_epoch_};
+    std::shared_ptr<const EpochContext> context{EpochContext::create(epoch_number, full_dataset)};
+    if (!context) {
+        return nullptr;
+    }
+    ++misses_;
+    highest_epoch_ = std::max(highest_epoch_, epoch_number);
+
+    if (context->has_full_dataset()) {
+        // Retain a single dataset: the previous one is released as soon as no verification is using it
+        lru_.remove_if([](const std::shared_ptr<const EpochContext>& c) { return c->has_full_dataset(); });
+    }
+    lru_.push_front(context);
+    if (lru_.size() > capacity_) {
+        lru_.pop_back();
+    }
+    return context;
+}
+
+}  // namespace silkworm::consensus
@@ -0,0 +1,94 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+#ifndef SILKWORM_CONSENSUS_ETHASH_EPOCH_CONTEXT_HPP_
+#define SILKWORM_CONSENSUS_ETHASH_EPOCH_CONTEXT_HPP_
+
+#include <list>
+#include <memory>
+
+#include <ethash/ethash.hpp>
+
+#include <silkworm/types/block.hpp>
+
+namespace silkworm::consensus {
+
+//! \brief Immutable Ethash context of an epoch: either the light cache only, or the full dataset (DAG).
+//! Verification against a light context computes every accessed dataset item on the fly;
+//! a full context computes each item at most once and serves it from memory afterwards.
+//! \remarks Both kinds can be shared across threads.
+class EpochContext {
+  public:
+    //! \brief Builds the context of the epoch. Building a full context falls back to a light one when the dataset
+    //! can't be allocated.
+    //! \return nullptr if the context can't be allocated at all
+    static std::shared_ptr<const EpochContext> create(int epoch_number, bool full_dataset = false);
+
+    EpochContext(const EpochContext&) = delete;
+    EpochContext& operator=(const EpochContext&) = delete;
+
+    [[nodiscard]] int epoch_number() const noexcept { return epoch_number_; }
+    [[nodiscard]] bool has_full_dataset() const noexcept { return full_ != nullptr; }
+
+    //! \brief Verifies mix_hash and nonce of a header belonging to this epoch
+    [[nodiscard]] bool verify(const BlockHeader& header) const;
+
+    //! \brief Computes the Ethash of a header (e.g. for diagnostics of an invalid seal)
+    [[nodiscard]] ethash::result hash(const BlockHeader& header) const;
+
+  private:
+    EpochContext(int epoch_number, ethash::epoch_context_ptr light, ethash::epoch_context_full_ptr full)
+        : epoch_number_{epoch_number}, light_{std::move(light)}, full_{std::move(full)} {}
+
+    int epoch_number_;
+    ethash::epoch_context_ptr light_;       // nullptr if full_ is set
+    ethash::epoch_context_full_ptr full_;  // nullptr if light_ is set
+};
+
+//! \brief Least recently used cache of epoch contexts, so that consecutive headers don't rebuild the
+//! (multi-megabyte) light cache of their epoch over and over.
+//! When full_dataset is set, the highest epoch requested so far (i.e. the current one when syncing) gets a full
+//! context, while older epochs keep using light ones. Only one full dataset is ever retained by the cache.
+//! \remarks Not thread-safe: concurrent users must serialize calls to get() (contexts returned are thread-safe).
+class EpochContextCache {
+  public:
+    static constexpr size_t kDefaultCapacity{3};
+
+    explicit EpochContextCache(size_t capacity = kDefaultCapacity, bool full_dataset = false)
+        : capacity_{capacity > 0 ? capacity : 1}, full_dataset_{full_dataset} {}
+
+    //! \brief Returns the context of the epoch, building it if not cached
+    //! \return nullptr if the context can't be allocated
+    std::shared_ptr<const EpochContext> get(int epoch_number);
+
+    [[nodiscard]] size_t size() const noexcept { return lru_.size(); }
+    [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+
+    //! \brief Number of contexts built so far
+    [[nodiscard]] size_t misses() const noexcept { return misses_; }
+
+  private:
+    size_t capacity_;
+    bool full_dataset_;
+    int highest_epoch_{-1};
+    size_t misses_{0};
+    std::list<std::shared_ptr<const EpochContext>> lru_{};  // Most recently used first
+};
+
+}  // namespace silkworm::consensus
+
+#endif  // SILKWORM_CONSENSUS_ETHASH_EPOCH_CONTEXT_HPP_
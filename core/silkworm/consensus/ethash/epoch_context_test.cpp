@@ -0,0 +1,70 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "epoch_context.hpp"
+
+#include <cstring>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/test_util.hpp>
+
+namespace silkworm::consensus {
+
+TEST_CASE("Epoch context") {
+    const BlockHeader header{test::sample_mainnet_header()};
+    REQUIRE(header.hash() == 0x88e96d4537bea4d9c05d12549907b32561d3bf31f45aae734cdc119f13406cb6_bytes32);
+
+    for (const bool full_dataset : {false, true}) {
+        const auto context{EpochContext::create(0, full_dataset)};
+        REQUIRE(context);
+        CHECK(context->epoch_number() == 0);
+        CHECK(context->verify(header));
+        CHECK(std::memcmp(context->hash(header).mix_hash.bytes, header.mix_hash.bytes, kHashLength) == 0);
+
+        BlockHeader tampered{header};
+        ++tampered.nonce[7];
+        CHECK(!context->verify(tampered));
+        tampered = header;
+        tampered.mix_hash.bytes[0] ^= 0x01;
+        CHECK(!context->verify(tampered));
+    }
+}
+
+TEST_CASE("Epoch context cache") {
+    EpochContextCache cache{/*capacity=*/2};
+
+    const auto context0{cache.get(0)};
+    REQUIRE(context0);
+    CHECK(!context0->has_full_dataset());
+    CHECK(cache.get(0) == context0);
+    CHECK(cache.misses() == 1);
+
+    const auto context1{cache.get(1)};
+    REQUIRE(context1);
+    CHECK(context1->epoch_number() == 1);
+    CHECK(cache.size() == 2);
+
+    CHECK(cache.get(0) == context0);  // Now the most recently used one
+    CHECK(cache.get(2));              // Evicts epoch 1
+    CHECK(cache.size() == 2);
+    CHECK(cache.misses() == 3);
+    CHECK(cache.get(0) == context0);
+    CHECK(cache.get(1) != context1);
+    CHECK(cache.misses() == 4);
+}
+
+}  // namespace silkworm::consensus
@@ -0,0 +1,102 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "baseline_analysis_cache.hpp"
+
+#include <algorithm>
+
+#if !defined(__wasm__)
+#include <mutex>
+#endif
+
+#include <evmone/baseline.hpp>
+
+#include <silkworm/common/lru_cache.hpp>
+
+namespace silkworm {
+
+#if defined(__wasm__)
+// No threads in Wasm
+struct NullMutex {
+    void lock() noexcept {}
+    void unlock() noexcept {}
+};
+using CacheMutex = NullMutex;
+#else
+using CacheMutex = std::mutex;
+#endif
+
+struct BaselineAnalysisCache::Shard {
+    explicit Shard(size_t max_size) : cache{max_size} {}
+
+    CacheMutex mtx;
+    lru_cache<evmc::bytes32, std::shared_ptr<Entry>> cache;
+};
+
+BaselineAnalysisCache::Entry::Entry(ByteView code)
+    : analysis_{new evmone::baseline::CodeAnalysis(evmone::baseline::analyze(code.data(), code.size()))} {}
+
+BaselineAnalysisCache::Entry::~Entry() = default;
+
+BaselineAnalysisCache::BaselineAnalysisCache(size_t maxSize) {
+    const size_t shard_size{std::max<size_t>(maxSize / kNumShards, 1)};
+    shards_.reserve(kNumShards);
+    for (size_t i{0}; i < kNumShards; ++i) {
+        shards_.push_back(std::make_unique<Shard>(shard_size));
+    }
+}
+
+BaselineAnalysisCache::~BaselineAnalysisCache() = default;
+
+BaselineAnalysisCache& BaselineAnalysisCache::instance() {
+    static BaselineAnalysisCache cache;
+    return cache;
+}
+
+std::shared_ptr<BaselineAnalysisCache::Entry> BaselineAnalysisCache::get(const evmc::bytes32& code_hash,
+                                                                         ByteView code) {
+    // Hashes are uniformly distributed, so any byte will do
+    Shard& shard{*shards_[code_hash.bytes[kHashLength - 1] % kNumShards]};
+    {
+        std::lock_guard lock{shard.mtx};
+        if (const auto* entry{shard.cache.get(code_hash)}; entry) {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return *entry;
+        }
+    }
+
+    // Analyse outside the lock; should another thread have been quicker, its entry is kept so that no executions go
+    // uncounted
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    auto entry{std::make_shared<Entry>(code)};
+    std::lock_guard lock{shard.mtx};
+    if (const auto* existing{shard.cache.get(code_hash)}; existing) {
+        return *existing;
+    }
+    shard.cache.put(code_hash, entry);
+    return entry;
+}
+
+size_t BaselineAnalysisCache::size() const noexcept {
+    size_t n{0};
+    for (const auto& shard : shards_) {
+        std::lock_guard lock{shard->mtx};
+        n += shard->cache.size();
+    }
+    return n;
+}
+
+}  // namespace silkworm
@@ -0,0 +1,91 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_EXECUTION_BASELINE_ANALYSIS_CACHE_HPP_
+#define SILKWORM_EXECUTION_BASELINE_ANALYSIS_CACHE_HPP_
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <silkworm/common/base.hpp>
+
+namespace evmone::baseline {
+struct CodeAnalysis;
+}
+
+namespace silkworm {
+
+/** @brief Thread-safe cache of evmone baseline analyses (i.e. jumpdest maps & padded code), keyed by code hash.
+ *
+ * Unlike advanced analyses, baseline ones don't depend on the EVM revision.
+ * Any hash of the exact code bytes can serve as a key, e.g. the init code hash computed by CREATE2.
+ * Entries are spread over independently locked LRU shards, so that parallel executors can share an instance.
+ */
+class BaselineAnalysisCache {
+  public:
+    static constexpr size_t kDefaultMaxSize{5'000};
+
+    /** @brief Baseline analysis of a piece of code along with the number of times it has been executed. */
+    class Entry {
+      public:
+        explicit Entry(ByteView code);
+        ~Entry();
+
+        Entry(const Entry&) = delete;
+        Entry& operator=(const Entry&) = delete;
+
+        [[nodiscard]] const evmone::baseline::CodeAnalysis& analysis() const noexcept { return *analysis_; }
+
+        /** @brief Records one more execution; returns the number of executions so far, this one included. */
+        uint32_t count_execution() noexcept { return executions_.fetch_add(1, std::memory_order_relaxed) + 1; }
+
+        [[nodiscard]] uint32_t executions() const noexcept { return executions_.load(std::memory_order_relaxed); }
+
+      private:
+        std::unique_ptr<const evmone::baseline::CodeAnalysis> analysis_;
+        std::atomic<uint32_t> executions_{0};
+    };
+
+    explicit BaselineAnalysisCache(size_t maxSize = kDefaultMaxSize);
+    ~BaselineAnalysisCache();
+
+    BaselineAnalysisCache(const BaselineAnalysisCache&) = delete;
+    BaselineAnalysisCache& operator=(const BaselineAnalysisCache&) = delete;
+
+    /** @brief Process wide instance, used by default by every EVM. */
+    static BaselineAnalysisCache& instance();
+
+    /** @brief Gets the entry of the code with the given hash, analysing the code first if it's not in the cache. */
+    std::shared_ptr<Entry> get(const evmc::bytes32& code_hash, ByteView code);
+
+    [[nodiscard]] size_t size() const noexcept;
+    [[nodiscard]] uint64_t hits() const noexcept { return hits_.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t misses() const noexcept { return misses_.load(std::memory_order_relaxed); }
+
+  private:
+    static constexpr size_t kNumShards{16};
+
+    struct Shard;
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+};
+
+}  // namespace silkworm
+
+#endif  // SILKWORM_EXECUTION_BASELINE_ANALYSIS_CACHE_HPP_
@@ -0,0 +1,77 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "baseline_analysis_cache.hpp"
+
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/util.hpp>
+
+namespace silkworm {
+
+TEST_CASE("Baseline analysis cache") {
+    const Bytes code{*from_hex("602a60005260206000f3")};
+
+    SECTION("Entries are shared") {
+        BaselineAnalysisCache cache;
+        const evmc::bytes32 code_hash{to_bytes32(*from_hex("01"))};
+        const auto entry{cache.get(code_hash, code)};
+        CHECK(cache.misses() == 1);
+        CHECK(cache.get(code_hash, code) == entry);
+        CHECK(cache.hits() == 1);
+        CHECK(cache.size() == 1);
+
+        CHECK(entry->count_execution() == 1);
+        CHECK(entry->count_execution() == 2);
+        CHECK(entry->executions() == 2);
+    }
+
+    SECTION("Bounded size") {
+        BaselineAnalysisCache cache{/*maxSize=*/32};
+        for (uint8_t i{0}; i < 200; ++i) {
+            cache.get(to_bytes32(Bytes{i, i}), code);
+        }
+        CHECK(cache.misses() == 200);
+        CHECK(cache.size() <= 32);
+    }
+
+    SECTION("Concurrent executors") {
+        BaselineAnalysisCache cache;
+        std::vector<std::thread> threads;
+        for (size_t t{0}; t < 4; ++t) {
+            threads.emplace_back([&cache, &code]() {
+                for (uint8_t i{0}; i < 250; ++i) {
+                    cache.get(to_bytes32(Bytes{static_cast<uint8_t>(i % 8)}), code)->count_execution();
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        CHECK(cache.size() == 8);
+        CHECK(cache.hits() + cache.misses() == 1'000);
+        uint64_t executions{0};
+        for (uint8_t i{0}; i < 8; ++i) {
+            executions += cache.get(to_bytes32(Bytes{i}), code)->executions();
+        }
+        CHECK(executions == 1'000);
+    }
+}
+
+}  // namespace silkworm
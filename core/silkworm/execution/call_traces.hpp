@@ -0,0 +1,40 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_EXECUTION_CALL_TRACES_HPP_
+#define SILKWORM_EXECUTION_CALL_TRACES_HPP_
+
+#include <evmc/evmc.hpp>
+
+#include <silkworm/common/hash_maps.hpp>
+
+namespace silkworm {
+
+// Addresses sending & receiving calls (including transactions, creations and self-destructs) within a block,
+// as in Erigon CallTracer
+struct CallTraces {
+    FlatHashSet<evmc::address> senders;
+    FlatHashSet<evmc::address> recipients;
+
+    void clear() noexcept {
+        senders.clear();
+        recipients.clear();
+    }
+};
+
+}  // namespace silkworm
+
+#endif  // SILKWORM_EXECUTION_CALL_TRACES_HPP_
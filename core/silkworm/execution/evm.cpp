@@ -19,22 +19,81 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
-#include <iterator>
+#include <utility>
 
 #include <ethash/keccak.hpp>
 #include <evmone/analysis.hpp>
 #include <evmone/baseline.hpp>
 #include <evmone/evmone.h>
 #include <evmone/execution.hpp>
+#include <evmone/tracing.hpp>
 #include <evmone/vm.hpp>
 
 #include <silkworm/chain/protocol_param.hpp>
+#include <silkworm/common/trace_span.hpp>
 
 #include "address.hpp"
 #include "precompiled.hpp"
 
 namespace silkworm {
 
+namespace {
+
+    // Forwards instructions executed by evmone baseline to the profiler of the EVM, if any
+    class ProfilingTracer : public evmone::Tracer {
+      public:
+        explicit ProfilingTracer(const EVM& evm) noexcept : evm_{evm} {}
+
+      private:
+        void on_execution_start(evmc_revision, const evmc_message&, evmone::bytes_view) noexcept override {
+            if (evm_.profiler) {
+                evm_.profiler->on_execution_start();
+            }
+        }
+
+        void on_instruction_start(uint32_t pc, const evmone::ExecutionState& state) noexcept override {
+            if (evm_.profiler) {
+                evm_.profiler->on_instruction(state.code[pc]);
+            }
+        }
+
+        void on_execution_end(const evmc_result&) noexcept override {
+            if (evm_.profiler) {
+                evm_.profiler->on_execution_end();
+            }
+        }
+
+        const EVM& evm_;
+    };
+
+    // Times a state read of the host when profiling
+    class ScopedReadTimer {
+      public:
+        ScopedReadTimer(EvmProfiler* profiler, EvmProfiler::StateRead kind) noexcept
+            : profiler_{profiler}, kind_{kind} {
+            if (profiler_) {
+                start_ = EvmProfiler::Clock::now();
+            }
+        }
+
+        ~ScopedReadTimer() {
+            if (profiler_) {
+                profiler_->on_state_read(kind_, EvmProfiler::Clock::now() - start_);
+            }
+        }
+
+        // Not copyable nor movable
+        ScopedReadTimer(const ScopedReadTimer&) = delete;
+        ScopedReadTimer& operator=(const ScopedReadTimer&) = delete;
+
+      private:
+        EvmProfiler* profiler_;
+        EvmProfiler::StateRead kind_;
+        EvmProfiler::Clock::time_point start_;
+    };
+
+}  // namespace
+
 EVM::EVM(const Block& block, IntraBlockState& state, const ChainConfig& config) noexcept
     : beneficiary{block.header.beneficiary},
       block_{block},
@@ -84,11 +143,13 @@ evmc::result EVM::create(const evmc_message& message) noexcept {
     state_.set_nonce(message.sender, nonce + 1);
 
     evmc::address contract_addr{};
+    std::optional<evmc::bytes32> init_code_hash;  // only known for free with CREATE2
     if (message.kind == EVMC_CREATE) {
         contract_addr = create_address(message.sender, nonce);
     } else if (message.kind == EVMC_CREATE2) {
-        auto init_code_hash{ethash::keccak256(message.input_data, message.input_size)};
-        contract_addr = create2_address(message.sender, message.create2_salt, init_code_hash.bytes);
+        auto hash{ethash::keccak256(message.input_data, message.input_size)};
+        contract_addr = create2_address(message.sender, message.create2_salt, hash.bytes);
+        init_code_hash = to_bytes32(full_view(hash.bytes));
     }
 
     state_.access_account(contract_addr);
@@ -100,6 +161,8 @@ evmc::result EVM::create(const evmc_message& message) noexcept {
         return res;
     }
 
+    trace_call(message.sender, contract_addr);
+
     auto snapshot{state_.take_snapshot()};
 
     state_.create_contract(contract_addr);
@@ -124,7 +187,7 @@ evmc::result EVM::create(const evmc_message& message) noexcept {
         message.value,   // value
     };
 
-    res = execute(deploy_message, ByteView{message.input_data, message.input_size}, /*code_hash=*/std::nullopt);
+    res = execute(deploy_message, ByteView{message.input_data, message.input_size}, init_code_hash);
 
     if (res.status_code == EVMC_SUCCESS) {
         const size_t code_len{res.output_size};
@@ -157,6 +220,7 @@ evmc::result EVM::create(const evmc_message& message) noexcept {
 }
 
 evmc::result EVM::call(const evmc_message& message) noexcept {
+    SILKWORM_TRACE_SPAN("EVM::call");
     evmc::result res{EVMC_SUCCESS, message.gas, nullptr, 0};
 
     const auto value{intx::be::load<intx::uint256>(message.value)};
@@ -165,6 +229,15 @@ evmc::result EVM::call(const evmc_message& message) noexcept {
         return res;
     }
 
+    // Code run in the context of the caller is traced as a call from the caller to the account owning the code
+    if (message.kind == EVMC_DELEGATECALL) {
+        trace_call(message.recipient, message.code_address);
+    } else if (message.kind == EVMC_CALLCODE) {
+        trace_call(message.sender, message.code_address);
+    } else {
+        trace_call(message.sender, message.recipient);
+    }
+
     const bool precompiled{is_precompiled(message.code_address)};
     const evmc_revision rev{revision()};
 
@@ -194,9 +267,9 @@ evmc::result EVM::call(const evmc_message& message) noexcept {
         if (gas < 0 || gas > message.gas) {
             res.status_code = EVMC_OUT_OF_GAS;
         } else {
-            const std::optional<Bytes> output{contract.run(input)};
+            std::optional<Bytes> output{precompile_cache ? precompile_cache->run(num, input) : contract.run(input)};
             if (output) {
-                res = {EVMC_SUCCESS, message.gas - gas, output->data(), output->size()};
+                res = result_pool_.make_result(EVMC_SUCCESS, message.gas - gas, std::move(*output));
             } else {
                 res.status_code = EVMC_PRECOMPILE_FAILURE;
             }
@@ -224,78 +297,108 @@ evmc::result EVM::call(const evmc_message& message) noexcept {
 
 evmc::result EVM::execute(const evmc_message& msg, ByteView code, std::optional<evmc::bytes32> code_hash) noexcept {
     const evmc_revision rev{revision()};
+    const auto start{profiler ? EvmProfiler::Clock::now() : EvmProfiler::Clock::time_point{}};
+    AnalysisCache* advanced_cache{profiler ? nullptr : advanced_analysis_cache};
 
     evmc_result res;
     if (exo_evm) {
         EvmHost host{*this};
         res = exo_evm->execute(exo_evm, &host.get_interface(), host.to_context(), rev, &msg, code.data(), code.size());
-    } else if (code_hash != std::nullopt && advanced_analysis_cache != nullptr) {
-        res = execute_with_default_interpreter(rev, msg, code, *code_hash);
+    } else if (code_hash == std::nullopt) {
+        // Init code of CREATE & contract creation transactions: hashing it just for the caches would cost
+        // about as much as the baseline analysis itself
+        res = execute_with_baseline_interpreter(rev, msg, code, /*analysis=*/nullptr);
     } else {
-        // for one-off execution baseline interpreter is generally faster
-        res = execute_with_baseline_interpreter(rev, msg, code);
+        std::shared_ptr<evmone::AdvancedCodeAnalysis> advanced_analysis;
+        if (advanced_cache != nullptr) {
+            advanced_analysis = advanced_cache->get(*code_hash, rev);
+        }
+
+        std::shared_ptr<BaselineAnalysisCache::Entry> entry;
+        uint32_t executions{0};
+        if (!advanced_analysis && baseline_analysis_cache != nullptr) {
+            entry = baseline_analysis_cache->get(*code_hash, code);
+            executions = entry->count_execution();
+        }
+
+        // Baseline analysis is much cheaper, so contracts only switch to advanced once they are executed frequently
+        if (!advanced_analysis && advanced_cache != nullptr && (!entry || executions >= advanced_threshold)) {
+            advanced_analysis =
+                std::make_shared<evmone::AdvancedCodeAnalysis>(evmone::analyze(rev, code.data(), code.size()));
+            advanced_cache->put(*code_hash, advanced_analysis, rev);
+        }
+
+        if (advanced_analysis) {
+            res = execute_with_default_interpreter(rev, msg, code, *advanced_analysis);
+        } else {
+            res = execute_with_baseline_interpreter(rev, msg, code, entry ? &entry->analysis() : nullptr);
+        }
+    }
+
+    if (profiler) {
+        const evmc::address& contract{is_zero(msg.code_address) ? msg.recipient : msg.code_address};
+        profiler->on_contract_executed(contract, static_cast<uint64_t>(msg.gas - std::max(res.gas_left, int64_t{0})),
+                                       EvmProfiler::Clock::now() - start);
     }
 
     return evmc::result{res};
 }
 
-evmc_result EVM::execute_with_baseline_interpreter(evmc_revision rev, const evmc_message& msg, ByteView code) noexcept {
-    const auto vm{static_cast<evmone::VM*>(evm1_)};
-
-    const auto analysis{evmone::baseline::analyze(code.data(), code.size())};
+evmc_result EVM::execute_with_baseline_interpreter(evmc_revision rev, const evmc_message& msg, ByteView code,
+                                                   const evmone::baseline::CodeAnalysis* analysis) noexcept {
+    if (analysis == nullptr) {
+        const auto own_analysis{evmone::baseline::analyze(code.data(), code.size())};
+        return execute_with_baseline_interpreter(rev, msg, code, &own_analysis);
+    }
 
-    std::unique_ptr<evmone::AdvancedExecutionState> state;
-    if (state_pool) {
-        state = state_pool->acquire();
-    } else {
-        state = std::make_unique<evmone::AdvancedExecutionState>();
+    const auto vm{static_cast<evmone::VM*>(evm1_)};
+    if (profiler && !tracer_added_) {
+        // Tracers can't be removed, so this one stays idle once the profiler is reset
+        vm->add_tracer(std::make_unique<ProfilingTracer>(*this));
+        tracer_added_ = true;
     }
 
+    ExecutionStatePool& pool{state_pool ? *state_pool : own_state_pool_};
+    std::unique_ptr<evmone::AdvancedExecutionState> state{pool.acquire()};
+
     EvmHost host{*this};
 
     state->reset(msg, rev, host.get_interface(), host.to_context(), code.data(), code.size());
 
-    evmc_result res{evmone::baseline::execute(*vm, *state, analysis)};
+    evmc_result res{evmone::baseline::execute(*vm, *state, *analysis)};
 
-    if (state_pool) {
-        state_pool->release(std::move(state));
-    }
+    pool.release(std::move(state));
+    ++interpreter_counters_.baseline;
 
     return res;
 }
 
 evmc_result EVM::execute_with_default_interpreter(evmc_revision rev, const evmc_message& msg, ByteView code,
-                                                  const evmc::bytes32& code_hash) noexcept {
-    assert(advanced_analysis_cache != nullptr);
-
-    std::shared_ptr<evmone::AdvancedCodeAnalysis> analysis{advanced_analysis_cache->get(code_hash, rev)};
-    if (!analysis) {
-        analysis = std::make_shared<evmone::AdvancedCodeAnalysis>(evmone::analyze(rev, code.data(), code.size()));
-        advanced_analysis_cache->put(code_hash, analysis, rev);
-    }
-
-    std::unique_ptr<evmone::AdvancedExecutionState> state;
-    if (state_pool) {
-        state = state_pool->acquire();
-    } else {
-        state = std::make_unique<evmone::AdvancedExecutionState>();
-    }
+                                                  const evmone::AdvancedCodeAnalysis& analysis) noexcept {
+    ExecutionStatePool& pool{state_pool ? *state_pool : own_state_pool_};
+    std::unique_ptr<evmone::AdvancedExecutionState> state{pool.acquire()};
 
     EvmHost host{*this};
 
     state->reset(msg, rev, host.get_interface(), host.to_context(), code.data(), code.size());
 
-    evmc_result res{evmone::execute(*state, *analysis)};
+    evmc_result res{evmone::execute(*state, analysis)};
 
-    if (state_pool) {
-        state_pool->release(std::move(state));
-    }
+    pool.release(std::move(state));
+    ++interpreter_counters_.advanced;
 
     return res;
 }
 
 evmc_revision EVM::revision() const noexcept { return config().revision(block_.header.number); }
 
+void EVM::trace_call(const evmc::address& sender, const evmc::address& recipient) noexcept {
+    if (call_traces) {
+        call_traces->senders.insert(sender);
+        call_traces->recipients.insert(recipient);
+    }
+}
+
 uint8_t EVM::number_of_precompiles() const noexcept {
     const evmc_revision rev{revision()};
 
@@ -318,6 +421,7 @@ bool EVM::is_precompiled(const evmc::address& contract) const noexcept {
 }
 
 bool EvmHost::account_exists(const evmc::address& address) const noexcept {
+    ScopedReadTimer timer{evm_.profiler, EvmProfiler::StateRead::kAccount};
     const evmc_revision rev{evm_.revision()};
 
     if (rev >= EVMC_SPURIOUS_DRAGON) {
@@ -335,10 +439,15 @@ evmc_access_status EvmHost::access_account(const evmc::address& address) noexcep
 }
 
 evmc_access_status EvmHost::access_storage(const evmc::address& address, const evmc::bytes32& key) noexcept {
-    return evm_.state().access_storage(address, key);
+    const evmc_access_status status{evm_.state().access_storage(address, key)};
+    if (evm_.profiler) {
+        evm_.profiler->on_storage_access(status);
+    }
+    return status;
 }
 
 evmc::bytes32 EvmHost::get_storage(const evmc::address& address, const evmc::bytes32& key) const noexcept {
+    ScopedReadTimer timer{evm_.profiler, EvmProfiler::StateRead::kStorage};
     return evm_.state().get_current_storage(address, key);
 }
 
@@ -419,15 +528,18 @@ evmc_storage_status EvmHost::set_storage(const evmc::address& address, const evm
 }
 
 evmc::uint256be EvmHost::get_balance(const evmc::address& address) const noexcept {
+    ScopedReadTimer timer{evm_.profiler, EvmProfiler::StateRead::kAccount};
     intx::uint256 balance{evm_.state().get_balance(address)};
     return intx::be::store<evmc::uint256be>(balance);
 }
 
 size_t EvmHost::get_code_size(const evmc::address& address) const noexcept {
+    ScopedReadTimer timer{evm_.profiler, EvmProfiler::StateRead::kAccount};
     return evm_.state().get_code(address).size();
 }
 
 evmc::bytes32 EvmHost::get_code_hash(const evmc::address& address) const noexcept {
+    ScopedReadTimer timer{evm_.profiler, EvmProfiler::StateRead::kAccount};
     if (evm_.state().is_dead(address)) {
         return {};
     } else {
@@ -437,6 +549,7 @@ evmc::bytes32 EvmHost::get_code_hash(const evmc::address& address) const noexcep
 
 size_t EvmHost::copy_code(const evmc::address& address, size_t code_offset, uint8_t* buffer_data,
                           size_t buffer_size) const noexcept {
+    ScopedReadTimer timer{evm_.profiler, EvmProfiler::StateRead::kCode};
     ByteView code{evm_.state().get_code(address)};
 
     if (code_offset >= code.size()) {
@@ -449,6 +562,7 @@ size_t EvmHost::copy_code(const evmc::address& address, size_t code_offset, uint
 }
 
 void EvmHost::selfdestruct(const evmc::address& address, const evmc::address& beneficiary) noexcept {
+    evm_.trace_call(address, beneficiary);
     evm_.state().record_suicide(address);
     evm_.state().add_to_balance(beneficiary, evm_.state().get_balance(address));
     evm_.state().set_balance(address, 0);
@@ -499,6 +613,7 @@ evmc::bytes32 EvmHost::get_block_hash(int64_t n) const noexcept {
 
     std::vector<evmc::bytes32>& hashes{evm_.block_hashes_};
     if (hashes.empty()) {
+        hashes.reserve(256);  // BLOCKHASH reaches back 256 blocks at most
         hashes.push_back(evm_.block_.header.parent_hash);
     }
 
@@ -521,9 +636,9 @@ evmc::bytes32 EvmHost::get_block_hash(int64_t n) const noexcept {
 void EvmHost::emit_log(const evmc::address& address, const uint8_t* data, size_t data_size,
                        const evmc::bytes32 topics[], size_t num_topics) noexcept {
     Log log{address};
-    std::copy_n(topics, num_topics, std::back_inserter(log.topics));
-    std::copy_n(data, data_size, std::back_inserter(log.data));
-    evm_.state().add_log(log);
+    log.topics.assign(topics, topics + num_topics);
+    log.data.assign(data, data_size);
+    evm_.state().add_log(std::move(log));
 }
 
 }  // namespace silkworm
@@ -25,6 +25,11 @@
 #include <silkworm/chain/config.hpp>
 #include <silkworm/common/util.hpp>
 #include <silkworm/execution/analysis_cache.hpp>
+#include <silkworm/execution/baseline_analysis_cache.hpp>
+#include <silkworm/execution/call_traces.hpp>
+#include <silkworm/execution/precompile_cache.hpp>
+#include <silkworm/execution/profiler.hpp>
+#include <silkworm/execution/result_pool.hpp>
 #include <silkworm/execution/state_pool.hpp>
 #include <silkworm/state/intra_block_state.hpp>
 #include <silkworm/types/block.hpp>
@@ -39,6 +44,14 @@ struct CallResult {
 
 class EVM {
   public:
+    static constexpr uint32_t kDefaultAdvancedThreshold{16};
+
+    // Number of code executions per interpreter
+    struct InterpreterCounters {
+        uint64_t baseline{0};
+        uint64_t advanced{0};
+    };
+
     // Not copyable nor movable
     EVM(const EVM&) = delete;
     EVM& operator=(const EVM&) = delete;
@@ -60,9 +73,29 @@ class EVM {
     evmc_revision revision() const noexcept;
 
     // Point to a cache instance in order to enable execution with evmone advanced rather than baseline interpreter
+    // for contracts executed at least advanced_threshold times; cheaper to analyse, baseline suits the others better
     AnalysisCache* advanced_analysis_cache{nullptr};
+    uint32_t advanced_threshold{kDefaultAdvancedThreshold};
+
+    // Baseline analyses shared across EVM instances, also keeping count of executions per contract.
+    // Set to nullptr in order to analyse on every execution instead.
+    BaselineAnalysisCache* baseline_analysis_cache{&BaselineAnalysisCache::instance()};
+
+    const InterpreterCounters& interpreter_counters() const noexcept { return interpreter_counters_; }
+
+    // Share a pool across EVM instances for better performance; otherwise each EVM recycles its own execution states
+    ExecutionStatePool* state_pool{nullptr};
 
-    ExecutionStatePool* state_pool{nullptr};  // use for better performance
+    PrecompileCache* precompile_cache{nullptr};  // reuses outputs of expensive precompiles for recurring inputs
+
+    // Point to a profiler in order to record opcode, contract & state access statistics; not to be changed while
+    // a transaction executes. Only the baseline interpreter traces instructions, so advanced is off meanwhile.
+    EvmProfiler* profiler{nullptr};
+
+    CallTraces* call_traces{nullptr};  // point to an instance in order to record call senders & recipients
+
+    // Buffers backing outputs of precompiles; recycled across calls & transactions
+    const ResultBufferPool& result_pool() const noexcept { return result_pool_; }
 
     evmc_vm* exo_evm{nullptr};  // it's possible to use an exogenous EVMC VM
 
@@ -77,11 +110,14 @@ class EVM {
 
     evmc::result execute(const evmc_message& message, ByteView code, std::optional<evmc::bytes32> code_hash) noexcept;
 
-    evmc_result execute_with_baseline_interpreter(evmc_revision rev, const evmc_message& message,
-                                                  ByteView code) noexcept;
+    // Analyses the code unless an analysis is provided
+    evmc_result execute_with_baseline_interpreter(evmc_revision rev, const evmc_message& message, ByteView code,
+                                                  const evmone::baseline::CodeAnalysis* analysis) noexcept;
 
     evmc_result execute_with_default_interpreter(evmc_revision rev, const evmc_message& message, ByteView code,
-                                                 const evmc::bytes32& code_hash) noexcept;
+                                                 const evmone::AdvancedCodeAnalysis& analysis) noexcept;
+
+    void trace_call(const evmc::address& sender, const evmc::address& recipient) noexcept;
 
     uint8_t number_of_precompiles() const noexcept;
     bool is_precompiled(const evmc::address& contract) const noexcept;
@@ -93,6 +129,11 @@ class EVM {
     std::vector<evmc::bytes32> block_hashes_{};
 
     evmc_vm* evm1_{nullptr};
+
+    ExecutionStatePool own_state_pool_;
+    ResultBufferPool result_pool_;
+    InterpreterCounters interpreter_counters_;
+    bool tracer_added_{false};
 };
 
 class EvmHost : public evmc::Host {
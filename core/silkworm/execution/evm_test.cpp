@@ -237,6 +237,64 @@ TEST_CASE("DELEGATECALL") {
     CHECK(to_hex(zeroless_view(state.get_current_storage(caller_address, key0))) == to_hex(full_view(caller_address)));
 }
 
+TEST_CASE("Call traces") {
+    Block block{};
+    block.header.number = 5'000'000;
+    evmc::address sender{0x8e4d1ea201b908ab5e1f5a1c3f9f1b4f6c1e9cf1_address};
+    evmc::address caller_address{0x3589d05a1ec4af9f65b0e5554e645707775ee43c_address};
+    evmc::address callee_address{0xb4200db1ec87f1c55aa0d6f8d1f6fac8f3dc2d9c_address};
+    evmc::address beneficiary{0x7c0c4aa4cd6b8d34dbd3c6c5bc4d4e41fd58b4e6_address};
+
+    InMemoryState db;
+    IntraBlockState state{db};
+
+    EVM evm{block, state, kMainnetConfig};
+    CallTraces traces;
+    evm.call_traces = &traces;
+
+    Transaction txn{};
+    txn.from = sender;
+    txn.to = caller_address;
+
+    uint64_t gas{1'000'000};
+
+    SECTION("CALL") {
+        // The caller calls the callee, which self-destructs
+        state.set_code(caller_address, *from_hex("60008080808073" + to_hex(callee_address) + "5af1"));
+        state.set_code(callee_address, *from_hex("73" + to_hex(beneficiary) + "ff"));
+
+        CallResult res{evm.execute(txn, gas)};
+        CHECK(res.status == EVMC_SUCCESS);
+
+        CHECK(traces.senders == FlatHashSet<evmc::address>{sender, caller_address, callee_address});
+        CHECK(traces.recipients == FlatHashSet<evmc::address>{caller_address, callee_address, beneficiary});
+    }
+
+    SECTION("DELEGATECALL") {
+        // The caller runs the code of the callee, on behalf of the sender
+        state.set_code(caller_address, *from_hex("600080808073" + to_hex(callee_address) + "5af4"));
+        state.set_code(callee_address, *from_hex("00"));
+
+        CallResult res{evm.execute(txn, gas)};
+        CHECK(res.status == EVMC_SUCCESS);
+
+        CHECK(traces.senders == FlatHashSet<evmc::address>{sender, caller_address});
+        CHECK(traces.recipients == FlatHashSet<evmc::address>{caller_address, callee_address});
+    }
+
+    SECTION("CALLCODE") {
+        // The caller runs the code of the callee, on its own behalf
+        state.set_code(caller_address, *from_hex("60008080808073" + to_hex(callee_address) + "5af2"));
+        state.set_code(callee_address, *from_hex("00"));
+
+        CallResult res{evm.execute(txn, gas)};
+        CHECK(res.status == EVMC_SUCCESS);
+
+        CHECK(traces.senders == FlatHashSet<evmc::address>{sender, caller_address});
+        CHECK(traces.recipients == FlatHashSet<evmc::address>{caller_address, callee_address});
+    }
+}
+
 // https://eips.ethereum.org/EIPS/eip-211#specification
 TEST_CASE("CREATE should only return on failure") {
     Block block{};
@@ -360,4 +418,153 @@ TEST_CASE("EIP-3541: Reject new contracts starting with the 0xEF byte") {
     CHECK(evm.execute(txn, gas).status == EVMC_SUCCESS);
 }
 
+TEST_CASE("Pooled execution states and precompile outputs") {
+    Block block{};
+    block.header.number = 10'336'006;
+    evmc::address caller{0x0a6bb546b9208cfab9e8fa2b9b2c042b18df7030_address};
+    evmc::address contract{0x62d1e4d6b3e9a84c2a8b2ed1bb4a5f82b7c5f6c4_address};
+
+    // 0      PUSH1  => 2a
+    // 2      PUSH1  => 00
+    // 4      MSTORE         // memory[0..32] = 0x2a
+    //        3 x (PUSH1 20, PUSH1 00, PUSH1 20, PUSH1 00, PUSH1 04, GAS, STATICCALL, POP)  // identity
+    //        PUSH1 20, PUSH1 00, LOG0
+    //        PUSH1 20, PUSH1 00, RETURN
+    Bytes code{*from_hex("602a600052")};
+    for (size_t i{0}; i < 3; ++i) {
+        code += *from_hex("602060006020600060045afa50");
+    }
+    code += *from_hex("60206000a060206000f3");
+
+    InMemoryState db;
+    IntraBlockState state{db};
+    state.set_code(contract, code);
+
+    EVM evm{block, state, kMainnetConfig};
+
+    ExecutionStatePool state_pool;
+    evm.state_pool = &state_pool;
+
+    Transaction txn{};
+    txn.from = caller;
+    txn.to = contract;
+
+    const Bytes expected_output{full_view(to_bytes32(*from_hex("2a")))};
+    for (size_t i{1}; i <= 10; ++i) {
+        const CallResult res{evm.execute(txn, 100'000)};
+        REQUIRE(res.status == EVMC_SUCCESS);
+        CHECK(res.data == expected_output);
+        REQUIRE(state.logs().size() == i);
+        CHECK(state.logs().back().data == expected_output);
+
+        // Calls are sequential, so a single buffer & a single state are recycled over and over
+        CHECK(state_pool.allocated() == 1);
+        CHECK(evm.result_pool().allocated() == 1);
+        CHECK(evm.result_pool().available() == 1);
+    }
+}
+
+TEST_CASE("Cached baseline analyses and switch to advanced interpreter") {
+    Block block{};
+    block.header.number = 10'336'006;
+    evmc::address caller{0x0a6bb546b9208cfab9e8fa2b9b2c042b18df7030_address};
+    evmc::address contract{0x62d1e4d6b3e9a84c2a8b2ed1bb4a5f82b7c5f6c4_address};
+
+    // PUSH1 2a, PUSH1 00, MSTORE, PUSH1 20, PUSH1 00, RETURN
+    Bytes code{*from_hex("602a60005260206000f3")};
+
+    InMemoryState db;
+    IntraBlockState state{db};
+    state.set_code(contract, code);
+
+    EVM evm{block, state, kMainnetConfig};
+
+    BaselineAnalysisCache baseline_cache;
+    evm.baseline_analysis_cache = &baseline_cache;
+
+    Transaction txn{};
+    txn.from = caller;
+    txn.to = contract;
+
+    const Bytes expected_output{full_view(to_bytes32(*from_hex("2a")))};
+
+    SECTION("Baseline only") {
+        for (size_t i{0}; i < 5; ++i) {
+            CHECK(evm.execute(txn, 100'000).data == expected_output);
+        }
+        CHECK(baseline_cache.misses() == 1);
+        CHECK(baseline_cache.hits() == 4);
+        CHECK(evm.interpreter_counters().baseline == 5);
+        CHECK(evm.interpreter_counters().advanced == 0);
+    }
+
+    SECTION("Frequently executed contracts switch to advanced") {
+        AnalysisCache advanced_cache;
+        evm.advanced_analysis_cache = &advanced_cache;
+        evm.advanced_threshold = 3;
+        for (size_t i{0}; i < 5; ++i) {
+            CHECK(evm.execute(txn, 100'000).data == expected_output);
+        }
+        // Once analysed for the advanced interpreter, the baseline cache is no longer looked up
+        CHECK(baseline_cache.misses() + baseline_cache.hits() == 3);
+        CHECK(evm.interpreter_counters().baseline == 2);
+        CHECK(evm.interpreter_counters().advanced == 3);
+    }
+}
+
+TEST_CASE("Profiler") {
+    Block block{};
+    block.header.number = 12'965'000;  // London
+    evmc::address caller{0x0a6bb546b9208cfab9e8fa2b9b2c042b18df7030_address};
+    evmc::address contract{0x62d1e4d6b3e9a84c2a8b2ed1bb4a5f82b7c5f6c4_address};
+
+    // PUSH1 01, PUSH1 00, SSTORE, PUSH1 00, SLOAD, PUSH1 00, MSTORE, PUSH1 20, PUSH1 00, RETURN
+    Bytes code{*from_hex("600160005560005460005260206000f3")};
+
+    InMemoryState db;
+    IntraBlockState state{db};
+    state.set_code(contract, code);
+
+    EVM evm{block, state, kMainnetConfig};
+    AnalysisCache advanced_cache;
+    evm.advanced_analysis_cache = &advanced_cache;
+    evm.advanced_threshold = 1;
+
+    EvmProfiler profiler;
+    evm.profiler = &profiler;
+
+    Transaction txn{};
+    txn.from = caller;
+    txn.to = contract;
+
+    const CallResult res{evm.execute(txn, 100'000)};
+    CHECK(res.status == EVMC_SUCCESS);
+    CHECK(res.data == full_view(to_bytes32(*from_hex("01"))));
+
+    // Instructions are only traced by baseline
+    CHECK(evm.interpreter_counters().advanced == 0);
+
+    CHECK(profiler.opcodes()[0x60].count == 6);  // PUSH1
+    CHECK(profiler.opcodes()[0x54].count == 1);  // SLOAD
+    CHECK(profiler.opcodes()[0x55].count == 1);  // SSTORE
+    CHECK(profiler.opcodes()[0xf3].count == 1);  // RETURN
+
+    CHECK(profiler.sstores().cold == 1);
+    CHECK(profiler.sstores().warm == 0);
+    CHECK(profiler.sloads().cold == 0);
+    CHECK(profiler.sloads().warm == 1);
+
+    REQUIRE(profiler.contracts().size() == 1);
+    const EvmProfiler::ContractStats& stats{profiler.contracts().at(contract)};
+    CHECK(stats.calls == 1);
+    CHECK(stats.gas == 100'000 - res.gas_left);
+
+    CHECK(profiler.state_reads(EvmProfiler::StateRead::kStorage).count > 0);
+
+    evm.profiler = nullptr;
+    CHECK(evm.execute(txn, 100'000).status == EVMC_SUCCESS);
+    CHECK(evm.interpreter_counters().advanced == 1);
+    CHECK(profiler.opcodes()[0x60].count == 6);
+}
+
 }  // namespace silkworm
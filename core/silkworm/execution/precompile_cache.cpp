@@ -0,0 +1,59 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "precompile_cache.hpp"
+
+#include <silkworm/common/cast.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/execution/precompiled.hpp>
+
+namespace silkworm {
+
+bool PrecompileCache::is_cacheable(uint8_t num) noexcept {
+    switch (num) {
+        case 0x01:  // ecrecover
+        case 0x05:  // modexp
+        case 0x06:  // alt_bn128 addition
+        case 0x07:  // alt_bn128 scalar multiplication
+        case 0x08:  // alt_bn128 pairing check
+            return true;
+        default:
+            return false;
+    }
+}
+
+std::optional<Bytes> PrecompileCache::run(uint8_t num, ByteView input) noexcept {
+    const precompiled::RunFunction run{precompiled::kContracts[num - 1].run};
+    if (!is_cacheable(num)) {
+        return run(input);
+    }
+
+    // Each contract gets its own key space
+    evmc::bytes32 key{bit_cast<evmc_bytes32>(keccak256(input))};
+    key.bytes[0] ^= num;
+
+    if (const std::optional<Bytes>* cached{cache_.get(key)}; cached) {
+        ++hits_;
+        return *cached;
+    }
+    ++misses_;
+
+    std::optional<Bytes> output{run(input)};
+    cache_.put(key, output);
+    return output;
+}
+
+}  // namespace silkworm
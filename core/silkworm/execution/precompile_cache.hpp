@@ -0,0 +1,60 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_EXECUTION_PRECOMPILE_CACHE_HPP_
+#define SILKWORM_EXECUTION_PRECOMPILE_CACHE_HPP_
+
+#include <optional>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/common/lru_cache.hpp>
+
+namespace silkworm {
+
+/** @brief Cache of precompiled contract outputs, keyed by contract & input hash.
+ *
+ * Only contracts whose execution is considerably more expensive than hashing the input
+ * (ecrecover, modexp and the alt_bn128 ones) go through the cache; the others are just run.
+ * Failures are cached as well.
+ */
+class PrecompileCache {
+  public:
+    static constexpr size_t kDefaultMaxSize{10'000};
+
+    explicit PrecompileCache(size_t maxSize = kDefaultMaxSize) : cache_{maxSize} {}
+
+    PrecompileCache(const PrecompileCache&) = delete;
+    PrecompileCache& operator=(const PrecompileCache&) = delete;
+
+    /** @brief Whether outputs of the precompiled contract at address num are worth caching. */
+    static bool is_cacheable(uint8_t num) noexcept;
+
+    /** @brief Runs the precompiled contract at address num, unless its output for the same input is cached. */
+    std::optional<Bytes> run(uint8_t num, ByteView input) noexcept;
+
+    [[nodiscard]] size_t size() const noexcept { return cache_.size(); }
+    [[nodiscard]] uint64_t hits() const noexcept { return hits_; }
+    [[nodiscard]] uint64_t misses() const noexcept { return misses_; }
+
+  private:
+    lru_cache<evmc::bytes32, std::optional<Bytes>> cache_;
+    uint64_t hits_{0};
+    uint64_t misses_{0};
+};
+
+}  // namespace silkworm
+
+#endif  // SILKWORM_EXECUTION_PRECOMPILE_CACHE_HPP_
@@ -0,0 +1,60 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "precompile_cache.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/util.hpp>
+#include <silkworm/execution/precompiled.hpp>
+
+namespace silkworm {
+
+TEST_CASE("Precompile cache") {
+    PrecompileCache cache{/*maxSize=*/2};
+
+    const Bytes ecrec_in{
+        *from_hex("18c547e4f7b0f325ad1e56f57e26c745b09a3e503d86e00e5255ff7f715d3d1c0000000000000000000000000000"
+                  "00000000000000000000000000000000001c73b1693892219d736caba55bdb67216e485557ea6b6af75f37096c9a"
+                  "a6a5a75feeb940b1d03b21e36b0e47e79769f095fe2ab855bd91e3a38756b7d75a9c4549")};
+    const std::optional<Bytes> ecrec_out{precompiled::ecrec_run(ecrec_in)};
+    REQUIRE(ecrec_out);
+
+    CHECK(cache.run(0x01, ecrec_in) == ecrec_out);
+    CHECK(cache.misses() == 1);
+    CHECK(cache.run(0x01, ecrec_in) == ecrec_out);
+    CHECK(cache.hits() == 1);
+
+    // Same input, different contract
+    const std::optional<Bytes> bn_add_out{cache.run(0x06, ecrec_in)};
+    CHECK(bn_add_out == precompiled::bn_add_run(ecrec_in));
+    CHECK(cache.misses() == 2);
+    CHECK(cache.size() == 2);
+
+    // Failures are cached too
+    const Bytes invalid_pairing{*from_hex("ab")};
+    CHECK(!cache.run(0x08, invalid_pairing));
+    CHECK(!cache.run(0x08, invalid_pairing));
+    CHECK(cache.hits() == 2);
+    CHECK(cache.size() == 2);  // ecrecover has been evicted
+
+    // Cheap contracts bypass the cache
+    CHECK(!PrecompileCache::is_cacheable(0x02));
+    CHECK(cache.run(0x04, ecrec_in) == ecrec_in);
+    CHECK(cache.hits() + cache.misses() == 5);
+}
+
+}  // namespace silkworm
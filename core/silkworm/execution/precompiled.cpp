@@ -184,6 +184,52 @@ uint64_t expmod_gas(ByteView input, evmc_revision rev) noexcept {
     }
 }
 
+// Loads a big endian integer of at most N bits
+template <unsigned N>
+static intx::uint<N> load_big_endian(ByteView bytes) noexcept {
+    uint8_t padded[N / 8]{};
+    std::memcpy(&padded[N / 8 - bytes.length()], bytes.data(), bytes.length());
+    return intx::be::unsafe::load<intx::uint<N>>(padded);
+}
+
+template <unsigned N>
+static intx::uint<N> mulmod(const intx::uint<N>& x, const intx::uint<N>& y, const intx::uint<N>& mod) noexcept {
+    return static_cast<intx::uint<N>>(intx::umul(x, y) % intx::uint<2 * N>{mod});
+}
+
+// Left-to-right binary exponentiation on fixed-width integers,
+// avoiding the heap allocations of GMP for moduli (and bases) of up to N bits
+template <unsigned N>
+static Bytes fixed_width_expmod(ByteView base, ByteView exponent, ByteView modulus) noexcept {
+    using Int = intx::uint<N>;
+
+    Bytes out(modulus.length(), '\0');
+    const Int mod{load_big_endian<N>(modulus)};
+    if (mod == 0) {
+        return out;
+    }
+
+    const Int b{load_big_endian<N>(base) % mod};
+    Int result{Int{1} % mod};
+    bool started{false};  // Squaring is pointless until the leading one of the exponent
+    for (const uint8_t byte : exponent) {
+        for (int bit{7}; bit >= 0; --bit) {
+            if (started) {
+                result = mulmod(result, result, mod);
+            }
+            if (byte & (1u << bit)) {
+                result = started ? mulmod(result, b, mod) : b;
+                started = true;
+            }
+        }
+    }
+
+    uint8_t be[N / 8];
+    intx::be::unsafe::store(be, result);
+    std::memcpy(out.data(), &be[N / 8 - out.length()], out.length());
+    return out;
+}
+
 std::optional<Bytes> expmod_run(ByteView input) noexcept {
     Bytes buffer;
     input = right_pad(input, 3 * 32, buffer);
@@ -203,6 +249,16 @@ std::optional<Bytes> expmod_run(ByteView input) noexcept {
 
     input = right_pad(input, base_len + exponent_len + modulus_len, buffer);
 
+    if (base_len <= 64 && modulus_len <= 64) {
+        const ByteView base{input.substr(0, base_len)};
+        const ByteView exponent{input.substr(base_len, exponent_len)};
+        const ByteView modulus{input.substr(base_len + exponent_len, modulus_len)};
+        if (base_len <= 32 && modulus_len <= 32) {
+            return fixed_width_expmod<256>(base, exponent, modulus);
+        }
+        return fixed_width_expmod<512>(base, exponent, modulus);
+    }
+
     mpz_t base;
     mpz_init(base);
     if (base_len) {
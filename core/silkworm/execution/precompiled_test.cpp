@@ -116,6 +116,85 @@ TEST_CASE("EXPMOD") {
     CHECK(expmod_gas(in, EVMC_BERLIN) == 5461);
 }
 
+TEST_CASE("EXPMOD fixed width") {
+    // Operands of up to 256 bits
+    Bytes in{*from_hex(
+        "0000000000000000000000000000000000000000000000000000000000000014"
+        "0000000000000000000000000000000000000000000000000000000000000005"
+        "0000000000000000000000000000000000000000000000000000000000000014"
+        "39f44380476d5036a221c56141563ba2d2f4a84f"
+        "51eb3baa5e"
+        "9fb5607a3ab54684fec1d8dc8996d017d3da3bc2")};
+    std::optional<Bytes> out{expmod_run(in)};
+    REQUIRE(out);
+    CHECK(to_hex(*out) == "8fd4ce48f86f4f7c0b13dd52af3a454503b650cf");
+
+    // Operands of up to 512 bits
+    in = *from_hex(
+        "0000000000000000000000000000000000000000000000000000000000000030"
+        "0000000000000000000000000000000000000000000000000000000000000021"
+        "0000000000000000000000000000000000000000000000000000000000000028"
+        "86839aee446f4a875f6518e216b99d62bd865db128f0939e4af21ca2cc716eb4e963493f14f150186424f752c95c9a17"
+        "c040419a9260411ab0c1268ea5be4a0a3d384bcf1f6d986a0ee3e8efe7c47a20eb"
+        "2599a2f3ad3825abffbca8957cf7f184c3ccb1a1c541a91f2cd28b678315e9685b2dea2fd9292ed6");
+    out = expmod_run(in);
+    REQUIRE(out);
+    CHECK(to_hex(*out) == "202dbfd7b0387de7a9cce500ed0668ae73a11d0b75d01db702fd09faba7a35a90fdc36ac4e7b502d");
+
+    in = *from_hex(
+        "0000000000000000000000000000000000000000000000000000000000000040"
+        "0000000000000000000000000000000000000000000000000000000000000002"
+        "0000000000000000000000000000000000000000000000000000000000000040"
+        "14c79ac3f2f5c34cd82574ce8beb48087d985ba764a726f90d6c38cf959ace84"
+        "10d32d79c8a55353239f7223f90121ee1918964e53be5dab52e039a253cd64d9"
+        "226c"
+        "0c67ad8213da95da8c46de64616fa68524692dfa8f4e694a501846c57ed42d8c"
+        "14dae8897e40a39ebaff1ce798626cc9e7af6f216b38070eb2a354a8b0a9e815");
+    out = expmod_run(in);
+    REQUIRE(out);
+    CHECK(to_hex(*out) ==
+          "0a525876a95970d16c20cbdcad3dbaf1a01d7c12bce210bc50d27f11ad5ffdb9"
+          "baa57ab405257537be6b0aa60c4fcb53422b4edceea7a46c51e426361251e8ed");
+
+    // Beyond 512 bits (GMP)
+    in = *from_hex(
+        "0000000000000000000000000000000000000000000000000000000000000021"
+        "0000000000000000000000000000000000000000000000000000000000000003"
+        "0000000000000000000000000000000000000000000000000000000000000041"
+        "6d7bd9801fe3fdf403d46aa94ea291bce69bfcd3b2adb0fa1fe8bf0c7e58977fd8"
+        "98754b"
+        "6e6d7a115873705ab17fa2381620dbf2ffaac4c2de48bc705f826228bf5c0b07d8"
+        "f7074a965ddedeed19b024d2e3208ca1b480f1e20651ec45d2928d8ae2dd43c9");
+    out = expmod_run(in);
+    REQUIRE(out);
+    CHECK(to_hex(*out) ==
+          "6d0e6ed41e30958f2706e5104a05014cd6d49762025d1270b305b09d6f45efbfc0"
+          "d6ae6fb4f623e6e0ea49ff524f8e03c5fb006f3eed088eab51ad2d3c5a992d60");
+
+    // Empty exponent
+    in = *from_hex(
+        "0000000000000000000000000000000000000000000000000000000000000001"
+        "0000000000000000000000000000000000000000000000000000000000000000"
+        "0000000000000000000000000000000000000000000000000000000000000002"
+        "02"
+        "0005");
+    out = expmod_run(in);
+    REQUIRE(out);
+    CHECK(to_hex(*out) == "0001");
+
+    // Modulus 1
+    in = *from_hex(
+        "0000000000000000000000000000000000000000000000000000000000000001"
+        "0000000000000000000000000000000000000000000000000000000000000001"
+        "0000000000000000000000000000000000000000000000000000000000000001"
+        "02"
+        "03"
+        "01");
+    out = expmod_run(in);
+    REQUIRE(out);
+    CHECK(to_hex(*out) == "00");
+}
+
 TEST_CASE("BN_ADD") {
     Bytes in{
         *from_hex("00000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000"
@@ -21,6 +21,7 @@
 #include <silkworm/chain/dao.hpp>
 #include <silkworm/chain/intrinsic_gas.hpp>
 #include <silkworm/chain/protocol_param.hpp>
+#include <silkworm/common/trace_span.hpp>
 #include <silkworm/trie/vector_root.hpp>
 
 namespace silkworm {
@@ -67,6 +68,7 @@ ValidationResult ExecutionProcessor::validate_transaction(const Transaction& txn
 }
 
 Receipt ExecutionProcessor::execute_transaction(const Transaction& txn) noexcept {
+    SILKWORM_TRACE_SPAN("ExecutionProcessor::execute_transaction");
     assert(validate_transaction(txn) == ValidationResult::kOk);
 
     state_.clear_journal_and_substate();
@@ -114,11 +116,11 @@ Receipt ExecutionProcessor::execute_transaction(const Transaction& txn) noexcept
     cumulative_gas_used_ += gas_used;
 
     return {
-        txn.type,                       // type
-        vm_res.status == EVMC_SUCCESS,  // success
-        cumulative_gas_used_,           // cumulative_gas_used
-        logs_bloom(state_.logs()),      // bloom
-        state_.logs(),                  // logs
+        txn.type,                                  // type
+        vm_res.status == EVMC_SUCCESS,             // success
+        cumulative_gas_used_,                      // cumulative_gas_used
+        bloom_builder_.logs_bloom(state_.logs()),  // bloom
+        state_.logs(),                             // logs
     };
 }
 
@@ -155,7 +157,12 @@ ValidationResult ExecutionProcessor::execute_block_no_post_validation(std::vecto
     }
 
     cumulative_gas_used_ = 0;
-    for (const Transaction& txn : evm_.block().transactions) {
+    const std::vector<Transaction>& transactions{evm_.block().transactions};
+    for (size_t i{0}; i < transactions.size(); ++i) {
+        if (sender_recovery) {
+            sender_recovery->wait(i);
+        }
+        const Transaction& txn{transactions[i]};
         const ValidationResult err{validate_transaction(txn)};
         if (err != ValidationResult::kOk) {
             return err;
@@ -22,8 +22,10 @@
 
 #include <silkworm/consensus/engine.hpp>
 #include <silkworm/execution/evm.hpp>
+#include <silkworm/execution/sender_recovery.hpp>
 #include <silkworm/state/state.hpp>
 #include <silkworm/types/block.hpp>
+#include <silkworm/types/bloom.hpp>
 #include <silkworm/types/receipt.hpp>
 #include <silkworm/types/transaction.hpp>
 
@@ -55,6 +57,10 @@ class ExecutionProcessor {
     EVM& evm() noexcept { return evm_; }
     const EVM& evm() const noexcept { return evm_; }
 
+    // If set, execute_and_write_block waits for the sender of every transaction right before executing it,
+    // which lets recovery started on the block's transactions overlap with execution
+    SenderRecovery* sender_recovery{nullptr};
+
   private:
     /// Execute the block, but do not write to the DB yet.
     /// Does not perform any post-execution validation (for example, receipt root is not checked).
@@ -65,6 +71,7 @@ class ExecutionProcessor {
     uint64_t refund_gas(const Transaction& txn, uint64_t gas_left) noexcept;
 
     uint64_t cumulative_gas_used_{0};
+    BloomBuilder bloom_builder_;  // addresses & topics of the logs of the block, hashed once
     IntraBlockState state_;
     consensus::IConsensusEngine& consensus_engine_;
     EVM evm_;
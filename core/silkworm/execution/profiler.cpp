@@ -0,0 +1,202 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <iomanip>
+#include <tuple>
+
+#include <evmc/instructions.h>
+
+#include <silkworm/common/util.hpp>
+
+namespace silkworm {
+
+namespace {
+
+    uint64_t to_nanos(EvmProfiler::Clock::duration d) noexcept {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+    }
+
+    double percentage(uint64_t part, uint64_t total) noexcept {
+        return total ? 100.0 * static_cast<double>(part) / static_cast<double>(total) : 0.0;
+    }
+
+    uint64_t average(uint64_t total, uint64_t count) noexcept { return count ? total / count : 0; }
+
+}  // namespace
+
+std::optional<EvmProfiler::SortKey> EvmProfiler::parse_sort_key(std::string_view name) noexcept {
+    if (name == "time") {
+        return SortKey::kTime;
+    } else if (name == "gas") {
+        return SortKey::kGas;
+    } else if (name == "count") {
+        return SortKey::kCount;
+    }
+    return std::nullopt;
+}
+
+void EvmProfiler::bill(Frame& frame, Clock::time_point now) noexcept {
+    if (frame.opcode) {
+        opcodes_[*frame.opcode].nanos += to_nanos(now - frame.since);
+    }
+    frame.since = now;
+}
+
+void EvmProfiler::on_execution_start() noexcept {
+    const auto now{Clock::now()};
+    if (!frames_.empty()) {
+        bill(frames_.back(), now);  // the CALL/CREATE up to here
+    }
+    frames_.push_back({std::nullopt, now});
+}
+
+void EvmProfiler::on_instruction(uint8_t opcode) noexcept {
+    assert(!frames_.empty());
+    const auto now{Clock::now()};
+    Frame& frame{frames_.back()};
+    bill(frame, now);
+    frame.opcode = opcode;
+    ++opcodes_[opcode].count;
+}
+
+void EvmProfiler::on_execution_end() noexcept {
+    assert(!frames_.empty());
+    const auto now{Clock::now()};
+    bill(frames_.back(), now);
+    frames_.pop_back();
+    if (!frames_.empty()) {
+        frames_.back().since = now;  // resume billing the CALL/CREATE after the nested call
+    }
+}
+
+void EvmProfiler::on_storage_access(evmc_access_status status) noexcept {
+    if (frames_.empty() || !frames_.back().opcode) {
+        return;
+    }
+    AccessStats* stats{nullptr};
+    if (*frames_.back().opcode == kSload) {
+        stats = &sloads_;
+    } else if (*frames_.back().opcode == kSstore) {
+        stats = &sstores_;
+    } else {
+        return;
+    }
+    ++(status == EVMC_ACCESS_COLD ? stats->cold : stats->warm);
+}
+
+void EvmProfiler::on_contract_executed(const evmc::address& contract, uint64_t gas, Clock::duration elapsed) {
+    ContractStats& stats{contracts_[contract]};
+    ++stats.calls;
+    stats.gas += gas;
+    stats.nanos += to_nanos(elapsed);
+}
+
+void EvmProfiler::on_state_read(StateRead kind, Clock::duration elapsed) noexcept {
+    ReadStats& stats{reads_[static_cast<size_t>(kind)]};
+    ++stats.count;
+    stats.nanos += to_nanos(elapsed);
+}
+
+void EvmProfiler::merge(const EvmProfiler& other) {
+    for (size_t i{0}; i < opcodes_.size(); ++i) {
+        opcodes_[i].count += other.opcodes_[i].count;
+        opcodes_[i].nanos += other.opcodes_[i].nanos;
+    }
+    for (const auto& [address, stats] : other.contracts_) {
+        ContractStats& mine{contracts_[address]};
+        mine.calls += stats.calls;
+        mine.gas += stats.gas;
+        mine.nanos += stats.nanos;
+    }
+    sloads_.cold += other.sloads_.cold;
+    sloads_.warm += other.sloads_.warm;
+    sstores_.cold += other.sstores_.cold;
+    sstores_.warm += other.sstores_.warm;
+    for (size_t i{0}; i < reads_.size(); ++i) {
+        reads_[i].count += other.reads_[i].count;
+        reads_[i].nanos += other.reads_[i].nanos;
+    }
+}
+
+void EvmProfiler::write_report(std::ostream& os, SortKey key, size_t top_contracts) const {
+    const char* const* names{evmc_get_instruction_names_table(EVMC_LONDON)};
+    const char* key_name{key == SortKey::kCount ? "count" : key == SortKey::kGas ? "gas" : "time"};
+    os << std::fixed << std::setprecision(2);
+
+    std::vector<size_t> opcodes;
+    uint64_t total_nanos{0};
+    for (size_t i{0}; i < opcodes_.size(); ++i) {
+        if (opcodes_[i].count) {
+            opcodes.push_back(i);
+            total_nanos += opcodes_[i].nanos;
+        }
+    }
+    std::sort(opcodes.begin(), opcodes.end(), [&](size_t a, size_t b) {
+        const OpcodeStats& x{opcodes_[a]};
+        const OpcodeStats& y{opcodes_[b]};
+        return key == SortKey::kCount ? std::tie(x.count, x.nanos) > std::tie(y.count, y.nanos)
+                                      : std::tie(x.nanos, x.count) > std::tie(y.nanos, y.count);
+    });
+    os << "# Opcodes by " << (key == SortKey::kCount ? "count" : "time") << "\n"
+       << "opcode\tname\tcount\ttime_ns\tavg_ns\ttime_%\n";
+    for (size_t i : opcodes) {
+        const OpcodeStats& stats{opcodes_[i]};
+        const auto opcode{static_cast<uint8_t>(i)};
+        os << "0x" << to_hex(ByteView{&opcode, 1}) << "\t" << (names[i] ? names[i] : "UNDEFINED") << "\t"
+           << stats.count << "\t" << stats.nanos << "\t" << average(stats.nanos, stats.count) << "\t"
+           << percentage(stats.nanos, total_nanos) << "\n";
+    }
+
+    std::vector<std::pair<evmc::address, ContractStats>> contracts{contracts_.begin(), contracts_.end()};
+    uint64_t total_gas{0};
+    for (const auto& [address, stats] : contracts) {
+        total_gas += stats.gas;
+    }
+    const size_t n{std::min(top_contracts, contracts.size())};
+    const auto rank{[key](const ContractStats& s) {
+        return key == SortKey::kCount ? std::tie(s.calls, s.gas)
+                                      : key == SortKey::kGas ? std::tie(s.gas, s.nanos) : std::tie(s.nanos, s.gas);
+    }};
+    std::partial_sort(contracts.begin(), contracts.begin() + static_cast<ptrdiff_t>(n), contracts.end(),
+                      [&](const auto& a, const auto& b) { return rank(a.second) > rank(b.second); });
+    os << "# Top " << n << " of " << contracts.size() << " contracts by " << key_name << " (including nested calls)\n"
+       << "contract\tcalls\tgas\tgas_%\ttime_ns\tavg_ns\n";
+    for (size_t i{0}; i < n; ++i) {
+        const auto& [address, stats]{contracts[i]};
+        os << "0x" << to_hex(address) << "\t" << stats.calls << "\t" << stats.gas << "\t"
+           << percentage(stats.gas, total_gas) << "\t" << stats.nanos << "\t" << average(stats.nanos, stats.calls)
+           << "\n";
+    }
+
+    os << "# Storage accesses (Berlin onwards)\n"
+       << "opcode\tcold\twarm\n"
+       << "SLOAD\t" << sloads_.cold << "\t" << sloads_.warm << "\n"
+       << "SSTORE\t" << sstores_.cold << "\t" << sstores_.warm << "\n";
+
+    os << "# State reads\n"
+       << "kind\tcount\ttime_ns\tavg_ns\n";
+    const char* kinds[]{"account", "code", "storage"};
+    for (size_t i{0}; i < reads_.size(); ++i) {
+        os << kinds[i] << "\t" << reads_[i].count << "\t" << reads_[i].nanos << "\t"
+           << average(reads_[i].nanos, reads_[i].count) << "\n";
+    }
+}
+
+}  // namespace silkworm
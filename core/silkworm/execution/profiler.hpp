@@ -0,0 +1,126 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_EXECUTION_PROFILER_HPP_
+#define SILKWORM_EXECUTION_PROFILER_HPP_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <evmc/evmc.hpp>
+
+namespace silkworm {
+
+// Profile of EVM execution aggregated over any number of transactions & blocks:
+// per-opcode counts & time, per-contract gas & wall time, SLOAD/SSTORE cold/warm accesses and state read latency.
+// Opcode times come from timestamps taken before every instruction, thus they are inflated by the profiling overhead
+// and only meaningful relative to one another.
+// Not thread safe: profile each thread separately and merge the profiles.
+class EvmProfiler {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    struct OpcodeStats {
+        uint64_t count{0};
+        uint64_t nanos{0};  // excluding nested calls
+    };
+
+    // Frames executing the code of a contract; gas & time include nested calls
+    struct ContractStats {
+        uint64_t calls{0};
+        uint64_t gas{0};
+        uint64_t nanos{0};
+    };
+
+    // EIP-2929 access status; nothing is recorded before Berlin
+    struct AccessStats {
+        uint64_t cold{0};
+        uint64_t warm{0};
+    };
+
+    struct ReadStats {
+        uint64_t count{0};
+        uint64_t nanos{0};
+    };
+
+    enum class StateRead {
+        kAccount,  // balance, existence, code hash & size
+        kCode,
+        kStorage,
+    };
+
+    enum class SortKey {
+        kTime,
+        kGas,  // contracts only; opcodes are sorted by time instead
+        kCount,
+    };
+
+    // Parses "time", "gas" or "count"
+    static std::optional<SortKey> parse_sort_key(std::string_view name) noexcept;
+
+    // Instruction tracing; frames of nested calls are stacked so that callee time isn't billed to the CALL opcode
+    void on_execution_start() noexcept;
+    void on_instruction(uint8_t opcode) noexcept;
+    void on_execution_end() noexcept;
+
+    // Attributed to SLOAD or SSTORE according to the instruction being executed
+    void on_storage_access(evmc_access_status status) noexcept;
+
+    void on_contract_executed(const evmc::address& contract, uint64_t gas, Clock::duration elapsed);
+
+    void on_state_read(StateRead kind, Clock::duration elapsed) noexcept;
+
+    // Adds up another profile, e.g. one of another thread
+    void merge(const EvmProfiler& other);
+
+    const std::array<OpcodeStats, 256>& opcodes() const noexcept { return opcodes_; }
+    const std::unordered_map<evmc::address, ContractStats>& contracts() const noexcept { return contracts_; }
+    const AccessStats& sloads() const noexcept { return sloads_; }
+    const AccessStats& sstores() const noexcept { return sstores_; }
+    const ReadStats& state_reads(StateRead kind) const noexcept { return reads_[static_cast<size_t>(kind)]; }
+
+    // Tab separated tables sorted by the given key in descending order, top_contracts rows at most for contracts.
+    // Rows can be re-sorted on any column with e.g. sort -t$'\t' -k3 -n -r.
+    void write_report(std::ostream& os, SortKey key = SortKey::kTime, size_t top_contracts = 100) const;
+
+  private:
+    static constexpr uint8_t kSload{0x54};
+    static constexpr uint8_t kSstore{0x55};
+
+    struct Frame {
+        std::optional<uint8_t> opcode;  // instruction being executed
+        Clock::time_point since;        // when it was last billed
+    };
+
+    void bill(Frame& frame, Clock::time_point now) noexcept;
+
+    std::array<OpcodeStats, 256> opcodes_{};
+    std::unordered_map<evmc::address, ContractStats> contracts_;
+    AccessStats sloads_;
+    AccessStats sstores_;
+    std::array<ReadStats, 3> reads_{};
+    std::vector<Frame> frames_;
+};
+
+}  // namespace silkworm
+
+#endif  // SILKWORM_EXECUTION_PROFILER_HPP_
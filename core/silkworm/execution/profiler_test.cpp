@@ -0,0 +1,116 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "profiler.hpp"
+
+#include <sstream>
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+using namespace evmc::literals;
+
+TEST_CASE("EVM profiler") {
+    using namespace std::chrono_literals;
+
+    EvmProfiler profiler;
+
+    SECTION("Nested calls aren't billed to the calling opcode") {
+        profiler.on_execution_start();
+        profiler.on_instruction(0x60);  // PUSH1
+        profiler.on_instruction(0xf1);  // CALL
+        profiler.on_execution_start();
+        profiler.on_instruction(0x5b);  // JUMPDEST
+        std::this_thread::sleep_for(10ms);
+        profiler.on_execution_end();
+        profiler.on_instruction(0x00);  // STOP
+        profiler.on_execution_end();
+
+        CHECK(profiler.opcodes()[0x60].count == 1);
+        CHECK(profiler.opcodes()[0xf1].count == 1);
+        CHECK(profiler.opcodes()[0x5b].count == 1);
+        CHECK(profiler.opcodes()[0x00].count == 1);
+        CHECK(profiler.opcodes()[0x5b].nanos >= 10'000'000);
+        CHECK(profiler.opcodes()[0xf1].nanos < profiler.opcodes()[0x5b].nanos);
+    }
+
+    SECTION("Storage accesses") {
+        profiler.on_storage_access(EVMC_ACCESS_COLD);  // outside of any frame
+        profiler.on_execution_start();
+        profiler.on_instruction(0x54);  // SLOAD
+        profiler.on_storage_access(EVMC_ACCESS_COLD);
+        profiler.on_instruction(0x55);  // SSTORE
+        profiler.on_storage_access(EVMC_ACCESS_WARM);
+        profiler.on_instruction(0x54);  // SLOAD
+        profiler.on_storage_access(EVMC_ACCESS_WARM);
+        profiler.on_instruction(0x31);  // BALANCE
+        profiler.on_storage_access(EVMC_ACCESS_COLD);
+        profiler.on_execution_end();
+
+        CHECK(profiler.sloads().cold == 1);
+        CHECK(profiler.sloads().warm == 1);
+        CHECK(profiler.sstores().cold == 0);
+        CHECK(profiler.sstores().warm == 1);
+    }
+
+    SECTION("Merge & report") {
+        const auto a{0x00000000000000000000000000000000000000aa_address};
+        const auto b{0x00000000000000000000000000000000000000bb_address};
+        profiler.on_contract_executed(a, 1'000, 5ms);
+        profiler.on_contract_executed(b, 500, 1ms);
+        profiler.on_state_read(EvmProfiler::StateRead::kStorage, 2us);
+
+        EvmProfiler other;
+        other.on_contract_executed(b, 2'000, 1ms);
+        other.on_state_read(EvmProfiler::StateRead::kStorage, 4us);
+        other.on_execution_start();
+        other.on_instruction(0x01);  // ADD
+        other.on_execution_end();
+
+        profiler.merge(other);
+        CHECK(profiler.contracts().at(a).calls == 1);
+        CHECK(profiler.contracts().at(b).calls == 2);
+        CHECK(profiler.contracts().at(b).gas == 2'500);
+        CHECK(profiler.contracts().at(b).nanos == 2'000'000);
+        CHECK(profiler.state_reads(EvmProfiler::StateRead::kStorage).count == 2);
+        CHECK(profiler.state_reads(EvmProfiler::StateRead::kStorage).nanos == 6'000);
+        CHECK(profiler.state_reads(EvmProfiler::StateRead::kAccount).count == 0);
+        CHECK(profiler.opcodes()[0x01].count == 1);
+
+        std::ostringstream by_gas;
+        profiler.write_report(by_gas, EvmProfiler::SortKey::kGas, /*top_contracts=*/1);
+        CHECK(by_gas.str().find("0x01\tADD\t1\t") != std::string::npos);
+        CHECK(by_gas.str().find("# Top 1 of 2 contracts by gas") != std::string::npos);
+        CHECK(by_gas.str().find("0x" + std::string(38, '0') + "bb\t2\t2500\t71.43\t") != std::string::npos);
+        CHECK(by_gas.str().find(std::string(38, '0') + "aa") == std::string::npos);
+        CHECK(by_gas.str().find("storage\t2\t6000\t3000\n") != std::string::npos);
+
+        std::ostringstream by_time;
+        profiler.write_report(by_time, EvmProfiler::SortKey::kTime, /*top_contracts=*/1);
+        CHECK(by_time.str().find(std::string(38, '0') + "aa\t1\t1000\t") != std::string::npos);
+    }
+
+    SECTION("Sort keys") {
+        CHECK(EvmProfiler::parse_sort_key("time") == EvmProfiler::SortKey::kTime);
+        CHECK(EvmProfiler::parse_sort_key("gas") == EvmProfiler::SortKey::kGas);
+        CHECK(EvmProfiler::parse_sort_key("count") == EvmProfiler::SortKey::kCount);
+        CHECK(EvmProfiler::parse_sort_key("calls") == std::nullopt);
+    }
+}
+
+}  // namespace silkworm
@@ -0,0 +1,68 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "result_pool.hpp"
+
+#include <cstring>
+#include <utility>
+
+#include <evmc/helpers.h>
+
+namespace silkworm {
+
+namespace {
+
+    // Lives in the optional storage of results, which is unused for anything but CREATE
+    struct PooledBuffer {
+        ResultBufferPool* pool;
+        Bytes* buffer;
+    };
+
+    static_assert(sizeof(PooledBuffer) <= sizeof(evmc_result_optional_storage));
+
+}  // namespace
+
+evmc::result ResultBufferPool::make_result(evmc_status_code status, int64_t gas_left, Bytes&& output) noexcept {
+    std::unique_ptr<Bytes> buffer;
+    if (free_.empty()) {
+        buffer = std::make_unique<Bytes>();
+        ++allocated_;
+    } else {
+        buffer = std::move(free_.back());
+        free_.pop_back();
+    }
+    *buffer = std::move(output);
+
+    evmc_result res{};
+    res.status_code = status;
+    res.gas_left = gas_left;
+    res.output_data = buffer->data();
+    res.output_size = buffer->size();
+    res.release = release;
+
+    const PooledBuffer pooled{this, buffer.release()};
+    std::memcpy(evmc_get_optional_storage(&res), &pooled, sizeof(pooled));
+
+    return evmc::result{res};
+}
+
+void ResultBufferPool::release(const evmc_result* result) noexcept {
+    PooledBuffer pooled;
+    std::memcpy(&pooled, evmc_get_const_optional_storage(result), sizeof(pooled));
+    pooled.pool->free_.emplace_back(pooled.buffer);
+}
+
+}  // namespace silkworm
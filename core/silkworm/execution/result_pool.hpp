@@ -0,0 +1,62 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_EXECUTION_RESULT_POOL_HPP_
+#define SILKWORM_EXECUTION_RESULT_POOL_HPP_
+
+#include <memory>
+#include <vector>
+
+#include <evmc/evmc.hpp>
+
+#include <silkworm/common/base.hpp>
+
+namespace silkworm {
+
+/** @brief Object pool of output buffers backing EVMC results produced by the host (i.e. precompiles).
+ *
+ * evmc::result{status, gas, data, size} mallocs a copy of the output for every call.
+ * Results made by the pool instead take ownership of the output and hand the buffer back
+ * to the pool once released, so that no allocation is needed for the result itself
+ * after the first few calls of a transaction.
+ * Results must not outlive the pool; not thread-safe.
+ */
+class ResultBufferPool {
+  public:
+    ResultBufferPool() = default;
+
+    ResultBufferPool(const ResultBufferPool&) = delete;
+    ResultBufferPool& operator=(const ResultBufferPool&) = delete;
+
+    /** @brief Makes a result whose output data is backed by a pooled buffer. */
+    evmc::result make_result(evmc_status_code status, int64_t gas_left, Bytes&& output) noexcept;
+
+    /** @brief Number of buffers ever created by the pool. */
+    [[nodiscard]] size_t allocated() const noexcept { return allocated_; }
+
+    /** @brief Number of buffers currently available for reuse. */
+    [[nodiscard]] size_t available() const noexcept { return free_.size(); }
+
+  private:
+    static void release(const evmc_result* result) noexcept;
+
+    std::vector<std::unique_ptr<Bytes>> free_;
+    size_t allocated_{0};
+};
+
+}  // namespace silkworm
+
+#endif  // SILKWORM_EXECUTION_RESULT_POOL_HPP_
@@ -0,0 +1,143 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sender_recovery.hpp"
+
+#include <cassert>
+
+namespace silkworm {
+
+#if defined(__wasm__)
+
+SenderRecovery::SenderRecovery(size_t) {}
+
+SenderRecovery::~SenderRecovery() = default;
+
+size_t SenderRecovery::default_num_workers() noexcept { return 0; }
+
+#else
+
+SenderRecovery::SenderRecovery(size_t num_workers) : num_workers_{num_workers} {}
+
+SenderRecovery::~SenderRecovery() {
+    {
+        std::lock_guard lock{mutex_};
+        stop_ = true;
+    }
+    work_cv_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+size_t SenderRecovery::default_num_workers() noexcept {
+    const size_t concurrency{std::thread::hardware_concurrency()};
+    return concurrency > 1 ? concurrency - 1 : 0;
+}
+
+void SenderRecovery::work() noexcept {
+    uint64_t generation{0};
+    while (true) {
+        {
+            std::unique_lock lock{mutex_};
+            work_cv_.wait(lock, [&] { return stop_ || generation_ != generation; });
+            if (stop_) {
+                return;
+            }
+            generation = generation_;
+            ++active_;
+        }
+
+        while (recover_next()) {
+        }
+
+        {
+            std::lock_guard lock{mutex_};
+            --active_;
+        }
+        idle_cv_.notify_all();
+    }
+}
+
+#endif
+
+void SenderRecovery::start(std::vector<Transaction>& transactions) {
+    const size_t size{transactions.size()};
+#if !defined(__wasm__)
+    // Workers still on the previous block (if any) merely found nothing left to claim
+    std::unique_lock lock{mutex_};
+    idle_cv_.wait(lock, [&] { return active_ == 0; });
+#endif
+
+    transactions_ = &transactions;
+    size_ = size;
+    if (capacity_ < size) {
+        capacity_ = size;
+        done_ = std::make_unique<std::atomic<bool>[]>(capacity_);
+    }
+    for (size_t i{0}; i < size; ++i) {
+        done_[i].store(false, std::memory_order_relaxed);
+    }
+    next_.store(0, std::memory_order_relaxed);
+
+#if !defined(__wasm__)
+    if (size < kMinParallelTransactions || num_workers_ == 0) {
+        return;
+    }
+    ++generation_;
+    lock.unlock();
+    if (workers_.empty()) {
+        workers_.reserve(num_workers_);
+        for (size_t i{0}; i < num_workers_; ++i) {
+            workers_.emplace_back(&SenderRecovery::work, this);
+        }
+    } else {
+        work_cv_.notify_all();
+    }
+#endif
+}
+
+void SenderRecovery::wait(size_t i) noexcept {
+    assert(i < size_);
+    while (!done_[i].load(std::memory_order_acquire)) {
+        if (!recover_next()) {
+#if !defined(__wasm__)
+            std::this_thread::yield();  // a worker is on it
+#endif
+        }
+    }
+}
+
+void SenderRecovery::finish() noexcept {
+    next_.store(size_, std::memory_order_relaxed);
+#if !defined(__wasm__)
+    std::unique_lock lock{mutex_};
+    idle_cv_.wait(lock, [&] { return active_ == 0; });
+#endif
+    transactions_ = nullptr;
+}
+
+bool SenderRecovery::recover_next() noexcept {
+    const size_t i{next_.fetch_add(1, std::memory_order_relaxed)};
+    if (i >= size_) {
+        return false;
+    }
+    (*transactions_)[i].recover_sender();
+    done_[i].store(true, std::memory_order_release);
+    return true;
+}
+
+}  // namespace silkworm
@@ -0,0 +1,93 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_EXECUTION_SENDER_RECOVERY_HPP_
+#define SILKWORM_EXECUTION_SENDER_RECOVERY_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#if !defined(__wasm__)
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+#include <silkworm/types/transaction.hpp>
+
+namespace silkworm {
+
+/** @brief Recovers the senders of the transactions of a block in the background, in transaction order.
+ *
+ * Meant to overlap with execution: the executor waits for the sender of each transaction right before executing it,
+ * lending a hand with pending recoveries meanwhile, so only the first few transactions of a block are on the critical
+ * path. Workers are spawned on the first block having at least kMinParallelTransactions transactions and are reused
+ * afterwards. In WebAssembly there are no workers, i.e. every sender is recovered by wait().
+ */
+class SenderRecovery {
+  public:
+    //! Below this many transactions waking up the workers isn't worth it
+    static constexpr size_t kMinParallelTransactions{8};
+
+    //! \param num_workers Threads recovering senders besides the one calling wait()
+    explicit SenderRecovery(size_t num_workers = default_num_workers());
+    ~SenderRecovery();
+
+    SenderRecovery(const SenderRecovery&) = delete;
+    SenderRecovery& operator=(const SenderRecovery&) = delete;
+
+    //! \brief Hardware concurrency minus the thread executing transactions
+    static size_t default_num_workers() noexcept;
+
+    //! \brief Starts recovering the missing senders of the transactions.
+    //! \warning Until finish() returns, the i-th transaction may only be accessed once wait(i) has returned.
+    void start(std::vector<Transaction>& transactions);
+
+    //! \brief Returns once the recovery of the sender of the i-th transaction is over, whether successful or not.
+    void wait(size_t i) noexcept;
+
+    //! \brief Cancels the recoveries not started yet and returns once the transactions aren't accessed anymore.
+    void finish() noexcept;
+
+  private:
+    //! \brief Claims the next pending transaction and recovers its sender; returns false if there's none left.
+    bool recover_next() noexcept;
+
+    std::vector<Transaction>* transactions_{nullptr};
+    size_t size_{0};
+    std::atomic<size_t> next_{0};
+    std::unique_ptr<std::atomic<bool>[]> done_;
+    size_t capacity_{0};
+
+#if !defined(__wasm__)
+    void work() noexcept;
+
+    size_t num_workers_;
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable work_cv_;  // workers wait for a new block (or stop_)
+    std::condition_variable idle_cv_;  // finish() waits for active_ to drop to zero
+    uint64_t generation_{0};
+    size_t active_{0};  // workers busy with the current block
+    bool stop_{false};
+#endif
+};
+
+}  // namespace silkworm
+
+#endif  // SILKWORM_EXECUTION_SENDER_RECOVERY_HPP_
@@ -0,0 +1,109 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sender_recovery.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/util.hpp>
+
+namespace silkworm {
+
+TEST_CASE("Sender recovery") {
+    using namespace evmc::literals;
+
+    // https://etherscan.io/tx/0x5c504ed432cb51138bcf09aa5e8a410dd4a1e204ef84bfed1be16dfba1b22060
+    Transaction signed_txn{
+        Transaction::Type::kLegacy,                          // type
+        0,                                                   // nonce
+        50'000 * kGiga,                                      // max_priority_fee_per_gas
+        50'000 * kGiga,                                      // max_fee_per_gas
+        21'000,                                              // gas_limit
+        0x5df9b87991262f6ba471f09758cde1c0fc1de734_address,  // to
+        31337,                                               // value
+        {},                                                  // data
+        true,                                                // odd_y_parity
+        std::nullopt,                                        // chain_id
+        intx::from_string<intx::uint256>("0x88ff6cf0fefd94db46111149ae4bfc179e9b94721fffd821d38d16464b3f71d0"),  // r
+        intx::from_string<intx::uint256>("0x45e0aff800961cfce805daef7016b9b675c137a6a41a548f7b60a3484c06a33a"),  // s
+    };
+    const auto sender{0xa1e4380a3b1f749673e270229993ee55f35663b4_address};
+
+    Transaction unsigned_txn{signed_txn};
+    unsigned_txn.r = 0;
+    unsigned_txn.s = 0;
+
+    Transaction recovered_txn{signed_txn};
+    recovered_txn.from = 0x0000000000000000000000000000000000000001_address;
+
+    // Every 10th transaction can't be recovered, every 7th already has a sender
+    std::vector<Transaction> transactions;
+    for (size_t i{0}; i < 100; ++i) {
+        transactions.push_back(i % 10 == 9 ? unsigned_txn : i % 7 == 3 ? recovered_txn : signed_txn);
+    }
+
+    const auto reset_senders{[&] {
+        for (size_t i{0}; i < transactions.size(); ++i) {
+            transactions[i].from = i % 10 != 9 && i % 7 == 3 ? recovered_txn.from : std::nullopt;
+        }
+    }};
+
+    const auto check_senders{[&](SenderRecovery& recovery) {
+        recovery.start(transactions);
+        for (size_t i{0}; i < transactions.size(); ++i) {
+            recovery.wait(i);
+            if (i % 10 == 9) {
+                CHECK(!transactions[i].from);
+            } else if (i % 7 == 3) {
+                CHECK(transactions[i].from == recovered_txn.from);
+            } else {
+                CHECK(transactions[i].from == sender);
+            }
+        }
+        recovery.finish();
+    }};
+
+    SECTION("Sequential") {
+        SenderRecovery recovery{0};
+        check_senders(recovery);
+    }
+
+    SECTION("Parallel") {
+        SenderRecovery recovery{3};
+        check_senders(recovery);
+
+        // Reused for the next block, which may be cut short by an invalid transaction
+        reset_senders();
+        recovery.start(transactions);
+        recovery.wait(0);
+        CHECK(transactions[0].from == sender);
+        recovery.finish();
+
+        // Too few transactions to wake up the workers
+        std::vector<Transaction> few(SenderRecovery::kMinParallelTransactions - 1, signed_txn);
+        recovery.start(few);
+        for (size_t i{0}; i < few.size(); ++i) {
+            recovery.wait(i);
+            CHECK(few[i].from == sender);
+        }
+        recovery.finish();
+
+        reset_senders();
+        check_senders(recovery);
+    }
+}
+
+}  // namespace silkworm
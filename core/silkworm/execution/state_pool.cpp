@@ -31,6 +31,7 @@ ExecutionStatePool::~ExecutionStatePool() = default;
 
 std::unique_ptr<evmone::AdvancedExecutionState> ExecutionStatePool::acquire() noexcept {
     if (pool_.empty()) {
+        ++allocated_;
         return std::make_unique<evmone::AdvancedExecutionState>();
     }
     std::unique_ptr<evmone::AdvancedExecutionState> obj{pool_.top().release()};
@@ -17,6 +17,7 @@
 #ifndef SILKWORM_EXECUTION_STATE_POOL_HPP_
 #define SILKWORM_EXECUTION_STATE_POOL_HPP_
 
+#include <cstddef>
 #include <memory>
 #include <stack>
 
@@ -39,8 +40,12 @@ class ExecutionStatePool {
 
     void release(std::unique_ptr<evmone::AdvancedExecutionState> obj) noexcept;
 
+    /// Number of execution states ever created by the pool.
+    [[nodiscard]] size_t allocated() const noexcept { return allocated_; }
+
   private:
     std::stack<std::unique_ptr<evmone::AdvancedExecutionState>> pool_;
+    size_t allocated_{0};
 };
 
 }  // namespace silkworm
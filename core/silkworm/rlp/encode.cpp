@@ -21,15 +21,23 @@
 
 namespace silkworm::rlp {
 
+// Appends the trailing len bytes of the big endian representation of n,
+// swapping the whole word at once rather than emitting bytes one by one
+static void append_big_compact(Bytes& to, uint64_t n, size_t len) {
+    uint8_t be[sizeof(uint64_t)];
+    endian::store_big_u64(be, n);
+    to.append(&be[sizeof(uint64_t) - len], len);
+}
+
 void encode_header(Bytes& to, Header header) {
     if (header.payload_length < 56) {
         const uint8_t code{header.list ? kEmptyListCode : kEmptyStringCode};
         to.push_back(static_cast<uint8_t>(code + header.payload_length));
     } else {
-        const Bytes len_be{endian::to_big_compact(header.payload_length)};
+        const size_t len_of_len{8 - intx::clz(header.payload_length) / 8};
         const uint8_t code = header.list ? 0xF7 : 0xB7;
-        to.push_back(static_cast<uint8_t>(code + len_be.length()));
-        to.append(len_be);
+        to.push_back(static_cast<uint8_t>(code + len_of_len));
+        append_big_compact(to, header.payload_length, len_of_len);
     }
 }
 
@@ -67,9 +75,9 @@ void encode(Bytes& to, uint64_t n) {
     } else if (n < kEmptyStringCode) {
         to.push_back(static_cast<uint8_t>(n));
     } else {
-        const Bytes be{endian::to_big_compact(n)};
-        to.push_back(static_cast<uint8_t>(kEmptyStringCode + be.length()));
-        to.append(be);
+        const size_t len{8 - intx::clz(n) / 8};
+        to.push_back(static_cast<uint8_t>(kEmptyStringCode + len));
+        append_big_compact(to, n, len);
     }
 }
 
@@ -87,9 +95,11 @@ void encode(Bytes& to, const intx::uint256& n) {
     } else if (n < kEmptyStringCode) {
         to.push_back(static_cast<uint8_t>(n));
     } else {
-        const Bytes be{endian::to_big_compact(n)};
-        to.push_back(static_cast<uint8_t>(kEmptyStringCode + be.length()));
-        to.append(be);
+        uint8_t be[sizeof(intx::uint256)];
+        intx::be::unsafe::store(be, n);
+        const size_t len{sizeof(intx::uint256) - intx::clz(n) / 8};
+        to.push_back(static_cast<uint8_t>(kEmptyStringCode + len));
+        to.append(&be[sizeof(intx::uint256) - len], len);
     }
 }
 
@@ -20,6 +20,7 @@
 #ifndef SILKWORM_RLP_ENCODE_HPP_
 #define SILKWORM_RLP_ENCODE_HPP_
 
+#include <algorithm>
 #include <array>
 #include <optional>
 #include <vector>
@@ -51,6 +52,17 @@ namespace rlp {
 
     void encode_header(Bytes& to, Header header);
 
+    //! \brief Makes room for additional_length more bytes, so that encoding a whole item
+    //! with a known length (see length functions) reallocates the buffer at most once.
+    //! \remarks Unlike a plain reserve, it never shrinks the buffer and keeps growth geometric
+    //! so that appending many items one after another stays amortized linear
+    inline void reserve_additional(Bytes& to, size_t additional_length) {
+        const size_t required{to.length() + additional_length};
+        if (to.capacity() < required) {
+            to.reserve(std::max(required, 2 * to.capacity()));
+        }
+    }
+
     void encode(Bytes& to, const evmc::bytes32&);
     void encode(Bytes& to, ByteView);
     void encode(Bytes& to, uint64_t);
@@ -111,6 +123,7 @@ namespace rlp {
         for (const T& x : v) {
             h.payload_length += length(x);
         }
+        reserve_additional(to, length_of_length(h.payload_length) + h.payload_length);
         encode_header(to, h);
         for (const T& x : v) {
             encode(to, x);
@@ -75,6 +75,31 @@ TEST_CASE("RLP encoding") {
     SECTION("vectors") {
         CHECK(to_hex(encoded(std::vector<uint64_t>{})) == "c0");
         CHECK(to_hex(encoded(std::vector<uint64_t>{0xFFCCB5, 0xFFC0B5})) == "c883ffccb583ffc0b5");
+
+        const Bytes long_list{encoded(std::vector<uint64_t>(100, 0x400))};
+        CHECK(long_list.length() == 303);
+        CHECK(to_hex(long_list.substr(0, 6)) == "f9012c820400");
+    }
+
+    SECTION("headers") {
+        Bytes s{};
+        rlp::encode_header(s, {/*list=*/false, 55});
+        CHECK(to_hex(s) == "b7");
+        s.clear();
+        rlp::encode_header(s, {/*list=*/false, 56});
+        CHECK(to_hex(s) == "b838");
+        s.clear();
+        rlp::encode_header(s, {/*list=*/true, 0xFFCCB5DD});
+        CHECK(to_hex(s) == "fbffccb5dd");
+    }
+
+    SECTION("appending") {
+        Bytes s(100, '\0');
+        const size_t capacity{s.capacity()};
+        rlp::reserve_additional(s, 0);
+        CHECK(s.capacity() == capacity);
+        rlp::encode(s, std::vector<uint64_t>{0xFFCCB5, 0xFFC0B5});
+        CHECK(to_hex(s.substr(100)) == "c883ffccb583ffc0b5");
     }
 }
 }  // namespace silkworm
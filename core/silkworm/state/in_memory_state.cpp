@@ -16,16 +16,38 @@
 
 #include "in_memory_state.hpp"
 
-#include <map>
+#include <cstring>
 
 #include <ethash/keccak.hpp>
 
 #include <silkworm/common/util.hpp>
 #include <silkworm/rlp/encode.hpp>
-#include <silkworm/trie/hash_builder.hpp>
 
 namespace silkworm {
 
+ByteView InMemoryState::ByteArena::store(ByteView data) {
+    if (data.empty()) {
+        return {};
+    }
+    uint8_t* ptr{nullptr};
+    if (data.length() > kChunkSize / 4) {
+        // Big enough for a chunk of its own, leaving the current one to smaller data
+        chunks_.push_back(std::make_unique<uint8_t[]>(data.length()));
+        ptr = chunks_.back().get();
+    } else {
+        if (available_ < data.length()) {
+            chunks_.push_back(std::make_unique<uint8_t[]>(kChunkSize));
+            free_ = chunks_.back().get();
+            available_ = kChunkSize;
+        }
+        ptr = free_;
+        free_ += data.length();
+        available_ -= data.length();
+    }
+    std::memcpy(ptr, data.data(), data.length());
+    return {ptr, data.length()};
+}
+
 std::optional<Account> InMemoryState::read_account(const evmc::address& address) const noexcept {
     auto it{accounts_.find(address)};
     if (it == accounts_.end()) {
@@ -44,19 +66,11 @@ ByteView InMemoryState::read_code(const evmc::bytes32& code_hash) const noexcept
 
 evmc::bytes32 InMemoryState::read_storage(const evmc::address& address, uint64_t incarnation,
                                           const evmc::bytes32& location) const noexcept {
-    auto it1{storage_.find(address)};
-    if (it1 == storage_.end()) {
+    auto it{storage_.find(StorageKey{{address, incarnation}, location})};
+    if (it == storage_.end()) {
         return {};
     }
-    auto it2{it1->second.find(incarnation)};
-    if (it2 == it1->second.end()) {
-        return {};
-    }
-    auto it3{it2->second.find(location)};
-    if (it3 == it2->second.end()) {
-        return {};
-    }
-    return it3->second;
+    return it->second;
 }
 
 uint64_t InMemoryState::previous_incarnation(const evmc::address& address) const noexcept {
@@ -69,41 +83,29 @@ uint64_t InMemoryState::previous_incarnation(const evmc::address& address) const
 
 std::optional<BlockHeader> InMemoryState::read_header(uint64_t block_number,
                                                       const evmc::bytes32& block_hash) const noexcept {
-    if (block_number >= headers_.size()) {
-        return std::nullopt;
-    }
-
-    auto it{headers_[block_number].find(block_hash)};
-    if (it == headers_[block_number].end()) {
+    auto it{blocks_.find(block_hash)};
+    if (it == blocks_.end() || it->second.header.number != block_number) {
         return std::nullopt;
     }
-    return it->second;
+    return it->second.header;
 }
 
 std::optional<BlockBody> InMemoryState::read_body(uint64_t block_number,
                                                   const evmc::bytes32& block_hash) const noexcept {
-    if (block_number >= bodies_.size()) {
-        return std::nullopt;
-    }
-
-    auto it{bodies_[block_number].find(block_hash)};
-    if (it == bodies_[block_number].end()) {
+    auto it{blocks_.find(block_hash)};
+    if (it == blocks_.end() || it->second.header.number != block_number) {
         return std::nullopt;
     }
-    return it->second;
+    return it->second.body;
 }
 
 std::optional<intx::uint256> InMemoryState::total_difficulty(uint64_t block_number,
                                                              const evmc::bytes32& block_hash) const noexcept {
-    if (block_number >= difficulty_.size()) {
-        return std::nullopt;
-    }
-
-    auto it{difficulty_[block_number].find(block_hash)};
-    if (it == difficulty_[block_number].end()) {
+    auto it{blocks_.find(block_hash)};
+    if (it == blocks_.end() || it->second.header.number != block_number) {
         return std::nullopt;
     }
-    return it->second;
+    return it->second.total_difficulty;
 }
 
 uint64_t InMemoryState::current_canonical_block() const { return canonical_hashes_.size() - 1; }
@@ -117,27 +119,13 @@ std::optional<evmc::bytes32> InMemoryState::canonical_hash(uint64_t block_number
 }
 
 void InMemoryState::insert_block(const Block& block, const evmc::bytes32& hash) {
-    uint64_t block_number{block.header.number};
-
-    if (headers_.size() <= block_number) {
-        headers_.resize(block_number + 1);
-    }
-    headers_[block_number][hash] = block.header;
-
-    if (bodies_.size() <= block_number) {
-        bodies_.resize(block_number + 1);
-    }
-    bodies_[block_number][hash] = block;
-
-    if (difficulty_.size() <= block_number) {
-        difficulty_.resize(block_number + 1);
-    }
-    if (block_number == 0) {
-        difficulty_[block_number][hash] = 0;
-    } else {
-        difficulty_[block_number][hash] = difficulty_[block_number - 1][block.header.parent_hash];
+    intx::uint256 difficulty{block.header.difficulty};
+    if (block.header.number > 0) {
+        if (auto parent{total_difficulty(block.header.number - 1, block.header.parent_hash)}; parent) {
+            difficulty += *parent;
+        }
     }
-    difficulty_[block_number][hash] += block.header.difficulty;
+    blocks_.insert_or_assign(hash, StoredBlock{block.header, block, difficulty});
 }
 
 void InMemoryState::canonize_block(uint64_t block_number, const evmc::bytes32& block_hash) {
@@ -160,6 +148,7 @@ void InMemoryState::begin_block(uint64_t block_number) {
 void InMemoryState::update_account(const evmc::address& address, std::optional<Account> initial,
                                    std::optional<Account> current) {
     account_changes_[block_number_][address] = initial;
+    dirty_accounts_.insert(address);
 
     if (current.has_value()) {
         accounts_[address] = current.value();
@@ -172,40 +161,51 @@ void InMemoryState::update_account(const evmc::address& address, std::optional<A
 }
 
 void InMemoryState::update_account_code(const evmc::address&, uint64_t, const evmc::bytes32& code_hash, ByteView code) {
-    // Don't overwrite already existing code so that views of it
-    // that were previously returned by read_code() are still valid.
-    code_.try_emplace(code_hash, code);
+    // Code already stored is left alone, hence the arena only grows by new code
+    if (auto [it, inserted]{code_.try_emplace(code_hash)}; inserted) {
+        it->second = code_arena_.store(code);
+    }
 }
 
 void InMemoryState::update_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
                                    const evmc::bytes32& initial, const evmc::bytes32& current) {
-    storage_changes_[block_number_][address][incarnation][location] = initial;
+    const StorageKey key{{address, incarnation}, location};
+    storage_changes_[block_number_][key] = initial;
+    dirty_storage_.insert(key);
+    write_storage(key, current);
+}
 
-    if (is_zero(current)) {
-        storage_[address][incarnation].erase(location);
+void InMemoryState::write_storage(const StorageKey& key, const evmc::bytes32& value) {
+    if (is_zero(value)) {
+        if (storage_.erase(key)) {
+            auto it{storage_sizes_.find(key.owner)};
+            if (--it->second == 0) {
+                storage_sizes_.erase(it);
+            }
+        }
+    } else if (auto [it, inserted]{storage_.try_emplace(key, value)}; inserted) {
+        ++storage_sizes_[key.owner];
     } else {
-        storage_[address][incarnation][location] = current;
+        it->second = value;
     }
 }
 
 void InMemoryState::unwind_state_changes(uint64_t block_number) {
-    for (const auto& [address, account] : account_changes_[block_number]) {
-        if (account) {
-            accounts_[address] = *account;
-        } else {
-            accounts_.erase(address);
+    if (auto it{account_changes_.find(block_number)}; it != account_changes_.end()) {
+        for (const auto& [address, account] : it->second) {
+            dirty_accounts_.insert(address);
+            if (account) {
+                accounts_[address] = *account;
+            } else {
+                accounts_.erase(address);
+            }
         }
     }
 
-    for (const auto& [address, storage1] : storage_changes_[block_number]) {
-        for (const auto& [incarnation, storage2] : storage1) {
-            for (const auto& [location, value] : storage2) {
-                if (is_zero(value)) {
-                    storage_[address][incarnation].erase(location);
-                } else {
-                    storage_[address][incarnation][location] = value;
-                }
-            }
+    if (auto it{storage_changes_.find(block_number)}; it != storage_changes_.end()) {
+        for (const auto& [key, value] : it->second) {
+            dirty_storage_.insert(key);
+            write_storage(key, value);
         }
     }
 }
@@ -213,70 +213,51 @@ void InMemoryState::unwind_state_changes(uint64_t block_number) {
 size_t InMemoryState::number_of_accounts() const { return accounts_.size(); }
 
 size_t InMemoryState::storage_size(const evmc::address& address, uint64_t incarnation) const {
-    auto it1{storage_.find(address)};
-    if (it1 == storage_.end()) {
-        return 0;
-    }
-    auto it2{it1->second.find(incarnation)};
-    if (it2 == it1->second.end()) {
+    auto it{storage_sizes_.find(IncarnationKey{address, incarnation})};
+    if (it == storage_sizes_.end()) {
         return 0;
     }
-
-    return it2->second.size();
+    return it->second;
 }
 
 // https://eth.wiki/fundamentals/patricia-tree#storage-trie
-evmc::bytes32 InMemoryState::account_storage_root(const evmc::address& address, uint64_t incarnation) const {
-    auto it1{storage_.find(address)};
-    if (it1 == storage_.end()) {
-        return kEmptyRoot;
-    }
-    auto it2{it1->second.find(incarnation)};
-    if (it2 == it1->second.end()) {
-        return kEmptyRoot;
-    }
-
-    const auto& storage{it2->second};
-
-    if (storage.empty()) {
-        return kEmptyRoot;
-    }
-
-    std::map<evmc::bytes32, Bytes> storage_rlp;
-    Bytes buffer;
-    for (const auto& [location, value] : storage) {
-        ethash::hash256 hash{keccak256(full_view(location))};
-        buffer.clear();
-        rlp::encode(buffer, zeroless_view(value));
-        storage_rlp[to_bytes32(full_view(hash.bytes))] = buffer;
+void InMemoryState::update_tries() const {
+    Bytes rlp;
+    for (const StorageKey& key : dirty_storage_) {
+        trie::InMemoryTrie& storage_trie{storage_tries_[key.owner]};
+        const ethash::hash256 hash{keccak256(full_view(key.location))};
+        const auto it{storage_.find(key)};
+        if (it == storage_.end()) {
+            storage_trie.erase(full_view(hash.bytes));
+        } else {
+            rlp.clear();
+            rlp::encode(rlp, zeroless_view(it->second));
+            storage_trie.upsert(full_view(hash.bytes), rlp);
+        }
+        dirty_accounts_.insert(key.owner.address);  // storage root may have changed
     }
+    dirty_storage_.clear();
 
-    trie::HashBuilder hb;
-    for (const auto& [hash, rlp] : storage_rlp) {
-        hb.add_leaf(trie::unpack_nibbles(full_view(hash)), rlp);
+    for (const auto& address : dirty_accounts_) {
+        const ethash::hash256 hash{keccak256(full_view(address))};
+        const auto it{accounts_.find(address)};
+        if (it == accounts_.end()) {
+            account_trie_.erase(full_view(hash.bytes));
+            continue;
+        }
+        const Account& account{it->second};
+        evmc::bytes32 storage_root{kEmptyRoot};
+        if (auto it1{storage_tries_.find(IncarnationKey{address, account.incarnation})}; it1 != storage_tries_.end()) {
+            storage_root = it1->second.root_hash();
+        }
+        account_trie_.upsert(full_view(hash.bytes), account.rlp(storage_root));
     }
-
-    return hb.root_hash();
+    dirty_accounts_.clear();
 }
 
 evmc::bytes32 InMemoryState::state_root_hash() const {
-    if (accounts_.empty()) {
-        return kEmptyRoot;
-    }
-
-    std::map<evmc::bytes32, Bytes> account_rlp;
-    for (const auto& [address, account] : accounts_) {
-        ethash::hash256 hash{keccak256(full_view(address))};
-        evmc::bytes32 storage_root{account_storage_root(address, account.incarnation)};
-        account_rlp[to_bytes32(full_view(hash.bytes))] = account.rlp(storage_root);
-    }
-
-    trie::HashBuilder hb;
-    for (const auto& [hash, rlp] : account_rlp) {
-        hb.add_leaf(trie::unpack_nibbles(full_view(hash)), rlp);
-    }
-
-    return hb.root_hash();
+    update_tries();
+    return account_trie_.root_hash();
 }
 
 }  // namespace silkworm
@@ -17,23 +17,71 @@
 #ifndef SILKWORM_STATE_IN_MEMORY_STATE_HPP_
 #define SILKWORM_STATE_IN_MEMORY_STATE_HPP_
 
-#include <unordered_map>
+#include <functional>
+#include <memory>
 #include <vector>
 
+#include <silkworm/common/hash_maps.hpp>
 #include <silkworm/state/state.hpp>
+#include <silkworm/trie/in_memory_trie.hpp>
+
+namespace silkworm {
+
+/// Storage of a contract incarnation
+struct IncarnationKey {
+    evmc::address address;
+    uint64_t incarnation{0};
+};
+
+inline bool operator==(const IncarnationKey& a, const IncarnationKey& b) noexcept {
+    return a.incarnation == b.incarnation && a.address == b.address;
+}
+
+/// Storage slot: address + incarnation + location
+struct StorageKey {
+    IncarnationKey owner;
+    evmc::bytes32 location;
+};
+
+inline bool operator==(const StorageKey& a, const StorageKey& b) noexcept {
+    return a.location == b.location && a.owner == b.owner;
+}
+
+}  // namespace silkworm
+
+namespace std {
+
+template <>
+struct hash<silkworm::IncarnationKey> {
+    size_t operator()(const silkworm::IncarnationKey& key) const noexcept {
+        return std::hash<evmc::address>{}(key.address) ^ (key.incarnation * 0x9e3779b97f4a7c15);
+    }
+};
+
+template <>
+struct hash<silkworm::StorageKey> {
+    size_t operator()(const silkworm::StorageKey& key) const noexcept {
+        const size_t h{std::hash<silkworm::IncarnationKey>{}(key.owner)};
+        return h ^ (std::hash<evmc::bytes32>{}(key.location) + 0x9e3779b97f4a7c15 + (h << 6) + (h >> 2));
+    }
+};
+
+}  // namespace std
 
 namespace silkworm {
 
 /// InMemoryState holds the entire state in memory.
+///
+/// Everything is kept in flat hash maps with fixed-width keys, e.g. a single map from address + incarnation +
+/// location to value for storage, so that reads take one probe and writes allocate only when a map grows.
+/// Code is copied into an append-only arena, which keeps the views returned by read_code() valid.
 class InMemoryState : public State {
   private:
     // address -> initial value
-    using AccountChanges = std::unordered_map<evmc::address, std::optional<Account>>;
+    using AccountChanges = FlatHashMap<evmc::address, std::optional<Account>>;
 
-    // address -> incarnation -> location -> initial value
-    using StorageChanges =
-        std::unordered_map<evmc::address,
-                           std::unordered_map<uint64_t, std::unordered_map<evmc::bytes32, evmc::bytes32>>>;
+    // address + incarnation + location -> initial value
+    using StorageChanges = FlatHashMap<StorageKey, evmc::bytes32>;
 
   public:
     std::optional<Account> read_account(const evmc::address& address) const noexcept override;
@@ -84,38 +132,61 @@ class InMemoryState : public State {
 
     size_t storage_size(const evmc::address& address, uint64_t incarnation) const;
 
-    const std::unordered_map<uint64_t, AccountChanges>& account_changes() const { return account_changes_; }
-    const std::unordered_map<evmc::address, Account>& accounts() const { return accounts_; }
+    const FlatHashMap<uint64_t, AccountChanges>& account_changes() const { return account_changes_; }
+    const FlatHashMap<evmc::address, Account>& accounts() const { return accounts_; }
 
   private:
-    evmc::bytes32 account_storage_root(const evmc::address& address, uint64_t incarnation) const;
+    /// Append-only storage of byte strings; what it holds stays put until it is destroyed.
+    class ByteArena {
+      public:
+        static constexpr size_t kChunkSize{64 * 1024};
+
+        ByteView store(ByteView data);
+
+      private:
+        std::vector<std::unique_ptr<uint8_t[]>> chunks_;
+        uint8_t* free_{nullptr};  // into the last regular chunk
+        size_t available_{0};
+    };
 
-    std::unordered_map<evmc::address, Account> accounts_;
+    struct StoredBlock {
+        BlockHeader header;
+        BlockBody body;
+        intx::uint256 total_difficulty;
+    };
 
-    // hash -> code
-    std::unordered_map<evmc::bytes32, Bytes> code_;
+    // Sets the value of a slot, zero meaning deletion, and keeps storage_sizes_ up to date
+    void write_storage(const StorageKey& key, const evmc::bytes32& value);
 
-    std::unordered_map<evmc::address, uint64_t> prev_incarnations_;
+    // Brings the tries up to date with the accounts & storage modified since the previous call
+    void update_tries() const;
 
-    // address -> incarnation -> location -> value
-    std::unordered_map<evmc::address, std::unordered_map<uint64_t, std::unordered_map<evmc::bytes32, evmc::bytes32>>>
-        storage_;
+    FlatHashMap<evmc::address, Account> accounts_;
 
-    // block number -> hash -> header
-    std::vector<std::unordered_map<evmc::bytes32, BlockHeader>> headers_;
+    // hash -> code, the latter in code_arena_
+    FlatHashMap<evmc::bytes32, ByteView> code_;
+    ByteArena code_arena_;
 
-    // block number -> hash -> body
-    std::vector<std::unordered_map<evmc::bytes32, BlockBody>> bodies_;
+    FlatHashMap<evmc::address, uint64_t> prev_incarnations_;
 
-    // block number -> hash -> total difficulty
-    std::vector<std::unordered_map<evmc::bytes32, intx::uint256>> difficulty_;
+    FlatHashMap<StorageKey, evmc::bytes32> storage_;
+    FlatHashMap<IncarnationKey, size_t> storage_sizes_;  // non-zero slots
+
+    // block hash -> block; the number is checked against the header
+    FlatHashMap<evmc::bytes32, StoredBlock> blocks_;
 
     std::vector<evmc::bytes32> canonical_hashes_;
 
-    std::unordered_map<uint64_t, AccountChanges> account_changes_;  // per block
-    std::unordered_map<uint64_t, StorageChanges> storage_changes_;  // per block
+    FlatHashMap<uint64_t, AccountChanges> account_changes_;  // per block
+    FlatHashMap<uint64_t, StorageChanges> storage_changes_;  // per block
 
     uint64_t block_number_{0};
+
+    // Tries are updated lazily, by state_root_hash(), from the keys modified in the meantime
+    mutable trie::InMemoryTrie account_trie_;
+    mutable FlatHashMap<IncarnationKey, trie::InMemoryTrie> storage_tries_;
+    mutable FlatHashSet<evmc::address> dirty_accounts_;
+    mutable FlatHashSet<StorageKey> dirty_storage_;
 };
 
 }  // namespace silkworm
@@ -0,0 +1,127 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "in_memory_state.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/util.hpp>
+
+namespace silkworm {
+
+TEST_CASE("InMemoryState storage") {
+    const auto a{0x0a00000000000000000000000000000000000000_address};
+    const auto location1{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+    const auto location2{0x0000000000000000000000000000000000000000000000000000000000000002_bytes32};
+    const auto one{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+    const auto two{0x0000000000000000000000000000000000000000000000000000000000000002_bytes32};
+
+    InMemoryState state;
+    state.begin_block(1);
+    state.update_account(a, std::nullopt, Account{0, 0, kEmptyHash, 1});
+    state.update_storage(a, 1, location1, {}, one);
+    state.update_storage(a, 1, location2, {}, two);
+    state.update_storage(a, 2, location1, {}, two);
+    CHECK(state.storage_size(a, 1) == 2);
+    CHECK(state.storage_size(a, 2) == 1);
+    CHECK(state.read_storage(a, 1, location1) == one);
+    CHECK(state.read_storage(a, 2, location1) == two);
+    const evmc::bytes32 root1{state.state_root_hash()};
+    CHECK(root1 != kEmptyRoot);
+
+    state.begin_block(2);
+    state.update_storage(a, 1, location1, one, {});
+    state.update_storage(a, 1, location2, two, one);
+    CHECK(state.storage_size(a, 1) == 1);
+    CHECK(state.read_storage(a, 1, location1) == evmc::bytes32{});
+    CHECK(state.read_storage(a, 1, location2) == one);
+    CHECK(state.state_root_hash() != root1);
+
+    state.unwind_state_changes(2);
+    CHECK(state.storage_size(a, 1) == 2);
+    CHECK(state.read_storage(a, 1, location1) == one);
+    CHECK(state.read_storage(a, 1, location2) == two);
+    CHECK(state.state_root_hash() == root1);
+
+    state.unwind_state_changes(1);
+    CHECK(state.number_of_accounts() == 0);
+    CHECK(state.storage_size(a, 1) == 0);
+    CHECK(state.storage_size(a, 2) == 0);
+    CHECK(state.state_root_hash() == kEmptyRoot);
+}
+
+TEST_CASE("InMemoryState code") {
+    const auto a{0x0a00000000000000000000000000000000000000_address};
+
+    InMemoryState state;
+    std::vector<std::pair<evmc::bytes32, ByteView>> stored;
+    for (size_t i{0}; i < 100; ++i) {
+        // Small and big pieces of code, the latter bigger than a quarter of an arena chunk
+        const Bytes code(i % 10 == 0 ? 20'000 : 100 + i, static_cast<uint8_t>(i));
+        const ethash::hash256 hash{keccak256(code)};
+        const evmc::bytes32 code_hash{to_bytes32(full_view(hash.bytes))};
+        state.update_account_code(a, 1, code_hash, code);
+        stored.emplace_back(code_hash, state.read_code(code_hash));
+        CHECK(stored.back().second == code);
+
+        // Already stored code is kept as is
+        state.update_account_code(a, 1, code_hash, code);
+        CHECK(state.read_code(code_hash).data() == stored.back().second.data());
+    }
+
+    // Views are still valid
+    for (size_t i{0}; i < stored.size(); ++i) {
+        CHECK(stored[i].second == Bytes(i % 10 == 0 ? 20'000 : 100 + i, static_cast<uint8_t>(i)));
+        CHECK(state.read_code(stored[i].first).data() == stored[i].second.data());
+    }
+    CHECK(state.read_code(kEmptyHash).empty());
+}
+
+TEST_CASE("InMemoryState blocks") {
+    InMemoryState state;
+
+    Block genesis;
+    genesis.header.difficulty = 10;
+    const evmc::bytes32 genesis_hash{genesis.header.hash()};
+    state.insert_block(genesis, genesis_hash);
+    state.canonize_block(0, genesis_hash);
+
+    Block block1;
+    block1.header.number = 1;
+    block1.header.parent_hash = genesis_hash;
+    block1.header.difficulty = 5;
+    block1.ommers.push_back(genesis.header);
+    const evmc::bytes32 hash1{block1.header.hash()};
+    state.insert_block(block1, hash1);
+
+    CHECK(state.read_header(1, hash1) == block1.header);
+    CHECK(state.read_body(1, hash1)->ommers.size() == 1);
+    CHECK(state.total_difficulty(0, genesis_hash) == 10);
+    CHECK(state.total_difficulty(1, hash1) == 15);
+
+    // Wrong number
+    CHECK(!state.read_header(2, hash1));
+    CHECK(!state.read_body(0, hash1));
+    CHECK(!state.total_difficulty(0, hash1));
+
+    CHECK(state.current_canonical_block() == 0);
+    state.canonize_block(1, hash1);
+    CHECK(state.canonical_hash(1) == hash1);
+    state.decanonize_block(1);
+    CHECK(!state.canonical_hash(1));
+}
+
+}  // namespace silkworm
@@ -16,6 +16,8 @@
 
 #include "intra_block_state.hpp"
 
+#include <utility>
+
 #include <ethash/keccak.hpp>
 
 #include <silkworm/common/cast.hpp>
@@ -372,7 +374,7 @@ void IntraBlockState::clear_journal_and_substate() {
     accessed_storage_keys_.clear();
 }
 
-void IntraBlockState::add_log(const Log& log) noexcept { logs_.push_back(log); }
+void IntraBlockState::add_log(Log log) noexcept { logs_.push_back(std::move(log)); }
 
 void IntraBlockState::add_refund(uint64_t addend) noexcept { refund_ += addend; }
 
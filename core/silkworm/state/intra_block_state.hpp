@@ -105,7 +105,7 @@ class IntraBlockState {
     // See Section 6.1 "Substate" of the Yellow Paper
     void clear_journal_and_substate();
 
-    void add_log(const Log& log) noexcept;
+    void add_log(Log log) noexcept;
 
     const std::vector<Log>& logs() const noexcept { return logs_; }
 
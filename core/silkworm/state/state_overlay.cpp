@@ -0,0 +1,183 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_overlay.hpp"
+
+#include <cassert>
+
+namespace silkworm {
+
+void StateOverlay::merge(const StateOverlay& changes) {
+    for (const auto& [address, change] : changes.accounts_) {
+        auto [it, inserted]{accounts_.try_emplace(address, change)};
+        if (!inserted) {
+            it->second.current = change.current;
+        }
+    }
+    for (const auto& [address, incarnations] : changes.storage_) {
+        for (const auto& [incarnation, locations] : incarnations) {
+            auto& storage{storage_[address][incarnation]};
+            for (const auto& [location, change] : locations) {
+                auto [it, inserted]{storage.try_emplace(location, change)};
+                if (!inserted) {
+                    it->second.current = change.current;
+                }
+            }
+        }
+    }
+    for (const auto& [code_hash, code] : changes.code_) {
+        code_.try_emplace(code_hash, code);
+    }
+    code_changes_.insert(code_changes_.end(), changes.code_changes_.begin(), changes.code_changes_.end());
+    for (const auto& [address, incarnation] : changes.prev_incarnations_) {
+        prev_incarnations_[address] = incarnation;
+    }
+}
+
+void StateOverlay::revert(const StateOverlay& changes) {
+    for (const auto& [address, change] : changes.accounts_) {
+        accounts_.insert_or_assign(address, Change<std::optional<Account>>{change.initial, change.initial});
+    }
+    for (const auto& [address, incarnations] : changes.storage_) {
+        for (const auto& [incarnation, locations] : incarnations) {
+            auto& storage{storage_[address][incarnation]};
+            for (const auto& [location, change] : locations) {
+                storage.insert_or_assign(location, Change<evmc::bytes32>{change.initial, change.initial});
+            }
+        }
+    }
+    // Code is addressed by hash, so the parent's copy remains valid
+}
+
+void StateOverlay::write_to(State& state) const {
+    // Same order as IntraBlockState::write_to_db
+    state.begin_block(block_number_);
+    for (const auto& [address, incarnations] : storage_) {
+        for (const auto& [incarnation, locations] : incarnations) {
+            for (const auto& [location, change] : locations) {
+                state.update_storage(address, incarnation, location, change.initial, change.current);
+            }
+        }
+    }
+    for (const auto& [address, change] : accounts_) {
+        state.update_account(address, change.initial, change.current);
+    }
+    for (const CodeChange& x : code_changes_) {
+        state.update_account_code(x.address, x.incarnation, x.code_hash, code_.at(x.code_hash));
+    }
+}
+
+std::optional<Account> StateOverlay::read_account(const evmc::address& address) const noexcept {
+    if (auto it{accounts_.find(address)}; it != accounts_.end()) {
+        return it->second.current;
+    }
+    return parent_->read_account(address);
+}
+
+ByteView StateOverlay::read_code(const evmc::bytes32& code_hash) const noexcept {
+    if (auto it{code_.find(code_hash)}; it != code_.end()) {
+        return it->second;
+    }
+    return parent_->read_code(code_hash);
+}
+
+evmc::bytes32 StateOverlay::read_storage(const evmc::address& address, uint64_t incarnation,
+                                         const evmc::bytes32& location) const noexcept {
+    if (auto it1{storage_.find(address)}; it1 != storage_.end()) {
+        if (auto it2{it1->second.find(incarnation)}; it2 != it1->second.end()) {
+            if (auto it3{it2->second.find(location)}; it3 != it2->second.end()) {
+                return it3->second.current;
+            }
+        }
+    }
+    return parent_->read_storage(address, incarnation, location);
+}
+
+uint64_t StateOverlay::previous_incarnation(const evmc::address& address) const noexcept {
+    if (auto it{prev_incarnations_.find(address)}; it != prev_incarnations_.end()) {
+        return it->second;
+    }
+    return parent_->previous_incarnation(address);
+}
+
+std::optional<BlockHeader> StateOverlay::read_header(uint64_t block_number,
+                                                     const evmc::bytes32& block_hash) const noexcept {
+    return parent_->read_header(block_number, block_hash);
+}
+
+std::optional<BlockBody> StateOverlay::read_body(uint64_t block_number,
+                                                 const evmc::bytes32& block_hash) const noexcept {
+    return parent_->read_body(block_number, block_hash);
+}
+
+std::optional<intx::uint256> StateOverlay::total_difficulty(uint64_t block_number,
+                                                            const evmc::bytes32& block_hash) const noexcept {
+    return parent_->total_difficulty(block_number, block_hash);
+}
+
+evmc::bytes32 StateOverlay::state_root_hash() const {
+    assert(accounts_.empty() && storage_.empty());
+    return parent_->state_root_hash();
+}
+
+uint64_t StateOverlay::current_canonical_block() const { return parent_->current_canonical_block(); }
+
+std::optional<evmc::bytes32> StateOverlay::canonical_hash(uint64_t block_number) const {
+    return parent_->canonical_hash(block_number);
+}
+
+void StateOverlay::begin_block(uint64_t block_number) { block_number_ = block_number; }
+
+void StateOverlay::update_account(const evmc::address& address, std::optional<Account> initial,
+                                  std::optional<Account> current) {
+    auto [it, inserted]{accounts_.try_emplace(address, Change<std::optional<Account>>{initial, current})};
+    if (!inserted) {
+        it->second.current = current;
+    }
+    if (!current.has_value() && initial.has_value()) {
+        prev_incarnations_[address] = initial->incarnation;
+    }
+}
+
+void StateOverlay::update_account_code(const evmc::address& address, uint64_t incarnation,
+                                       const evmc::bytes32& code_hash, ByteView code) {
+    // Don't overwrite already existing code so that views of it
+    // that were previously returned by read_code() are still valid.
+    code_.try_emplace(code_hash, code);
+    code_changes_.push_back({address, incarnation, code_hash});
+}
+
+void StateOverlay::update_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
+                                  const evmc::bytes32& initial, const evmc::bytes32& current) {
+    auto& storage{storage_[address][incarnation]};
+    auto [it, inserted]{storage.try_emplace(location, Change<evmc::bytes32>{initial, current})};
+    if (!inserted) {
+        it->second.current = current;
+    }
+}
+
+void StateOverlay::unwind_state_changes(uint64_t block_number) {
+    if (block_number != block_number_) {
+        return;
+    }
+    accounts_.clear();
+    code_.clear();
+    code_changes_.clear();
+    prev_incarnations_.clear();
+    storage_.clear();
+}
+
+}  // namespace silkworm
@@ -0,0 +1,135 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_STATE_STATE_OVERLAY_HPP_
+#define SILKWORM_STATE_STATE_OVERLAY_HPP_
+
+#include <unordered_map>
+#include <vector>
+
+#include <silkworm/state/state.hpp>
+
+namespace silkworm {
+
+/// StateOverlay is a copy-on-write layer on top of a parent state.
+/// Reads fall through to the parent unless the overlay holds a newer value;
+/// state changes are kept in the overlay and only reach another state through write_to().
+/// Block & canonical chain data are not layered: they are read from the parent
+/// and the corresponding writers are no-ops.
+class StateOverlay : public State {
+  public:
+    explicit StateOverlay(const State& parent) : parent_{&parent} {}
+
+    /// Points the overlay to another parent, e.g. once the state it was built on has been discarded.
+    void rebase(const State& parent) noexcept { parent_ = &parent; }
+
+    /// Layers the changes recorded in another overlay on top of this one.
+    void merge(const StateOverlay& changes);
+
+    /// Layers the values prior to the changes recorded in another overlay on top of this one.
+    /// Reverting the overlays of blocks in descending order turns the overlay into a view of the state before them.
+    /// Previous incarnations are not reverted, which at worst gives recreated contracts a higher incarnation.
+    void revert(const StateOverlay& changes);
+
+    /// Replays the changes recorded in the overlay as a block of changes of the given state.
+    void write_to(State& state) const;
+
+    /// Block number of the changes recorded in the overlay.
+    uint64_t block_number() const noexcept { return block_number_; }
+
+    std::optional<Account> read_account(const evmc::address& address) const noexcept override;
+
+    ByteView read_code(const evmc::bytes32& code_hash) const noexcept override;
+
+    evmc::bytes32 read_storage(const evmc::address& address, uint64_t incarnation,
+                               const evmc::bytes32& location) const noexcept override;
+
+    uint64_t previous_incarnation(const evmc::address& address) const noexcept override;
+
+    std::optional<BlockHeader> read_header(uint64_t block_number,
+                                           const evmc::bytes32& block_hash) const noexcept override;
+
+    std::optional<BlockBody> read_body(uint64_t block_number, const evmc::bytes32& block_hash) const noexcept override;
+
+    std::optional<intx::uint256> total_difficulty(uint64_t block_number,
+                                                  const evmc::bytes32& block_hash) const noexcept override;
+
+    /// Overlays keep no tries, so the root is only available while the overlay holds no state changes;
+    /// otherwise write the overlay to a full state and compute the root there.
+    evmc::bytes32 state_root_hash() const override;
+
+    uint64_t current_canonical_block() const override;
+
+    std::optional<evmc::bytes32> canonical_hash(uint64_t block_number) const override;
+
+    void insert_block(const Block&, const evmc::bytes32&) override {}
+
+    void canonize_block(uint64_t, const evmc::bytes32&) override {}
+
+    void decanonize_block(uint64_t) override {}
+
+    void insert_receipts(uint64_t, const std::vector<Receipt>&) override {}
+
+    void begin_block(uint64_t block_number) override;
+
+    void update_account(const evmc::address& address, std::optional<Account> initial,
+                        std::optional<Account> current) override;
+
+    void update_account_code(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& code_hash,
+                             ByteView code) override;
+
+    void update_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
+                        const evmc::bytes32& initial, const evmc::bytes32& current) override;
+
+    /// Discards the changes recorded in the overlay if they belong to the given block.
+    void unwind_state_changes(uint64_t block_number) override;
+
+    size_t number_of_account_changes() const { return accounts_.size(); }
+
+  private:
+    template <class T>
+    struct Change {
+        T initial;
+        T current;
+    };
+
+    struct CodeChange {
+        evmc::address address;
+        uint64_t incarnation{0};
+        evmc::bytes32 code_hash;
+    };
+
+    const State* parent_;
+
+    uint64_t block_number_{0};
+
+    std::unordered_map<evmc::address, Change<std::optional<Account>>> accounts_;
+
+    // hash -> code
+    std::unordered_map<evmc::bytes32, Bytes> code_;
+    std::vector<CodeChange> code_changes_;
+
+    std::unordered_map<evmc::address, uint64_t> prev_incarnations_;
+
+    // address -> incarnation -> location -> value
+    std::unordered_map<evmc::address,
+                       std::unordered_map<uint64_t, std::unordered_map<evmc::bytes32, Change<evmc::bytes32>>>>
+        storage_;
+};
+
+}  // namespace silkworm
+
+#endif  // SILKWORM_STATE_STATE_OVERLAY_HPP_
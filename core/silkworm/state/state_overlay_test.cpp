@@ -0,0 +1,104 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_overlay.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/state/in_memory_state.hpp>
+
+namespace silkworm {
+
+TEST_CASE("StateOverlay") {
+    const auto a{0x0a00000000000000000000000000000000000000_address};
+    const auto b{0x0b00000000000000000000000000000000000000_address};
+    const auto location{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+    const auto one{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+    const auto two{0x0000000000000000000000000000000000000000000000000000000000000002_bytes32};
+    const Account a1{1, 100, kEmptyHash, 1};
+    const Account a2{2, 90, kEmptyHash, 1};
+
+    InMemoryState state;
+    state.begin_block(1);
+    state.update_account(a, std::nullopt, a1);
+    state.update_storage(a, 1, location, {}, one);
+    const evmc::bytes32 root1{state.state_root_hash()};
+
+    // Block 2 on top of block 1
+    StateOverlay block2{state};
+    block2.begin_block(2);
+    block2.update_account(a, a1, a2);
+    block2.update_account(b, std::nullopt, Account{0, 10});
+    block2.update_storage(a, 1, location, one, two);
+
+    SECTION("Changes stay in the overlay") {
+        CHECK(block2.read_account(a)->nonce == 2);
+        CHECK(block2.read_account(b)->balance == 10);
+        CHECK(block2.read_storage(a, 1, location) == two);
+        CHECK(block2.state_root_hash() == root1);  // unchanged parent
+
+        CHECK(state.read_account(a)->nonce == 1);
+        CHECK(!state.read_account(b));
+        CHECK(state.read_storage(a, 1, location) == one);
+        CHECK(state.state_root_hash() == root1);
+    }
+
+    SECTION("Write to the full state") {
+        block2.write_to(state);
+        CHECK(state.read_account(a)->nonce == 2);
+        CHECK(state.read_account(b)->balance == 10);
+        CHECK(state.read_storage(a, 1, location) == two);
+        CHECK(state.state_root_hash() != root1);
+
+        state.unwind_state_changes(2);
+        CHECK(state.read_account(a)->nonce == 1);
+        CHECK(!state.read_account(b));
+        CHECK(state.state_root_hash() == root1);
+    }
+
+    SECTION("Layered and reverted views") {
+        block2.write_to(state);
+        block2.rebase(state);
+
+        // Block 2' competing with block 2
+        StateOverlay ancestor{state};
+        ancestor.revert(block2);
+        CHECK(ancestor.read_account(a)->nonce == 1);
+        CHECK(!ancestor.read_account(b));
+        CHECK(ancestor.read_storage(a, 1, location) == one);
+
+        StateOverlay sibling{ancestor};
+        sibling.begin_block(2);
+        sibling.update_account(a, a1, std::nullopt);
+        CHECK(!sibling.read_account(a));
+        CHECK(sibling.previous_incarnation(a) == 1);
+        CHECK(state.previous_incarnation(a) == 0);
+
+        // Block 3' on top of block 2'
+        StateOverlay view{ancestor};
+        view.merge(sibling);
+        CHECK(!view.read_account(a));
+        CHECK(!view.read_account(b));
+        CHECK(view.previous_incarnation(a) == 1);
+
+        // Discarding the side chain leaves the canonical state intact
+        sibling.unwind_state_changes(2);
+        CHECK(sibling.read_account(a)->nonce == 1);
+        CHECK(state.read_account(a)->nonce == 2);
+    }
+}
+
+}  // namespace silkworm
@@ -24,6 +24,7 @@
 #include <ethash/keccak.hpp>
 
 #include <silkworm/common/cast.hpp>
+#include <silkworm/common/trace_span.hpp>
 #include <silkworm/common/util.hpp>
 #include <silkworm/rlp/encode.hpp>
 
@@ -82,24 +83,26 @@ static Bytes encode_path(ByteView path, bool terminating) {
     return res;
 }
 
-static Bytes leaf_node_rlp(ByteView path, ByteView value) {
+Bytes leaf_node_rlp(ByteView path, ByteView value) {
     Bytes encoded_path{encode_path(path, /*terminating=*/true)};
     Bytes rlp;
     rlp::Header h;
     h.list = true;
     h.payload_length = rlp::length(encoded_path) + rlp::length(value);
+    rlp.reserve(rlp::length_of_length(h.payload_length) + h.payload_length);
     rlp::encode_header(rlp, h);
     rlp::encode(rlp, encoded_path);
     rlp::encode(rlp, value);
     return rlp;
 }
 
-static Bytes extension_node_rlp(ByteView path, ByteView child_ref) {
+Bytes extension_node_rlp(ByteView path, ByteView child_ref) {
     Bytes encoded_path{encode_path(path, /*terminating=*/false)};
     Bytes rlp;
     rlp::Header h;
     h.list = true;
     h.payload_length = rlp::length(encoded_path) + child_ref.length();
+    rlp.reserve(rlp::length_of_length(h.payload_length) + h.payload_length);
     rlp::encode_header(rlp, h);
     rlp::encode(rlp, encoded_path);
     rlp.append(child_ref);
@@ -113,7 +116,7 @@ static Bytes wrap_hash(gsl::span<const uint8_t, kHashLength> hash) {
     return wrapped;
 }
 
-static Bytes node_ref(ByteView rlp) {
+Bytes node_ref(ByteView rlp) {
     if (rlp.length() < kHashLength) {
         return Bytes{rlp};
     }
@@ -171,6 +174,7 @@ evmc::bytes32 HashBuilder::root_hash(bool auto_finalize) {
 
 // https://github.com/ledgerwatch/erigon/blob/devel/docs/programmers_guide/guide.md#generating-the-structural-information-from-the-sequence-of-keys
 void HashBuilder::gen_struct_step(ByteView current, const ByteView succeeding) {
+    SILKWORM_TRACE_SPAN("HashBuilder::gen_struct_step");
     for (bool build_extensions{false};; build_extensions = true) {
         const bool preceding_exists{!groups_.empty()};
 
@@ -308,6 +312,7 @@ std::vector<Bytes> HashBuilder::branch_ref(uint16_t state_mask, uint16_t hash_ma
     }
 
     Bytes rlp{};
+    rlp.reserve(rlp::length_of_length(h.payload_length) + h.payload_length);
     rlp::encode_header(rlp, h);
 
     for (size_t i{first_child_idx}, digit{0}; digit < 16; ++digit) {
@@ -84,6 +84,15 @@ Bytes pack_nibbles(ByteView nibbles);
 // Erigon DecompressNibbles
 Bytes unpack_nibbles(ByteView packed);
 
+// RLP of a leaf node; path is unpacked and value is the (already encoded) leaf value
+Bytes leaf_node_rlp(ByteView path, ByteView value);
+
+// RLP of an extension node; path is unpacked and child_ref is as returned by node_ref
+Bytes extension_node_rlp(ByteView path, ByteView child_ref);
+
+// Reference to a node from its parent : the node RLP itself if shorter than 32 bytes, the RLP of its hash otherwise
+Bytes node_ref(ByteView rlp);
+
 }  // namespace silkworm::trie
 
 #endif  // SILKWORM_TRIE_HASH_BUILDER_HPP_
@@ -0,0 +1,254 @@
+/*
+   Copyright 2020-2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "in_memory_trie.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+#include <ethash/keccak.hpp>
+
+#include <silkworm/common/cast.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/rlp/encode.hpp>
+#include <silkworm/trie/hash_builder.hpp>
+
+namespace silkworm::trie {
+
+struct InMemoryTrie::Node {
+    enum class Type : uint8_t { kLeaf, kExtension, kBranch };
+
+    explicit Node(Type t) : type{t} {}
+
+    Type type;
+    Bytes path;   // unpacked; rest of the key for leaves, shared nibbles for extensions
+    Bytes value;  // leaves only
+    std::vector<std::unique_ptr<Node>> children;  // 16 for branches, 1 for extensions
+    Bytes ref;    // cached reference; empty if the node has been modified since computed
+};
+
+namespace {
+
+    using Node = InMemoryTrie::Node;
+    using NodePtr = std::unique_ptr<Node>;
+
+    size_t common_prefix_length(ByteView a, ByteView b) {
+        size_t n{0};
+        while (n < a.length() && n < b.length() && a[n] == b[n]) {
+            ++n;
+        }
+        return n;
+    }
+
+    NodePtr make_leaf(ByteView path, ByteView value) {
+        auto node{std::make_unique<Node>(Node::Type::kLeaf)};
+        node->path = path;
+        node->value = value;
+        return node;
+    }
+
+    NodePtr make_extension(ByteView path, NodePtr child) {
+        auto node{std::make_unique<Node>(Node::Type::kExtension)};
+        node->path = path;
+        node->children.push_back(std::move(child));
+        return node;
+    }
+
+    NodePtr make_branch() {
+        auto node{std::make_unique<Node>(Node::Type::kBranch)};
+        node->children.resize(16);
+        return node;
+    }
+
+    // Replaces slot, whose key diverges from path at nibble n, with a branch at n holding both
+    void split(NodePtr& slot, size_t n, ByteView path, ByteView value) {
+        NodePtr existing{std::move(slot)};
+        NodePtr branch{make_branch()};
+        const uint8_t existing_nibble{existing->path[n]};
+        if (existing->type == Node::Type::kExtension && existing->path.length() == n + 1) {
+            branch->children[existing_nibble] = std::move(existing->children[0]);
+        } else {
+            existing->path.erase(0, n + 1);
+            existing->ref.clear();
+            branch->children[existing_nibble] = std::move(existing);
+        }
+        branch->children[path[n]] = make_leaf(path.substr(n + 1), value);
+        slot = n ? make_extension(path.substr(0, n), std::move(branch)) : std::move(branch);
+    }
+
+    // Returns whether a new key was added
+    bool insert(NodePtr& slot, ByteView path, ByteView value) {
+        if (!slot) {
+            slot = make_leaf(path, value);
+            return true;
+        }
+        Node& node{*slot};
+        node.ref.clear();
+        switch (node.type) {
+            case Node::Type::kLeaf:
+                if (node.path == path) {
+                    node.value = value;
+                    return false;
+                }
+                split(slot, common_prefix_length(node.path, path), path, value);
+                return true;
+            case Node::Type::kExtension:
+                if (const size_t n{common_prefix_length(node.path, path)}; n < node.path.length()) {
+                    split(slot, n, path, value);
+                    return true;
+                }
+                return insert(node.children[0], path.substr(node.path.length()), value);
+            case Node::Type::kBranch:
+                return insert(node.children[path[0]], path.substr(1), value);
+        }
+        return false;
+    }
+
+    // Prepends prefix to the path of a leaf or extension node
+    NodePtr prepend(ByteView prefix, NodePtr node) {
+        node->path.insert(0, prefix.data(), prefix.length());
+        node->ref.clear();
+        return node;
+    }
+
+    // Returns whether the key was found
+    bool remove(NodePtr& slot, ByteView path) {
+        if (!slot) {
+            return false;
+        }
+        Node& node{*slot};
+        switch (node.type) {
+            case Node::Type::kLeaf:
+                if (node.path != path) {
+                    return false;
+                }
+                slot.reset();
+                return true;
+            case Node::Type::kExtension: {
+                if (path.substr(0, node.path.length()) != node.path ||
+                    !remove(node.children[0], path.substr(node.path.length()))) {
+                    return false;
+                }
+                node.ref.clear();
+                assert(node.children[0]);
+                // The child branch may have collapsed into a leaf or an extension : merge with it
+                if (node.children[0]->type != Node::Type::kBranch) {
+                    slot = prepend(node.path, std::move(node.children[0]));
+                }
+                return true;
+            }
+            case Node::Type::kBranch: {
+                if (!remove(node.children[path[0]], path.substr(1))) {
+                    return false;
+                }
+                node.ref.clear();
+                // A branch left with a single child collapses
+                size_t count{0}, last{0};
+                for (size_t i{0}; i < 16; ++i) {
+                    if (node.children[i]) {
+                        ++count;
+                        last = i;
+                    }
+                }
+                assert(count > 0);
+                if (count == 1) {
+                    const uint8_t nibble{static_cast<uint8_t>(last)};
+                    NodePtr child{std::move(node.children[last])};
+                    if (child->type == Node::Type::kBranch) {
+                        slot = make_extension(ByteView{&nibble, 1}, std::move(child));
+                    } else {
+                        slot = prepend(ByteView{&nibble, 1}, std::move(child));
+                    }
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const Bytes& reference(Node& node) {
+        if (!node.ref.empty()) {
+            return node.ref;
+        }
+        switch (node.type) {
+            case Node::Type::kLeaf:
+                node.ref = node_ref(leaf_node_rlp(node.path, node.value));
+                break;
+            case Node::Type::kExtension:
+                node.ref = node_ref(extension_node_rlp(node.path, reference(*node.children[0])));
+                break;
+            case Node::Type::kBranch: {
+                rlp::Header h;
+                h.list = true;
+                h.payload_length = 1;  // for the nil value
+                for (const auto& child : node.children) {
+                    h.payload_length += child ? reference(*child).length() : 1;
+                }
+                Bytes rlp;
+                rlp.reserve(rlp::length_of_length(h.payload_length) + h.payload_length);
+                rlp::encode_header(rlp, h);
+                for (const auto& child : node.children) {
+                    if (child) {
+                        rlp.append(child->ref);
+                    } else {
+                        rlp.push_back(rlp::kEmptyStringCode);
+                    }
+                }
+                rlp.push_back(rlp::kEmptyStringCode);
+                node.ref = node_ref(rlp);
+                break;
+            }
+        }
+        return node.ref;
+    }
+
+}  // namespace
+
+InMemoryTrie::InMemoryTrie() = default;
+InMemoryTrie::~InMemoryTrie() = default;
+InMemoryTrie::InMemoryTrie(InMemoryTrie&&) noexcept = default;
+InMemoryTrie& InMemoryTrie::operator=(InMemoryTrie&&) noexcept = default;
+
+void InMemoryTrie::upsert(ByteView key, ByteView value) {
+    if (insert(root_, unpack_nibbles(key), value)) {
+        ++size_;
+    }
+}
+
+bool InMemoryTrie::erase(ByteView key) {
+    if (!remove(root_, unpack_nibbles(key))) {
+        return false;
+    }
+    --size_;
+    return true;
+}
+
+evmc::bytes32 InMemoryTrie::root_hash() {
+    if (!root_) {
+        return kEmptyRoot;
+    }
+    const Bytes& ref{reference(*root_)};
+    evmc::bytes32 res{};
+    if (ref.length() == kHashLength + 1) {
+        std::memcpy(res.bytes, &ref[1], kHashLength);
+    } else {
+        res = bit_cast<evmc_bytes32>(keccak256(ref));
+    }
+    return res;
+}
+
+}  // namespace silkworm::trie
@@ -0,0 +1,63 @@
+/*
+   Copyright 2020-2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_TRIE_IN_MEMORY_TRIE_HPP_
+#define SILKWORM_TRIE_IN_MEMORY_TRIE_HPP_
+
+#include <memory>
+
+#include <silkworm/common/base.hpp>
+
+namespace silkworm::trie {
+
+// Modified Merkle Patricia Trie held in memory and updated in place, as opposed to HashBuilder which builds it anew
+// from sorted leaves. Every node caches its reference (RLP or hash thereof); an update only invalidates the caches
+// along the path of its key, hence root_hash() re-hashes modified paths only and is cheap between small change sets.
+//
+// All keys must have the same length, e.g. hashed addresses or hashed storage locations, so that no key is a prefix
+// of another and branch nodes never hold values.
+class InMemoryTrie {
+  public:
+    InMemoryTrie();
+    ~InMemoryTrie();
+
+    InMemoryTrie(InMemoryTrie&&) noexcept;
+    InMemoryTrie& operator=(InMemoryTrie&&) noexcept;
+
+    InMemoryTrie(const InMemoryTrie&) = delete;
+    InMemoryTrie& operator=(const InMemoryTrie&) = delete;
+
+    // Inserts the value (already RLP encoded, as for HashBuilder::add_leaf) or replaces the current one
+    void upsert(ByteView key, ByteView value);
+
+    // Returns whether the key was present
+    bool erase(ByteView key);
+
+    [[nodiscard]] bool empty() const noexcept { return root_ == nullptr; }
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+
+    evmc::bytes32 root_hash();
+
+    struct Node;  // opaque, see in_memory_trie.cpp
+
+  private:
+    std::unique_ptr<Node> root_;
+    size_t size_{0};
+};
+
+}  // namespace silkworm::trie
+
+#endif  // SILKWORM_TRIE_IN_MEMORY_TRIE_HPP_
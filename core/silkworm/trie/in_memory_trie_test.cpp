@@ -0,0 +1,76 @@
+/*
+   Copyright 2020-2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "in_memory_trie.hpp"
+
+#include <map>
+#include <random>
+
+#include <catch2/catch.hpp>
+#include <ethash/keccak.hpp>
+
+#include <silkworm/common/util.hpp>
+#include <silkworm/trie/hash_builder.hpp>
+
+namespace silkworm::trie {
+
+static evmc::bytes32 hash_builder_root(const std::map<evmc::bytes32, Bytes>& leaves) {
+    HashBuilder hb;
+    for (const auto& [key, value] : leaves) {
+        hb.add_leaf(unpack_nibbles(full_view(key)), value);
+    }
+    return hb.root_hash();
+}
+
+TEST_CASE("InMemoryTrie") {
+    InMemoryTrie trie;
+    CHECK(trie.empty());
+    CHECK(trie.root_hash() == kEmptyRoot);
+
+    SECTION("Single leaf") {
+        const auto key{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+        trie.upsert(full_view(key), *from_hex("01"));
+        CHECK(trie.size() == 1);
+        CHECK(trie.root_hash() == hash_builder_root({{key, *from_hex("01")}}));
+        CHECK(trie.erase(full_view(key)));
+        CHECK_FALSE(trie.erase(full_view(key)));
+        CHECK(trie.root_hash() == kEmptyRoot);
+    }
+
+    SECTION("Same roots as HashBuilder through random updates") {
+        std::mt19937_64 rng{1};
+        std::map<evmc::bytes32, Bytes> leaves;
+        for (uint64_t round{0}; round < 20; ++round) {
+            for (uint64_t i{0}; i < 100; ++i) {
+                // Hashed keys out of a small pool, so that some are updated and deleted
+                const uint64_t n{rng() % 500};
+                const ethash::hash256 hash{keccak256(ByteView{reinterpret_cast<const uint8_t*>(&n), sizeof(n)})};
+                const auto key{to_bytes32(full_view(hash.bytes))};
+                if (rng() % 4 == 0) {
+                    CHECK(trie.erase(full_view(key)) == (leaves.erase(key) == 1));
+                } else {
+                    Bytes value(1 + rng() % 40, static_cast<uint8_t>(rng()));
+                    trie.upsert(full_view(key), value);
+                    leaves[key] = value;
+                }
+            }
+            CHECK(trie.size() == leaves.size());
+            CHECK(to_hex(trie.root_hash()) == to_hex(hash_builder_root(leaves)));
+        }
+    }
+}
+
+}  // namespace silkworm::trie
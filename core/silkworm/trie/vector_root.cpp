@@ -0,0 +1,176 @@
+/*
+   Copyright 2020-2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "vector_root.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+
+#include <silkworm/common/util.hpp>
+
+namespace silkworm::trie {
+
+namespace {
+
+    // RLP-encoded index; the longest one of a size_t takes 1 + 8 bytes
+    struct Key {
+        std::array<uint8_t, 9> bytes{};
+        uint8_t length{0};
+
+        explicit Key(size_t index) noexcept {
+            if (index == 0) {
+                bytes[0] = rlp::kEmptyStringCode;
+                length = 1;
+            } else if (index < rlp::kEmptyStringCode) {
+                bytes[0] = static_cast<uint8_t>(index);
+                length = 1;
+            } else {
+                uint8_t n{0};
+                for (size_t i{index}; i; i >>= 8) {
+                    ++n;
+                }
+                bytes[0] = rlp::kEmptyStringCode + n;
+                for (uint8_t i{n}; i; --i, index >>= 8) {
+                    bytes[i] = static_cast<uint8_t>(index);
+                }
+                length = n + 1;
+            }
+        }
+
+        size_t nibbles() const noexcept { return 2u * length; }
+
+        uint8_t nibble(size_t i) const noexcept {
+            return i % 2 ? bytes[i / 2] & 0x0f : static_cast<uint8_t>(bytes[i / 2] >> 4);
+        }
+    };
+
+    // Byte headroom in node buffers for the RLP list header, written once the payload length is known
+    constexpr size_t kHeaderRoom{9};
+
+    class OrderedTrie {
+      public:
+        OrderedTrie(ByteView values, const std::vector<size_t>& value_ends) : values_{values}, value_ends_{value_ends} {
+            const size_t n{value_ends.size()};
+            keys_.reserve(n);
+            size_t max_nibbles{0};
+            for (size_t j{0}; j < n; ++j) {
+                max_nibbles = std::max(max_nibbles, keys_.emplace_back(adjust_index_for_rlp(j, n)).nibbles());
+            }
+            // Every node but leaves consumes at least a nibble
+            buffers_.resize(max_nibbles + 1);
+        }
+
+        evmc::bytes32 root_hash() {
+            const ethash::hash256 hash{keccak256(encode_node(0, keys_.size(), 0, 0))};
+            return to_bytes32(hash.bytes);
+        }
+
+      private:
+        ByteView value(size_t j) const noexcept {
+            const size_t begin{j ? value_ends_[j - 1] : 0};
+            return values_.substr(begin, value_ends_[j] - begin);
+        }
+
+        // Hex prefix encoding (Appendix C of the Yellow Paper) of nibbles [from, to) of key
+        static void encode_path(Bytes& to, const Key& key, size_t from, size_t to_nibble, bool leaf) {
+            std::array<uint8_t, 10> path{};
+            const size_t odd{(to_nibble - from) % 2};
+            path[0] = static_cast<uint8_t>(((leaf ? 2u : 0u) + odd) << 4);
+            if (odd) {
+                path[0] |= key.nibble(from++);
+            }
+            size_t length{1};
+            for (; from < to_nibble; from += 2) {
+                path[length++] = static_cast<uint8_t>(key.nibble(from) << 4 | key.nibble(from + 1));
+            }
+            rlp::encode(to, ByteView{path.data(), length});
+        }
+
+        // Appends to payload the reference of the node of keys [begin, end) from nibble depth on
+        void append_ref(Bytes& payload, size_t begin, size_t end, size_t depth, size_t level) {
+            const ByteView node{encode_node(begin, end, depth, level)};
+            if (node.length() < kHashLength) {
+                payload.append(node);
+            } else {
+                const ethash::hash256 hash{keccak256(node)};
+                payload.push_back(rlp::kEmptyStringCode + kHashLength);
+                payload.append(hash.bytes, kHashLength);
+            }
+        }
+
+        // RLP of the node of keys [begin, end) from nibble depth on, valid until the next call at the same level
+        ByteView encode_node(size_t begin, size_t end, size_t depth, size_t level) {
+            Bytes& buffer{buffers_[level]};
+            buffer.assign(kHeaderRoom, '\0');
+
+            const Key& first{keys_[begin]};
+            if (end - begin == 1) {
+                encode_path(buffer, first, depth, first.nibbles(), /*leaf=*/true);
+                rlp::encode(buffer, value(begin));
+            } else {
+                // Keys are sorted, hence the common prefix of the range is that of its first and last keys
+                const Key& last{keys_[end - 1]};
+                size_t prefix_end{depth};
+                while (first.nibble(prefix_end) == last.nibble(prefix_end)) {
+                    ++prefix_end;  // RLP-encoded integers being prefix-free, distinct keys differ before either ends
+                }
+                if (prefix_end > depth) {
+                    encode_path(buffer, first, depth, prefix_end, /*leaf=*/false);
+                    append_ref(buffer, begin, end, prefix_end, level + 1);
+                } else {
+                    for (uint8_t nibble{0}; nibble < 16; ++nibble) {
+                        size_t child_end{begin};
+                        while (child_end < end && keys_[child_end].nibble(depth) == nibble) {
+                            ++child_end;
+                        }
+                        if (child_end == begin) {
+                            buffer.push_back(rlp::kEmptyStringCode);
+                        } else {
+                            append_ref(buffer, begin, child_end, depth + 1, level + 1);
+                            begin = child_end;
+                        }
+                    }
+                    buffer.push_back(rlp::kEmptyStringCode);  // no value in branches, keys being prefix-free
+                }
+            }
+
+            header_.clear();
+            rlp::encode_header(header_, {/*list=*/true, buffer.length() - kHeaderRoom});
+            assert(header_.length() <= kHeaderRoom);
+            const size_t node_begin{kHeaderRoom - header_.length()};
+            std::memcpy(&buffer[node_begin], header_.data(), header_.length());
+            return ByteView{buffer}.substr(node_begin);
+        }
+
+        ByteView values_;
+        const std::vector<size_t>& value_ends_;
+        std::vector<Key> keys_;
+        std::vector<Bytes> buffers_;  // node encodings by recursion level
+        Bytes header_;
+    };
+
+}  // namespace
+
+evmc::bytes32 ordered_root_hash(ByteView values, const std::vector<size_t>& value_ends) {
+    if (value_ends.empty()) {
+        return kEmptyRoot;
+    }
+    return OrderedTrie{values, value_ends}.root_hash();
+}
+
+}  // namespace silkworm::trie
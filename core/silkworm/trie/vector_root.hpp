@@ -17,6 +17,8 @@
 #ifndef SILKWORM_TRIE_VECTOR_ROOT_HPP_
 #define SILKWORM_TRIE_VECTOR_ROOT_HPP_
 
+#include <vector>
+
 #include <silkworm/rlp/encode.hpp>
 #include <silkworm/trie/hash_builder.hpp>
 
@@ -34,26 +36,23 @@ inline size_t adjust_index_for_rlp(size_t i, size_t len) {
     }
 }
 
+// Trie root hash of an ordered trie, i.e. one keyed by the RLP-encoded indices 0, 1, ..., n - 1, built straight from
+// values, the concatenation of the n values in key order (see adjust_index_for_rlp), value_ends[j] being the end of the
+// j-th one. Keys are walked nibble by nibble in place and nodes encoded into reused buffers, with no HashBuilder.
+evmc::bytes32 ordered_root_hash(ByteView values, const std::vector<size_t>& value_ends);
+
 // Trie root hash of RLP-encoded values, the keys are RLP-encoded integers.
 // See Section 4.3.2. "Holistic Validity" of the Yellow Paper.
 template <class Value, typename Encoder>
 evmc::bytes32 root_hash(const std::vector<Value>& v, Encoder value_encoder) {
-    Bytes index_rlp;
-    Bytes value_rlp;
-
-    HashBuilder hb;
-
+    Bytes values;
+    std::vector<size_t> value_ends;
+    value_ends.reserve(v.size());
     for (size_t j{0}; j < v.size(); ++j) {
-        const size_t index{adjust_index_for_rlp(j, v.size())};
-        index_rlp.clear();
-        rlp::encode(index_rlp, index);
-        value_rlp.clear();
-        value_encoder(value_rlp, v[index]);
-
-        hb.add_leaf(unpack_nibbles(index_rlp), value_rlp);
+        value_encoder(values, v[adjust_index_for_rlp(j, v.size())]);
+        value_ends.push_back(values.length());
     }
-
-    return hb.root_hash();
+    return ordered_root_hash(values, value_ends);
 }
 
 }  // namespace silkworm::trie
@@ -53,4 +53,28 @@ TEST_CASE("Hardcoded root hash") {
     CHECK(to_hex(root_hash(receipts, kEncoder)) == "7ea023138ee7d80db04eeec9cf436dc35806b00cc5fe8e5f611fb7cf1b35b177");
 }
 
+TEST_CASE("Ordered root hash matches HashBuilder") {
+    const auto reference{[](const std::vector<Bytes>& values) {
+        HashBuilder hb;
+        Bytes index_rlp;
+        for (size_t j{0}; j < values.size(); ++j) {
+            const size_t index{adjust_index_for_rlp(j, values.size())};
+            index_rlp.clear();
+            rlp::encode(index_rlp, index);
+            hb.add_leaf(unpack_nibbles(index_rlp), values[index]);
+        }
+        return hb.root_hash();
+    }};
+    static constexpr auto kEncoder = [](Bytes& to, const Bytes& value) { to.append(value); };
+
+    // Around branching on the 1st & 2nd byte of keys, with values both embedded in & hashed out of their parents
+    for (size_t n : {1, 2, 3, 16, 17, 127, 128, 129, 255, 256, 257, 1'000}) {
+        std::vector<Bytes> values;
+        for (size_t i{0}; i < n; ++i) {
+            values.emplace_back(i % 70, static_cast<uint8_t>(i));
+        }
+        CHECK(root_hash(values, kEncoder) == reference(values));
+    }
+}
+
 }  // namespace silkworm::trie
@@ -21,11 +21,26 @@
 namespace silkworm {
 
 evmc::bytes32 BlockHeader::hash(bool for_sealing) const {
+    const std::optional<evmc::bytes32>& cached{for_sealing ? cached_seal_hash_ : cached_hash_};
+    if (cached.has_value()) {
+        return *cached;
+    }
     Bytes rlp;
     rlp::encode(rlp, *this, for_sealing);
     return bit_cast<evmc_bytes32>(keccak256(rlp));
 }
 
+void BlockHeader::cache_hashes() {
+    reset_hash_cache();
+    cached_hash_ = hash(/*for_sealing=*/false);
+    cached_seal_hash_ = hash(/*for_sealing=*/true);
+}
+
+void BlockHeader::reset_hash_cache() noexcept {
+    cached_hash_.reset();
+    cached_seal_hash_.reset();
+}
+
 ethash::hash256 BlockHeader::boundary() const {
     using intx::operator""_u256;
     static const auto dividend{intx::uint320{1} << 256};
@@ -87,7 +102,9 @@ namespace rlp {
     }
 
     void encode(Bytes& to, const BlockHeader& header, bool for_sealing) {
-        encode_header(to, rlp_header(header, for_sealing));
+        const Header rlp_head{rlp_header(header, for_sealing)};
+        reserve_additional(to, length_of_length(rlp_head.payload_length) + rlp_head.payload_length);
+        encode_header(to, rlp_head);
         encode(to, header.parent_hash.bytes);
         encode(to, header.ommers_hash.bytes);
         encode(to, header.beneficiary.bytes);
@@ -112,6 +129,8 @@ namespace rlp {
 
     template <>
     DecodingResult decode(ByteView& from, BlockHeader& to) noexcept {
+        to.reset_hash_cache();
+
         auto [rlp_head, err1]{decode_header(from)};
         if (err1 != DecodingResult::kOk) {
             return err1;
@@ -191,6 +210,7 @@ namespace rlp {
         Header rlp_head{true, 0};
         rlp_head.payload_length += length(block_body.transactions);
         rlp_head.payload_length += length(block_body.ommers);
+        reserve_additional(to, length_of_length(rlp_head.payload_length) + rlp_head.payload_length);
         encode_header(to, rlp_head);
         encode(to, block_body.transactions);
         encode(to, block_body.ommers);
@@ -255,6 +275,7 @@ namespace rlp {
         rlp_head.payload_length += length(block.header);
         rlp_head.payload_length += length(block.transactions);
         rlp_head.payload_length += length(block.ommers);
+        reserve_additional(to, length_of_length(rlp_head.payload_length) + rlp_head.payload_length);
         encode_header(to, rlp_head);
         encode(to, block.header);
         encode(to, block.transactions);
@@ -54,14 +54,25 @@ struct BlockHeader {
 
     std::optional<intx::uint256> base_fee_per_gas{std::nullopt};  // EIP-1559
 
+    //! \brief Returns Keccak-256 of the header RLP (of the RLP without mix_hash and nonce if for_sealing is set)
+    //! \remarks Served from cache when hashes have been pinned with cache_hashes()
     evmc::bytes32 hash(bool for_sealing = false) const;
 
+    //! \brief Pins both hashes so that subsequent calls of hash() don't re-encode the header
+    //! \warning Any further modification of the header must be followed by reset_hash_cache()
+    void cache_hashes();
+
+    void reset_hash_cache() noexcept;
+
     //! \brief Calculates header's boundary. This is described by Equation(50) by the yellow paper.
     //! \return A hash of 256 bits with big endian byte order
     ethash::hash256 boundary() const;
 
   private:
     friend rlp::DecodingResult rlp::decode<BlockHeader>(ByteView& from, BlockHeader& to) noexcept;
+
+    std::optional<evmc::bytes32> cached_hash_{std::nullopt};
+    std::optional<evmc::bytes32> cached_seal_hash_{std::nullopt};
 };
 
 bool operator==(const BlockHeader& a, const BlockHeader& b);
@@ -187,6 +187,34 @@ TEST_CASE("EIP-1559 Header RLP") {
     CHECK(decoded == h);
 }
 
+TEST_CASE("Header hash cache") {
+    BlockHeader h;
+    h.number = 13'500'000;
+    h.extra_data = Bytes(100, 0xab);  // long enough for a multi-byte payload length
+    h.nonce[7] = 0x42;
+
+    const evmc::bytes32 hash{h.hash()};
+    const evmc::bytes32 seal_hash{h.hash(/*for_sealing=*/true)};
+    CHECK(hash != seal_hash);
+
+    h.cache_hashes();
+    CHECK(h.hash() == hash);
+    CHECK(h.hash(/*for_sealing=*/true) == seal_hash);
+
+    BlockHeader copy{h};
+    CHECK(copy == h);
+    copy.number = 13'500'001;
+    CHECK(copy.hash() == hash);  // stale until reset
+    copy.reset_hash_cache();
+    CHECK(copy.hash() != hash);
+
+    Bytes rlp;
+    rlp::encode(rlp, copy);
+    ByteView view{rlp};
+    REQUIRE(rlp::decode(view, h) == rlp::DecodingResult::kOk);
+    CHECK(h.hash() == copy.hash());
+}
+
 TEST_CASE("Hash header boundary computation") {
     BlockHeader h;
     h.difficulty = 0x13009de5666753258eb9306157680dc5da0d_u256;
@@ -23,14 +23,23 @@
 namespace silkworm {
 
 // See Section 4.3.1 "Transaction Receipt" of the Yellow Paper
-static void m3_2048(Bloom& bloom, ByteView x) {
+static std::array<uint16_t, 3> m3_2048_bits(ByteView x) {
     ethash::hash256 hash{keccak256(x)};
+    std::array<uint16_t, 3> bits{};
     for (unsigned i{0}; i < 6; i += 2) {
-        unsigned bit{static_cast<unsigned>(hash.bytes[i + 1] + (hash.bytes[i] << 8)) & 0x7FFu};
-        bloom[kBloomByteLength - 1 - bit / 8] |= 1 << (bit % 8);
+        bits[i / 2] = static_cast<uint16_t>((hash.bytes[i + 1] + (hash.bytes[i] << 8)) & 0x7FF);
     }
+    return bits;
 }
 
+static void set_bits(Bloom& bloom, const std::array<uint16_t, 3>& bits) {
+    for (const uint16_t bit : bits) {
+        bloom[kBloomByteLength - 1 - bit / 8u] |= static_cast<uint8_t>(1u << (bit % 8u));
+    }
+}
+
+static void m3_2048(Bloom& bloom, ByteView x) { set_bits(bloom, m3_2048_bits(x)); }
+
 Bloom logs_bloom(const std::vector<Log>& logs) {
     Bloom bloom{};  // zero initialization
     for (const Log& log : logs) {
@@ -41,4 +50,24 @@ Bloom logs_bloom(const std::vector<Log>& logs) {
     }
     return bloom;
 }
+
+Bloom BloomBuilder::logs_bloom(const std::vector<Log>& logs) {
+    Bloom bloom{};  // zero initialization
+    for (const Log& log : logs) {
+        auto [address_it, new_address]{addresses_.try_emplace(log.address)};
+        if (new_address) {
+            address_it->second = m3_2048_bits(full_view(log.address));
+        }
+        set_bits(bloom, address_it->second);
+        for (const auto& topic : log.topics) {
+            auto [topic_it, new_topic]{topics_.try_emplace(topic)};
+            if (new_topic) {
+                topic_it->second = m3_2048_bits(full_view(topic));
+            }
+            set_bits(bloom, topic_it->second);
+        }
+    }
+    return bloom;
+}
+
 }  // namespace silkworm
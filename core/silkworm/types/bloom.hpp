@@ -22,6 +22,7 @@
 #include <cstdint>
 #include <vector>
 
+#include <silkworm/common/hash_maps.hpp>
 #include <silkworm/types/log.hpp>
 
 namespace silkworm {
@@ -34,6 +35,25 @@ inline ByteView full_view(const Bloom& bloom) { return {bloom.data(), kBloomByte
 
 Bloom logs_bloom(const std::vector<Log>& logs);
 
+// Builds the logs blooms of a batch of logs, such as those of a block, hashing every distinct address & topic only
+// once: contracts and event signatures recur throughout a block (e.g. ERC-20 Transfer), so most are cache hits.
+class BloomBuilder {
+  public:
+    Bloom logs_bloom(const std::vector<Log>& logs);
+
+    void clear() noexcept {
+        addresses_.clear();
+        topics_.clear();
+    }
+
+  private:
+    // Positions of the 3 bits set by an address or topic
+    using BloomBits = std::array<uint16_t, 3>;
+
+    FlatHashMap<evmc::address, BloomBits> addresses_;
+    FlatHashMap<evmc::bytes32, BloomBits> topics_;
+};
+
 inline void join(Bloom& sum, const Bloom& addend) {
     for (size_t i{0}; i < kBloomByteLength; ++i) {
         sum[i] |= addend[i];
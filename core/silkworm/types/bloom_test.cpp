@@ -44,5 +44,12 @@ TEST_CASE("Hardcoded Bloom") {
           "000000000000000000000000000000000000000000000000000000280000000000400000800000004000000000"
           "000000000000000000000000000000000000000000000000000000000000100000100000000000000000000000"
           "00000000001400000000000000008000000000000000000000000000000000");
+
+    // Cached hashes give the same blooms, be they first seen or not
+    BloomBuilder builder;
+    CHECK(builder.logs_bloom(logs) == bloom);
+    CHECK(builder.logs_bloom(logs) == bloom);
+    CHECK(builder.logs_bloom({logs[1]}) == logs_bloom({logs[1]}));
+    CHECK(builder.logs_bloom({}) == Bloom{});
 }
 }  // namespace silkworm
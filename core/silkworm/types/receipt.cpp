@@ -32,10 +32,13 @@ static Header header(const Receipt& r) {
 }
 
 void encode(Bytes& to, const Receipt& r) {
+    const Header h{header(r)};
+    reserve_additional(to, (r.type != Transaction::Type::kLegacy ? 1 : 0) + length_of_length(h.payload_length) +
+                               h.payload_length);
     if (r.type != Transaction::Type::kLegacy) {
         to.push_back(static_cast<uint8_t>(r.type));
     }
-    encode_header(to, header(r));
+    encode_header(to, h);
     encode(to, r.success);
     encode(to, r.cumulative_gas_used);
     encode(to, full_view(r.bloom));
@@ -21,6 +21,7 @@
 
 #include <ethash/keccak.hpp>
 
+#include <silkworm/common/cast.hpp>
 #include <silkworm/common/util.hpp>
 #include <silkworm/crypto/ecdsa.hpp>
 #include <silkworm/rlp/encode.hpp>
@@ -32,7 +33,7 @@ bool operator==(const AccessListEntry& a, const AccessListEntry& b) {
 }
 
 bool operator==(const Transaction& a, const Transaction& b) {
-    // from is omitted since it's derived from the signature
+    // from, cached_hash and cached_signing_hash are omitted since they're derived
     return a.type == b.type && a.nonce == b.nonce && a.max_priority_fee_per_gas == b.max_priority_fee_per_gas &&
            a.max_fee_per_gas == b.max_fee_per_gas && a.gas_limit == b.gas_limit && a.to == b.to && a.value == b.value &&
            a.data == b.data && a.odd_y_parity == b.odd_y_parity && a.chain_id == b.chain_id && a.r == b.r &&
@@ -142,7 +143,9 @@ namespace rlp {
     }
 
     static void legacy_encode(Bytes& to, const Transaction& txn, bool for_signing) {
-        encode_header(to, rlp_header(txn, for_signing));
+        const Header rlp_head{rlp_header(txn, for_signing)};
+        reserve_additional(to, length_of_length(rlp_head.payload_length) + rlp_head.payload_length);
+        encode_header(to, rlp_head);
 
         encode(to, txn.nonce);
         encode(to, txn.max_fee_per_gas);
@@ -170,10 +173,13 @@ namespace rlp {
         assert(txn.type == Transaction::Type::kEip2930 || txn.type == Transaction::Type::kEip1559);
 
         Header rlp_head{rlp_header(txn, for_signing)};
+        const auto rlp_len{static_cast<size_t>(length_of_length(rlp_head.payload_length) + rlp_head.payload_length)};
 
         if (wrap_into_array) {
-            auto rlp_len{static_cast<size_t>(length_of_length(rlp_head.payload_length) + rlp_head.payload_length)};
+            reserve_additional(to, length_of_length(rlp_len + 1) + rlp_len + 1);
             encode_header(to, {false, rlp_len + 1});
+        } else {
+            reserve_additional(to, rlp_len + 1);
         }
 
         to.push_back(static_cast<uint8_t>(txn.type));
@@ -333,6 +339,8 @@ namespace rlp {
 
     template <>
     DecodingResult decode(ByteView& from, Transaction& to) noexcept {
+        to.reset_hash_cache();
+
         auto [h, err0]{decode_header(from)};
         if (err0 != DecodingResult::kOk) {
             return err0;
@@ -374,20 +382,41 @@ namespace rlp {
 
 }  // namespace rlp
 
+evmc::bytes32 Transaction::hash() const {
+    if (cached_hash.has_value()) {
+        return *cached_hash;
+    }
+    Bytes rlp{};
+    rlp::encode(rlp, *this, /*for_signing=*/false, /*wrap_eip2718_into_array=*/false);
+    return bit_cast<evmc_bytes32>(keccak256(rlp));
+}
+
+void Transaction::cache_hash() {
+    reset_hash_cache();
+    cached_hash = hash();
+}
+
+evmc::bytes32 Transaction::signing_hash() {
+    if (!cached_signing_hash.has_value()) {
+        Bytes rlp{};
+        rlp::encode(rlp, *this, /*for_signing=*/true, /*wrap_eip2718_into_array=*/false);
+        cached_signing_hash = bit_cast<evmc_bytes32>(keccak256(rlp));
+    }
+    return *cached_signing_hash;
+}
+
 void Transaction::recover_sender() {
     if (from.has_value()) {
         return;
     }
-    Bytes rlp{};
-    rlp::encode(rlp, *this, /*for_signing=*/true, /*wrap_eip2718_into_array=*/false);
-    ethash::hash256 hash{keccak256(rlp)};
+    const evmc::bytes32 message_hash{signing_hash()};
 
     uint8_t signature[kHashLength * 2];
     intx::be::unsafe::store(signature, r);
     intx::be::unsafe::store(signature + kHashLength, s);
 
     // Might still return std::nullopt if the recovery fails
-    auto recovered_address{ecdsa::recover_address(full_view(hash.bytes), full_view(signature), odd_y_parity)};
+    auto recovered_address{ecdsa::recover_address(full_view(message_hash), full_view(signature), odd_y_parity)};
     if (recovered_address.has_value()){
         from.emplace(std::move(recovered_address.value()));
     }
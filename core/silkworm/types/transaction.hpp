@@ -62,8 +62,29 @@ struct Transaction {
 
     std::optional<evmc::address> from{std::nullopt};  // sender recovered from the signature
 
+    std::optional<evmc::bytes32> cached_hash{std::nullopt};          // see cache_hash(); not part of equality
+    std::optional<evmc::bytes32> cached_signing_hash{std::nullopt};  // see signing_hash(); not part of equality
+
     intx::uint256 v() const;  // EIP-155
 
+    //! \brief Returns the transaction hash, i.e. Keccak-256 of the encoding without EIP-2718 byte array wrapping
+    //! \remarks Served from cached_hash when populated
+    [[nodiscard]] evmc::bytes32 hash() const;
+
+    //! \brief Populates cached_hash so that subsequent calls of hash() don't re-encode the transaction
+    //! \warning Any further modification of the transaction must be followed by reset_hash_cache()
+    void cache_hash();
+
+    void reset_hash_cache() noexcept {
+        cached_hash.reset();
+        cached_signing_hash.reset();
+    }
+
+    //! \brief Returns Keccak-256 of the encoding for signing, i.e. the message hash the sender is recovered from
+    //! \remarks Computed on first use and kept in cached_signing_hash, which recover_sender() fills as well
+    //! \warning Any further modification of the transaction must be followed by reset_hash_cache()
+    [[nodiscard]] evmc::bytes32 signing_hash();
+
     //! \brief Returns false if v is not acceptable (v != 27 && v != 28 && v < 35, see EIP-155)
     [[nodiscard]] bool set_v(const intx::uint256& v);
 
@@ -72,6 +93,7 @@ struct Transaction {
     //! https://eips.ethereum.org/EIPS/eip-2 and
     //! https://eips.ethereum.org/EIPS/eip-155.
     //! If recovery fails the from field is set to null.
+    //! The signing hash is cached, so that recovering again after resetting from doesn't re-encode the transaction.
     void recover_sender();
 
     intx::uint256 priority_fee_per_gas(const intx::uint256& base_fee_per_gas) const;  // EIP-1559
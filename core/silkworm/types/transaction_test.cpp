@@ -164,6 +164,53 @@ TEST_CASE("Recover sender 2") {
 
     txn.recover_sender();
     CHECK(txn.from == 0xa1e4380a3b1f749673e270229993ee55f35663b4_address);
+
+    const auto expected_hash{0xe17d4d0c4596ea7d5166ad5da600a6fdc49e26e0680135a2f7300eedfd0d8314_bytes32};
+    CHECK(txn.hash() == expected_hash);
+
+    SECTION("Cached hash") {
+        txn.reset_hash_cache();
+        txn.cache_hash();
+        REQUIRE(txn.cached_hash == expected_hash);
+        CHECK(!txn.cached_signing_hash);  // left to signing_hash() & recover_sender()
+
+        Transaction copy{txn};
+        copy.nonce = 2;
+        CHECK(copy.hash() == expected_hash);  // stale until reset
+        copy.reset_hash_cache();
+        CHECK(copy.hash() != expected_hash);
+
+        Bytes encoded{};
+        rlp::encode(encoded, copy);
+        ByteView view{encoded};
+        REQUIRE(rlp::decode(view, txn) == rlp::DecodingResult::kOk);
+        CHECK(!txn.cached_hash);
+        CHECK(txn.hash() == copy.hash());
+    }
+
+    SECTION("Cached signing hash") {
+        REQUIRE(txn.cached_signing_hash);  // populated by recover_sender
+        const evmc::bytes32 signing_hash{*txn.cached_signing_hash};
+        txn.reset_hash_cache();
+        CHECK(!txn.cached_signing_hash);
+        CHECK(txn.signing_hash() == signing_hash);
+        CHECK(txn.cached_signing_hash == signing_hash);
+
+        Transaction copy{txn};
+        copy.nonce = 2;
+        CHECK(copy.signing_hash() == signing_hash);  // stale until reset
+        copy.reset_hash_cache();
+        CHECK(copy.signing_hash() != signing_hash);
+        copy.from.reset();
+        copy.recover_sender();
+        CHECK(copy.cached_signing_hash == copy.signing_hash());
+        CHECK(copy.from != txn.from);
+
+        txn.from.reset();
+        txn.recover_sender();
+        CHECK(txn.cached_signing_hash == signing_hash);
+        CHECK(txn.from == 0xa1e4380a3b1f749673e270229993ee55f35663b4_address);
+    }
 }
 
 }  // namespace silkworm
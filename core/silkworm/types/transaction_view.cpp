@@ -0,0 +1,213 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "transaction_view.hpp"
+
+#include <cstring>
+
+#include <silkworm/common/util.hpp>
+#include <silkworm/crypto/ecdsa.hpp>
+#include <silkworm/rlp/encode.hpp>
+
+namespace silkworm {
+
+using Field = TransactionView::Field;
+
+// Returns the view spanning from the beginning of first to the end of last
+static ByteView join(ByteView first, ByteView last) noexcept {
+    return {first.data(), static_cast<size_t>(last.data() + last.length() - first.data())};
+}
+
+std::optional<evmc::address> TransactionView::to() const noexcept {
+    ByteView view{field(Field::kTo)};
+    if (view.length() != kAddressLength + 1) {
+        return std::nullopt;  // Contract creation
+    }
+    evmc::address res;
+    std::memcpy(res.bytes, &view[1], kAddressLength);
+    return res;
+}
+
+ByteView TransactionView::data() const noexcept {
+    ByteView view{field(Field::kData)};
+    // Header has already been validated on parsing
+    const auto [h, err]{rlp::decode_header(view)};
+    static_cast<void>(err);
+    return view.substr(0, h.payload_length);
+}
+
+rlp::DecodingResult TransactionView::decode_signature(Signature& to) const noexcept {
+    if (type_ == Transaction::Type::kLegacy) {
+        intx::uint256 v;
+        if (rlp::DecodingResult err{decode_field(Field::kYParity, v)}; err != rlp::DecodingResult::kOk) {
+            return err;
+        }
+        const std::optional<ecdsa::YParityAndChainId> parity_and_id{ecdsa::v_to_y_parity_and_chain_id(v)};
+        if (parity_and_id == std::nullopt) {
+            return rlp::DecodingResult::kInvalidVInSignature;
+        }
+        to.odd_y_parity = parity_and_id->odd;
+        to.chain_id = parity_and_id->chain_id;
+    } else {
+        intx::uint256 chain_id;
+        if (rlp::DecodingResult err{decode_field(Field::kChainId, chain_id)}; err != rlp::DecodingResult::kOk) {
+            return err;
+        }
+        to.chain_id = chain_id;
+        if (rlp::DecodingResult err{decode_field(Field::kYParity, to.odd_y_parity)}; err != rlp::DecodingResult::kOk) {
+            return err;
+        }
+    }
+
+    if (rlp::DecodingResult err{decode_field(Field::kR, to.r)}; err != rlp::DecodingResult::kOk) {
+        return err;
+    }
+    return decode_field(Field::kS, to.s);
+}
+
+ethash::hash256 TransactionView::hash() const noexcept { return keccak256(rlp_); }
+
+ethash::hash256 TransactionView::signing_hash(const std::optional<intx::uint256>& chain_id) const {
+    Bytes rlp;
+    if (type_ == Transaction::Type::kLegacy) {
+        // nonce, gas price, gas limit, to, value and data are contiguous in the original encoding
+        const ByteView fields{join(field(Field::kNonce), field(Field::kData))};
+        rlp::Header h{true, fields.length()};
+        if (chain_id) {
+            h.payload_length += rlp::length(*chain_id) + 2;
+        }
+        rlp.reserve(rlp::length_of_length(h.payload_length) + h.payload_length);
+        rlp::encode_header(rlp, h);
+        rlp.append(fields);
+        if (chain_id) {
+            rlp::encode(rlp, *chain_id);
+            rlp.push_back(rlp::kEmptyStringCode);
+            rlp.push_back(rlp::kEmptyStringCode);
+        }
+    } else {
+        // Everything but the signature
+        const ByteView fields{join(field(Field::kChainId), field(Field::kAccessList))};
+        const rlp::Header h{true, fields.length()};
+        rlp.reserve(1 + rlp::length_of_length(h.payload_length) + h.payload_length);
+        rlp.push_back(static_cast<uint8_t>(type_));
+        rlp::encode_header(rlp, h);
+        rlp.append(fields);
+    }
+    return keccak256(rlp);
+}
+
+rlp::DecodingResult TransactionView::decode(Transaction& to) const noexcept {
+    ByteView view{encoded_};
+    return rlp::decode(view, to);
+}
+
+namespace rlp {
+
+    static constexpr Field kLegacyLayout[]{
+        Field::kNonce, Field::kMaxFeePerGas, Field::kGasLimit, Field::kTo, Field::kValue,
+        Field::kData,  Field::kYParity,      Field::kR,        Field::kS,
+    };
+
+    static constexpr Field kEip2930Layout[]{
+        Field::kChainId, Field::kNonce,      Field::kMaxFeePerGas, Field::kGasLimit, Field::kTo, Field::kValue,
+        Field::kData,    Field::kAccessList, Field::kYParity,      Field::kR,        Field::kS,
+    };
+
+    static constexpr Field kEip1559Layout[]{
+        Field::kChainId, Field::kNonce,      Field::kMaxPriorityFeePerGas, Field::kMaxFeePerGas,
+        Field::kGasLimit, Field::kTo,        Field::kValue,                Field::kData,
+        Field::kAccessList, Field::kYParity, Field::kR,                    Field::kS,
+    };
+
+    // Walks the payload of a transaction list recording the RLP of each field
+    template <size_t N, size_t M>
+    static DecodingResult parse_fields(ByteView payload, const Field (&layout)[N],
+                                       std::array<ByteView, M>& fields) noexcept {
+        for (const Field f : layout) {
+            const ByteView begin{payload};
+            auto [h, err]{decode_header(payload)};
+            if (err != DecodingResult::kOk) {
+                return err;
+            }
+            if (f == Field::kAccessList) {
+                if (!h.list) {
+                    return DecodingResult::kUnexpectedString;
+                }
+            } else if (h.list) {
+                return DecodingResult::kUnexpectedList;
+            }
+            if (f == Field::kTo && h.payload_length != 0 && h.payload_length != kAddressLength) {
+                return DecodingResult::kUnexpectedLength;
+            }
+            payload.remove_prefix(h.payload_length);
+            fields[static_cast<size_t>(f)] = begin.substr(0, begin.length() - payload.length());
+        }
+        return payload.empty() ? DecodingResult::kOk : DecodingResult::kListLengthMismatch;
+    }
+
+    template <>
+    DecodingResult decode(ByteView& from, TransactionView& to) noexcept {
+        const ByteView begin{from};
+        auto [h, err0]{decode_header(from)};
+        if (err0 != DecodingResult::kOk) {
+            return err0;
+        }
+
+        to.fields_ = {};
+
+        if (h.list) {
+            to.type_ = Transaction::Type::kLegacy;
+            const ByteView payload{from.substr(0, h.payload_length)};
+            from.remove_prefix(h.payload_length);
+            to.encoded_ = begin.substr(0, begin.length() - from.length());
+            to.rlp_ = to.encoded_;
+            return parse_fields(payload, kLegacyLayout, to.fields_);
+        }
+
+        if (h.payload_length == 0) {
+            return DecodingResult::kInputTooShort;
+        }
+
+        to.type_ = static_cast<Transaction::Type>(from[0]);
+        if (to.type_ != Transaction::Type::kEip2930 && to.type_ != Transaction::Type::kEip1559) {
+            return DecodingResult::kUnsupportedTransactionType;
+        }
+
+        to.rlp_ = from.substr(0, h.payload_length);
+        from.remove_prefix(h.payload_length);
+        to.encoded_ = begin.substr(0, begin.length() - from.length());
+
+        ByteView eip2718_view{to.rlp_.substr(1)};
+        auto [list_head, err1]{decode_header(eip2718_view)};
+        if (err1 != DecodingResult::kOk) {
+            return err1;
+        }
+        if (!list_head.list) {
+            return DecodingResult::kUnexpectedString;
+        }
+        if (eip2718_view.length() != list_head.payload_length) {
+            return DecodingResult::kListLengthMismatch;
+        }
+
+        if (to.type_ == Transaction::Type::kEip2930) {
+            return parse_fields(eip2718_view, kEip2930Layout, to.fields_);
+        }
+        return parse_fields(eip2718_view, kEip1559Layout, to.fields_);
+    }
+
+}  // namespace rlp
+
+}  // namespace silkworm
@@ -0,0 +1,120 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_TYPES_TRANSACTION_VIEW_HPP_
+#define SILKWORM_TYPES_TRANSACTION_VIEW_HPP_
+
+#include <array>
+#include <optional>
+
+#include <ethash/hash_types.hpp>
+#include <intx/intx.hpp>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/rlp/decode.hpp>
+#include <silkworm/types/transaction.hpp>
+
+namespace silkworm {
+
+//! \brief Non-owning, lazily decoded counterpart of Transaction.
+//! Parsing only walks the RLP structure and records where each field lives in the source buffer;
+//! field values are decoded on demand. Hence the view must not outlive the buffer it has been parsed from
+//! (e.g. a value returned by an MDBX cursor is valid only until the end of the database transaction).
+class TransactionView {
+  public:
+    // Fields in the order they appear in EIP-2718 transactions.
+    // Legacy transactions have neither kChainId, kMaxPriorityFeePerGas nor kAccessList
+    // and kYParity holds the EIP-155 v instead.
+    enum class Field : uint8_t {
+        kChainId = 0,
+        kNonce,
+        kMaxPriorityFeePerGas,
+        kMaxFeePerGas,
+        kGasLimit,
+        kTo,
+        kValue,
+        kData,
+        kAccessList,
+        kYParity,
+        kR,
+        kS,
+    };
+
+    struct Signature {
+        bool odd_y_parity{false};
+        std::optional<intx::uint256> chain_id{std::nullopt};  // EIP-155
+        intx::uint256 r{0}, s{0};
+    };
+
+    [[nodiscard]] Transaction::Type type() const noexcept { return type_; }
+
+    //! \brief Returns the encoding the transaction hash is computed from,
+    //! i.e. without the byte array wrapping EIP-2718 transactions get in block RLP
+    [[nodiscard]] ByteView rlp() const noexcept { return rlp_; }
+
+    //! \brief Returns the RLP of a single field (header included); empty if the field is not present
+    [[nodiscard]] ByteView field(Field f) const noexcept { return fields_[static_cast<size_t>(f)]; }
+
+    //! \brief Decodes a single field
+    template <class T>
+    [[nodiscard]] rlp::DecodingResult decode_field(Field f, T& to) const noexcept {
+        ByteView view{field(f)};
+        if (view.empty()) {
+            return rlp::DecodingResult::kInputTooShort;
+        }
+        return rlp::decode(view, to);
+    }
+
+    //! \brief Returns the recipient; std::nullopt for contract creation or if the field is malformed
+    [[nodiscard]] std::optional<evmc::address> to() const noexcept;
+
+    //! \brief Returns the payload of the data field without copying it
+    [[nodiscard]] ByteView data() const noexcept;
+
+    //! \brief Decodes signature values (and chain id) without touching any other field
+    [[nodiscard]] rlp::DecodingResult decode_signature(Signature& to) const noexcept;
+
+    //! \brief Keccak-256 of rlp(), i.e. the transaction hash
+    [[nodiscard]] ethash::hash256 hash() const noexcept;
+
+    //! \brief Keccak-256 of the payload signed by the sender.
+    //! The signing payload is spliced from the encoded fields, which are never decoded.
+    //! \remarks For legacy transactions chain_id is required to be the one returned by decode_signature.
+    [[nodiscard]] ethash::hash256 signing_hash(const std::optional<intx::uint256>& chain_id) const;
+
+    //! \brief Fully decodes the transaction
+    [[nodiscard]] rlp::DecodingResult decode(Transaction& to) const noexcept;
+
+  private:
+    friend rlp::DecodingResult rlp::decode<TransactionView>(ByteView& from, TransactionView& to) noexcept;
+
+    static constexpr size_t kNumFields{static_cast<size_t>(Field::kS) + 1};
+
+    Transaction::Type type_{Transaction::Type::kLegacy};
+    ByteView encoded_{};  // As found in the source buffer (EIP-2718 wrapping included, if any)
+    ByteView rlp_{};
+    std::array<ByteView, kNumFields> fields_{};
+};
+
+namespace rlp {
+    //! \brief Parses a transaction the same way decode<Transaction> does, without decoding field values
+    template <>
+    DecodingResult decode(ByteView& from, TransactionView& to) noexcept;
+}  // namespace rlp
+
+}  // namespace silkworm
+
+#endif  // SILKWORM_TYPES_TRANSACTION_VIEW_HPP_
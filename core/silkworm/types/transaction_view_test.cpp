@@ -0,0 +1,102 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "transaction_view.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/test_util.hpp>
+#include <silkworm/common/util.hpp>
+
+namespace silkworm {
+
+static void check_view(const Transaction& txn) {
+    Bytes encoded{};
+    rlp::encode(encoded, txn);
+
+    TransactionView view;
+    ByteView from{encoded};
+    REQUIRE(rlp::decode(from, view) == rlp::DecodingResult::kOk);
+    CHECK(from.empty());
+
+    CHECK(view.type() == txn.type);
+    CHECK(view.to() == txn.to);
+    CHECK(view.data() == txn.data);
+
+    uint64_t nonce{0};
+    CHECK(view.decode_field(TransactionView::Field::kNonce, nonce) == rlp::DecodingResult::kOk);
+    CHECK(nonce == txn.nonce);
+    uint64_t gas_limit{0};
+    CHECK(view.decode_field(TransactionView::Field::kGasLimit, gas_limit) == rlp::DecodingResult::kOk);
+    CHECK(gas_limit == txn.gas_limit);
+
+    TransactionView::Signature signature;
+    REQUIRE(view.decode_signature(signature) == rlp::DecodingResult::kOk);
+    CHECK(signature.odd_y_parity == txn.odd_y_parity);
+    CHECK(signature.chain_id == txn.chain_id);
+    CHECK(signature.r == txn.r);
+    CHECK(signature.s == txn.s);
+
+    Bytes unwrapped{};
+    rlp::encode(unwrapped, txn, /*for_signing=*/false, /*wrap_eip2718_into_array=*/false);
+    CHECK(view.rlp() == unwrapped);
+    CHECK(full_view(view.hash().bytes) == full_view(keccak256(unwrapped).bytes));
+
+    Bytes for_signing{};
+    rlp::encode(for_signing, txn, /*for_signing=*/true, /*wrap_eip2718_into_array=*/false);
+    CHECK(full_view(view.signing_hash(signature.chain_id).bytes) == full_view(keccak256(for_signing).bytes));
+
+    Transaction decoded;
+    REQUIRE(view.decode(decoded) == rlp::DecodingResult::kOk);
+    CHECK(decoded == txn);
+}
+
+TEST_CASE("TransactionView") {
+    const std::vector<Transaction> transactions{test::sample_transactions()};
+
+    SECTION("Legacy") { check_view(transactions[0]); }
+
+    SECTION("Legacy EIP-155") {
+        Transaction txn{transactions[0]};
+        REQUIRE(txn.set_v(37));
+        check_view(txn);
+    }
+
+    SECTION("EIP-2930") {
+        Transaction txn{transactions[1]};
+        txn.type = Transaction::Type::kEip2930;
+        txn.max_priority_fee_per_gas = txn.max_fee_per_gas;
+        txn.access_list = {
+            {0xde0b295669a9fd93d5f28d9ec85e40f4cb697bae_address,
+             {0x0000000000000000000000000000000000000000000000000000000000000003_bytes32}},
+        };
+        check_view(txn);
+    }
+
+    SECTION("EIP-1559") { check_view(transactions[1]); }
+
+    SECTION("Malformed") {
+        Bytes encoded{};
+        rlp::encode(encoded, transactions[0]);
+        encoded.pop_back();
+
+        TransactionView view;
+        ByteView from{encoded};
+        CHECK(rlp::decode(from, view) != rlp::DecodingResult::kOk);
+    }
+}
+
+}  // namespace silkworm
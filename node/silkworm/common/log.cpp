@@ -14,7 +14,14 @@
    limitations under the License.
 */
 
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <memory>
+#include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 #include <absl/time/clock.h>
 
@@ -34,15 +41,215 @@ constexpr char const kLogTags_[7][6] = {
 // Log to one or two output streams - typically the console and optional log file.
 void log_set_streams_(std::ostream& o1, std::ostream& o2) { log_streams_.set_streams(o1.rdbuf(), o2.rdbuf()); }
 
-std::mutex log_::log_mtx_;
+namespace {
 
-std::ostream& log_::header_(LogLevel level) {
-    log_streams_ << kLogTags_[static_cast<int>(level)] << "["
-                 << absl::FormatTime("%m-%d|%H:%M:%E3S", absl::Now(), absl::LocalTimeZone()) << "]";
-    if (log_thread_enabled_) {
-        log_streams_ << " " << std::this_thread::get_id();
+    struct LogRecord {
+        uint64_t sequence{0};
+        LogLevel level{LogLevel::Info};
+        std::chrono::system_clock::time_point time;
+        std::thread::id thread;
+        std::string message;
+    };
+
+    // Single producer (the owning thread) single consumer (whoever holds flush_mtx) ring of records
+    class LogQueue {
+      public:
+        static constexpr size_t kCapacity{1024};
+
+        [[nodiscard]] size_t size() const noexcept {
+            return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+        }
+
+        bool push(LogRecord& record) noexcept {
+            const size_t tail{tail_.load(std::memory_order_relaxed)};
+            if (tail - head_.load(std::memory_order_acquire) == kCapacity) {
+                return false;
+            }
+            std::swap(slots_[tail % kCapacity], record);
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        template <class Out>
+        void pop_all(Out& out) {
+            const size_t head{head_.load(std::memory_order_relaxed)};
+            const size_t tail{tail_.load(std::memory_order_acquire)};
+            for (size_t i{head}; i != tail; ++i) {
+                out.push_back(std::move(slots_[i % kCapacity]));
+            }
+            head_.store(tail, std::memory_order_release);
+        }
+
+        std::atomic<bool> orphaned{false};  // owning thread has exited
+
+      private:
+        std::array<LogRecord, kCapacity> slots_;
+        alignas(64) std::atomic<size_t> head_{0};
+        alignas(64) std::atomic<size_t> tail_{0};
+    };
+
+    std::mutex log_mtx;    // serializes writes to log_streams_
+    std::mutex flush_mtx;  // only one consumer of the queues at a time
+    std::mutex queues_mtx;
+    std::vector<std::shared_ptr<LogQueue>> queues;
+
+    std::atomic<bool> async_enabled{false};
+    std::atomic<uint64_t> sequence{0};
+    std::mutex control_mtx;  // serializes log_set_async_, must outlive async_guard
+    std::mutex flusher_mtx;
+    std::condition_variable flusher_cv;
+    bool flusher_stopping{false};
+    std::thread flusher;
+
+    void format(std::string& out, LogLevel level, std::chrono::system_clock::time_point time, std::thread::id thread,
+                const std::string& message) {
+        std::ostringstream os;
+        os << kLogTags_[static_cast<int>(level)] << "["
+           << absl::FormatTime("%m-%d|%H:%M:%E3S", absl::FromChrono(time), absl::LocalTimeZone()) << "]";
+        if (log_thread_enabled_) {
+            os << " " << thread;
+        }
+        out += os.str();
+        out += message;
+    }
+
+    void write(const std::string& lines) {
+        std::scoped_lock lock{log_mtx};
+        log_streams_.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+        log_streams_.flush();
+    }
+
+    // Drains all queues and writes their records in sequence order
+    void drain() {
+        std::scoped_lock lock{flush_mtx};
+        std::vector<LogRecord> records;
+        {
+            std::scoped_lock queues_lock{queues_mtx};
+            for (auto it{queues.begin()}; it != queues.end();) {
+                const bool orphaned{(*it)->orphaned.load(std::memory_order_acquire)};
+                (*it)->pop_all(records);
+                it = orphaned ? queues.erase(it) : std::next(it);
+            }
+        }
+        if (records.empty()) {
+            return;
+        }
+        std::sort(records.begin(), records.end(),
+                  [](const LogRecord& a, const LogRecord& b) { return a.sequence < b.sequence; });
+        std::string lines;
+        for (const auto& record : records) {
+            format(lines, record.level, record.time, record.thread, record.message);
+        }
+        write(lines);
+    }
+
+    void flusher_loop() {
+        std::unique_lock lock{flusher_mtx};
+        while (!flusher_stopping) {
+            flusher_cv.wait_for(lock, std::chrono::milliseconds(10));
+            lock.unlock();
+            drain();
+            lock.lock();
+        }
+    }
+
+    void stop_flusher() {
+        if (!flusher.joinable()) {
+            return;
+        }
+        {
+            std::scoped_lock lock{flusher_mtx};
+            flusher_stopping = true;
+        }
+        flusher_cv.notify_one();
+        flusher.join();
+    }
+
+    // Registers the calling thread's queue on first use and marks it orphaned on thread exit
+    struct ThreadQueue {
+        ThreadQueue() : queue{std::make_shared<LogQueue>()} {
+            std::scoped_lock lock{queues_mtx};
+            queues.push_back(queue);
+        }
+        ~ThreadQueue() { queue->orphaned.store(true, std::memory_order_release); }
+
+        std::shared_ptr<LogQueue> queue;
+    };
+
+    void enqueue(LogRecord& record) {
+        thread_local ThreadQueue thread_queue;
+        LogQueue& queue{*thread_queue.queue};
+        while (!queue.push(record)) {
+            // Full : wake the flusher and wait for room rather than dropping lines
+            flusher_cv.notify_one();
+            std::this_thread::yield();
+        }
+        if (queue.size() >= LogQueue::kCapacity / 2) {
+            flusher_cv.notify_one();
+        }
+    }
+
+    // Composition buffers of the calling thread, one per nesting level
+    // (an operator<< may log by itself while a line is being composed)
+    struct ThreadStreams {
+        std::vector<std::unique_ptr<std::ostringstream>> streams;
+        size_t depth{0};
+
+        std::ostringstream& acquire() {
+            if (depth == streams.size()) {
+                streams.push_back(std::make_unique<std::ostringstream>());
+            }
+            std::ostringstream& os{*streams[depth++]};
+            os.str({});
+            os.clear();
+            os.flags(std::ios_base::dec | std::ios_base::skipws);
+            os.precision(6);
+            os.fill(' ');
+            return os;
+        }
+    };
+
+    thread_local ThreadStreams thread_streams;
+
+    // Writes pending lines at exit
+    struct AsyncGuard {
+        ~AsyncGuard() { log_set_async_(false); }
+    } async_guard;
+
+}  // namespace
+
+void log_set_async_(bool async) {
+    std::scoped_lock lock{control_mtx};
+    if (async == async_enabled.load()) {
+        return;
+    }
+    if (async) {
+        flusher_stopping = false;
+        flusher = std::thread(flusher_loop);
+        async_enabled.store(true);
+    } else {
+        async_enabled.store(false);
+        stop_flusher();
+        drain();
+    }
+}
+
+void log_flush_() { drain(); }
+
+log_::log_(LogLevel level)
+    : level_{level}, time_{std::chrono::system_clock::now()}, stream_{thread_streams.acquire()} {}
+
+log_::~log_() {
+    --thread_streams.depth;
+    if (async_enabled.load(std::memory_order_relaxed)) {
+        LogRecord record{sequence.fetch_add(1, std::memory_order_relaxed), level_, time_, std::this_thread::get_id(),
+                         stream_.str()};
+        enqueue(record);
+    } else {
+        std::string line;
+        format(line, level_, time_, std::this_thread::get_id(), stream_.str());
+        write(line);
     }
-    return log_streams_;
 }
 
 std::ostream& null_stream() {
@@ -17,7 +17,12 @@
 #ifndef SILKWORM_COMMON_LOG_HPP_
 #define SILKWORM_COMMON_LOG_HPP_
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <mutex>
+#include <sstream>
+#include <string_view>
 
 #include <silkworm/common/tee.hpp>
 
@@ -26,10 +31,32 @@ namespace silkworm {
 // stream labeled logging output - e.g.
 //	  SILKWORM_LOG(LogInfo) << "All your " << num_bases << " base are belong to us\n";
 //
-#define SILKWORM_LOG(level_)                   \
-    if ((level_) < silkworm::log_verbosity_) { \
-    } else                                     \
-        log_(level_) << " "
+// A line is composed on the calling thread into a thread local buffer without any locking. In synchronous mode
+// (default) it's then written to the output streams; in asynchronous mode it's pushed into a per-thread ring buffer
+// and written by a background thread, so the caller never waits on the console.
+//
+#define SILKWORM_LOG(level_)                                                                \
+    if ((level_) < SILKWORM_LOG_COMPILE_LEVEL || (level_) < silkworm::log_verbosity_) { \
+    } else                                                                                \
+        silkworm::log_(level_) << " "
+
+// as SILKWORM_LOG but emitting at most one line every interval_ms_ milliseconds per call site - e.g.
+//	  SILKWORM_LOG_EVERY(LogLevel::Info, 5'000) << "Progress" << log_kv("block", block_num) << std::endl;
+//
+#define SILKWORM_LOG_EVERY(level_, interval_ms_)                                             \
+    if ((level_) < SILKWORM_LOG_COMPILE_LEVEL || (level_) < silkworm::log_verbosity_ ||  \
+        ![]() -> silkworm::LogRateLimiter& {                                              \
+            static silkworm::LogRateLimiter limiter;                                       \
+            return limiter;                                                                \
+        }()                                                                                \
+             .allow(std::chrono::milliseconds(interval_ms_))) {                           \
+    } else                                                                                 \
+        silkworm::log_(level_) << " "
+
+// levels below this one are compiled out - e.g. -DSILKWORM_LOG_COMPILE_LEVEL=silkworm::LogLevel::Info
+#ifndef SILKWORM_LOG_COMPILE_LEVEL
+#define SILKWORM_LOG_COMPILE_LEVEL silkworm::LogLevel::Trace
+#endif
 
 // change the logging verbosity level - default level is LogInfo
 //
@@ -46,9 +73,49 @@ enum class LogLevel { Trace, Debug, Info, Warn, Error, Critical, None };
 //
 #define SILKWORM_LOG_STREAMS(stream1_, stream2_) silkworm::log_set_streams_((stream1_), (stream2_));
 
+// switch to asynchronous (true) or synchronous (false) output - default is false
+// switching back to synchronous output writes all pending lines
+//
+#define SILKWORM_LOG_ASYNC(async_) silkworm::log_set_async_(async_)
+
+// write all lines pending in asynchronous mode
+//
+#define SILKWORM_LOG_FLUSH() silkworm::log_flush_()
+
 // silence
 std::ostream& null_stream();
 
+// structured key/value field, logged as " key=value" - e.g.
+//	  SILKWORM_LOG(LogLevel::Info) << "Committed" << log_kv("block", block_num) << log_kv("txs", txs) << std::endl;
+template <class T>
+struct LogField {
+    std::string_view key;
+    const T& value;
+};
+
+template <class T>
+LogField<T> log_kv(std::string_view key, const T& value) {
+    return {key, value};
+}
+
+template <class T>
+std::ostream& operator<<(std::ostream& os, const LogField<T>& field) {
+    return os << " " << field.key << "=" << field.value;
+}
+
+// Lets through at most one caller per interval; lock free
+class LogRateLimiter {
+  public:
+    bool allow(std::chrono::steady_clock::duration interval) noexcept {
+        const int64_t now{std::chrono::steady_clock::now().time_since_epoch().count()};
+        int64_t next{next_.load(std::memory_order_relaxed)};
+        return now >= next && next_.compare_exchange_strong(next, now + interval.count(), std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<int64_t> next_{0};
+};
+
 //
 // Below are for access via macros ONLY.
 // Placing them in detail namespace prevents use of macros in nested namespaces of silkworm :(
@@ -56,19 +123,25 @@ std::ostream& null_stream();
 extern LogLevel log_verbosity_;
 extern bool log_thread_enabled_;
 void log_set_streams_(std::ostream& o1, std::ostream& o2);
+void log_set_async_(bool async);
+void log_flush_();
 class log_ {
   public:
-    explicit log_(LogLevel level) : level_(level) { log_mtx_.lock(); }
-    ~log_() { log_mtx_.unlock(); }
-    std::ostream& header_(LogLevel);
+    explicit log_(LogLevel level);
+    ~log_();
+
+    log_(const log_&) = delete;
+    log_& operator=(const log_&) = delete;
+
     template <class T>
     std::ostream& operator<<(const T& message) {
-        return header_(level_) << message;
+        return stream_ << message;
     }
 
   private:
     LogLevel level_;
-    static std::mutex log_mtx_;
+    std::chrono::system_clock::time_point time_;
+    std::ostringstream& stream_;
 };
 
 }  // namespace silkworm
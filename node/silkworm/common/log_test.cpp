@@ -20,6 +20,8 @@
 #include <regex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <catch2/catch.hpp>
 
@@ -70,4 +72,73 @@ TEST_CASE("Logging") {
     CHECK(test_log("", "", ""));
 }
 
+TEST_CASE("Structured logging") {
+    SILKWORM_LOG_STREAMS(stream1, stream2);
+    SILKWORM_LOG_VERBOSITY(LogLevel::Info);
+
+    const std::string hash{"0xabcd"};
+    SILKWORM_LOG(LogLevel::Info) << "Block" << log_kv("number", 46147) << log_kv("hash", hash) << std::endl;
+    CHECK(test_log("INFO ", kInfix, "Block number=46147 hash=0xabcd\n$"));
+
+    // Formatting state doesn't leak into the next line
+    SILKWORM_LOG(LogLevel::Info) << std::hex << 255 << std::endl;
+    SILKWORM_LOG(LogLevel::Info) << 255 << std::endl;
+    CHECK(test_log("INFO ", kInfix, "ff\n.* 255\n$"));
+}
+
+TEST_CASE("Rate limited logging") {
+    SILKWORM_LOG_STREAMS(stream1, stream2);
+    SILKWORM_LOG_VERBOSITY(LogLevel::Info);
+
+    for (int i{0}; i < 100; ++i) {
+        SILKWORM_LOG_EVERY(LogLevel::Info, 60'000) << "Progress" << log_kv("i", i) << std::endl;
+    }
+    CHECK(test_log("INFO ", kInfix, "Progress i=0\n$"));
+
+    LogRateLimiter limiter;
+    CHECK(limiter.allow(std::chrono::hours(1)));
+    CHECK_FALSE(limiter.allow(std::chrono::hours(1)));
+
+    LogRateLimiter unlimited;
+    CHECK(unlimited.allow(std::chrono::nanoseconds(0)));
+    CHECK(unlimited.allow(std::chrono::nanoseconds(0)));
+}
+
+TEST_CASE("Asynchronous logging") {
+    SILKWORM_LOG_STREAMS(stream1, stream2);
+    SILKWORM_LOG_VERBOSITY(LogLevel::Info);
+    SILKWORM_LOG_ASYNC(true);
+
+    constexpr int kThreads{4};
+    constexpr int kLines{3000};  // more than a ring buffer holds
+    std::vector<std::thread> threads;
+    for (int t{0}; t < kThreads; ++t) {
+        threads.emplace_back([t]() {
+            for (int i{0}; i < kLines; ++i) {
+                SILKWORM_LOG(LogLevel::Info) << "Line" << log_kv("thread", t) << log_kv("i", i) << std::endl;
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    SILKWORM_LOG(LogLevel::Info) << "Last" << std::endl;
+    SILKWORM_LOG_ASYNC(false);  // writes all pending lines
+
+    const std::string output{stream1.str()};
+    CHECK(test_log("INFO ", kInfix, "Last\n$"));
+
+    std::istringstream lines{output};
+    std::vector<int> next(kThreads, 0);
+    int count{0};
+    const std::regex rx("^INFO " + kInfix + "Line thread=(\\d) i=(\\d+)$");
+    for (std::string line; std::getline(lines, line) && line.find("Last") == std::string::npos; ++count) {
+        std::smatch match;
+        REQUIRE(std::regex_match(line, match, rx));
+        const int t{std::stoi(match[1])};
+        CHECK(std::stoi(match[2]) == next[t]++);  // per thread order is preserved
+    }
+    CHECK(count == kThreads * kLines);
+}
+
 }  // namespace silkworm
@@ -0,0 +1,154 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "metrics.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace silkworm::metrics {
+
+Histogram::Histogram(std::vector<double> bounds)
+    : bounds_{std::move(bounds)}, buckets_{new std::atomic<uint64_t>[bounds_.size() + 1]} {
+    if (!std::is_sorted(bounds_.begin(), bounds_.end())) {
+        throw std::invalid_argument("Histogram bounds must be sorted");
+    }
+    for (size_t i{0}; i <= bounds_.size(); ++i) {
+        buckets_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void Histogram::observe(double v) noexcept {
+    const auto bucket{static_cast<size_t>(std::lower_bound(bounds_.begin(), bounds_.end(), v) - bounds_.begin())};
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    double sum{sum_.load(std::memory_order_relaxed)};
+    while (!sum_.compare_exchange_weak(sum, sum + v, std::memory_order_relaxed)) {
+    }
+}
+
+std::vector<uint64_t> Histogram::bucket_counts() const {
+    std::vector<uint64_t> counts(bounds_.size() + 1);
+    for (size_t i{0}; i < counts.size(); ++i) {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    }
+    return counts;
+}
+
+std::vector<double> latency_buckets() {
+    return {0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30, 60};
+}
+
+Registry& Registry::instance() {
+    static Registry registry;
+    return registry;
+}
+
+Registry::Entry& Registry::entry(const std::string& name, const std::string& help) {
+    auto [it, inserted]{entries_.try_emplace(name)};
+    if (inserted) {
+        it->second.help = help;
+    }
+    return it->second;
+}
+
+Counter& Registry::counter(const std::string& name, const std::string& help) {
+    std::scoped_lock lock{mtx_};
+    Entry& e{entry(name, help)};
+    if (e.gauge || e.histogram) {
+        throw std::logic_error("Metric " + name + " already registered with another type");
+    }
+    if (!e.counter) {
+        e.counter = std::make_unique<Counter>();
+    }
+    return *e.counter;
+}
+
+Gauge& Registry::gauge(const std::string& name, const std::string& help) {
+    std::scoped_lock lock{mtx_};
+    Entry& e{entry(name, help)};
+    if (e.counter || e.histogram) {
+        throw std::logic_error("Metric " + name + " already registered with another type");
+    }
+    if (!e.gauge) {
+        e.gauge = std::make_unique<Gauge>();
+    }
+    return *e.gauge;
+}
+
+Histogram& Registry::histogram(const std::string& name, const std::string& help, std::vector<double> bounds) {
+    std::scoped_lock lock{mtx_};
+    Entry& e{entry(name, help)};
+    if (e.counter || e.gauge) {
+        throw std::logic_error("Metric " + name + " already registered with another type");
+    }
+    if (!e.histogram) {
+        e.histogram = std::make_unique<Histogram>(std::move(bounds));
+    }
+    return *e.histogram;
+}
+
+void Registry::write_prometheus(std::ostream& os) const {
+    std::scoped_lock lock{mtx_};
+    for (const auto& [name, e] : entries_) {
+        os << "# HELP " << name << " " << e.help << "\n";
+        if (e.counter) {
+            os << "# TYPE " << name << " counter\n" << name << " " << e.counter->value() << "\n";
+        } else if (e.gauge) {
+            os << "# TYPE " << name << " gauge\n" << name << " " << e.gauge->value() << "\n";
+        } else if (e.histogram) {
+            os << "# TYPE " << name << " histogram\n";
+            const auto counts{e.histogram->bucket_counts()};
+            uint64_t cumulative{0};
+            for (size_t i{0}; i < counts.size(); ++i) {
+                cumulative += counts[i];
+                os << name << "_bucket{le=\"";
+                if (i < e.histogram->bounds().size()) {
+                    os << e.histogram->bounds()[i];
+                } else {
+                    os << "+Inf";
+                }
+                os << "\"} " << cumulative << "\n";
+            }
+            os << name << "_sum " << e.histogram->sum() << "\n" << name << "_count " << cumulative << "\n";
+        }
+    }
+}
+
+std::map<std::string, uint64_t> Registry::counters() const {
+    std::scoped_lock lock{mtx_};
+    std::map<std::string, uint64_t> values;
+    for (const auto& [name, e] : entries_) {
+        if (e.counter) {
+            values.emplace(name, e.counter->value());
+        }
+    }
+    return values;
+}
+
+std::map<std::string, int64_t> Registry::gauges() const {
+    std::scoped_lock lock{mtx_};
+    std::map<std::string, int64_t> values;
+    for (const auto& [name, e] : entries_) {
+        if (e.gauge) {
+            values.emplace(name, e.gauge->value());
+        }
+    }
+    return values;
+}
+
+}  // namespace silkworm::metrics
@@ -0,0 +1,138 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_COMMON_METRICS_HPP_
+#define SILKWORM_COMMON_METRICS_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace silkworm::metrics {
+
+// Metrics are plain atomics updated with relaxed ordering, so recording one on a hot path costs about as much as an
+// uncontended atomic add. Instances are owned by the Registry and never move, hence the usual pattern is to look them
+// up once in a function-local static:
+//
+//	  static auto& blocks{metrics::Registry::instance().counter("silkworm_blocks_total", "Blocks executed")};
+//	  blocks.inc();
+
+// Monotonically increasing value
+class Counter {
+  public:
+    void inc(uint64_t n = 1) noexcept { value_.fetch_add(n, std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t value() const noexcept { return value_.load(std::memory_order_relaxed); }
+
+  private:
+    std::atomic<uint64_t> value_{0};
+};
+
+// Value that can go up and down
+class Gauge {
+  public:
+    void set(int64_t v) noexcept { value_.store(v, std::memory_order_relaxed); }
+    void add(int64_t n) noexcept { value_.fetch_add(n, std::memory_order_relaxed); }
+    [[nodiscard]] int64_t value() const noexcept { return value_.load(std::memory_order_relaxed); }
+
+  private:
+    std::atomic<int64_t> value_{0};
+};
+
+// Distribution of observed values over fixed buckets (upper bounds, in increasing order)
+class Histogram {
+  public:
+    explicit Histogram(std::vector<double> bounds);
+
+    void observe(double v) noexcept;
+
+    [[nodiscard]] const std::vector<double>& bounds() const noexcept { return bounds_; }
+    [[nodiscard]] std::vector<uint64_t> bucket_counts() const;  // not cumulative, last one is +Inf
+    [[nodiscard]] uint64_t count() const noexcept { return count_.load(std::memory_order_relaxed); }
+    [[nodiscard]] double sum() const noexcept { return sum_.load(std::memory_order_relaxed); }
+
+  private:
+    const std::vector<double> bounds_;
+    std::unique_ptr<std::atomic<uint64_t>[]> buckets_;
+    std::atomic<uint64_t> count_{0};
+    std::atomic<double> sum_{0};
+};
+
+// Default buckets for latencies in seconds: 1ms .. ~1min
+std::vector<double> latency_buckets();
+
+// Observes on destruction the seconds elapsed since construction
+class ScopedTimer {
+  public:
+    explicit ScopedTimer(Histogram& histogram) : histogram_{histogram}, start_{std::chrono::steady_clock::now()} {}
+    ~ScopedTimer() {
+        histogram_.observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count());
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+  private:
+    Histogram& histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+class Registry {
+  public:
+    // Process wide registry
+    static Registry& instance();
+
+    Registry() = default;
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    // Return the metric registered with name, registering it first if needed.
+    // Throws std::logic_error if name is already registered with another type.
+    Counter& counter(const std::string& name, const std::string& help);
+    Gauge& gauge(const std::string& name, const std::string& help);
+    Histogram& histogram(const std::string& name, const std::string& help,
+                         std::vector<double> bounds = latency_buckets());
+
+    // Writes all metrics in Prometheus text exposition format (version 0.0.4)
+    void write_prometheus(std::ostream& os) const;
+
+    // Snapshot of counters (by name) for rate computations
+    [[nodiscard]] std::map<std::string, uint64_t> counters() const;
+
+    // Snapshot of gauges (by name)
+    [[nodiscard]] std::map<std::string, int64_t> gauges() const;
+
+  private:
+    struct Entry {
+        std::string help;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    Entry& entry(const std::string& name, const std::string& help);
+
+    mutable std::mutex mtx_;
+    std::map<std::string, Entry> entries_;
+};
+
+}  // namespace silkworm::metrics
+
+#endif  // SILKWORM_COMMON_METRICS_HPP_
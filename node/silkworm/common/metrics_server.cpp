@@ -0,0 +1,193 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "metrics_server.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <silkworm/common/log.hpp>
+
+namespace silkworm::metrics {
+
+using boost::asio::ip::tcp;
+
+namespace {
+
+    // A connection being served, kept alive by the handlers of its pending operations
+    struct Session {
+        static constexpr size_t kMaxRequestSize{8 * 1024};
+
+        explicit Session(tcp::socket s) : socket{std::move(s)}, deadline{socket.get_executor()} {}
+
+        tcp::socket socket;
+        boost::asio::steady_timer deadline;
+        boost::asio::streambuf request{kMaxRequestSize};
+        std::string response;
+    };
+
+}  // namespace
+
+MetricsServer::MetricsServer(Registry& registry, Config config) : registry_{registry}, config_{std::move(config)} {
+    if (config_.port != 0) {
+        tcp::endpoint endpoint{boost::asio::ip::make_address(config_.address), config_.port};
+        acceptor_ = std::make_unique<tcp::acceptor>(io_context_, endpoint);  // may throw if port is taken
+    }
+    last_counters_ = registry_.counters();
+}
+
+MetricsServer::~MetricsServer() {
+    // Members must outlive the thread, hence it can't be left to ~Worker
+    if (get_state() != WorkerState::kStopped) {
+        stop(/*wait=*/true);
+    }
+}
+
+MetricsServer::Config MetricsServer::parse_endpoint(const std::string& endpoint) {
+    Config config;
+    std::string port{endpoint};
+    if (const auto colon{endpoint.rfind(':')}; colon != std::string::npos) {
+        config.address = endpoint.substr(0, colon);
+        port = endpoint.substr(colon + 1);
+    }
+    if (port.empty() || port.size() > 5 || port.find_first_not_of("0123456789") != std::string::npos ||
+        std::stoul(port) > UINT16_MAX) {
+        throw std::invalid_argument("Invalid metrics endpoint : " + endpoint);
+    }
+    config.port = static_cast<uint16_t>(std::stoul(port));
+    return config;
+}
+
+std::string MetricsServer::summary(std::chrono::steady_clock::duration elapsed) {
+    const double seconds{std::max(std::chrono::duration<double>(elapsed).count(), 1e-3)};
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(1);
+    const auto counters{registry_.counters()};
+    for (const auto& [name, value] : counters) {
+        const auto it{last_counters_.find(name)};
+        const uint64_t previous{it == last_counters_.end() ? 0 : it->second};
+        if (value != previous) {
+            os << " " << name << "=" << static_cast<double>(value - previous) / seconds << "/s";
+        }
+    }
+    for (const auto& [name, value] : registry_.gauges()) {
+        os << " " << name << "=" << value;
+    }
+    last_counters_ = counters;
+    return os.str();
+}
+
+void MetricsServer::accept() {
+    acceptor_->async_accept([this](const boost::system::error_code& ec, tcp::socket socket) {
+        if (!ec) {
+            serve(std::move(socket));
+        }
+        if (acceptor_->is_open()) {
+            accept();
+        }
+    });
+}
+
+void MetricsServer::serve(tcp::socket socket) {
+    auto session{std::make_shared<Session>(std::move(socket))};
+
+    // Whatever is still pending past the deadline is aborted by closing the socket
+    session->deadline.expires_after(config_.request_timeout);
+    session->deadline.async_wait([session](const boost::system::error_code& ec) {
+        if (!ec) {
+            boost::system::error_code ignored;
+            session->socket.close(ignored);
+        }
+    });
+
+    boost::asio::async_read_until(
+        session->socket, session->request, "\r\n\r\n", [this, session](const boost::system::error_code& ec, size_t) {
+            if (ec) {
+                session->deadline.cancel();
+                return;
+            }
+            std::istream request_stream{&session->request};
+            session->response = respond(request_stream);
+            boost::asio::async_write(session->socket, boost::asio::buffer(session->response),
+                                     [session](const boost::system::error_code&, size_t) {
+                                         session->deadline.cancel();
+                                         boost::system::error_code ignored;
+                                         session->socket.shutdown(tcp::socket::shutdown_both, ignored);
+                                     });
+        });
+}
+
+std::string MetricsServer::respond(std::istream& request) {
+    std::string method, target;
+    request >> method >> target;
+
+    std::ostringstream body;
+    std::string status{"200 OK"};
+    if (method != "GET") {
+        status = "405 Method Not Allowed";
+    } else if (target != "/metrics") {
+        status = "404 Not Found";
+    } else {
+        registry_.write_prometheus(body);
+    }
+
+    std::ostringstream response;
+    response << "HTTP/1.1 " << status << "\r\n"
+             << "Content-Type: text/plain; version=0.0.4\r\n"
+             << "Content-Length: " << body.str().size() << "\r\n"
+             << "Connection: close\r\n\r\n"
+             << body.str();
+    return response.str();
+}
+
+void MetricsServer::work() {
+    if (acceptor_) {
+        SILKWORM_LOG(LogLevel::Info) << "Serving metrics at http://" << acceptor_->local_endpoint() << "/metrics"
+                                     << std::endl;
+        accept();
+    }
+
+    auto last_summary{std::chrono::steady_clock::now()};
+    while (!is_stopping()) {
+        if (acceptor_) {
+            if (io_context_.stopped()) {
+                io_context_.restart();
+            }
+            io_context_.run_for(std::chrono::milliseconds(500));
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        }
+
+        const auto now{std::chrono::steady_clock::now()};
+        if (config_.summary_interval.count() && now - last_summary >= config_.summary_interval) {
+            SILKWORM_LOG(LogLevel::Info) << "Metrics" << summary(now - last_summary) << std::endl;
+            last_summary = now;
+        }
+    }
+
+    if (acceptor_) {
+        boost::system::error_code ec;
+        acceptor_->close(ec);
+    }
+}
+
+}  // namespace silkworm::metrics
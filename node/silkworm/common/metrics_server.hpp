@@ -0,0 +1,69 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_COMMON_METRICS_SERVER_HPP_
+#define SILKWORM_COMMON_METRICS_SERVER_HPP_
+
+#include <chrono>
+#include <istream>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <boost/asio.hpp>
+
+#include <silkworm/common/metrics.hpp>
+#include <silkworm/concurrency/worker.hpp>
+
+namespace silkworm::metrics {
+
+// Serves the metrics of a Registry over HTTP at GET /metrics (Prometheus text format) and periodically logs a summary
+// line with the rate per second of every counter and the value of every gauge. Connections are served asynchronously
+// and dropped after request_timeout, so a slow or idle client can't hold up scrapes.
+class MetricsServer final : public Worker {
+  public:
+    struct Config {
+        std::string address{"127.0.0.1"};
+        uint16_t port{0};                                  // 0 means no HTTP endpoint, only summaries
+        std::chrono::seconds summary_interval{30};         // 0 means no summaries
+        std::chrono::milliseconds request_timeout{5'000};  // to receive a request and send its response
+    };
+
+    MetricsServer(Registry& registry, Config config);
+    ~MetricsServer() override;
+
+    // Parses "host:port" or "port"; throws std::invalid_argument if malformed
+    static Config parse_endpoint(const std::string& endpoint);
+
+    // Summary of the changes since the previous call, with rates computed over elapsed
+    std::string summary(std::chrono::steady_clock::duration elapsed);
+
+  private:
+    void work() final;
+    void accept();
+    void serve(boost::asio::ip::tcp::socket socket);
+    std::string respond(std::istream& request);
+
+    Registry& registry_;
+    Config config_;
+    boost::asio::io_context io_context_;
+    std::unique_ptr<boost::asio::ip::tcp::acceptor> acceptor_;
+    std::map<std::string, uint64_t> last_counters_;
+};
+
+}  // namespace silkworm::metrics
+
+#endif  // SILKWORM_COMMON_METRICS_SERVER_HPP_
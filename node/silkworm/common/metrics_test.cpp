@@ -0,0 +1,116 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "metrics.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "metrics_server.hpp"
+
+namespace silkworm::metrics {
+
+TEST_CASE("Metrics registry") {
+    Registry registry;
+
+    SECTION("Counters and gauges") {
+        Counter& counter{registry.counter("test_total", "A counter")};
+        CHECK(&counter == &registry.counter("test_total", "Same counter"));
+        std::vector<std::thread> threads;
+        for (int i{0}; i < 4; ++i) {
+            threads.emplace_back([&counter]() {
+                for (int j{0}; j < 1000; ++j) {
+                    counter.inc();
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        CHECK(counter.value() == 4000);
+
+        Gauge& gauge{registry.gauge("test_gauge", "A gauge")};
+        gauge.set(10);
+        gauge.add(-3);
+        CHECK(gauge.value() == 7);
+
+        CHECK_THROWS_AS(registry.gauge("test_total", "Not a gauge"), std::logic_error);
+        CHECK(registry.counters().at("test_total") == 4000);
+        CHECK(registry.gauges().at("test_gauge") == 7);
+    }
+
+    SECTION("Histogram") {
+        Histogram& histogram{registry.histogram("test_seconds", "A histogram", {0.1, 1})};
+        histogram.observe(0.05);
+        histogram.observe(0.1);
+        histogram.observe(0.5);
+        histogram.observe(5);
+        CHECK(histogram.bucket_counts() == std::vector<uint64_t>{2, 1, 1});
+        CHECK(histogram.count() == 4);
+        CHECK(histogram.sum() == Approx(5.65));
+
+        CHECK_THROWS_AS(Histogram({1, 0.1}), std::invalid_argument);
+    }
+
+    SECTION("Prometheus format") {
+        registry.counter("test_total", "A counter").inc(3);
+        registry.histogram("test_seconds", "A histogram", {1}).observe(0.5);
+
+        std::ostringstream os;
+        registry.write_prometheus(os);
+        CHECK(os.str() ==
+              "# HELP test_seconds A histogram\n"
+              "# TYPE test_seconds histogram\n"
+              "test_seconds_bucket{le=\"1\"} 1\n"
+              "test_seconds_bucket{le=\"+Inf\"} 1\n"
+              "test_seconds_sum 0.5\n"
+              "test_seconds_count 1\n"
+              "# HELP test_total A counter\n"
+              "# TYPE test_total counter\n"
+              "test_total 3\n");
+    }
+}
+
+TEST_CASE("Metrics server") {
+    SECTION("Endpoint") {
+        auto config{MetricsServer::parse_endpoint("0.0.0.0:9100")};
+        CHECK(config.address == "0.0.0.0");
+        CHECK(config.port == 9100);
+        config = MetricsServer::parse_endpoint("9100");
+        CHECK(config.address == "127.0.0.1");
+        CHECK(config.port == 9100);
+        CHECK_THROWS_AS(MetricsServer::parse_endpoint("localhost:"), std::invalid_argument);
+        CHECK_THROWS_AS(MetricsServer::parse_endpoint("localhost:99999"), std::invalid_argument);
+    }
+
+    SECTION("Summary") {
+        Registry registry;
+        Counter& counter{registry.counter("test_total", "A counter")};
+        registry.gauge("test_gauge", "A gauge").set(42);
+        MetricsServer server{registry, MetricsServer::Config{}};
+
+        counter.inc(20);
+        CHECK(server.summary(std::chrono::seconds(10)) == " test_total=2.0/s test_gauge=42");
+        // Counters not moving are left out
+        CHECK(server.summary(std::chrono::seconds(10)) == " test_gauge=42");
+    }
+}
+
+}  // namespace silkworm::metrics
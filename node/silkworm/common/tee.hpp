@@ -17,6 +17,7 @@
 #ifndef SILKWORM_COMMON_TEE_HPP_
 #define SILKWORM_COMMON_TEE_HPP_
 
+#include <algorithm>
 #include <cstdio>
 #include <ctime>
 #include <fstream>
@@ -49,6 +50,13 @@ class teebuf : public std::streambuf {
         }
     }
 
+    // Write whole sequences at once rather than char by char.
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        std::streamsize const r1 = sb1->sputn(s, n);
+        std::streamsize const r2 = sb2->sputn(s, n);
+        return std::min(r1, r2);
+    }
+
     // Sync both teed buffers.
     int sync() override {
         int const r1 = sb1->pubsync();
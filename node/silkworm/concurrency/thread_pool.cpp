@@ -0,0 +1,71 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+namespace silkworm {
+
+ThreadPool::ThreadPool(size_t num_threads) {
+    num_threads = std::max<size_t>(num_threads, 1);
+    threads_.reserve(num_threads);
+    for (size_t i{0}; i < num_threads; ++i) {
+        threads_.emplace_back([this]() { work(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::unique_lock lock{mtx_};
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+size_t ThreadPool::pending() const {
+    std::unique_lock lock{mtx_};
+    return tasks_.size();
+}
+
+void ThreadPool::push(std::function<void()> task) {
+    {
+        std::unique_lock lock{mtx_};
+        tasks_.push(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+void ThreadPool::work() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock{mtx_};
+            cv_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;  // stopping and drained
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop();
+        }
+        task();
+    }
+}
+
+}  // namespace silkworm
@@ -0,0 +1,72 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_CONCURRENCY_THREAD_POOL_HPP_
+#define SILKWORM_CONCURRENCY_THREAD_POOL_HPP_
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace silkworm {
+
+// A fixed set of threads running submitted tasks in FIFO order.
+// Tasks still queued on destruction are run before threads are joined.
+class ThreadPool {
+  public:
+    explicit ThreadPool(size_t num_threads = std::max(std::thread::hardware_concurrency(), 1u));
+    ~ThreadPool();
+
+    /* Not movable nor copyable */
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Queues a task; the returned future yields its result (or rethrows its exception)
+    template <class F>
+    auto submit(F&& task) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using result_t = std::invoke_result_t<std::decay_t<F>>;
+        auto packaged = std::make_shared<std::packaged_task<result_t()>>(std::forward<F>(task));
+        std::future<result_t> result{packaged->get_future()};
+        push([packaged]() { (*packaged)(); });
+        return result;
+    }
+
+    [[nodiscard]] size_t size() const { return threads_.size(); }
+
+    // Number of tasks waiting for a thread
+    [[nodiscard]] size_t pending() const;
+
+  private:
+    void push(std::function<void()> task);
+    void work();
+
+    std::vector<std::thread> threads_;
+    std::queue<std::function<void()>> tasks_;
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    bool stopping_{false};
+};
+
+}  // namespace silkworm
+
+#endif  // SILKWORM_CONCURRENCY_THREAD_POOL_HPP_
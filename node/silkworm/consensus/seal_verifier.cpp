@@ -0,0 +1,127 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "seal_verifier.hpp"
+
+namespace silkworm::consensus {
+
+SealVerifier::SealVerifier(size_t num_workers, bool full_dataset, size_t cache_capacity)
+    : cache_{cache_capacity, full_dataset} {
+    threads_.reserve(num_workers);
+    for (size_t i{0}; i < num_workers; ++i) {
+        threads_.emplace_back(&SealVerifier::work, this);
+    }
+}
+
+SealVerifier::~SealVerifier() {
+    {
+        std::lock_guard lock{batch_mtx_};
+        stopping_ = true;
+    }
+    batch_cv_.notify_all();
+    for (std::thread& t : threads_) {
+        t.join();
+    }
+}
+
+double SealVerifier::headers_per_second() const noexcept {
+    std::lock_guard lock{verify_mtx_};
+    const auto seconds{std::chrono::duration<double>(busy_time_).count()};
+    return seconds > 0 ? static_cast<double>(verified_headers_.load()) / seconds : 0.0;
+}
+
+std::vector<ValidationResult> SealVerifier::verify(const std::vector<BlockHeader>& headers) {
+    std::vector<ValidationResult> results(headers.size(), ValidationResult::kOk);
+    if (headers.empty()) {
+        return results;
+    }
+
+    std::lock_guard verify_lock{verify_mtx_};
+    const auto start{std::chrono::steady_clock::now()};
+
+    const Batch batch{&headers, &results};
+    {
+        std::lock_guard lock{batch_mtx_};
+        batch_ = batch;
+        ++batch_id_;
+        next_index_.store(0);
+    }
+    batch_cv_.notify_all();
+
+    process(batch);
+
+    {
+        // Every header has been claimed by now: wait for the workers still verifying theirs
+        // and retire the batch so that late wakers don't pick it up
+        std::unique_lock lock{batch_mtx_};
+        done_cv_.wait(lock, [this] { return active_workers_ == 0; });
+        batch_ = {};
+    }
+
+    verified_headers_ += headers.size();
+    busy_time_ += std::chrono::steady_clock::now() - start;
+    return results;
+}
+
+void SealVerifier::work() {
+    uint64_t last_batch_id{0};
+    while (true) {
+        Batch batch;
+        {
+            std::unique_lock lock{batch_mtx_};
+            batch_cv_.wait(lock, [&] { return stopping_ || batch_id_ != last_batch_id; });
+            if (stopping_) {
+                return;
+            }
+            last_batch_id = batch_id_;
+            if (!batch_.headers) {
+                continue;  // Woke up too late: the batch has already been completed
+            }
+            batch = batch_;
+            ++active_workers_;
+        }
+
+        process(batch);
+
+        {
+            std::lock_guard lock{batch_mtx_};
+            --active_workers_;
+        }
+        done_cv_.notify_all();
+    }
+}
+
+void SealVerifier::process(const Batch& batch) {
+    const std::vector<BlockHeader>& headers{*batch.headers};
+    std::shared_ptr<const EpochContext> context{nullptr};
+    for (size_t i{next_index_++}; i < headers.size(); i = next_index_++) {
+        const BlockHeader& header{headers[i]};
+        const auto epoch_number{static_cast<int>(header.number / ethash::epoch_length)};
+        if (!context || context->epoch_number() != epoch_number) {
+            context = epoch_context(epoch_number);
+        }
+        const bool valid{context && context->verify(header)};
+        (*batch.results)[i] = valid ? ValidationResult::kOk : ValidationResult::kInvalidSeal;
+    }
+}
+
+std::shared_ptr<const EpochContext> SealVerifier::epoch_context(int epoch_number) {
+    // Building a context happens once per epoch, meanwhile other threads needing one wait
+    std::lock_guard lock{cache_mtx_};
+    return cache_.get(epoch_number);
+}
+
+}  // namespace silkworm::consensus
@@ -0,0 +1,94 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+#ifndef SILKWORM_CONSENSUS_SEAL_VERIFIER_HPP_
+#define SILKWORM_CONSENSUS_SEAL_VERIFIER_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <silkworm/consensus/ethash/epoch_context.hpp>
+#include <silkworm/consensus/validation.hpp>
+
+namespace silkworm::consensus {
+
+//! \brief Verifies Ethash seals of batches of headers across a pool of threads.
+//! Epoch contexts are shared by all threads through a single EpochContextCache, so each epoch's light cache
+//! (or the dataset of the current epoch, when full_dataset is set) is built once.
+class SealVerifier {
+  public:
+    //! \param [in] num_workers : number of threads besides the caller's one, which takes part in every batch
+    //! \param [in] full_dataset : whether the highest epoch seen gets a full dataset (see EpochContextCache)
+    explicit SealVerifier(size_t num_workers = std::max(std::thread::hardware_concurrency(), 1u) - 1,
+                          bool full_dataset = false,
+                          size_t cache_capacity = EpochContextCache::kDefaultCapacity);
+    ~SealVerifier();
+
+    SealVerifier(const SealVerifier&) = delete;
+    SealVerifier& operator=(const SealVerifier&) = delete;
+
+    //! \brief Verifies the seals of the headers in parallel; blocks until the whole batch is done
+    //! \return Either kOk or kInvalidSeal for each header, in the same order
+    std::vector<ValidationResult> verify(const std::vector<BlockHeader>& headers);
+
+    [[nodiscard]] size_t num_workers() const noexcept { return threads_.size(); }
+
+    //! \brief Total number of headers verified so far
+    [[nodiscard]] uint64_t verified_headers() const noexcept { return verified_headers_.load(); }
+
+    //! \brief Throughput over all batches verified so far
+    [[nodiscard]] double headers_per_second() const noexcept;
+
+  private:
+    struct Batch {
+        const std::vector<BlockHeader>* headers{nullptr};
+        std::vector<ValidationResult>* results{nullptr};
+    };
+
+    void work();
+    void process(const Batch& batch);
+    std::shared_ptr<const EpochContext> epoch_context(int epoch_number);
+
+    std::mutex cache_mtx_;
+    EpochContextCache cache_;
+
+    mutable std::mutex verify_mtx_;  // One batch at a time
+
+    std::mutex batch_mtx_;
+    std::condition_variable batch_cv_;
+    std::condition_variable done_cv_;
+    Batch batch_{};
+    uint64_t batch_id_{0};
+    size_t active_workers_{0};
+    bool stopping_{false};
+    std::atomic<size_t> next_index_{0};
+
+    std::vector<std::thread> threads_;
+
+    std::atomic<uint64_t> verified_headers_{0};
+    std::chrono::nanoseconds busy_time_{0};  // Guarded by verify_mtx_
+};
+
+}  // namespace silkworm::consensus
+
+#endif  // SILKWORM_CONSENSUS_SEAL_VERIFIER_HPP_
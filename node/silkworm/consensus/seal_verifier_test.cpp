@@ -0,0 +1,50 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "seal_verifier.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/test_util.hpp>
+
+namespace silkworm::consensus {
+
+TEST_CASE("Seal verifier") {
+    const BlockHeader valid{test::sample_mainnet_header()};
+    BlockHeader invalid{valid};
+    ++invalid.nonce[0];
+
+    std::vector<BlockHeader> headers;
+    std::vector<ValidationResult> expected;
+    for (size_t i{0}; i < 64; ++i) {
+        headers.push_back(i % 5 == 3 ? invalid : valid);
+        expected.push_back(i % 5 == 3 ? ValidationResult::kInvalidSeal : ValidationResult::kOk);
+    }
+
+    for (const size_t num_workers : {0, 1, 4}) {
+        SealVerifier verifier{num_workers};
+        CHECK(verifier.num_workers() == num_workers);
+        CHECK(verifier.verify({}).empty());
+
+        // Consecutive batches reuse the same workers
+        CHECK(verifier.verify(headers) == expected);
+        CHECK(verifier.verify(headers) == expected);
+        CHECK(verifier.verified_headers() == 2 * headers.size());
+        CHECK(verifier.headers_per_second() > 0);
+    }
+}
+
+}  // namespace silkworm::consensus
@@ -21,6 +21,7 @@
 #include <nlohmann/json.hpp>
 
 #include <silkworm/common/endian.hpp>
+#include <silkworm/common/trace_span.hpp>
 
 #include "bitmap.hpp"
 #include "tables.hpp"
@@ -181,15 +182,35 @@ std::vector<Transaction> read_transactions(mdbx::cursor& txn_table, uint64_t bas
     for (auto data{txn_table.find(to_slice(key), false)}; data.done && i < count;
          data = txn_table.to_next(/*throw_notfound = */ false), ++i) {
         ByteView data_view{from_slice(data.value)};
-        Transaction eth_txn;
+        Transaction& eth_txn{v.emplace_back()};
         rlp::err_handler(rlp::decode(data_view, eth_txn));
-        v.push_back(eth_txn);
+    }
+
+    return v;
+}
+
+std::vector<TransactionView> read_transaction_views(mdbx::cursor& txn_table, uint64_t base_id, uint64_t count) {
+    std::vector<TransactionView> v;
+    if (count == 0) {
+        return v;
+    }
+    v.reserve(count);
+
+    Bytes key(8, '\0');
+    endian::store_big_u64(key.data(), base_id);
+
+    uint64_t i{0};
+    for (auto data{txn_table.find(to_slice(key), false)}; data.done && i < count;
+         data = txn_table.to_next(/*throw_notfound = */ false), ++i) {
+        ByteView data_view{from_slice(data.value)};
+        rlp::err_handler(rlp::decode(data_view, v.emplace_back()));
     }
 
     return v;
 }
 
 std::optional<BlockWithHash> read_block(mdbx::txn& txn, uint64_t block_number, bool read_senders) {
+    SILKWORM_TRACE_SPAN("db::read_block");
     // Locate canonical hash
     auto src{db::open_cursor(txn, table::kCanonicalHashes)};
     auto key{block_key(block_number)};
@@ -253,6 +274,77 @@ std::optional<BlockBody> read_body(mdbx::txn& txn, uint64_t block_number, const
     return out;
 }
 
+void write_header(mdbx::txn& txn, const BlockHeader& header) {
+    Bytes rlp;
+    rlp::encode(rlp, header);
+    const ethash::hash256 hash{keccak256(rlp)};
+
+    auto key{block_key(header.number, hash.bytes)};
+    auto target{db::open_cursor(txn, table::kHeaders)};
+    target.upsert(to_slice(key), to_slice(rlp));
+
+    target = db::open_cursor(txn, table::kHeaderNumbers);
+    Bytes number(8, '\0');
+    endian::store_big_u64(number.data(), header.number);
+    target.upsert(mdbx::slice{hash.bytes, kHashLength}, to_slice(number));
+}
+
+void write_canonical_header_hash(mdbx::txn& txn, const uint8_t (&hash)[kHashLength], uint64_t block_number) {
+    auto target{db::open_cursor(txn, table::kCanonicalHashes)};
+    auto key{block_key(block_number)};
+    target.upsert(to_slice(key), mdbx::slice{hash, kHashLength});
+}
+
+void write_total_difficulty(mdbx::txn& txn, uint64_t block_number, const uint8_t (&hash)[kHashLength],
+                            const intx::uint256& total_difficulty) {
+    Bytes value;
+    rlp::encode(value, total_difficulty);
+    auto target{db::open_cursor(txn, table::kDifficulty)};
+    auto key{block_key(block_number, hash)};
+    target.upsert(to_slice(key), to_slice(value));
+}
+
+void write_body(mdbx::txn& txn, const BlockBody& body, uint64_t block_number, const uint8_t (&hash)[kHashLength]) {
+    detail::BlockBodyForStorage body_for_storage{};
+    body_for_storage.ommers = body.ommers;
+    body_for_storage.txn_count = body.transactions.size();
+    body_for_storage.base_txn_id = increment_map_sequence(txn, table::kEthTx.name, body_for_storage.txn_count);
+
+    auto target{db::open_cursor(txn, table::kBlockBodies)};
+    auto key{block_key(block_number, hash)};
+    Bytes value{body_for_storage.encode()};
+    target.upsert(to_slice(key), to_slice(value));
+
+    if (body.transactions.empty()) {
+        return;
+    }
+    target = db::open_cursor(txn, table::kEthTx);
+    Bytes txn_key(8, '\0');
+    for (size_t i{0}; i < body.transactions.size(); ++i) {
+        endian::store_big_u64(txn_key.data(), body_for_storage.base_txn_id + i);
+        value.clear();
+        rlp::encode(value, body.transactions[i]);
+        target.upsert(to_slice(txn_key), to_slice(value));
+    }
+}
+
+uint64_t increment_map_sequence(mdbx::txn& txn, const char* map_name, uint64_t increment) {
+    uint64_t current{0};
+    auto target{db::open_cursor(txn, table::kSequence)};
+    mdbx::slice key{map_name};
+    auto data{target.find(key, /*throw_notfound=*/false)};
+    if (data.done) {
+        assert(data.value.length() == sizeof(uint64_t));
+        current = endian::load_big_u64(static_cast<uint8_t*>(data.value.iov_base));
+    }
+    if (increment) {
+        Bytes value(8, '\0');
+        endian::store_big_u64(value.data(), current + increment);
+        target.upsert(key, to_slice(value));
+    }
+    return current;
+}
+
 std::vector<evmc::address> read_senders(mdbx::txn& txn, BlockNum block_number, const uint8_t (&hash)[kHashLength]) {
     std::vector<evmc::address> senders{};
 
@@ -29,6 +29,7 @@
 #include <silkworm/db/util.hpp>
 #include <silkworm/types/account.hpp>
 #include <silkworm/types/block.hpp>
+#include <silkworm/types/transaction_view.hpp>
 
 namespace silkworm::db {
 
@@ -57,6 +58,24 @@ std::optional<BlockHeader> read_header(mdbx::txn& txn, uint64_t block_number, co
 std::optional<BlockBody> read_body(mdbx::txn& txn, uint64_t block_number, const uint8_t (&hash)[kHashLength],
                                    bool read_senders);
 
+// See Erigon WriteHeader (also writes the HeaderNumber entry)
+void write_header(mdbx::txn& txn, const BlockHeader& header);
+
+// See Erigon WriteCanonicalHash
+void write_canonical_header_hash(mdbx::txn& txn, const uint8_t (&hash)[kHashLength], uint64_t block_number);
+
+// See Erigon WriteTd
+void write_total_difficulty(mdbx::txn& txn, uint64_t block_number, const uint8_t (&hash)[kHashLength],
+                            const intx::uint256& total_difficulty);
+
+// See Erigon WriteBody
+// Transactions get consecutive ids allocated from the EthTx sequence
+void write_body(mdbx::txn& txn, const BlockBody& body, uint64_t block_number, const uint8_t (&hash)[kHashLength]);
+
+// See Erigon IncrementSequence
+// Returns the value of the sequence before the increment
+uint64_t increment_map_sequence(mdbx::txn& txn, const char* map_name, uint64_t increment);
+
 // See Erigon ReadTd
 std::optional<intx::uint256> read_total_difficulty(mdbx::txn& txn, uint64_t block_number,
                                                    const uint8_t (&hash)[kHashLength]);
@@ -71,6 +90,11 @@ std::vector<evmc::address> read_senders(mdbx::txn& txn, BlockNum block_number, c
 // Overload
 std::vector<Transaction> read_transactions(mdbx::cursor& txn_table, uint64_t base_id, uint64_t count);
 
+// Same as read_transactions but transactions are not decoded.
+// Returned views point into database pages, hence they are valid only as long as
+// the database transaction is alive and the table is not modified.
+std::vector<TransactionView> read_transaction_views(mdbx::cursor& txn_table, uint64_t base_id, uint64_t count);
+
 std::optional<ByteView> read_code(mdbx::txn& txn, const evmc::bytes32& code_hash);
 
 // Reads current or historical (if block_number is specified) account.
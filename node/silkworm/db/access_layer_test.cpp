@@ -379,6 +379,45 @@ namespace db {
         }
     }
 
+    TEST_CASE("write_header & write_body") {
+        TemporaryDirectory tmp_dir;
+
+        db::EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+        db_config.inmemory = true;
+        auto env{db::open_env(db_config)};
+        auto txn{env.start_write()};
+        table::create_all(txn);
+
+        BlockHeader header;
+        header.number = 11'054'435;
+        header.beneficiary = 0x09ab1303d3ccaf5f018cd511146b07a240c70294_address;
+        header.gas_limit = 12'451'080;
+        const evmc::bytes32 hash{header.hash()};
+
+        write_header(txn, header);
+        write_canonical_header_hash(txn, hash.bytes, header.number);
+        write_total_difficulty(txn, header.number, hash.bytes, 1'000'000);
+
+        CHECK(read_header(txn, header.number, hash.bytes) == header);
+        CHECK(read_total_difficulty(txn, header.number, hash.bytes) == 1'000'000);
+
+        const BlockBody body{sample_block_body()};
+        write_body(txn, body, header.number, hash.bytes);
+        CHECK(increment_map_sequence(txn, table::kEthTx.name, 0) == body.transactions.size());
+
+        std::optional<BlockWithHash> bh{read_block(txn, header.number, /*read_senders=*/false)};
+        REQUIRE(bh);
+        CHECK(bh->block.header == header);
+        CHECK(bh->block.ommers == body.ommers);
+        CHECK(bh->block.transactions == body.transactions);
+
+        // Transaction ids of the next body follow
+        write_body(txn, body, header.number + 1, hash.bytes);
+        CHECK(increment_map_sequence(txn, table::kEthTx.name, 0) == 2 * body.transactions.size());
+        CHECK(read_body(txn, header.number + 1, hash.bytes, /*read_senders=*/false)->transactions ==
+              body.transactions);
+    }
+
     TEST_CASE("read_account") {
         TemporaryDirectory tmp_dir;
         DataDirectory data_dir{tmp_dir.path(), /*create=*/true};
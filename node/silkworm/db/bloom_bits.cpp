@@ -0,0 +1,342 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "bloom_bits.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <silkworm/common/endian.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/tables.hpp>
+
+namespace silkworm::db::bloom_bits {
+
+namespace {
+
+    // geth bitsetEncodeBytes
+    Bytes encode(ByteView data) {
+        if (data.empty()) {
+            return {};
+        }
+        if (data.length() == 1) {
+            return data[0] ? Bytes{data} : Bytes{};
+        }
+        Bytes non_zero_bitset((data.length() + 7) / 8, '\0');
+        Bytes non_zero_bytes;
+        non_zero_bytes.reserve(data.length());
+        for (size_t i{0}; i < data.length(); ++i) {
+            if (data[i]) {
+                non_zero_bytes.push_back(data[i]);
+                non_zero_bitset[i / 8] |= static_cast<uint8_t>(0x80u >> (i % 8));
+            }
+        }
+        if (non_zero_bytes.empty()) {
+            return {};
+        }
+        return encode(non_zero_bitset) + non_zero_bytes;
+    }
+
+    // geth bitsetDecodePartialBytes: fills length bytes of out and returns how many bytes of data were consumed
+    size_t decode(ByteView data, uint8_t* out, size_t length) {
+        if (length == 0) {
+            return 0;
+        }
+        std::memset(out, 0, length);
+        if (data.empty()) {
+            return 0;
+        }
+        if (length == 1) {
+            out[0] = data[0];
+            return data[0] ? 1 : 0;
+        }
+        Bytes non_zero_bitset((length + 7) / 8, '\0');
+        size_t consumed{decode(data, non_zero_bitset.data(), non_zero_bitset.length())};
+        for (size_t i{0}; i < 8 * non_zero_bitset.length(); ++i) {
+            if (non_zero_bitset[i / 8] & (0x80u >> (i % 8))) {
+                if (consumed >= data.length()) {
+                    throw std::runtime_error("Missing data in compressed bloom bits");
+                }
+                if (i >= length) {
+                    throw std::runtime_error("Compressed bloom bits exceed target length");
+                }
+                if (data[consumed] == 0) {
+                    throw std::runtime_error("Zero byte in compressed bloom bits");
+                }
+                out[i] = data[consumed++];
+            }
+        }
+        return consumed;
+    }
+
+    void decompress_vector(ByteView data, BitVector& out) {
+        if (data.length() > kVectorLength) {
+            throw std::runtime_error("Compressed bloom bits exceed target length");
+        }
+        if (data.length() == kVectorLength) {
+            std::memcpy(out.data(), data.data(), kVectorLength);
+        } else if (decode(data, out.data(), kVectorLength) != data.length()) {
+            throw std::runtime_error("Unreferenced data in compressed bloom bits");
+        }
+    }
+
+    // Vector kernels: 16 bytes at a time with SSE2 (always available on x86-64), 8 otherwise
+
+#if defined(__SSE2__)
+    constexpr size_t kStride{16};
+
+    inline __m128i load(const uint8_t* p) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    inline void store(uint8_t* p, __m128i x) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), x); }
+    inline __m128i bit_and(__m128i x, __m128i y) noexcept { return _mm_and_si128(x, y); }
+    inline __m128i bit_or(__m128i x, __m128i y) noexcept { return _mm_or_si128(x, y); }
+    inline bool is_zero(__m128i x) noexcept {
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_setzero_si128())) == 0xFFFF;
+    }
+#else
+    constexpr size_t kStride{8};
+
+    inline uint64_t load(const uint8_t* p) noexcept {
+        uint64_t x;
+        std::memcpy(&x, p, sizeof(x));
+        return x;
+    }
+    inline void store(uint8_t* p, uint64_t x) noexcept { std::memcpy(p, &x, sizeof(x)); }
+    inline uint64_t bit_and(uint64_t x, uint64_t y) noexcept { return x & y; }
+    inline uint64_t bit_or(uint64_t x, uint64_t y) noexcept { return x | y; }
+    inline bool is_zero(uint64_t x) noexcept { return x == 0; }
+#endif
+
+    static_assert(kVectorLength % kStride == 0);
+
+    // sum |= x & y & z
+    void or_and3(BitVector& sum, const BitVector& x, const BitVector& y, const BitVector& z) noexcept {
+        for (size_t i{0}; i < kVectorLength; i += kStride) {
+            const auto product{bit_and(bit_and(load(&x[i]), load(&y[i])), load(&z[i]))};
+            store(&sum[i], bit_or(load(&sum[i]), product));
+        }
+    }
+
+    // product &= x; returns whether product is all zeros
+    bool and_into(BitVector& product, const BitVector& x) noexcept {
+        bool zero{true};
+        for (size_t i{0}; i < kVectorLength; i += kStride) {
+            const auto y{bit_and(load(&product[i]), load(&x[i]))};
+            store(&product[i], y);
+            zero &= is_zero(y);
+        }
+        return zero;
+    }
+
+    std::array<uint16_t, 3> bloom_bits_of(ByteView value) noexcept {
+        const ethash::hash256 hash{keccak256(value)};
+        std::array<uint16_t, 3> bits{};
+        for (size_t i{0}; i < 3; ++i) {
+            bits[i] = static_cast<uint16_t>(((hash.bytes[2 * i] << 8) | hash.bytes[2 * i + 1]) & 0x7FF);
+        }
+        return bits;
+    }
+
+    // Bit i of a bloom is the i-th least significant one counting from its last byte
+    bool bloom_bit(const Bloom& bloom, size_t bit) noexcept {
+        return bloom[kBloomByteLength - 1 - bit / 8] & (1u << (bit % 8));
+    }
+
+}  // namespace
+
+Bytes compress(ByteView data) {
+    Bytes out{encode(data)};
+    if (out.length() < data.length()) {
+        return out;
+    }
+    return Bytes{data};
+}
+
+Bytes decompress(ByteView data, size_t target) {
+    if (data.length() > target) {
+        throw std::runtime_error("Compressed bloom bits exceed target length");
+    }
+    if (data.length() == target) {
+        return Bytes{data};
+    }
+    Bytes out(target, '\0');
+    if (decode(data, out.data(), target) != data.length()) {
+        throw std::runtime_error("Unreferenced data in compressed bloom bits");
+    }
+    return out;
+}
+
+Bytes vector_key(uint16_t bit, uint64_t section, const evmc::bytes32& head_hash) {
+    Bytes key(sizeof(uint16_t) + sizeof(uint64_t) + kHashLength, '\0');
+    endian::store_big_u16(&key[0], bit);
+    endian::store_big_u64(&key[sizeof(uint16_t)], section);
+    std::memcpy(&key[sizeof(uint16_t) + sizeof(uint64_t)], head_hash.bytes, kHashLength);
+    return key;
+}
+
+void SectionGenerator::add_bloom(uint64_t index, const Bloom& bloom) noexcept {
+    const size_t byte_index{static_cast<size_t>(index / 8)};
+    const auto mask{static_cast<uint8_t>(0x80u >> (index % 8))};
+    for (size_t i{0}; i < kBloomByteLength; ++i) {
+        const uint8_t bloom_byte{bloom[kBloomByteLength - 1 - i]};  // bits 8 * i to 8 * i + 7
+        for (size_t j{0}; bloom_byte >> j; ++j) {
+            if (bloom_byte & (1u << j)) {
+                vectors_[8 * i + j][byte_index] |= mask;
+            }
+        }
+    }
+}
+
+Matcher::Matcher(const std::vector<evmc::address>& addresses, const std::vector<std::vector<evmc::bytes32>>& topics) {
+    std::vector<ByteView> values;
+    for (const auto& address : addresses) {
+        values.push_back(full_view(address));
+    }
+    add_group(values);
+    for (const auto& position : topics) {
+        values.clear();
+        for (const auto& topic : position) {
+            values.push_back(full_view(topic));
+        }
+        add_group(values);
+    }
+
+    // Groups were built with bloom bits in place of indices
+    std::sort(bits_.begin(), bits_.end());
+    bits_.erase(std::unique(bits_.begin(), bits_.end()), bits_.end());
+    for (auto& group : groups_) {
+        for (auto& element : group) {
+            for (size_t& bit : element) {
+                bit = static_cast<size_t>(std::lower_bound(bits_.begin(), bits_.end(), bit) - bits_.begin());
+            }
+        }
+    }
+}
+
+void Matcher::add_group(const std::vector<ByteView>& values) {
+    if (values.empty()) {
+        return;  // wildcard
+    }
+    std::vector<Element>& group{groups_.emplace_back()};
+    for (ByteView value : values) {
+        const auto bits{bloom_bits_of(value)};
+        group.push_back({bits[0], bits[1], bits[2]});
+        bits_.insert(bits_.end(), bits.begin(), bits.end());
+    }
+}
+
+BitVector Matcher::match(const std::vector<const BitVector*>& vectors) const noexcept {
+    BitVector result;
+    result.fill(0xFF);
+    BitVector sum;
+    for (const auto& group : groups_) {
+        sum.fill(0);
+        for (const auto& element : group) {
+            or_and3(sum, *vectors[element[0]], *vectors[element[1]], *vectors[element[2]]);
+        }
+        if (and_into(result, sum)) {
+            break;  // no candidates left
+        }
+    }
+    return result;
+}
+
+bool Matcher::matches(const Bloom& bloom) const noexcept {
+    return std::all_of(groups_.begin(), groups_.end(), [&](const auto& group) {
+        return std::any_of(group.begin(), group.end(), [&](const Element& element) {
+            return std::all_of(element.begin(), element.end(),
+                               [&](size_t i) { return bloom_bit(bloom, bits_[i]); });
+        });
+    });
+}
+
+std::vector<BlockNum> find_candidates(mdbx::txn& txn, BlockNum from, BlockNum to, const Matcher& matcher) {
+    std::vector<BlockNum> candidates;
+    if (from > to) {
+        return candidates;
+    }
+
+    auto index_table{open_cursor(txn, table::kBloomBitsIndex)};
+    auto vectors_table{open_cursor(txn, table::kBloomBits)};
+    std::vector<BitVector> vectors(matcher.bits().size());
+    std::vector<const BitVector*> vector_ptrs;
+    for (const auto& vector : vectors) {
+        vector_ptrs.push_back(&vector);
+    }
+
+    BlockNum block_num{from};
+    while (true) {
+        const uint64_t section{block_num / kSectionSize};
+        const auto index_data{index_table.find(to_slice(block_key(section)), /*throw_notfound=*/false)};
+        if (!index_data) {
+            break;
+        }
+        const evmc::bytes32 head_hash{to_bytes32(from_slice(index_data.value))};
+        for (size_t i{0}; i < vectors.size(); ++i) {
+            const Bytes key{vector_key(matcher.bits()[i], section, head_hash)};
+            // All-zero vectors aren't stored
+            if (const auto data{vectors_table.find(to_slice(key), /*throw_notfound=*/false)}; data) {
+                decompress_vector(from_slice(data.value), vectors[i]);
+            } else {
+                vectors[i].fill(0);
+            }
+        }
+
+        const BitVector matched{matcher.match(vector_ptrs)};
+        const BlockNum first{section * kSectionSize};
+        const BlockNum last{std::min(first + kSectionSize - 1, to)};
+        for (BlockNum n{block_num}; n <= last; ++n) {
+            const uint64_t i{n - first};
+            if (!matched[i / 8]) {
+                n = first + i / 8 * 8 + 7;  // skip the rest of the byte
+            } else if (matched[i / 8] & (0x80u >> (i % 8))) {
+                candidates.push_back(n);
+            }
+        }
+
+        if (last == to) {
+            return candidates;
+        }
+        block_num = last + 1;
+    }
+
+    // Past the indexed sections
+    auto canonical_hashes{open_cursor(txn, table::kCanonicalHashes)};
+    for (auto data{canonical_hashes.lower_bound(to_slice(block_key(block_num)), /*throw_notfound=*/false)}; data;
+         data = canonical_hashes.to_next(/*throw_notfound=*/false)) {
+        const BlockNum n{endian::load_big_u64(static_cast<uint8_t*>(data.key.iov_base))};
+        if (n > to) {
+            break;
+        }
+        const evmc::bytes32 hash{to_bytes32(from_slice(data.value))};
+        const std::optional<BlockHeader> header{read_header(txn, n, hash.bytes)};
+        if (!header) {
+            break;
+        }
+        if (matcher.matches(header->logs_bloom)) {
+            candidates.push_back(n);
+        }
+    }
+
+    return candidates;
+}
+
+}  // namespace silkworm::db::bloom_bits
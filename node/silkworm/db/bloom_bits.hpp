@@ -0,0 +1,98 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_DB_BLOOM_BITS_HPP_
+#define SILKWORM_DB_BLOOM_BITS_HPP_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/db/mdbx.hpp>
+#include <silkworm/types/bloom.hpp>
+
+// Bloom bits index as in geth core/bloombits: the logs blooms of every section of consecutive blocks are rotated into
+// one bit vector per bloom bit, where the i-th bit tells whether the bloom of the i-th block of the section has that
+// bit set. Filtering logs then takes 3 vectors per address or topic instead of every header in range.
+//
+// BloomBits         : bit (u16 BE) + section (u64 BE) + hash of the last header of the section -> compressed vector
+// BloomBitsIndex    : section (u64 BE) -> hash of the last header of the section
+namespace silkworm::db::bloom_bits {
+
+constexpr uint64_t kSectionSize{4096};              // blocks per section
+constexpr size_t kBitLength{kBloomByteLength * 8};  // bit vectors per section
+constexpr size_t kVectorLength{kSectionSize / 8};   // bytes per bit vector
+
+using BitVector = std::array<uint8_t, kVectorLength>;
+
+// See geth bitutil.CompressBytes: sparse data is encoded as a bitset of its non-zero bytes (itself compressed
+// recursively) followed by those bytes; data not getting any shorter is left as is
+Bytes compress(ByteView data);
+
+// See geth bitutil.DecompressBytes; throws std::runtime_error if data is malformed or longer than target
+Bytes decompress(ByteView data, size_t target);
+
+// BloomBits key
+Bytes vector_key(uint16_t bit, uint64_t section, const evmc::bytes32& head_hash);
+
+// Rotates the blooms of the blocks of a section into bit vectors
+class SectionGenerator {
+  public:
+    SectionGenerator() : vectors_(kBitLength) {}
+
+    // index is the position of the block within the section
+    void add_bloom(uint64_t index, const Bloom& bloom) noexcept;
+
+    const BitVector& vector(size_t bit) const noexcept { return vectors_[bit]; }
+
+  private:
+    std::vector<BitVector> vectors_;
+};
+
+// Log filter as in eth_getLogs: logs emitted by any of the addresses and having, at each position, any of the topics
+// there. Empty lists match anything. Blooms being probabilistic, the blocks matched are a superset of the blocks
+// having matching logs.
+class Matcher {
+  public:
+    Matcher(const std::vector<evmc::address>& addresses, const std::vector<std::vector<evmc::bytes32>>& topics);
+
+    // Bloom bits of the vectors match() needs, sorted
+    const std::vector<uint16_t>& bits() const noexcept { return bits_; }
+
+    // Candidate blocks of a section; vectors[i] is the vector of bits()[i]
+    BitVector match(const std::vector<const BitVector*>& vectors) const noexcept;
+
+    // Whether a single bloom is a candidate
+    bool matches(const Bloom& bloom) const noexcept;
+
+  private:
+    // Indices into bits_ of the 3 bloom bits of an address or topic
+    using Element = std::array<size_t, 3>;
+
+    void add_group(const std::vector<ByteView>& values);
+
+    std::vector<uint16_t> bits_;
+    std::vector<std::vector<Element>> groups_;  // ANDed together, elements within ORed
+};
+
+// Candidate blocks in [from, to] in ascending order. Sections indexed by stage_bloom_bits are matched vector wise,
+// the remaining blocks by the blooms of their canonical headers.
+std::vector<BlockNum> find_candidates(mdbx::txn& txn, BlockNum from, BlockNum to, const Matcher& matcher);
+
+}  // namespace silkworm::db::bloom_bits
+
+#endif  // SILKWORM_DB_BLOOM_BITS_HPP_
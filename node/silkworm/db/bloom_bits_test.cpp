@@ -0,0 +1,135 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "bloom_bits.hpp"
+
+#include <random>
+#include <stdexcept>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/util.hpp>
+
+namespace silkworm::db::bloom_bits {
+
+using namespace evmc::literals;
+
+TEST_CASE("Bloom bits compression") {
+    SECTION("Sparse data") {
+        const Bytes data{*from_hex("00050000")};
+        const Bytes compressed{compress(data)};
+        CHECK(to_hex(compressed) == "4005");
+        CHECK(decompress(compressed, data.length()) == data);
+    }
+
+    SECTION("Zeros") {
+        CHECK(compress(Bytes(kVectorLength, '\0')).empty());
+        CHECK(decompress({}, kVectorLength) == Bytes(kVectorLength, '\0'));
+    }
+
+    SECTION("Dense data is kept as is") {
+        const Bytes data{*from_hex("0102030405")};
+        CHECK(compress(data) == data);
+        CHECK(decompress(data, data.length()) == data);
+    }
+
+    SECTION("Round trip") {
+        std::mt19937 rng{42};
+        for (size_t density : {1, 10, 100, 400}) {
+            Bytes data(kVectorLength, '\0');
+            for (size_t i{0}; i < density; ++i) {
+                data[rng() % kVectorLength] = static_cast<uint8_t>(rng() % 255 + 1);
+            }
+            const Bytes compressed{compress(data)};
+            CHECK(compressed.length() <= data.length());
+            CHECK(decompress(compressed, kVectorLength) == data);
+        }
+    }
+
+    SECTION("Malformed data") {
+        CHECK_THROWS_AS(decompress(*from_hex("40"), 4), std::runtime_error);          // missing data
+        CHECK_THROWS_AS(decompress(*from_hex("400507"), 4), std::runtime_error);      // unreferenced data
+        CHECK_THROWS_AS(decompress(*from_hex("4000"), 4), std::runtime_error);        // zero byte
+        CHECK_THROWS_AS(decompress(*from_hex("0102030405"), 4), std::runtime_error);  // too long
+    }
+}
+
+TEST_CASE("Bloom bits matching") {
+    const auto address{0x06012c8cf97bead5deae237070f9587f8e7a266d_address};
+    const auto topic{0xddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef_bytes32};
+    const auto other_topic{0x8c5be1e5ebec7d5bd14f71427d1e84f3dd0314c0f7b2291e5b200ac8c7c3b925_bytes32};
+
+    std::mt19937_64 rng{7};
+    std::vector<Bloom> blooms(kSectionSize);
+    SectionGenerator generator;
+    for (uint64_t i{0}; i < kSectionSize; ++i) {
+        std::vector<Log> logs;
+        for (size_t j{0}; j < 3; ++j) {
+            Log log;
+            for (auto& b : log.address.bytes) {
+                b = static_cast<uint8_t>(rng());
+            }
+            logs.push_back(log);
+        }
+        if (i % 100 == 7) {
+            logs.push_back(Log{address, {topic}});
+        } else if (i % 100 == 8) {
+            logs.push_back(Log{address, {other_topic}});
+        }
+        blooms[i] = logs_bloom(logs);
+        generator.add_bloom(i, blooms[i]);
+    }
+
+    const auto check_matcher{[&](const Matcher& matcher) {
+        std::vector<const BitVector*> vectors;
+        for (uint16_t bit : matcher.bits()) {
+            vectors.push_back(&generator.vector(bit));
+        }
+        const BitVector matched{matcher.match(vectors)};
+        size_t count{0};
+        for (uint64_t i{0}; i < kSectionSize; ++i) {
+            const bool candidate{(matched[i / 8] & (0x80u >> (i % 8))) != 0};
+            REQUIRE(candidate == matcher.matches(blooms[i]));
+            count += candidate;
+        }
+        return count;
+    }};
+
+    SECTION("Address") {
+        const Matcher matcher{{address}, {}};
+        CHECK(matcher.bits().size() == 3);
+        CHECK(check_matcher(matcher) >= 2 * kSectionSize / 100);
+    }
+
+    SECTION("Address and topic") {
+        const Matcher matcher{{address}, {{topic}}};
+        const size_t count{check_matcher(matcher)};
+        CHECK(count >= kSectionSize / 100);
+        CHECK(count < 2 * kSectionSize / 100);
+    }
+
+    SECTION("Alternative topics") {
+        CHECK(check_matcher(Matcher{{}, {{topic, other_topic}}}) >= 2 * kSectionSize / 100);
+    }
+
+    SECTION("Wildcards") {
+        const Matcher matcher{{}, {{}, {}}};
+        CHECK(matcher.bits().empty());
+        CHECK(check_matcher(matcher) == kSectionSize);
+    }
+}
+
+}  // namespace silkworm::db::bloom_bits
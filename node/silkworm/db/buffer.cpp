@@ -21,6 +21,8 @@
 #include <absl/container/btree_set.h>
 
 #include <silkworm/common/endian.hpp>
+#include <silkworm/common/metrics.hpp>
+#include <silkworm/common/trace_span.hpp>
 #include <silkworm/types/log_cbor.hpp>
 #include <silkworm/types/receipt_cbor.hpp>
 
@@ -29,6 +31,25 @@
 
 namespace silkworm::db {
 
+namespace {
+
+    // State reads served by the buffer (hits) or by the db (misses)
+    struct BufferMetrics {
+        metrics::Counter& hits{metrics::Registry::instance().counter("silkworm_buffer_state_hits_total",
+                                                                     "State reads served by db::Buffer")};
+        metrics::Counter& misses{metrics::Registry::instance().counter("silkworm_buffer_state_misses_total",
+                                                                       "State reads db::Buffer passed to the db")};
+        metrics::Histogram& write_to_db{metrics::Registry::instance().histogram(
+            "silkworm_buffer_write_to_db_seconds", "Time taken by db::Buffer::write_to_db")};
+    };
+
+    BufferMetrics& buffer_metrics() {
+        static BufferMetrics instance;
+        return instance;
+    }
+
+}  // namespace
+
 void Buffer::bump_batch_size(size_t key_len, size_t value_len) {
     // Approximately matches Erigon's batch size logic in (m *mutation) Put
     static constexpr size_t kEntryOverhead{8};
@@ -156,6 +177,9 @@ void Buffer::write_to_state_table() {
 }
 
 void Buffer::write_to_db() {
+    SILKWORM_TRACE_SPAN("db::Buffer::write_to_db");
+    metrics::ScopedTimer timer{buffer_metrics().write_to_db};
+
     write_to_state_table();
 
     auto incarnation_table{db::open_cursor(txn_, table::kIncarnationMap)};
@@ -214,6 +238,16 @@ void Buffer::write_to_db() {
     for (const auto& entry : logs_) {
         log_table.upsert(to_slice(entry.first), to_slice(entry.second));
     }
+
+    auto call_trace_table{db::open_cursor(txn_, table::kCallTraceSet)};
+    for (const auto& [block_num, traces] : call_traces_) {
+        change_key = block_key(block_num);
+        for (const auto& [address, flags] : traces) {
+            data = full_view(address);
+            data.push_back(flags);
+            call_trace_table.upsert(to_slice(change_key), to_slice(data));
+        }
+    }
 }
 
 // Erigon WriteReceipts in core/rawdb/accessors_chain.go
@@ -239,6 +273,17 @@ void Buffer::insert_receipts(uint64_t block_number, const std::vector<Receipt>&
     }
 }
 
+void Buffer::insert_call_traces(uint64_t block_number, const CallTraces& traces) {
+    auto& block_traces{call_traces_[block_number]};
+    for (const evmc::address& address : traces.senders) {
+        block_traces[address] |= 1;
+    }
+    for (const evmc::address& address : traces.recipients) {
+        block_traces[address] |= 2;
+    }
+    bump_batch_size(8, block_traces.size() * (kAddressLength + 1));
+}
+
 evmc::bytes32 Buffer::state_root_hash() const {
     throw std::runtime_error(std::string(__FUNCTION__).append(" not yet implemented"));
 }
@@ -301,15 +346,19 @@ std::optional<BlockBody> Buffer::read_body(uint64_t block_number, const evmc::by
 
 std::optional<Account> Buffer::read_account(const evmc::address& address) const noexcept {
     if (auto it{accounts_.find(address)}; it != accounts_.end()) {
+        buffer_metrics().hits.inc();
         return it->second;
     }
+    buffer_metrics().misses.inc();
     return db::read_account(txn_, address, historical_block_);
 }
 
 ByteView Buffer::read_code(const evmc::bytes32& code_hash) const noexcept {
     if (auto it{hash_to_code_.find(code_hash)}; it != hash_to_code_.end()) {
+        buffer_metrics().hits.inc();
         return it->second;
     }
+    buffer_metrics().misses.inc();
     std::optional<ByteView> code{db::read_code(txn_, code_hash)};
     if (code.has_value()) {
         return *code;
@@ -323,11 +372,13 @@ evmc::bytes32 Buffer::read_storage(const evmc::address& address, uint64_t incarn
     if (auto it1{storage_.find(address)}; it1 != storage_.end()) {
         if (auto it2{it1->second.find(incarnation)}; it2 != it1->second.end()) {
             if (auto it3{it2->second.find(location)}; it3 != it2->second.end()) {
+                buffer_metrics().hits.inc();
                 return it3->second;
             }
         }
     }
 
+    buffer_metrics().misses.inc();
     return db::read_storage(txn_, address, incarnation, location, historical_block_);
 }
 
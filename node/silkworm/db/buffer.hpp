@@ -26,6 +26,7 @@
 #include <absl/container/flat_hash_set.h>
 
 #include <silkworm/db/util.hpp>
+#include <silkworm/execution/call_traces.hpp>
 #include <silkworm/state/state.hpp>
 #include <silkworm/trie/hash_builder.hpp>
 #include <silkworm/types/account.hpp>
@@ -79,6 +80,9 @@ class Buffer : public State {
 
     void insert_receipts(uint64_t block_number, const std::vector<Receipt>& receipts) override;
 
+    // Erigon CallTraceSet: one address + flags (1 for a sender, 2 for a recipient) per address of a block
+    void insert_call_traces(uint64_t block_number, const CallTraces& traces);
+
     /** @name State changes
      *  Change sets are backward changes of the state, i.e. account/storage values <em>at the beginning of a block</em>.
      */
@@ -140,6 +144,7 @@ class Buffer : public State {
     absl::btree_map<Bytes, evmc::bytes32> storage_prefix_to_code_hash_;
     absl::btree_map<Bytes, Bytes> receipts_;
     absl::btree_map<Bytes, Bytes> logs_;
+    absl::btree_map<uint64_t, absl::btree_map<evmc::address, uint8_t>> call_traces_;  // per block
 
     size_t batch_size_{0};
 
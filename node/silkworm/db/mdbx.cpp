@@ -71,7 +71,21 @@ namespace detail {
         }
     }
 
-    uint32_t flags{MDBX_NOTLS | MDBX_NORDAHEAD | MDBX_COALESCE | MDBX_SYNC_DURABLE};  // Default flags
+    uint32_t flags{MDBX_NOTLS | MDBX_COALESCE};  // Default flags
+    if (!config.read_ahead) {
+        flags |= MDBX_NORDAHEAD;
+    }
+    switch (config.sync_mode) {
+        case SyncMode::kDurable:
+            flags |= MDBX_SYNC_DURABLE;
+            break;
+        case SyncMode::kSafeNoSync:
+            flags |= MDBX_SAFE_NOSYNC;
+            break;
+        case SyncMode::kUtterlyNoSync:
+            flags |= MDBX_UTTERLY_NOSYNC;
+            break;
+    }
 
     if (config.exclusive && config.shared) {
         throw std::runtime_error("Exclusive conflicts with Shared");
@@ -95,14 +109,24 @@ namespace detail {
     if (config.shared) {
         flags |= MDBX_ACCEDE;
     }
+    if (config.write_map && !config.readonly) {
+        flags |= MDBX_WRITEMAP;
+    }
+
+    if (config.page_size < 256 || config.page_size > 64_Kibi || (config.page_size & (config.page_size - 1))) {
+        throw std::invalid_argument("Invalid argument : config.page_size must be a power of 2 in [256, 65536]");
+    }
+    if (!config.inmemory && config.growth_size > config.max_size) {
+        throw std::invalid_argument("Invalid argument : config.growth_size exceeds config.max_size");
+    }
 
     ::mdbx::env_managed::create_parameters cp{};  // Default create parameters
     if (!(config.shared)) {
-        const intptr_t max_map_size = config.inmemory ? 64_Mebi : 2_Tebi;
-        const intptr_t growth_size = config.inmemory ? 2_Mebi : 2_Gibi;
+        const auto max_map_size = static_cast<intptr_t>(config.inmemory ? 64_Mebi : config.max_size);
+        const auto growth_size = static_cast<intptr_t>(config.inmemory ? 2_Mebi : config.growth_size);
         cp.geometry.make_dynamic(::mdbx::env::geometry::default_value, max_map_size);
         cp.geometry.growth_step = growth_size;
-        cp.geometry.pagesize = 4_Kibi;
+        cp.geometry.pagesize = static_cast<intptr_t>(config.page_size);
     }
 
     ::mdbx::env::operate_parameters op{};  // Operational parameters
@@ -137,6 +161,8 @@ namespace detail {
     return ret;
 }
 
+void checkpoint(::mdbx::env& env) { env.sync_to_disk(/*force=*/true, /*nonblock=*/false); }
+
 ::mdbx::map_handle open_map(::mdbx::txn& tx, const MapConfig& config) {
     return tx.create_map(config.name, config.key_mode, config.value_mode);
 }
@@ -44,16 +44,29 @@ constexpr std::string_view kDbLockFileName{"mdbx.lck"};
 //! \remarks Return value signals whether the loop should continue on next record
 using WalkFunc = std::function<bool(::mdbx::cursor& _cursor, ::mdbx::cursor::move_result& _data)>;
 
+//! \brief How commits are flushed to disk
+enum class SyncMode {
+    kDurable,       // Every commit is synced (MDBX_SYNC_DURABLE)
+    kSafeNoSync,    // Commits are not synced: a crash may lose the last ones but never corrupts db (MDBX_SAFE_NOSYNC)
+    kUtterlyNoSync  // Nothing is synced: a system crash may corrupt db (MDBX_UTTERLY_NOSYNC)
+};
+
 //! \brief Essential environment settings
 struct EnvConfig {
     std::string path{};
-    bool create{false};         // Whether db file must be created
-    bool readonly{false};       // Whether db should be opened in RO mode
-    bool exclusive{false};      // Whether this process has exclusive access
-    bool inmemory{false};       // Whether this db is in memory
-    bool shared{false};         // Whether this process opens a db already opened by another process
-    uint32_t max_tables{128};   // Default max number of named tables
-    uint32_t max_readers{100};  // Default max number of readers
+    bool create{false};          // Whether db file must be created
+    bool readonly{false};        // Whether db should be opened in RO mode
+    bool exclusive{false};       // Whether this process has exclusive access
+    bool inmemory{false};        // Whether this db is in memory
+    bool shared{false};          // Whether this process opens a db already opened by another process
+    uint32_t max_tables{128};    // Default max number of named tables
+    uint32_t max_readers{100};   // Default max number of readers
+    size_t page_size{4_Kibi};    // Page size, only for new dbs (a power of 2 between 256 B and 64 KiB)
+    size_t max_size{2_Tebi};     // Max size of the data file (ignored for inmemory)
+    size_t growth_size{2_Gibi};  // Increment of the data file size (ignored for inmemory)
+    bool write_map{false};       // Whether pages are written through a writable memory map (MDBX_WRITEMAP)
+    bool read_ahead{false};      // Whether the OS may read ahead, which helps sequential scans of large tables
+    SyncMode sync_mode{SyncMode::kDurable};
 };
 
 //! \brief Configuration settings for a "map" (aka a table)
@@ -69,6 +82,11 @@ struct MapConfig {
 //! \remarks May throw exceptions
 ::mdbx::env_managed open_env(const EnvConfig& config);
 
+//! \brief Flushes to disk all commits not synced yet, i.e. a durable checkpoint for envs opened with a no-sync mode
+//! \param [in] env : the environment to flush
+//! \remarks To be invoked at stage boundaries, so that a crash can only lose the stage in progress
+void checkpoint(::mdbx::env& env);
+
 //! \brief Opens an mdbx "map" (aka table)
 //! \param [in] tx : a reference to a valid mdbx transaction
 //! \param [in] config : the configuration settings for the map
@@ -39,6 +39,7 @@ constexpr const char* kStorageHistoryIndexKey{"StorageHistoryIndex"}; // Generat
 constexpr const char* kLogIndexKey{"LogIndex"};                       // Generating logs index (from receipts)
 constexpr const char* kCallTracesKey{"CallTraces"};                   // Generating call traces index
 constexpr const char* kTxLookupKey{"TxLookup"};                       // Generating transactions lookup index
+constexpr const char* kBloomBitsKey{"BloomBits"};                     // Rotating header blooms into bloom bits sections
 constexpr const char* kTxPoolKey{"TxPool"};                           // Starts Backend
 constexpr const char* kFinishKey{"Finish"};                           // Nominal stage after all other stages
 
@@ -62,6 +63,7 @@ constexpr const char* kAllStages[]{
     kLogIndexKey,
     kCallTracesKey,
     kTxLookupKey,
+    kBloomBitsKey,
     kTxPoolKey,
     kFinishKey,
 };
@@ -148,5 +148,34 @@ namespace detail {
         return to;
     }
 
+    BlockBodyForStorageView decode_stored_block_body_view(ByteView& from) {
+        auto [header, err]{rlp::decode_header(from)};
+        rlp::err_handler(err);
+        if (!header.list) {
+            rlp::err_handler(rlp::DecodingResult::kUnexpectedString);
+        }
+        uint64_t leftover{from.length() - header.payload_length};
+
+        BlockBodyForStorageView to;
+        rlp::err_handler(rlp::decode(from, to.base_txn_id));
+        rlp::err_handler(rlp::decode(from, to.txn_count));
+
+        // Only walk the list header of ommers
+        const ByteView ommers_begin{from};
+        auto [ommers_header, ommers_err]{rlp::decode_header(from)};
+        rlp::err_handler(ommers_err);
+        if (!ommers_header.list) {
+            rlp::err_handler(rlp::DecodingResult::kUnexpectedString);
+        }
+        from.remove_prefix(ommers_header.payload_length);
+        to.ommers_rlp = ommers_begin.substr(0, ommers_begin.length() - from.length());
+
+        if (from.length() != leftover) {
+            throw rlp::DecodingError{rlp::DecodingResult::kListLengthMismatch};
+        }
+
+        return to;
+    }
+
 }  // namespace detail
 }  // namespace silkworm::db
@@ -206,6 +206,17 @@ namespace detail {
 
     BlockBodyForStorage decode_stored_block_body(ByteView& from);
 
+    // Same as BlockBodyForStorage but ommers are left undecoded:
+    // ommers_rlp is a view over the source buffer (RLP list header included)
+    struct BlockBodyForStorageView {
+        uint64_t base_txn_id{0};
+        uint64_t txn_count{0};
+        ByteView ommers_rlp{};
+    };
+
+    // Cheaper alternative to decode_stored_block_body for those who don't need ommers
+    BlockBodyForStorageView decode_stored_block_body_view(ByteView& from);
+
 }  // namespace detail
 }  // namespace silkworm::db
 
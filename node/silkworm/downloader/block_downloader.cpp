@@ -0,0 +1,520 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "block_downloader.hpp"
+
+#include <deque>
+#include <iterator>
+#include <list>
+#include <map>
+#include <numeric>
+
+#include <silkworm/common/cast.hpp>
+#include <silkworm/common/log.hpp>
+#include <silkworm/consensus/engine.hpp>
+#include <silkworm/consensus/noproof/engine.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/stages.hpp>
+#include <silkworm/db/tables.hpp>
+#include <silkworm/db/util.hpp>
+
+#include "internals/DbTx.hpp"
+#include "internals/random_number.hpp"
+#include "packets/BlockBodiesPacket.hpp"
+#include "packets/BlockHeadersPacket.hpp"
+#include "packets/GetBlockBodiesPacket.hpp"
+#include "packets/GetBlockHeadersPacket.hpp"
+#include "packets/RLPEth66PacketCoding.hpp"
+#include "rpc/PenalizePeer.hpp"
+#include "rpc/ReceiveMessages.hpp"
+#include "rpc/SendMessageByMinBlock.hpp"
+
+namespace silkworm {
+
+// Reads the request id of an eth/66 packet without decoding the rest
+static std::optional<uint64_t> eth66_request_id(ByteView data) {
+    auto [header, err]{rlp::decode_header(data)};
+    if (err != rlp::DecodingResult::kOk || !header.list) return std::nullopt;
+    uint64_t request_id{0};
+    if (rlp::decode(data, request_id) != rlp::DecodingResult::kOk) return std::nullopt;
+    return request_id;
+}
+
+static bool is_empty_body(const BlockHeader& header) {
+    return header.ommers_hash == kEmptyListHash && header.transactions_root == kEmptyRoot;
+}
+
+BlockDownloader::BlockDownloader(SentryClient& sentry, mdbx::env env, Config config)
+    : sentry_{sentry},
+      env_{env},
+      config_{config},
+      pool_{std::max<size_t>(config.validation_threads, 1)} {
+    config_.skeleton_stride = std::max<uint64_t>(config_.skeleton_stride, 2);  // anchors must not be adjacent
+    config_.max_outstanding_requests = std::max<size_t>(config_.max_outstanding_requests, 1);
+    config_.bodies_per_request = std::max<size_t>(config_.bodies_per_request, 1);
+    config_.body_write_batch = std::max<size_t>(config_.body_write_batch, 1);
+
+    DbTx db{env_};
+    chain_config_ = db.read_chain_config();
+    if (!chain_config_) {
+        throw std::runtime_error("BlockDownloader: chain config not found in db");
+    }
+    // the header rules of ethash & noproof chains are the same, ethash seals are left to seal_verifier_ (in batches)
+    const SealEngineType seal_engine = chain_config_->seal_engine;
+    if (seal_engine == SealEngineType::kEthash || seal_engine == SealEngineType::kNoProof) {
+        header_engine_ = std::make_unique<consensus::ConsensusEngineNoproof>(*chain_config_);
+    }
+    if (config_.verify_seals && seal_engine == SealEngineType::kEthash) {
+        seal_verifier_ = std::make_unique<consensus::SealVerifier>();
+    }
+}
+
+void BlockDownloader::execution_loop() {
+    try {
+        rpc::ReceiveMessages receive_messages(rpc::ReceiveMessages::Scope::BlockAnnouncements);
+        sentry_.exec_remotely(receive_messages);
+
+        while (!stopping_ && !sentry_.closing() && receive_messages.receive_one_reply()) {
+            const sentry::InboundMessage& message = receive_messages.reply();
+            if (message.id() == sentry::MessageId::BLOCK_HEADERS_66 ||
+                message.id() == sentry::MessageId::BLOCK_BODIES_66) {
+                replies_.push(std::make_shared<sentry::InboundMessage>(message));
+            }
+        }
+
+        SILKWORM_LOG(LogLevel::Warn) << "BlockDownloader execution_loop is_stopping...\n";
+    }
+    catch(const std::exception& e) {
+        SILKWORM_LOG(LogLevel::Error) << "BlockDownloader execution_loop is_stopping due to exception: " << e.what()
+                                      << "\n";
+        sentry_.need_close();
+    }
+}
+
+BlockNum BlockDownloader::wind(BlockNum target) {
+    BlockNum headers_progress = download_headers(target);
+    SILKWORM_LOG(LogLevel::Info) << "BlockDownloader headers up to " << headers_progress << ", stats: " << stats()
+                                 << "\n";
+
+    BlockNum bodies_progress = download_bodies(target);
+    SILKWORM_LOG(LogLevel::Info) << "BlockDownloader bodies up to " << bodies_progress << ", stats: " << stats()
+                                 << "\n";
+    return bodies_progress;
+}
+
+BlockNum BlockDownloader::download_headers(BlockNum target) {
+    DbTx db{env_};
+    BlockNum from = db.stage_progress(db::stages::kHeadersKey);
+
+    while (from < target && !stopping_ && !sentry_.closing()) {
+        db.renew();
+        std::optional<Hash> from_hash = db.read_canonical_hash(from);
+        std::optional<BlockHeader> from_header;
+        std::optional<intx::uint256> total_difficulty;
+        if (from_hash) {
+            from_header = db.read_header(from, *from_hash);
+            total_difficulty = db.read_total_difficulty(from, *from_hash);
+        }
+        db.park();  // nothing else to read until the next skeleton
+        if (!from_header || !total_difficulty) {
+            throw std::runtime_error("BlockDownloader: header " + std::to_string(from) + " not found in db");
+        }
+        from_header->cache_hashes();
+
+        HeaderSkeleton skeleton{from, target, config_.skeleton_stride, config_.skeleton_max_anchors};
+        if (!download_skeleton(skeleton, *from_header, *total_difficulty)) {
+            ++discarded_skeletons_;
+            continue;  // from scratch, hopefully with other peers
+        }
+        from = skeleton.last();
+    }
+    return from;
+}
+
+bool BlockDownloader::download_skeleton(const HeaderSkeleton& skeleton, const BlockHeader& from_header,
+                                        intx::uint256& total_difficulty) {
+    const BlockNum from = from_header.number;
+
+    // Returns a job requesting headers and accepting a reply only if verify(headers) succeeds
+    auto make_job = [](const GetBlockHeadersPacket& request, std::vector<BlockHeader>& headers,
+                       std::function<ValidationResult(std::vector<BlockHeader>&)> verify) {
+        Job job;
+        job.message_id = sentry::MessageId::GET_BLOCK_HEADERS_66;
+        job.min_block = std::get<BlockNum>(request.origin) + (request.amount - 1) * (request.skip + 1);
+        job.encode = [request](uint64_t request_id) {
+            GetBlockHeadersPacket66 packet{request_id, request};
+            Bytes rlp;
+            rlp::encode(rlp, packet);
+            return rlp;
+        };
+        job.accept = [&headers, verify = std::move(verify)](const sentry::InboundMessage& message) {
+            BlockHeadersPacket66 packet;
+            ByteView data = string_view_to_byte_view(message.data());
+            if (rlp::decode(data, packet) != rlp::DecodingResult::kOk) return Outcome::kBad;
+            if (verify(packet.request) != ValidationResult::kOk) return Outcome::kBad;
+            headers = std::move(packet.request);
+            return Outcome::kDone;
+        };
+        return job;
+    };
+
+    // 1) the anchors, from a single peer
+    std::vector<BlockHeader> anchors;
+    if (skeleton.anchors() > 0) {
+        const uint64_t stride = config_.skeleton_stride;
+        const uint64_t count = skeleton.anchors();
+        std::vector<Job> jobs;
+        jobs.push_back(make_job(skeleton.skeleton_request(), anchors,
+                                [from, stride, count](std::vector<BlockHeader>& headers) {
+                                    if (headers.size() != count) return ValidationResult::kUnknownParent;
+                                    for (size_t i = 0; i < headers.size(); ++i) {
+                                        if (headers[i].number != from + (i + 1) * stride) {
+                                            return ValidationResult::kUnknownParent;
+                                        }
+                                        headers[i].cache_hashes();
+                                    }
+                                    return ValidationResult::kOk;
+                                }));
+        if (!run(jobs)) return false;
+    }
+
+    // 2) the gaps, from many peers; each one is verified against the anchors (or the db header) around it, and so
+    // every header against its parent, anchors included
+    const std::vector<HeaderSkeleton::Segment>& segments = skeleton.segments();
+    std::vector<std::vector<BlockHeader>> filled(segments.size());
+    std::vector<Job> jobs;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        const HeaderSkeleton::Segment& segment = segments[i];
+        const BlockNum parent_number = segment.first - 1;
+        const BlockHeader* parent{&from_header};
+        if (parent_number > from) {
+            parent = &anchors[(parent_number - from) / config_.skeleton_stride - 1];
+        }
+        const BlockHeader* anchor{nullptr};
+        if (segment.anchored) {
+            anchor = &anchors[(segment.first + segment.count - from) / config_.skeleton_stride - 1];
+        }
+        const uint64_t count = segment.count;
+        consensus::IConsensusEngine* engine = header_engine_.get();
+        jobs.push_back(make_job(skeleton.fill_request(segment), filled[i],
+                                [parent, anchor, count, engine](std::vector<BlockHeader>& headers) {
+                                    if (headers.size() != count) return ValidationResult::kUnknownParent;
+                                    return verify_segment(headers, *parent, anchor, engine);
+                                }));
+    }
+    if (!run(jobs)) return false;
+
+    // 3) all together, in order
+    std::vector<BlockHeader> headers;
+    headers.reserve(skeleton.last() - from);
+    size_t next_anchor = 0;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        std::move(filled[i].begin(), filled[i].end(), std::back_inserter(headers));
+        if (segments[i].anchored) {
+            headers.push_back(std::move(anchors[next_anchor++]));
+        }
+    }
+
+    if (seal_verifier_) {
+        std::vector<ValidationResult> results = seal_verifier_->verify(headers);
+        auto invalid = std::find_if(results.begin(), results.end(),
+                                    [](ValidationResult r) { return r != ValidationResult::kOk; });
+        if (invalid != results.end()) {
+            SILKWORM_LOG(LogLevel::Warn) << "BlockDownloader invalid seal of header "
+                                         << headers[static_cast<size_t>(invalid - results.begin())].number
+                                         << ", skeleton discarded\n";
+            return false;
+        }
+    }
+
+    save_headers(headers, total_difficulty);
+    return true;
+}
+
+BlockNum BlockDownloader::download_bodies(BlockNum target) {
+    DbTx db{env_};
+    BlockNum from = db.stage_progress(db::stages::kBlockBodiesKey);
+    const BlockNum to = std::min(target, db.stage_progress(db::stages::kHeadersKey));
+    const size_t window = config_.max_outstanding_requests * config_.bodies_per_request;
+
+    while (from < to && !stopping_ && !sentry_.closing()) {
+        db.renew();
+        const BlockNum last = std::min<BlockNum>(to, from + window);
+
+        std::vector<BlockHeader> headers;
+        headers.reserve(last - from);
+        for (BlockNum number = from + 1; number <= last; ++number) {
+            std::optional<BlockHeader> header = db.read_canonical_header(number);
+            if (!header) {
+                throw std::runtime_error("BlockDownloader: header " + std::to_string(number) + " not found in db");
+            }
+            header->cache_hashes();
+            headers.push_back(std::move(*header));
+        }
+        db.park();  // nothing else to read until the next window
+
+        // empty bodies need no request
+        std::vector<std::optional<BlockBody>> bodies(headers.size());
+        std::vector<size_t> to_request;
+        for (size_t i = 0; i < headers.size(); ++i) {
+            if (is_empty_body(headers[i]))
+                bodies[i] = BlockBody{};
+            else
+                to_request.push_back(i);
+        }
+
+        // one job per chunk of bodies; on partial replies the job asks for what is missing
+        struct Chunk {
+            std::vector<size_t> indexes;
+            size_t next{0};  // first index still missing
+        };
+        std::vector<Job> jobs;
+        for (size_t begin = 0; begin < to_request.size(); begin += config_.bodies_per_request) {
+            size_t end = std::min(to_request.size(), begin + config_.bodies_per_request);
+            auto chunk = std::make_shared<Chunk>();
+            chunk->indexes.assign(to_request.begin() + static_cast<long>(begin),
+                                  to_request.begin() + static_cast<long>(end));
+
+            Job job;
+            job.message_id = sentry::MessageId::GET_BLOCK_BODIES_66;
+            job.min_block = headers[chunk->indexes.back()].number;
+            job.encode = [chunk, &headers](uint64_t request_id) {
+                GetBlockBodiesPacket66 packet;
+                packet.requestId = request_id;
+                for (size_t i = chunk->next; i < chunk->indexes.size(); ++i) {
+                    packet.request.push_back(Hash{headers[chunk->indexes[i]].hash()});
+                }
+                Bytes rlp;
+                rlp::encode(rlp, packet);
+                return rlp;
+            };
+            job.accept = [chunk, &headers, &bodies](const sentry::InboundMessage& message) {
+                BlockBodiesPacket66 packet;
+                ByteView data = string_view_to_byte_view(message.data());
+                if (rlp::decode(data, packet) != rlp::DecodingResult::kOk) return Outcome::kBad;
+                const size_t missing = chunk->indexes.size() - chunk->next;
+                if (packet.request.empty() || packet.request.size() > missing) return Outcome::kBad;
+                for (size_t i = 0; i < packet.request.size(); ++i) {
+                    const BlockHeader& header = headers[chunk->indexes[chunk->next + i]];
+                    if (consensus::validate_body_roots(header, packet.request[i]) != ValidationResult::kOk) {
+                        return Outcome::kBad;
+                    }
+                }
+                for (BlockBody& body : packet.request) {
+                    bodies[chunk->indexes[chunk->next++]] = std::move(body);
+                }
+                return chunk->next == chunk->indexes.size() ? Outcome::kDone : Outcome::kPartial;
+            };
+            jobs.push_back(std::move(job));
+        }
+        if (!run(jobs)) continue;  // the window from scratch, if not stopping
+
+        save_bodies(headers, bodies);
+        from = last;
+    }
+    return from;
+}
+
+bool BlockDownloader::run(std::vector<Job>& jobs) {
+    using namespace std::chrono_literals;
+
+    struct Pending {
+        size_t job;
+        clock::time_point sent_at;
+    };
+    struct Verification {
+        size_t job;
+        std::string peer_id;
+        std::future<Outcome> outcome;
+    };
+
+    std::deque<size_t> to_send(jobs.size());
+    std::iota(to_send.begin(), to_send.end(), size_t{0});
+    std::map<uint64_t, Pending> pending;  // by request id
+    std::list<Verification> verifications;
+    size_t done = 0;
+
+    // verifications in flight refer to the jobs, they must not outlive them
+    auto drain = [&verifications]() {
+        for (auto& verification : verifications) verification.outcome.wait();
+    };
+
+    try {
+        while (done < jobs.size()) {
+            if (stopping_ || sentry_.closing()) {
+                drain();
+                return false;
+            }
+
+            // keep the pipeline full; if no peer can serve a request wait for replies and retry later
+            while (!to_send.empty() && pending.size() + verifications.size() < config_.max_outstanding_requests) {
+                uint64_t request_id = static_cast<uint64_t>(RANDOM_NUMBER.generate_one());
+                if (!send(jobs[to_send.front()], request_id)) break;
+                pending[request_id] = {to_send.front(), clock::now()};
+                to_send.pop_front();
+            }
+
+            // hand replies over to the pool
+            std::shared_ptr<sentry::InboundMessage> reply;
+            while (replies_.timed_wait_and_pop(reply, verifications.empty() ? 100ms : 1ms)) {
+                std::optional<uint64_t> request_id = eth66_request_id(string_view_to_byte_view(reply->data()));
+                if (!request_id) continue;
+                auto it = pending.find(*request_id);
+                if (it == pending.end()) continue;  // late, or a reply to someone else
+                size_t j = it->second.job;
+                pending.erase(it);
+                auto accept = [&job = jobs[j], reply]() {
+                    try {
+                        return job.accept(*reply);
+                    } catch (const std::exception&) {  // e.g. bad rlp
+                        return Outcome::kBad;
+                    }
+                };
+                verifications.push_back({j, string_from_H512(reply->peer_id()), pool_.submit(std::move(accept))});
+            }
+
+            // collect verified replies
+            for (auto it = verifications.begin(); it != verifications.end();) {
+                if (it->outcome.wait_for(0s) != std::future_status::ready) {
+                    ++it;
+                    continue;
+                }
+                Job& job = jobs[it->job];
+                switch (it->outcome.get()) {
+                    case Outcome::kDone:
+                        ++done;
+                        break;
+                    case Outcome::kPartial:
+                        to_send.push_front(it->job);
+                        break;
+                    case Outcome::kBad:
+                        ++bad_replies_;
+                        penalize(it->peer_id);
+                        if (++job.bad_replies > config_.max_bad_replies) {
+                            drain();
+                            return false;
+                        }
+                        to_send.push_back(it->job);
+                        break;
+                }
+                it = verifications.erase(it);
+            }
+
+            // send again expired requests
+            const auto now = clock::now();
+            for (auto it = pending.begin(); it != pending.end();) {
+                if (now - it->second.sent_at < config_.request_timeout) {
+                    ++it;
+                    continue;
+                }
+                ++timeouts_;
+                to_send.push_back(it->second.job);
+                it = pending.erase(it);
+            }
+        }
+    }
+    catch(...) {  // e.g. the sentry went away
+        drain();
+        throw;
+    }
+    return true;
+}
+
+bool BlockDownloader::send(const Job& job, uint64_t request_id) {
+    Bytes rlp = job.encode(request_id);
+
+    auto message = std::make_unique<sentry::OutboundMessageData>();
+    message->set_id(job.message_id);
+    message->set_data(rlp.data(), rlp.length());  // copy
+
+    rpc::SendMessageByMinBlock rpc{job.min_block, std::move(message)};
+    sentry_.exec_remotely(rpc);
+
+    sentry::SentPeers peers = rpc.reply();
+    if (peers.peers_size() == 0) return false;
+    ++requests_;
+    return true;
+}
+
+void BlockDownloader::penalize(const std::string& peer_id) {
+    try {
+        rpc::PenalizePeer rpc{peer_id, Penalty::BadBlockPenalty};
+        sentry_.exec_remotely(rpc);
+    }
+    catch(const std::exception& e) {
+        SILKWORM_LOG(LogLevel::Warn) << "BlockDownloader failed to penalize a peer: " << e.what() << "\n";
+    }
+}
+
+void BlockDownloader::save_headers(const std::vector<BlockHeader>& headers, intx::uint256& total_difficulty) {
+    if (headers.empty()) return;
+
+    auto txn = env_.start_write();
+    for (const BlockHeader& header : headers) {
+        const evmc::bytes32 hash = header.hash();
+        total_difficulty += header.difficulty;
+        db::write_header(txn, header);
+        db::write_canonical_header_hash(txn, hash.bytes, header.number);
+        db::write_total_difficulty(txn, header.number, hash.bytes, total_difficulty);
+    }
+
+    auto head_header_table = db::open_cursor(txn, db::table::kHeadHeader);
+    const evmc::bytes32 head_hash = headers.back().hash();
+    head_header_table.upsert(db::to_slice(DbTx::head_header_key()), db::to_slice(head_hash));
+
+    db::stages::write_stage_progress(txn, db::stages::kHeadersKey, headers.back().number);
+    txn.commit();
+
+    headers_ += headers.size();
+}
+
+void BlockDownloader::save_bodies(const std::vector<BlockHeader>& headers,
+                                  std::vector<std::optional<BlockBody>>& bodies) {
+    for (size_t begin = 0; begin < headers.size(); begin += config_.body_write_batch) {
+        size_t end = std::min(headers.size(), begin + config_.body_write_batch);
+
+        auto txn = env_.start_write();
+        for (size_t i = begin; i < end; ++i) {
+            const evmc::bytes32 hash = headers[i].hash();
+            db::write_body(txn, *bodies[i], headers[i].number, hash.bytes);
+            bodies[i].reset();
+        }
+        db::stages::write_stage_progress(txn, db::stages::kBlockBodiesKey, headers[end - 1].number);
+        txn.commit();
+
+        bodies_ += end - begin;
+    }
+}
+
+BlockDownloader::Stats BlockDownloader::stats() const {
+    Stats stats;
+    stats.requests = requests_.load();
+    stats.timeouts = timeouts_.load();
+    stats.bad_replies = bad_replies_.load();
+    stats.discarded_skeletons = discarded_skeletons_.load();
+    stats.headers = headers_.load();
+    stats.bodies = bodies_.load();
+    return stats;
+}
+
+std::ostream& operator<<(std::ostream& os, const BlockDownloader::Stats& stats) {
+    os << "requests=" << stats.requests << " timeouts=" << stats.timeouts << " bad_replies=" << stats.bad_replies
+       << " discarded_skeletons=" << stats.discarded_skeletons << " headers=" << stats.headers
+       << " bodies=" << stats.bodies;
+    return os;
+}
+
+}  // namespace silkworm
@@ -0,0 +1,140 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_BLOCK_DOWNLOADER_HPP
+#define SILKWORM_BLOCK_DOWNLOADER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <silkworm/chain/config.hpp>
+#include <silkworm/concurrency/active_component.hpp>
+#include <silkworm/concurrency/containers.hpp>
+#include <silkworm/concurrency/thread_pool.hpp>
+#include <silkworm/consensus/seal_verifier.hpp>
+#include <silkworm/db/mdbx.hpp>
+
+#include "internals/header_skeleton.hpp"
+#include "internals/types.hpp"
+#include "sentry_client.hpp"
+
+namespace silkworm {
+
+/*
+ * BlockDownloader downloads headers and then bodies up to a target block, feeding the Headers and Bodies stages.
+ * Headers are requested as a skeleton of anchors (see HeaderSkeleton) whose gaps are then filled by many peers at
+ * once, each gap being validated header by header against its parent by the consensus engine before anything is
+ * saved; bodies are requested in chunks to many peers at once, too. Up to max_outstanding_requests requests are in
+ * flight; replies are decoded and verified on a thread pool while new requests are sent, so network round-trips,
+ * decoding and validation overlap. Requests that time out or get an invalid reply are sent again (and bad peers
+ * penalized). Verified data is written in batches, each in a single write transaction that also moves forward the
+ * progress of the stage. Read transactions are renewed for every batch and released while it is downloaded and
+ * written, so that they don't pin old snapshots.
+ *
+ * execution_loop() receives the replies and must run in a thread of its own; wind() runs the download.
+ */
+class BlockDownloader : public ActiveComponent {
+  public:
+    struct Config {
+        size_t max_outstanding_requests{32};
+        uint64_t skeleton_stride{HeaderSkeleton::kDefaultStride};
+        uint64_t skeleton_max_anchors{HeaderSkeleton::kDefaultMaxAnchors};
+        size_t bodies_per_request{128};
+        size_t body_write_batch{1024};  // bodies per write transaction
+        size_t validation_threads{std::max(std::thread::hardware_concurrency(), 1u)};
+        std::chrono::milliseconds request_timeout{5000};
+        unsigned max_bad_replies{3};  // per request, beyond which the skeleton (or the window of bodies) is redone
+        bool verify_seals{true};      // only for ethash chains
+    };
+
+    struct Stats {
+        uint64_t requests{0};
+        uint64_t timeouts{0};
+        uint64_t bad_replies{0};
+        uint64_t discarded_skeletons{0};
+        uint64_t headers{0};  // saved
+        uint64_t bodies{0};   // saved
+    };
+
+    BlockDownloader(SentryClient& sentry, mdbx::env env, Config config);
+    BlockDownloader(const BlockDownloader&) = delete;  // not copyable
+    BlockDownloader(BlockDownloader&&) = delete;       // nor movable
+
+    // Receives headers and bodies replies
+    void execution_loop() override;
+
+    // Downloads headers and then bodies up to target, returns the Bodies stage progress
+    BlockNum wind(BlockNum target);
+
+    Stats stats() const;
+
+  private:
+    using clock = std::chrono::steady_clock;
+
+    enum class Outcome { kDone, kPartial, kBad };
+
+    // A request that is sent again until a valid reply completes it
+    struct Job {
+        sentry::MessageId message_id;
+        BlockNum min_block;                                             // peers must have it
+        std::function<Bytes(uint64_t request_id)> encode;               // eth/66 request
+        std::function<Outcome(const sentry::InboundMessage&)> accept;  // runs on the pool
+        unsigned bad_replies{0};
+    };
+
+    BlockNum download_headers(BlockNum target);
+    BlockNum download_bodies(BlockNum target);
+
+    // Returns true if the skeleton has been completed and saved
+    bool download_skeleton(const HeaderSkeleton& skeleton, const BlockHeader& from_header,
+                           intx::uint256& total_difficulty);
+
+    // Runs jobs until all of them are done; false if stopped or a job got too many bad replies
+    bool run(std::vector<Job>& jobs);
+    bool send(const Job& job, uint64_t request_id);
+    void penalize(const std::string& peer_id);
+
+    void save_headers(const std::vector<BlockHeader>& headers, intx::uint256& total_difficulty);
+    void save_bodies(const std::vector<BlockHeader>& headers, std::vector<std::optional<BlockBody>>& bodies);
+
+    SentryClient& sentry_;
+    mdbx::env env_;
+    Config config_;
+    std::optional<ChainConfig> chain_config_;
+    ThreadPool pool_;
+    std::unique_ptr<consensus::IConsensusEngine> header_engine_;  // header rules but the seal, if known for the chain
+    std::unique_ptr<consensus::SealVerifier> seal_verifier_;
+    ConcurrentQueue<std::shared_ptr<sentry::InboundMessage>> replies_;
+
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> timeouts_{0};
+    std::atomic<uint64_t> bad_replies_{0};
+    std::atomic<uint64_t> discarded_skeletons_{0};
+    std::atomic<uint64_t> headers_{0};
+    std::atomic<uint64_t> bodies_{0};
+};
+
+std::ostream& operator<<(std::ostream& os, const BlockDownloader::Stats& stats);
+
+}  // namespace silkworm
+
+#endif  // SILKWORM_BLOCK_DOWNLOADER_HPP
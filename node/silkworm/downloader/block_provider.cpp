@@ -16,6 +16,10 @@
 
 #include "block_provider.hpp"
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
 #include <silkworm/common/log.hpp>
 
 #include "rpc/ReceiveMessages.hpp"
@@ -24,10 +28,13 @@
 
 namespace silkworm {
 
-BlockProvider::BlockProvider(SentryClient& sentry, DbTx& db, ChainIdentity chain_identity):
+BlockProvider::BlockProvider(SentryClient& sentry, DbTx& db, ChainIdentity chain_identity, size_t num_workers,
+                             size_t max_queue_size):
     chain_identity_(std::move(chain_identity)),
     db_{db},
-    sentry_{sentry}
+    sentry_{sentry},
+    num_workers_{std::max<size_t>(num_workers, 1)},
+    max_queue_size_{max_queue_size}
 {
 }
 
@@ -37,8 +44,10 @@ BlockProvider::~BlockProvider() {
 }
 
 void BlockProvider::send_status() {
+    db_.renew();  // the shared read transaction is kept parked in between
     HeaderRetrieval headers(db_);
     auto [head_hash, head_td] = headers.head_hash_and_total_difficulty();
+    db_.park();
 
     rpc::SetStatus set_status(chain_identity_, head_hash, head_td);
     sentry_.exec_remotely(set_status);
@@ -54,6 +63,28 @@ void BlockProvider::send_status() {
     }
     }
 
+static void update_max(std::atomic<uint64_t>& max, uint64_t value) {
+    uint64_t current = max.load();
+    while (value > current && !max.compare_exchange_weak(current, value))
+        ;
+}
+
+void BlockProvider::enqueue(const sentry::InboundMessage& raw_message) {
+    ++received_;
+
+    size_t depth = queue_.size();
+    if (depth >= max_queue_size_) {
+        ++dropped_;
+        SILKWORM_LOG_EVERY(LogLevel::Warn, 1'000) << "BlockProvider queue full, request dropped"
+                                                  << log_kv("depth", depth) << log_kv("dropped", dropped_.load())
+                                                  << "\n";
+        return;
+    }
+
+    queue_.push({std::make_shared<sentry::InboundMessage>(raw_message), clock::now()});
+    update_max(max_queue_depth_, depth + 1);
+}
+
 void BlockProvider::process_message(std::shared_ptr<InboundMessage> message) {
 
     SILKWORM_LOG(LogLevel::Info) << "BlockProvider processing message " << *message << "\n";
@@ -61,31 +92,93 @@ void BlockProvider::process_message(std::shared_ptr<InboundMessage> message) {
     message->execute();
 }
 
+void BlockProvider::worker_loop() {
+    DbTx db{db_.environment()};  // a read transaction of our own
+
+    PendingRequest request;
+    while (!stopping_ && !sentry_.closing()) {
+        if (!queue_.timed_wait_and_pop(request, std::chrono::milliseconds(500)))
+            continue;
+
+        try {
+            db.renew();  // serve from the latest snapshot without pinning the previous one
+
+            auto message = InboundBlockRequestMessage::make(*request.raw_message, db, sentry_);
+            if (message)
+                process_message(message);
+            ++processed_;
+        }
+        catch(const std::exception& e) {  // e.g. a malformed request from a peer, it must not stop the others
+            ++failed_;
+            SILKWORM_LOG(LogLevel::Warn) << "BlockProvider failed to serve a request: " << e.what() << "\n";
+        }
+
+        auto latency = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - request.received_at);
+        total_latency_us_ += static_cast<uint64_t>(latency.count());
+        update_max(max_latency_us_, static_cast<uint64_t>(latency.count()));
+        request.raw_message.reset();
+    }
+}
+
+BlockProvider::Stats BlockProvider::stats() const {
+    Stats stats;
+    stats.received = received_.load();
+    stats.processed = processed_.load();
+    stats.dropped = dropped_.load();
+    stats.failed = failed_.load();
+    stats.queue_depth = queue_.size();
+    stats.max_queue_depth = max_queue_depth_.load();
+    uint64_t served = stats.processed + stats.failed;
+    if (served)
+        stats.avg_latency = std::chrono::microseconds(total_latency_us_.load() / served);
+    stats.max_latency = std::chrono::microseconds(max_latency_us_.load());
+    return stats;
+}
+
+std::ostream& operator<<(std::ostream& os, const BlockProvider::Stats& stats) {
+    os << "received=" << stats.received << " processed=" << stats.processed << " dropped=" << stats.dropped
+       << " failed=" << stats.failed << " queue=" << stats.queue_depth << " (max " << stats.max_queue_depth << ")"
+       << " latency avg=" << stats.avg_latency.count() << "us max=" << stats.max_latency.count() << "us";
+    return os;
+}
+
 void BlockProvider::execution_loop() {
+    using namespace std::chrono_literals;
 
+    std::vector<std::thread> workers;
     try {
         send_status();
 
+        for (size_t i = 0; i < num_workers_; ++i)
+            workers.emplace_back([this]() { worker_loop(); });
+
         rpc::ReceiveMessages receive_messages(rpc::ReceiveMessages::Scope::BlockRequests);
         sentry_.exec_remotely(receive_messages);
 
+        auto last_report = clock::now();
         while (!stopping_ && !sentry_.closing() && receive_messages.receive_one_reply()) {
 
-            auto message = InboundBlockRequestMessage::make(receive_messages.reply(), db_, sentry_);
+            enqueue(receive_messages.reply());
 
-            process_message(message);
-}
+            if (clock::now() - last_report > 60s) {
+                SILKWORM_LOG(LogLevel::Info) << "BlockProvider stats: " << stats() << "\n";
+                last_report = clock::now();
+            }
+        }
 
         SILKWORM_LOG(LogLevel::Warn) << "BlockProvider execution_loop is_stopping...\n";
     }
     catch(const std::exception& e) {
         SILKWORM_LOG(LogLevel::Error) << "BlockProvider execution_loop is_stopping due to exception: " << e.what() << "\n";
-        stopping_ = true;
         sentry_.need_close();
     }
 
-    }
+    stopping_ = true;  // workers too
+    for (auto& worker : workers)
+        worker.join();
 
+    SILKWORM_LOG(LogLevel::Info) << "BlockProvider stats: " << stats() << "\n";
+}
 
 }  // namespace silkworm
 
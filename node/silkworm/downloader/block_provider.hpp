@@ -16,8 +16,13 @@
 #ifndef SILKWORM_BLOCK_PROVIDER_HPP
 #define SILKWORM_BLOCK_PROVIDER_HPP
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+
 #include <silkworm/chain/identity.hpp>
 #include <silkworm/concurrency/active_component.hpp>
+#include <silkworm/concurrency/containers.hpp>
 
 #include "messages/InboundMessage.hpp"
 #include "internals/DbTx.hpp"
@@ -32,6 +37,12 @@ class BlockProviderException: public std::runtime_error {
 };
 
 
+/*
+ * BlockProvider serves headers and bodies to external peers.
+ * Inbound requests are queued by the receiving loop and processed concurrently by a bounded pool of workers;
+ * each worker owns a read transaction that is renewed before every request (not to pin old db pages)
+ * and replies by itself, so that slow lookups and sentry round-trips do not hold up the others.
+ */
 class BlockProvider : public ActiveComponent {  // but also an active component that must run always
 
     ChainIdentity chain_identity_;
@@ -39,7 +50,22 @@ class BlockProvider : public ActiveComponent {  // but also an active component
     SentryClient& sentry_;
 
   public:
-    BlockProvider(SentryClient& sentry, DbTx& db, ChainIdentity chain_identity);
+    static constexpr size_t kDefaultWorkers = 4;
+    static constexpr size_t kDefaultMaxQueueSize = 1024;  // requests beyond are dropped, peers will ask elsewhere
+
+    struct Stats {
+        uint64_t received{0};
+        uint64_t processed{0};
+        uint64_t dropped{0};
+        uint64_t failed{0};
+        size_t queue_depth{0};
+        uint64_t max_queue_depth{0};
+        std::chrono::microseconds avg_latency{0};  // from reception to reply, queueing included
+        std::chrono::microseconds max_latency{0};
+    };
+
+    BlockProvider(SentryClient& sentry, DbTx& db, ChainIdentity chain_identity, size_t num_workers = kDefaultWorkers,
+                  size_t max_queue_size = kDefaultMaxQueueSize);
     BlockProvider(const BlockProvider&) = delete;  // not copyable
     BlockProvider(BlockProvider&&) = delete;       // nor movable
     ~BlockProvider();
@@ -49,12 +75,36 @@ class BlockProvider : public ActiveComponent {  // but also an active component
 
     void execution_loop() override;
 
+    Stats stats() const;
+
   private:
+    using clock = std::chrono::steady_clock;
+
+    struct PendingRequest {
+        std::shared_ptr<sentry::InboundMessage> raw_message;
+        clock::time_point received_at;
+    };
+
     void send_status();
+    void enqueue(const sentry::InboundMessage& raw_message);
+    void worker_loop();
     void process_message(std::shared_ptr<InboundMessage> message);
 
+    size_t num_workers_;
+    size_t max_queue_size_;
+    ConcurrentQueue<PendingRequest> queue_;
+
+    std::atomic<uint64_t> received_{0};
+    std::atomic<uint64_t> processed_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> failed_{0};
+    std::atomic<uint64_t> max_queue_depth_{0};
+    std::atomic<uint64_t> total_latency_us_{0};
+    std::atomic<uint64_t> max_latency_us_{0};
 };
 
+std::ostream& operator<<(std::ostream& os, const BlockProvider::Stats& stats);
+
 }  // namespace silkworm
 
 #endif  // SILKWORM_BLOCK_PROVIDER_HPP
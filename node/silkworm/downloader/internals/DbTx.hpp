@@ -28,17 +28,40 @@
 using namespace silkworm;
 
 class DbTx {
-    mdbx::env_managed env;
+    mdbx::env_managed managed_env;  // only when the environment has been opened by this instance
+    mdbx::env env;
     mdbx::txn_managed txn;
+    bool parked{false};  // reading reset, no snapshot held
 
   public:
     explicit DbTx(std::string db_path) {
         db::EnvConfig db_config{db_path};
         db_config.readonly = true;
-        env = db::open_env(db_config);
+        managed_env = db::open_env(db_config);
+        env = managed_env;
         txn = env.start_read();
     }
 
+    // Another read transaction on an environment already open, e.g. for a different thread
+    // (environments are opened with MDBX_NOTLS so read transactions are not tied to threads)
+    explicit DbTx(mdbx::env shared_env) : env{shared_env} { txn = env.start_read(); }
+
+    mdbx::env environment() { return env; }
+
+    // Moves the read transaction to the latest snapshot, so that the pages of the old one can be reclaimed
+    // (a long-lived reader prevents mdbx from reusing pages and makes the db grow)
+    void renew() {
+        if (!parked) txn.reset_reading();
+        txn.renew_reading();
+        parked = false;
+    }
+
+    // Releases the snapshot until the next renew(), e.g. while waiting for peers or while others write
+    void park() {
+        if (!parked) txn.reset_reading();
+        parked = true;
+    }
+
     std::optional<Hash> read_canonical_hash(BlockNum b) {  // throws db exceptions // todo: add to db::access_layer.hpp?
         auto hashes_table = db::open_cursor(txn, db::table::kCanonicalHashes);
         // accessing this table with only b we will get the hash of the canonical block at height b
@@ -112,11 +135,38 @@ class DbTx {
         return db::read_body(txn, *block_num, h.bytes, read_senders);
     }
 
+    std::optional<ByteView> read_rlp_encoded_stored_body(BlockNum b, Hash h) {  // see Erigon BodyForStorage
+        auto bodies_table = db::open_cursor(txn, db::table::kBlockBodies);
+        auto key = db::block_key(b, h.bytes);
+        auto data = bodies_table.find(db::to_slice(key), /*throw_notfound*/ false);
+        if (!data) return std::nullopt;
+        return db::from_slice(data.value);
+    }
+
+    // Returned views point into db pages, they are valid as long as the read transaction is alive
+    std::vector<ByteView> read_rlp_encoded_transactions(uint64_t base_id, uint64_t count) {
+        std::vector<ByteView> transactions;
+        if (count == 0) return transactions;
+        transactions.reserve(count);
+
+        auto transactions_table = db::open_cursor(txn, db::table::kEthTx);
+        Bytes key(8, '\0');
+        endian::store_big_u64(key.data(), base_id);
+        auto data = transactions_table.find(db::to_slice(key), /*throw_notfound*/ false);
+        while (data && transactions.size() < count) {
+            transactions.push_back(db::from_slice(data.value));
+            data = transactions_table.to_next(/*throw_notfound*/ false);
+        }
+        return transactions;
+    }
+
     std::optional<intx::uint256> read_total_difficulty(BlockNum b, Hash h) {
         return db::read_total_difficulty(txn, b, h.bytes);
     }
 
     BlockNum stage_progress(const char* stage_name) { return db::stages::read_stage_progress(txn, stage_name); }
+
+    std::optional<ChainConfig> read_chain_config() { return db::read_chain_config(txn); }
 };
 
 #endif  // SILKWORM_DBTX_HPP
@@ -14,6 +14,8 @@
    limitations under the License.
 */
 
+#include <silkworm/db/util.hpp>
+#include <silkworm/rlp/encode.hpp>
 #include <silkworm/types/block.hpp>
 
 #include "body_retrieval.hpp"
@@ -27,7 +29,7 @@ BodyRetrieval::BodyRetrieval(DbTx& db): db_(db) {
 std::vector<BlockBody> BodyRetrieval::recover(std::vector<Hash> request) {
     std::vector<BlockBody> response;
     size_t bytes = 0;
-    for(size_t i = 0; i <= request.size(); ++i) {
+    for(size_t i = 0; i < request.size(); ++i) {
         Hash& hash = request[i];
         auto body = db_.read_body(hash);
         if (!body) continue;
@@ -41,4 +43,59 @@ std::vector<BlockBody> BodyRetrieval::recover(std::vector<Hash> request) {
     return response;
 }
 
-}
\ No newline at end of file
+// The wire encoding of a body is [[transactions...], [ommers...]] while the db stores
+// [base_txn_id, txn_count, [ommers...]] and every transaction by itself
+static size_t splice_body(const db::detail::BlockBodyForStorageView& body, const std::vector<ByteView>& transactions,
+                          Bytes& out) {
+    // Transactions are normally stored as they appear in a block, but a bare EIP-2718 envelope
+    // (type byte followed by the payload) has to be wrapped into an RLP string
+    auto is_bare_envelope = [](ByteView txn) { return !txn.empty() && txn[0] < rlp::kEmptyStringCode; };
+
+    rlp::Header txs_head{true, 0};
+    for (ByteView txn : transactions) {
+        if (is_bare_envelope(txn)) txs_head.payload_length += rlp::length_of_length(txn.length());
+        txs_head.payload_length += txn.length();
+    }
+    rlp::Header body_head{true, 0};
+    body_head.payload_length += rlp::length_of_length(txs_head.payload_length) + txs_head.payload_length;
+    body_head.payload_length += body.ommers_rlp.length();
+
+    const size_t body_len = rlp::length_of_length(body_head.payload_length) + body_head.payload_length;
+    rlp::reserve_additional(out, body_len);
+
+    rlp::encode_header(out, body_head);
+    rlp::encode_header(out, txs_head);
+    for (ByteView txn : transactions) {
+        if (is_bare_envelope(txn)) rlp::encode_header(out, {false, txn.length()});
+        out.append(txn);
+    }
+    out.append(body.ommers_rlp);
+
+    return body_len;
+}
+
+size_t BodyRetrieval::recover_rlp(const std::vector<Hash>& request, Bytes& out) {
+    size_t count = 0;
+    size_t bytes = 0;
+    for(size_t i = 0; i < request.size(); ++i) {
+        const Hash& hash = request[i];
+        auto block_num = db_.read_block_num(hash);
+        if (!block_num) continue;
+        auto stored_body = db_.read_rlp_encoded_stored_body(*block_num, hash);
+        if (!stored_body) continue;
+
+        ByteView view = *stored_body;
+        db::detail::BlockBodyForStorageView body = db::detail::decode_stored_block_body_view(view);
+        std::vector<ByteView> transactions = db_.read_rlp_encoded_transactions(body.base_txn_id, body.txn_count);
+
+        bytes += splice_body(body, transactions, out);
+        ++count;
+        if (bytes >= soft_response_limit ||
+            count >= max_bodies_serve ||
+            i >= 2 * max_bodies_serve)
+            break;
+    }
+    return count;
+}
+
+}
@@ -31,6 +31,10 @@ class BodyRetrieval {
 
     std::vector<BlockBody> recover(std::vector<Hash>);
 
+    // Same as recover but bodies are appended to out as RLP spliced from what is stored in the db,
+    // without decoding transactions nor ommers; returns the number of bodies appended
+    size_t recover_rlp(const std::vector<Hash>& request, Bytes& out);
+
   protected:
     DbTx& db_;
 };
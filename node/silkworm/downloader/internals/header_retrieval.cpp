@@ -24,27 +24,30 @@ HeaderRetrieval::HeaderRetrieval(DbTx& db): db_(db) {
 
 }
 
-std::vector<BlockHeader> HeaderRetrieval::recover_by_hash(Hash origin, uint64_t amount, uint64_t skip, bool reverse) {
+template <class Serve>
+void HeaderRetrieval::walk_by_hash(Hash origin, uint64_t amount, uint64_t skip, bool reverse, Serve serve) {
     using std::optional;
     uint64_t max_non_canonical = 100;
 
-    std::vector<BlockHeader> headers;
+    uint64_t count = 0;
     long long bytes = 0;
     Hash hash = origin;
     bool unknown = false;
 
     // first
-    optional<BlockHeader> header = db_.read_header(hash);
-    if (!header) return headers;
-    BlockNum block_num = header->number;
-    headers.push_back(*header);
-    bytes += est_header_rlp_size;
+    optional<BlockNum> origin_num = db_.read_block_num(hash);
+    if (!origin_num) return;
+    BlockNum block_num = *origin_num;
+    optional<size_t> served = serve(block_num, hash);
+    if (!served) return;
+    ++count;
+    bytes += static_cast<long long>(*served);
 
     // followings
     do {
         // compute next hash & number - todo: understand
         if (!reverse) {
-            BlockNum current = header->number;
+            BlockNum current = block_num;
             BlockNum next = current + skip + 1;
             if (next <= current) {
                 unknown = true;
@@ -55,14 +58,13 @@ std::vector<BlockHeader> HeaderRetrieval::recover_by_hash(Hash origin, uint64_t
                     << ", next=" << next << std::endl;
             }
             else {
-                header = db_.read_canonical_header(next);
-                if (!header)
+                optional<Hash> next_hash = db_.read_canonical_hash(next);
+                if (!next_hash)
                     unknown = true;
                 else {
-                    Hash nextHash = header->hash();
-                    auto [expOldHash, _ ] = get_ancestor(nextHash, next, skip + 1, max_non_canonical);
+                    auto [expOldHash, _ ] = get_ancestor(*next_hash, next, skip + 1, max_non_canonical);
                     if (expOldHash == hash) {
-                        hash = nextHash;
+                        hash = *next_hash;
                         block_num = next;
                     }
                     else
@@ -82,40 +84,86 @@ std::vector<BlockHeader> HeaderRetrieval::recover_by_hash(Hash origin, uint64_t
 
         if (unknown) break;
 
-        header = db_.read_header(block_num, hash);
-        if (!header) break;
-        headers.push_back(*header);
-        bytes += est_header_rlp_size;
-
-    } while(headers.size() < amount && bytes < soft_response_limit && headers.size() < max_headers_serve);
+        served = serve(block_num, hash);
+        if (!served) break;
+        ++count;
+        bytes += static_cast<long long>(*served);
 
-    return headers;
+    } while(count < amount && bytes < soft_response_limit && count < max_headers_serve);
 }
 
-std::vector<BlockHeader> HeaderRetrieval::recover_by_number(BlockNum origin, uint64_t amount, uint64_t skip, bool reverse) {
+template <class Serve>
+void HeaderRetrieval::walk_by_number(BlockNum origin, uint64_t amount, uint64_t skip, bool reverse, Serve serve) {
     using std::optional;
 
-    std::vector<BlockHeader> headers;
+    uint64_t count = 0;
     long long bytes = 0;
     BlockNum block_num = origin;
 
     do {
-        optional<BlockHeader> header = db_.read_canonical_header(block_num);
-        if (!header) break;
+        optional<Hash> hash = db_.read_canonical_hash(block_num);
+        if (!hash) break;
 
-        headers.push_back(*header);
-        bytes += est_header_rlp_size;
+        optional<size_t> served = serve(block_num, *hash);
+        if (!served) break;
+        ++count;
+        bytes += static_cast<long long>(*served);
 
         if (!reverse)
             block_num += skip + 1; // Number based traversal towards the leaf block
         else
             block_num -= skip + 1; // Number based traversal towards the genesis block
 
-    } while(block_num > 0 && headers.size() < amount && bytes < soft_response_limit && headers.size() < max_headers_serve);
+    } while(block_num > 0 && count < amount && bytes < soft_response_limit && count < max_headers_serve);
+}
+
+std::vector<BlockHeader> HeaderRetrieval::recover_by_hash(Hash origin, uint64_t amount, uint64_t skip, bool reverse) {
+    std::vector<BlockHeader> headers;
+    walk_by_hash(origin, amount, skip, reverse, [&](BlockNum block_num, Hash hash) -> std::optional<size_t> {
+        std::optional<BlockHeader> header = db_.read_header(block_num, hash);
+        if (!header) return std::nullopt;
+        headers.push_back(std::move(*header));
+        return est_header_rlp_size;
+    });
+    return headers;
+}
 
+std::vector<BlockHeader> HeaderRetrieval::recover_by_number(BlockNum origin, uint64_t amount, uint64_t skip, bool reverse) {
+    std::vector<BlockHeader> headers;
+    walk_by_number(origin, amount, skip, reverse, [&](BlockNum block_num, Hash hash) -> std::optional<size_t> {
+        std::optional<BlockHeader> header = db_.read_header(block_num, hash);
+        if (!header) return std::nullopt;
+        headers.push_back(std::move(*header));
+        return est_header_rlp_size;
+    });
     return headers;
 }
 
+size_t HeaderRetrieval::recover_rlp_by_hash(Hash origin, uint64_t amount, uint64_t skip, bool reverse, Bytes& out) {
+    size_t count = 0;
+    walk_by_hash(origin, amount, skip, reverse, [&](BlockNum block_num, Hash hash) -> std::optional<size_t> {
+        std::optional<ByteView> rlp = db_.read_rlp_encoded_header(block_num, hash);
+        if (!rlp) return std::nullopt;
+        out.append(*rlp);
+        ++count;
+        return rlp->length();
+    });
+    return count;
+}
+
+size_t HeaderRetrieval::recover_rlp_by_number(BlockNum origin, uint64_t amount, uint64_t skip, bool reverse,
+                                              Bytes& out) {
+    size_t count = 0;
+    walk_by_number(origin, amount, skip, reverse, [&](BlockNum block_num, Hash hash) -> std::optional<size_t> {
+        std::optional<ByteView> rlp = db_.read_rlp_encoded_header(block_num, hash);
+        if (!rlp) return std::nullopt;
+        out.append(*rlp);
+        ++count;
+        return rlp->length();
+    });
+    return count;
+}
+
 // Node current status
 BlockNum HeaderRetrieval::head_height() {
     return db_.stage_progress(db::stages::kBlockBodiesKey);
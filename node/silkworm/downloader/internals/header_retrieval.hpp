@@ -34,6 +34,11 @@ class HeaderRetrieval {
     std::vector<BlockHeader> recover_by_hash(Hash origin, uint64_t amount, uint64_t skip, bool reverse);
     std::vector<BlockHeader> recover_by_number(BlockNum origin, uint64_t amount, uint64_t skip, bool reverse);
 
+    // Same as above but headers are appended to out as stored in the db (RLP), without decoding;
+    // return the number of headers appended
+    size_t recover_rlp_by_hash(Hash origin, uint64_t amount, uint64_t skip, bool reverse, Bytes& out);
+    size_t recover_rlp_by_number(BlockNum origin, uint64_t amount, uint64_t skip, bool reverse, Bytes& out);
+
     // Node current status
     BlockNum                head_height();
     std::tuple<Hash,BigInt> head_hash_and_total_difficulty();
@@ -42,6 +47,13 @@ class HeaderRetrieval {
     std::tuple<Hash,BlockNum> get_ancestor(Hash hash, BlockNum blockNum, BlockNum ancestor, uint64_t& max_non_canonical);
 
   protected:
+    // Walk the headers requested by a GetBlockHeaders query calling serve(block_num, hash) for each of them;
+    // serve returns the size of what it served or std::nullopt if the header is missing, which ends the walk
+    template <class Serve>
+    void walk_by_hash(Hash origin, uint64_t amount, uint64_t skip, bool reverse, Serve serve);
+    template <class Serve>
+    void walk_by_number(BlockNum origin, uint64_t amount, uint64_t skip, bool reverse, Serve serve);
+
     DbTx& db_;
 };
 
@@ -0,0 +1,95 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "header_skeleton.hpp"
+
+#include <algorithm>
+
+#include <silkworm/state/in_memory_state.hpp>
+
+namespace silkworm {
+
+HeaderSkeleton::HeaderSkeleton(BlockNum from, BlockNum to, uint64_t stride, uint64_t max_anchors)
+    : from_{from}, stride_{std::max<uint64_t>(stride, 1)} {
+    const uint64_t distance = to > from ? to - from : 0;
+    anchors_ = std::min(distance / stride_, max_anchors);
+
+    for (uint64_t i = 0; i < anchors_; ++i) {
+        if (stride_ > 1) {
+            segments_.push_back({from_ + i * stride_ + 1, stride_ - 1, /*anchored=*/true});
+        }
+    }
+
+    last_ = from_ + anchors_ * stride_;
+    if (anchors_ < max_anchors && last_ < to) {  // tail without anchor
+        segments_.push_back({last_ + 1, to - last_, /*anchored=*/false});
+        last_ = to;
+    }
+}
+
+GetBlockHeadersPacket HeaderSkeleton::skeleton_request() const {
+    GetBlockHeadersPacket request;
+    request.origin = BlockNum{from_ + stride_};
+    request.amount = anchors_;
+    request.skip = stride_ - 1;
+    request.reverse = false;
+    return request;
+}
+
+GetBlockHeadersPacket HeaderSkeleton::fill_request(const Segment& segment) const {
+    GetBlockHeadersPacket request;
+    request.origin = BlockNum{segment.first};
+    request.amount = segment.count;
+    request.skip = 0;
+    request.reverse = false;
+    return request;
+}
+
+ValidationResult verify_segment(std::vector<BlockHeader>& headers, const BlockHeader& parent,
+                                const BlockHeader* anchor, consensus::IConsensusEngine* engine) {
+    // the engine looks up the parent of a header in a state, so parents are inserted there as we go
+    InMemoryState parents;
+    Block parent_block;
+    auto validate = [&](const BlockHeader& header, const BlockHeader& header_parent, const evmc::bytes32& hash) {
+        if (!engine) return ValidationResult::kOk;
+        parent_block.header = header_parent;
+        parents.insert_block(parent_block, hash);
+        return engine->validate_block_header(header, parents, /*with_future_timestamp_check=*/true);
+    };
+
+    const BlockHeader* previous = &parent;
+    evmc::bytes32 hash = parent.hash();
+    for (BlockHeader& header : headers) {
+        if (header.number != previous->number + 1 || header.parent_hash != hash) {
+            return ValidationResult::kUnknownParent;
+        }
+        if (ValidationResult err = validate(header, *previous, hash); err != ValidationResult::kOk) {
+            return err;
+        }
+        header.cache_hashes();
+        previous = &header;
+        hash = header.hash();
+    }
+    if (anchor) {
+        if (anchor->number != previous->number + 1 || anchor->parent_hash != hash) {
+            return ValidationResult::kUnknownParent;
+        }
+        return validate(*anchor, *previous, hash);
+    }
+    return ValidationResult::kOk;
+}
+
+}  // namespace silkworm
@@ -0,0 +1,81 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_HEADER_SKELETON_HPP
+#define SILKWORM_HEADER_SKELETON_HPP
+
+#include <vector>
+
+#include <silkworm/consensus/engine.hpp>
+#include <silkworm/consensus/validation.hpp>
+#include <silkworm/downloader/packets/GetBlockHeadersPacket.hpp>
+
+#include "types.hpp"
+
+namespace silkworm {
+
+/*
+ * Plans the GetBlockHeaders requests needed to download headers (from, to].
+ * First a skeleton of anchors, one every stride headers, is requested to a single peer; then the gaps between
+ * anchors are filled by independent requests that can be sent to many peers at once. Each filled segment is
+ * verified against the header preceding it and the anchor closing it, so segments can be verified in parallel.
+ * At most max_anchors anchors are planned, a longer range needs more skeletons (see last()).
+ */
+class HeaderSkeleton {
+  public:
+    static constexpr uint64_t kDefaultStride = 192;
+    static constexpr uint64_t kDefaultMaxAnchors = 128;
+
+    struct Segment {
+        BlockNum first;  // first header to fill
+        uint64_t count;  // number of headers to fill
+        bool anchored;   // whether the header following the last one is an anchor
+    };
+
+    HeaderSkeleton(BlockNum from, BlockNum to, uint64_t stride = kDefaultStride,
+                   uint64_t max_anchors = kDefaultMaxAnchors);
+
+    uint64_t anchors() const { return anchors_; }
+
+    // Request for the anchors from + stride, from + 2*stride, ...; meaningful only if anchors() > 0
+    GetBlockHeadersPacket skeleton_request() const;
+
+    // Segments to fill, in ascending order; anchored ones end right before anchor i
+    const std::vector<Segment>& segments() const { return segments_; }
+
+    // Highest header covered by this skeleton (anchors included)
+    BlockNum last() const { return last_; }
+
+    GetBlockHeadersPacket fill_request(const Segment& segment) const;
+
+  private:
+    BlockNum from_;
+    uint64_t stride_;
+    uint64_t anchors_;
+    BlockNum last_;
+    std::vector<Segment> segments_;
+};
+
+// Checks that headers are consecutive and chained by parent hash right after the given parent and, if an anchor
+// is given, right before it; header hashes are computed (and cached) on the way. If an engine is given, each header
+// (anchor included) must also pass its validate_block_header against its parent. Returns kOk, kUnknownParent or the
+// first error of the engine
+ValidationResult verify_segment(std::vector<BlockHeader>& headers, const BlockHeader& parent,
+                                const BlockHeader* anchor = nullptr, consensus::IConsensusEngine* engine = nullptr);
+
+}  // namespace silkworm
+
+#endif  // SILKWORM_HEADER_SKELETON_HPP
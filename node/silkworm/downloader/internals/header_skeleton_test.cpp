@@ -0,0 +1,136 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "header_skeleton.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/chain/difficulty.hpp>
+#include <silkworm/consensus/noproof/engine.hpp>
+
+namespace silkworm {
+
+// Headers following parent that pass the header rules of mainnet
+static std::vector<BlockHeader> sample_chain(const BlockHeader& parent, size_t count) {
+    std::vector<BlockHeader> headers(count);
+    const BlockHeader* previous = &parent;
+    for (BlockHeader& header : headers) {
+        header.number = previous->number + 1;
+        header.parent_hash = previous->hash();
+        header.ommers_hash = kEmptyListHash;
+        header.gas_limit = previous->gas_limit;
+        header.timestamp = previous->timestamp + 15;
+        header.difficulty = canonical_difficulty(header.number, header.timestamp, previous->difficulty,
+                                                 previous->timestamp, /*parent_has_uncles=*/false, kMainnetConfig);
+        previous = &header;
+    }
+    return headers;
+}
+
+TEST_CASE("HeaderSkeleton") {
+    SECTION("range shorter than stride") {
+        HeaderSkeleton skeleton{100, 150, /*stride=*/192};
+        CHECK(skeleton.anchors() == 0);
+        CHECK(skeleton.last() == 150);
+        REQUIRE(skeleton.segments().size() == 1);
+        CHECK(skeleton.segments()[0].first == 101);
+        CHECK(skeleton.segments()[0].count == 50);
+        CHECK(!skeleton.segments()[0].anchored);
+    }
+
+    SECTION("anchors and tail") {
+        HeaderSkeleton skeleton{1000, 1000 + 3 * 192 + 10, /*stride=*/192};
+        REQUIRE(skeleton.anchors() == 3);
+
+        GetBlockHeadersPacket request = skeleton.skeleton_request();
+        CHECK(std::get<BlockNum>(request.origin) == 1192);
+        CHECK(request.amount == 3);
+        CHECK(request.skip == 191);
+        CHECK(!request.reverse);
+
+        const auto& segments = skeleton.segments();
+        REQUIRE(segments.size() == 4);
+        for (size_t i = 0; i < 3; ++i) {
+            CHECK(segments[i].first == 1000 + i * 192 + 1);
+            CHECK(segments[i].count == 191);
+            CHECK(segments[i].anchored);
+        }
+        CHECK(segments[3].first == 1000 + 3 * 192 + 1);
+        CHECK(segments[3].count == 10);
+        CHECK(!segments[3].anchored);
+        CHECK(skeleton.last() == 1000 + 3 * 192 + 10);
+
+        GetBlockHeadersPacket fill = skeleton.fill_request(segments[1]);
+        CHECK(std::get<BlockNum>(fill.origin) == 1193);
+        CHECK(fill.amount == 191);
+        CHECK(fill.skip == 0);
+    }
+
+    SECTION("too many anchors") {
+        HeaderSkeleton skeleton{0, 10'000, /*stride=*/100, /*max_anchors=*/10};
+        CHECK(skeleton.anchors() == 10);
+        CHECK(skeleton.last() == 1'000);
+        CHECK(skeleton.segments().size() == 10);
+        CHECK(skeleton.segments().back().anchored);
+    }
+}
+
+TEST_CASE("verify_segment") {
+    BlockHeader genesis;
+    genesis.ommers_hash = kEmptyListHash;
+    genesis.difficulty = 17'179'869'184;
+    genesis.gas_limit = 8'000'000;
+    std::vector<BlockHeader> chain = sample_chain(genesis, 11);
+    const BlockHeader anchor = chain.back();
+    chain.pop_back();
+
+    consensus::ConsensusEngineNoproof engine{kMainnetConfig};
+
+    CHECK(verify_segment(chain, genesis, &anchor) == ValidationResult::kOk);
+    CHECK(verify_segment(chain, genesis) == ValidationResult::kOk);
+    CHECK(verify_segment(chain, genesis, &anchor, &engine) == ValidationResult::kOk);
+
+    SECTION("wrong parent") {
+        BlockHeader other{genesis};
+        other.timestamp += 1;
+        CHECK(verify_segment(chain, other, &anchor) == ValidationResult::kUnknownParent);
+        CHECK(verify_segment(chain, chain[0], &anchor) == ValidationResult::kUnknownParent);
+    }
+
+    SECTION("broken link") {
+        chain[5].gas_limit += 1;
+        CHECK(verify_segment(chain, genesis) == ValidationResult::kUnknownParent);
+    }
+
+    SECTION("wrong anchor") {
+        BlockHeader other{anchor};
+        other.parent_hash = genesis.hash();
+        CHECK(verify_segment(chain, genesis, &other) == ValidationResult::kUnknownParent);
+    }
+
+    SECTION("invalid header") {
+        BlockHeader other{anchor};
+        other.difficulty += 1;
+        CHECK(verify_segment(chain, genesis, &other) == ValidationResult::kOk);  // chained all the same
+        CHECK(verify_segment(chain, genesis, &other, &engine) == ValidationResult::kWrongDifficulty);
+
+        std::vector<BlockHeader> first{chain[0]};
+        first[0].gas_used = first[0].gas_limit + 1;
+        CHECK(verify_segment(first, genesis, nullptr, &engine) == ValidationResult::kGasAboveLimit);
+    }
+}
+
+}  // namespace silkworm
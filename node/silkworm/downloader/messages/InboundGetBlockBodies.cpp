@@ -58,16 +58,14 @@ void InboundGetBlockBodies::execute() {
 
     BodyRetrieval body_retrieval(db_);
 
-    BlockBodiesPacket66 reply;
-    reply.requestId = packet_.requestId;
-    reply.request = body_retrieval.recover(packet_.request);
-
-    Bytes rlp_encoding;
-    rlp::encode(rlp_encoding, reply);
+    // bodies are spliced from the RLP stored in the db, the packet head is written in front of them afterwards
+    Bytes rlp_encoding(rlp::kEth66PacketHeadRoom, '\0');
+    body_retrieval.recover_rlp(packet_.request, rlp_encoding);
+    ByteView reply = rlp::wrap_eth66(rlp_encoding, packet_.requestId);
 
     auto msg_reply = std::make_unique<sentry::OutboundMessageData>();
     msg_reply->set_id(sentry::MessageId::BLOCK_BODIES_66);
-    msg_reply->set_data(rlp_encoding.data(), rlp_encoding.length());  // copy
+    msg_reply->set_data(reply.data(), reply.length());  // copy
 
     SILKWORM_LOG(LogLevel::Info) << "Replying to " << identify(*this) << " with send_message_by_id\n";
     rpc::SendMessageById send_message_by_id(peerId_, std::move(msg_reply));
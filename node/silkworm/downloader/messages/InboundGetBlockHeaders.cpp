@@ -48,22 +48,20 @@ void InboundGetBlockHeaders::execute() {
 
     HeaderRetrieval header_retrieval(db_);
 
-    BlockHeadersPacket66 reply;
-    reply.requestId = packet_.requestId;
+    // headers are served as stored in the db, the packet head is written in front of them afterwards
+    Bytes rlp_encoding(rlp::kEth66PacketHeadRoom, '\0');
     if (holds_alternative<Hash>(packet_.request.origin)) {
-        reply.request = header_retrieval.recover_by_hash(get<Hash>(packet_.request.origin), packet_.request.amount,
-                                                     packet_.request.skip, packet_.request.reverse);
+        header_retrieval.recover_rlp_by_hash(get<Hash>(packet_.request.origin), packet_.request.amount,
+                                             packet_.request.skip, packet_.request.reverse, rlp_encoding);
     } else {
-        reply.request = header_retrieval.recover_by_number(get<BlockNum>(packet_.request.origin), packet_.request.amount,
-                                                       packet_.request.skip, packet_.request.reverse);
+        header_retrieval.recover_rlp_by_number(get<BlockNum>(packet_.request.origin), packet_.request.amount,
+                                               packet_.request.skip, packet_.request.reverse, rlp_encoding);
     }
-
-    Bytes rlp_encoding;
-    rlp::encode(rlp_encoding, reply);
+    ByteView reply = rlp::wrap_eth66(rlp_encoding, packet_.requestId);
 
     auto msg_reply = std::make_unique<sentry::OutboundMessageData>();
     msg_reply->set_id(sentry::MessageId::BLOCK_HEADERS_66);
-    msg_reply->set_data(rlp_encoding.data(), rlp_encoding.length());  // copy
+    msg_reply->set_data(reply.data(), reply.length());  // copy
 
     SILKWORM_LOG(LogLevel::Info) << "Replying to " << identify(*this) << " with send_message_by_id\n";
 
@@ -17,6 +17,8 @@
 #ifndef SILKWORM_RLPETH66PACKETS_HPP
 #define SILKWORM_RLPETH66PACKETS_HPP
 
+#include <cassert>
+#include <cstring>
 #include <type_traits>
 
 #include <silkworm/downloader/internals/types.hpp>
@@ -62,6 +64,36 @@ inline size_t length(const T& from) noexcept {
     return rlp_head_len + rlp_head.payload_length;
 }
 
+/*
+ * Room to be left at the front of a buffer that will be turned into an eth66 packet by wrap_eth66:
+ * packet header (up to 9 bytes) + request id (up to 9 bytes) + list header (up to 9 bytes)
+ */
+inline constexpr size_t kEth66PacketHeadRoom = 32;
+
+/*
+ * Turns RLP items already encoded in buffer after kEth66PacketHeadRoom bytes into the eth66 packet {requestId, [items]}
+ * writing packet header, request id and list header backwards into the head room; returns a view of the whole packet.
+ * It lets us serve RLP read from the db without decoding and re-encoding it (see Erigon ReplyBlockBodiesRLP)
+ */
+inline ByteView wrap_eth66(Bytes& buffer, uint64_t requestId) {
+    assert(buffer.length() >= kEth66PacketHeadRoom);
+
+    const rlp::Header list_head{true, buffer.length() - kEth66PacketHeadRoom};
+    rlp::Header rlp_head{true, 0};
+    rlp_head.payload_length += rlp::length(requestId);
+    rlp_head.payload_length += rlp::length_of_length(list_head.payload_length) + list_head.payload_length;
+
+    Bytes head;
+    rlp::encode_header(head, rlp_head);
+    rlp::encode(head, requestId);
+    rlp::encode_header(head, list_head);
+    assert(head.length() <= kEth66PacketHeadRoom);
+
+    const size_t offset = kEth66PacketHeadRoom - head.length();
+    std::memcpy(&buffer[offset], head.data(), head.length());
+    return ByteView{buffer}.substr(offset);
+}
+
 /*
  * The constrained generic decode function below clashes with decode<T> defined in silkworm/core/rlp packet:
  *  - using concepts template<Eth66Packet T> decode(...) compiler resolves ambiguity because the concept version is more constrained of template<typename T> decode(...)
@@ -1077,6 +1077,12 @@ TEST_CASE("BlockHeadersPacket (eth/66) decoding/encoding") {
     // length test
     auto len = rlp::length(packet);
     REQUIRE(len == re_encoded.size());
+
+    // splicing already encoded headers
+    Bytes buffer(rlp::kEth66PacketHeadRoom, '\0');
+    rlp::encode(buffer, packet.request[0]);
+    ByteView spliced = rlp::wrap_eth66(buffer, packet.requestId);
+    REQUIRE(to_hex(spliced) == raw_packet);
 }
 
 // TESTs related to BlockBodiesPacket66 encoding/decoding - eth/66 version
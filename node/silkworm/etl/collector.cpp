@@ -19,11 +19,31 @@
 
 #include <silkworm/common/directories.hpp>
 #include <silkworm/common/log.hpp>
+#include <silkworm/common/metrics.hpp>
+#include <silkworm/common/trace_span.hpp>
 
 namespace silkworm::etl {
 
 namespace fs = std::filesystem;
 
+namespace {
+
+    struct CollectorMetrics {
+        metrics::Counter& spilled_bytes{metrics::Registry::instance().counter(
+            "silkworm_etl_spilled_bytes_total", "Bytes flushed by ETL collectors to temporary files")};
+        metrics::Counter& spilled_files{metrics::Registry::instance().counter(
+            "silkworm_etl_spilled_files_total", "Temporary files written by ETL collectors")};
+        metrics::Counter& loaded_entries{metrics::Registry::instance().counter(
+            "silkworm_etl_loaded_entries_total", "Entries loaded into the db by ETL collectors")};
+    };
+
+    CollectorMetrics& collector_metrics() {
+        static CollectorMetrics instance;
+        return instance;
+    }
+
+}  // namespace
+
 Collector::~Collector() {
     clear();  // Will ensure all files (if any) have been orderly closed and deleted
     if (work_path_managed_ && fs::exists(work_path_)) {
@@ -32,6 +52,7 @@ Collector::~Collector() {
 }
 
 void Collector::flush_buffer() {
+    SILKWORM_TRACE_SPAN("etl::Collector::flush_buffer");
     if (buffer_.size()) {
         SILKWORM_LOG(LogLevel::Info) << "Flushing Buffer File..." << std::endl;
         buffer_.sort();
@@ -42,6 +63,8 @@ void Collector::flush_buffer() {
 
         file_providers_.emplace_back(new FileProvider(new_file_path.string(), file_providers_.size()));
         file_providers_.back()->flush(buffer_);
+        collector_metrics().spilled_bytes.inc(buffer_.size());
+        collector_metrics().spilled_files.inc();
         buffer_.clear();
         SILKWORM_LOG(LogLevel::Info) << "Buffer Flushed" << std::endl;
     }
@@ -64,12 +87,14 @@ void Collector::collect(Entry&& entry) {
 }
 
 void Collector::load(mdbx::cursor& target, LoadFunc load_func, MDBX_put_flags_t flags, uint32_t log_every_percent) {
+    SILKWORM_TRACE_SPAN("etl::Collector::load");
     const auto overall_size{size()};  // Amount of work
 
     if (!overall_size) {
         SILKWORM_LOG(LogLevel::Info) << "ETL Load called without data to process" << std::endl;
         return;
     }
+    collector_metrics().loaded_entries.inc(overall_size);
 
     const uint32_t progress_step{log_every_percent ? std::min(log_every_percent, 100u) : 100u};
     const size_t progress_increment_count{overall_size / (100 / progress_step)};
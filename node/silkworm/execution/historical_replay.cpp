@@ -0,0 +1,197 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "historical_replay.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include <silkworm/consensus/engine.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/buffer.hpp>
+#include <silkworm/db/tables.hpp>
+#include <silkworm/execution/analysis_cache.hpp>
+#include <silkworm/execution/precompile_cache.hpp>
+#include <silkworm/execution/processor.hpp>
+#include <silkworm/execution/state_pool.hpp>
+#include <silkworm/types/receipt_cbor.hpp>
+
+namespace silkworm {
+
+// Caches and engines aren't thread safe, hence each worker has its own
+struct HistoricalReplay::WorkerState {
+    WorkerState(mdbx::txn_managed ro_txn, std::unique_ptr<consensus::IConsensusEngine> consensus_engine)
+        : txn{std::move(ro_txn)}, engine{std::move(consensus_engine)} {}
+
+    mdbx::txn_managed txn;
+    std::unique_ptr<consensus::IConsensusEngine> engine;
+    AnalysisCache analysis_cache;
+    ExecutionStatePool state_pool;
+    PrecompileCache precompile_cache;
+    EvmProfiler profiler;
+};
+
+HistoricalReplay::HistoricalReplay(mdbx::env& env, const ChainConfig& chain_config, Config config)
+    : env_{env}, chain_config_{chain_config}, config_{std::move(config)} {}
+
+uint64_t HistoricalReplay::run(uint64_t from, uint64_t to, const Callback& on_result) {
+    next_block_ = next_result_ = from;
+    end_ = to;
+    stopping_ = false;
+    error_ = nullptr;
+    results_.clear();
+
+    std::vector<std::thread> threads;
+    for (size_t i{0}; i < std::max(config_.num_workers, size_t{1}); ++i) {
+        threads.emplace_back(&HistoricalReplay::work, this);
+    }
+    const auto stop_workers{[&]() {
+        {
+            std::scoped_lock lock{mtx_};
+            stopping_ = true;
+        }
+        workers_cv_.notify_all();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }};
+
+    try {
+        std::unique_lock lock{mtx_};
+        while (true) {
+            results_cv_.wait(lock, [&]() { return error_ || next_result_ >= end_ || results_.count(next_result_); });
+            if (error_ || next_result_ >= end_) {
+                break;
+            }
+            auto node{results_.extract(next_result_)};
+            lock.unlock();
+            const bool proceed{on_result(node.mapped())};
+            lock.lock();
+            ++next_result_;
+            workers_cv_.notify_all();
+            if (!proceed) {
+                break;
+            }
+        }
+    } catch (...) {
+        stop_workers();
+        throw;
+    }
+
+    stop_workers();
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+    return next_result_;
+}
+
+void HistoricalReplay::work() {
+    try {
+        WorkerState worker{env_.start_read(), consensus::engine_factory(chain_config_)};
+        if (!worker.engine) {
+            throw std::runtime_error("Unable to retrieve consensus engine");
+        }
+        while (true) {
+            uint64_t block_number{0};
+            {
+                std::unique_lock lock{mtx_};
+                workers_cv_.wait(lock, [&]() {
+                    return stopping_ || next_block_ >= end_ || next_block_ < next_result_ + config_.max_pending;
+                });
+                if (stopping_ || next_block_ >= end_) {
+                    if (config_.profile) {
+                        profiler_.merge(worker.profiler);
+                    }
+                    return;
+                }
+                block_number = next_block_++;
+            }
+
+            auto result{replay_block(worker, block_number)};
+
+            {
+                std::scoped_lock lock{mtx_};
+                if (result) {
+                    results_.emplace(block_number, std::move(*result));
+                } else {
+                    end_ = std::min(end_, block_number);
+                    workers_cv_.notify_all();
+                }
+            }
+            results_cv_.notify_one();
+        }
+    } catch (...) {
+        {
+            std::scoped_lock lock{mtx_};
+            if (!error_) {
+                error_ = std::current_exception();
+            }
+            stopping_ = true;
+        }
+        workers_cv_.notify_all();
+        results_cv_.notify_one();
+    }
+}
+
+std::optional<ReplayResult> HistoricalReplay::replay_block(WorkerState& worker, uint64_t block_number) {
+    // Don't hold on to an old snapshot, lest the DB grows while a syncing Erigon can't reclaim pages
+    worker.txn.renew_reading();
+    mdbx::txn& txn{worker.txn};
+
+    std::optional<BlockWithHash> bh{db::read_block(txn, block_number, /*read_senders=*/true)};
+    if (!bh) {
+        return std::nullopt;
+    }
+
+    ReplayResult result;
+    result.block_number = block_number;
+    result.transaction_count = bh->block.transactions.size();
+
+    db::Buffer buffer{txn, /*prune_from=*/0, /*historical_block=*/block_number};
+    ExecutionProcessor processor{bh->block, *worker.engine, buffer, chain_config_};
+    processor.evm().advanced_analysis_cache = &worker.analysis_cache;
+    processor.evm().state_pool = &worker.state_pool;
+    processor.evm().precompile_cache = &worker.precompile_cache;
+    if (config_.profile) {
+        processor.evm().profiler = &worker.profiler;
+    }
+
+    result.validation = processor.execute_and_write_block(result.receipts);
+    if (result.validation == ValidationResult::kOk) {
+        if (auto it{buffer.account_changes().find(block_number)}; it != buffer.account_changes().end()) {
+            result.account_changes = it->second;
+        }
+        if (auto it{buffer.storage_changes().find(block_number)}; it != buffer.storage_changes().end()) {
+            result.storage_changes = it->second;
+        }
+    }
+
+    if (config_.compare_with_db) {
+        result.db_account_changes = db::read_account_changes(txn, block_number);
+        result.db_storage_changes = db::read_storage_changes(txn, block_number);
+
+        auto receipts_table{db::open_cursor(txn, db::table::kBlockReceipts)};
+        const Bytes key{db::block_key(block_number)};
+        if (auto data{receipts_table.find(db::to_slice(key), /*throw_notfound=*/false)}; data) {
+            result.receipts_match = db::from_slice(data.value) == ByteView{cbor_encode(result.receipts)};
+        }
+    }
+
+    return result;
+}
+
+}  // namespace silkworm
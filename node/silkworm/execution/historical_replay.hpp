@@ -0,0 +1,114 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_EXECUTION_HISTORICAL_REPLAY_HPP_
+#define SILKWORM_EXECUTION_HISTORICAL_REPLAY_HPP_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <silkworm/chain/config.hpp>
+#include <silkworm/consensus/validation.hpp>
+#include <silkworm/db/mdbx.hpp>
+#include <silkworm/db/util.hpp>
+#include <silkworm/execution/profiler.hpp>
+#include <silkworm/types/receipt.hpp>
+
+namespace silkworm {
+
+// Outcome of re-executing one historical block
+struct ReplayResult {
+    uint64_t block_number{0};
+    size_t transaction_count{0};
+    ValidationResult validation{ValidationResult::kOk};
+    std::vector<Receipt> receipts;
+
+    // Change sets as calculated
+    db::AccountChanges account_changes;
+    db::StorageChanges storage_changes;
+
+    // Change sets as stored in the DB, only read when Config::compare_with_db
+    db::AccountChanges db_account_changes;
+    db::StorageChanges db_storage_changes;
+
+    // Whether receipts match those stored in the DB; nullopt if not compared or none stored
+    std::optional<bool> receipts_match;
+};
+
+// Re-executes historical blocks against the state at their beginning (see db::Buffer's historical_block).
+// Every block is independent of the others, so blocks are spread over worker threads each having its own read-only
+// transaction (renewed per block) and execution caches, while results are handed back in block order on the calling
+// thread.
+class HistoricalReplay {
+  public:
+    struct Config {
+        size_t num_workers{std::max(std::thread::hardware_concurrency(), 1u)};
+        size_t max_pending{1024};  // blocks executed ahead of the one due to be handed back
+        bool compare_with_db{false};
+        bool profile{false};  // record an EVM profile per worker, merged into profiler() as workers finish
+    };
+
+    // Called in block order; returning false stops the replay
+    using Callback = std::function<bool(ReplayResult& result)>;
+
+    HistoricalReplay(mdbx::env& env, const ChainConfig& chain_config, Config config);
+
+    // Not copyable nor movable
+    HistoricalReplay(const HistoricalReplay&) = delete;
+    HistoricalReplay& operator=(const HistoricalReplay&) = delete;
+
+    // Replays blocks in [from, to) until the end of the canonical chain or until on_result returns false.
+    // Returns the number of the first block not handed back. Rethrows the first exception of workers or on_result.
+    uint64_t run(uint64_t from, uint64_t to, const Callback& on_result);
+
+    // Aggregated over all runs so far; empty unless Config::profile
+    const EvmProfiler& profiler() const noexcept { return profiler_; }
+
+  private:
+    struct WorkerState;  // execution state of one worker thread
+
+    void work();
+
+    // Returns nullopt if block_number is past the end of the chain
+    std::optional<ReplayResult> replay_block(WorkerState& worker, uint64_t block_number);
+
+    mdbx::env& env_;
+    const ChainConfig chain_config_;
+    const Config config_;
+
+    std::mutex mtx_;
+    std::condition_variable workers_cv_;  // room for more blocks ahead
+    std::condition_variable results_cv_;  // a result or an error is available
+    uint64_t next_block_{0};              // next block for workers to pick
+    uint64_t next_result_{0};             // next block to hand back
+    uint64_t end_{0};                     // first block not to replay
+    bool stopping_{false};
+    std::exception_ptr error_;
+    std::map<uint64_t, ReplayResult> results_;
+    EvmProfiler profiler_;
+};
+
+}  // namespace silkworm
+
+#endif  // SILKWORM_EXECUTION_HISTORICAL_REPLAY_HPP_
@@ -0,0 +1,103 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "historical_replay.hpp"
+
+#include <stdexcept>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/directories.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/tables.hpp>
+
+namespace silkworm {
+
+TEST_CASE("Historical replay") {
+    static constexpr uint64_t kBlocks{50};
+
+    TemporaryDirectory tmp_dir;
+    db::EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{db::open_env(db_config)};
+
+    // Empty Frontier blocks : executing them only credits the block reward to their beneficiary
+    {
+        auto txn{env.start_write()};
+        db::table::create_all(txn);
+        for (uint64_t block_num{1}; block_num <= kBlocks; ++block_num) {
+            BlockHeader header;
+            header.number = block_num;
+            header.beneficiary.bytes[19] = static_cast<uint8_t>(block_num);
+            header.gas_limit = 5'000;
+            const evmc::bytes32 hash{header.hash()};
+            db::write_header(txn, header);
+            db::write_canonical_header_hash(txn, hash.bytes, block_num);
+            db::write_body(txn, BlockBody{}, block_num, hash.bytes);
+        }
+        txn.commit();
+    }
+
+    HistoricalReplay::Config config;
+    config.num_workers = 4;
+    config.max_pending = 8;
+    config.compare_with_db = true;
+    HistoricalReplay replay{env, kMainnetConfig, config};
+
+    SECTION("Results in block order up to the end of the chain") {
+        uint64_t expected{1};
+        const uint64_t end{replay.run(1, UINT64_MAX, [&](ReplayResult& result) {
+            CHECK(result.block_number == expected++);
+            CHECK(result.validation == ValidationResult::kOk);
+            CHECK(result.transaction_count == 0);
+            evmc::address beneficiary{};
+            beneficiary.bytes[19] = static_cast<uint8_t>(result.block_number);
+            CHECK(result.account_changes.size() == 1);
+            CHECK(result.account_changes.contains(beneficiary));
+            CHECK(result.db_account_changes.empty());
+            CHECK(!result.receipts_match.has_value());  // none stored
+            return true;
+        })};
+        CHECK(end == kBlocks + 1);
+        CHECK(expected == kBlocks + 1);
+    }
+
+    SECTION("Bounded range") {
+        uint64_t count{0};
+        CHECK(replay.run(5, 10, [&](ReplayResult&) {
+            ++count;
+            return true;
+        }) == 10);
+        CHECK(count == 5);
+    }
+
+    SECTION("Stopped by the callback") {
+        CHECK(replay.run(1, UINT64_MAX, [](ReplayResult& result) { return result.block_number < 10; }) == 11);
+    }
+
+    SECTION("Callback exceptions are rethrown") {
+        CHECK_THROWS_AS(replay.run(1, UINT64_MAX,
+                                   [](ReplayResult& result) {
+                                       if (result.block_number == 3) {
+                                           throw std::runtime_error("test");
+                                       }
+                                       return true;
+                                   }),
+                        std::runtime_error);
+    }
+}
+
+}  // namespace silkworm
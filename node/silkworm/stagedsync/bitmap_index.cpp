@@ -0,0 +1,127 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "bitmap_index.hpp"
+
+#include <cstring>
+
+#include <silkworm/common/cast.hpp>
+#include <silkworm/common/endian.hpp>
+
+namespace silkworm::stagedsync::bitmap_index {
+
+void flush(etl::Collector& collector, std::unordered_map<std::string, roaring::Roaring>& bitmaps) {
+    for (const auto& [key, bm] : bitmaps) {
+        Bytes bitmap_bytes(bm.getSizeInBytes(), '\0');
+        bm.write(byte_ptr_cast(bitmap_bytes.data()));
+        collector.collect(etl::Entry{Bytes(byte_ptr_cast(key.c_str()), key.size()), bitmap_bytes});
+    }
+    bitmaps.clear();
+}
+
+void load(const etl::Entry& entry, mdbx::cursor& target, MDBX_put_flags_t db_flags) {
+    auto bm{roaring::Roaring::readSafe(byte_ptr_cast(entry.value.data()), entry.value.size())};
+    Bytes last_chunk_index(entry.key.size() + 4, '\0');
+    std::memcpy(&last_chunk_index[0], &entry.key[0], entry.key.size());
+    endian::store_big_u32(&last_chunk_index[entry.key.size()], UINT32_MAX);
+    auto previous_bitmap_bytes{target.find(db::to_slice(last_chunk_index), false)};
+    if (previous_bitmap_bytes) {
+        bm |= roaring::Roaring::readSafe(previous_bitmap_bytes.value.char_ptr(), previous_bitmap_bytes.value.length());
+        db_flags = MDBX_put_flags_t::MDBX_UPSERT;
+    }
+    while (bm.cardinality() > 0) {
+        auto current_chunk{db::bitmap::cut_left(bm, db::bitmap::kBitmapChunkLimit)};
+        // make chunk index
+        Bytes chunk_index(entry.key.size() + 4, '\0');
+        std::memcpy(&chunk_index[0], &entry.key[0], entry.key.size());
+        uint64_t suffix{bm.cardinality() == 0 ? UINT32_MAX : current_chunk.maximum()};
+        endian::store_big_u32(&chunk_index[entry.key.size()], suffix);
+        Bytes current_chunk_bytes(current_chunk.getSizeInBytes(), '\0');
+        current_chunk.write(byte_ptr_cast(&current_chunk_bytes[0]));
+
+        mdbx::slice k{db::to_slice(chunk_index)};
+        mdbx::slice v{db::to_slice(current_chunk_bytes)};
+        mdbx::error::success_or_throw(target.put(k, &v, db_flags));
+    }
+}
+
+void unwind(mdbx::cursor& target, etl::Collector& collector, BlockNum unwind_to) {
+    auto data{target.to_first(/*throw_notfound=*/false)};
+    while (data) {
+        // Get bitmap data of current element
+        auto key{db::from_slice(data.key)};
+        auto bitmap_data{db::from_slice(data.value)};
+
+        auto bm{roaring::Roaring::readSafe(byte_ptr_cast(bitmap_data.data()), bitmap_data.size())};
+        // Check for keys that can be skipped
+        if (bm.maximum() <= unwind_to) {
+            data = target.to_next(/*throw_notfound*/ false);
+            continue;
+        }
+        // adjust bitmaps
+        if (bm.minimum() <= unwind_to) {
+            // Erase elements that are > unwind_to
+            bm &= roaring::Roaring(roaring::api::roaring_bitmap_from_range(0, unwind_to + 1, 1));
+            auto new_bitmap{Bytes(bm.getSizeInBytes(), '\0')};
+            bm.write(byte_ptr_cast(&new_bitmap[0]));
+            // make new key
+            Bytes new_key(key.size(), '\0');
+            std::memcpy(&new_key[0], key.data(), key.size());
+            endian::store_big_u32(&new_key[new_key.size() - 4], UINT32_MAX);
+            // collect higher bitmap
+            collector.collect(etl::Entry{new_key, new_bitmap});
+        }
+        // erase index
+        target.erase(true);
+        data = target.to_next(/*throw_notfound*/ false);
+    }
+
+    collector.load(target, nullptr, MDBX_put_flags_t::MDBX_UPSERT, /* log_every_percent = */ 100);
+}
+
+void prune(mdbx::cursor& target, etl::Collector& collector, BlockNum prune_from, BlockNum last_processed_block) {
+    if (target.to_first(/* throw_notfound = */ false)) {
+        auto data{target.current()};
+        while (data) {
+            // Get bitmap data of current element
+            auto key{db::from_slice(data.key)};
+            auto bitmap_data{db::from_slice(data.value)};
+            auto bm{roaring::Roaring::readSafe(byte_ptr_cast(bitmap_data.data()), bitmap_data.size())};
+            // Check whether we should skip the current bitmap
+            if (bm.minimum() >= prune_from) {
+                data = target.to_next(/*throw_notfound*/ false);
+                continue;
+            }
+            // check if prune can be applied
+            if (bm.maximum() >= prune_from) {
+                // Erase elements that are below prune_from
+                bm &=
+                    roaring::Roaring(roaring::api::roaring_bitmap_from_range(prune_from, last_processed_block + 1, 1));
+                Bytes new_bitmap(bm.getSizeInBytes(), '\0');
+                bm.write(byte_ptr_cast(&new_bitmap[0]));
+                // replace with new index
+                etl::Entry entry{Bytes{key}, new_bitmap};
+                collector.collect(entry);
+            }
+            target.erase(/* whole_multivalue = */ true);
+            data = target.to_next(/*throw_notfound*/ false);
+        }
+    }
+
+    collector.load(target, nullptr, MDBX_put_flags_t::MDBX_UPSERT, /* log_every_percent = */ 100);
+}
+
+}  // namespace silkworm::stagedsync::bitmap_index
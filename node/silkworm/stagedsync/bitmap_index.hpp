@@ -0,0 +1,49 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_STAGEDSYNC_BITMAP_INDEX_HPP_
+#define SILKWORM_STAGEDSYNC_BITMAP_INDEX_HPP_
+
+#include <string>
+#include <unordered_map>
+
+#include <silkworm/db/bitmap.hpp>
+#include <silkworm/db/mdbx.hpp>
+#include <silkworm/etl/collector.hpp>
+
+/*
+Block number indices keyed by address or topic, as written by the LogIndex and CallTraces stages: the blocks of each
+key are split into roaring bitmap chunks keyed by key + u32 BE maximum block of the chunk, the last chunk of a key
+having UINT32_MAX instead (Erigon bitmapdb).
+*/
+
+namespace silkworm::stagedsync::bitmap_index {
+
+// Collects the bitmaps accumulated so far and clears them
+void flush(etl::Collector& collector, std::unordered_map<std::string, roaring::Roaring>& bitmaps);
+
+// etl::LoadFunc merging a collected bitmap into the last chunk of its key, then splitting it into chunks
+void load(const etl::Entry& entry, mdbx::cursor& target, MDBX_put_flags_t db_flags);
+
+// Removes blocks after unwind_to, collector holding the rewritten chunks meanwhile
+void unwind(mdbx::cursor& target, etl::Collector& collector, BlockNum unwind_to);
+
+// Removes blocks before prune_from, collector holding the rewritten chunks meanwhile
+void prune(mdbx::cursor& target, etl::Collector& collector, BlockNum prune_from, BlockNum last_processed_block);
+
+}  // namespace silkworm::stagedsync::bitmap_index
+
+#endif  // SILKWORM_STAGEDSYNC_BITMAP_INDEX_HPP_
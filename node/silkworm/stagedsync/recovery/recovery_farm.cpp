@@ -20,11 +20,30 @@
 
 #include <silkworm/common/endian.hpp>
 #include <silkworm/common/log.hpp>
+#include <silkworm/common/metrics.hpp>
 #include <silkworm/db/access_layer.hpp>
 #include <silkworm/db/stages.hpp>
 
 namespace silkworm::stagedsync::recovery {
 
+namespace {
+
+    struct RecoveryMetrics {
+        metrics::Counter& blocks{metrics::Registry::instance().counter("silkworm_senders_blocks_total",
+                                                                       "Blocks whose senders have been recovered")};
+        metrics::Counter& senders{metrics::Registry::instance().counter("silkworm_senders_recovered_total",
+                                                                        "Transaction senders recovered")};
+        metrics::Gauge& workers_in_flight{metrics::Registry::instance().gauge(
+            "silkworm_senders_workers_in_flight", "Recovery workers processing a batch")};
+    };
+
+    RecoveryMetrics& recovery_metrics() {
+        static RecoveryMetrics instance;
+        return instance;
+    }
+
+}  // namespace
+
 RecoveryFarm::RecoveryFarm(mdbx::txn& db_transaction, uint32_t max_workers, size_t max_batch_size,
                            etl::Collector& collector)
     : db_transaction_{db_transaction},
@@ -119,10 +138,10 @@ StageResult RecoveryFarm::recover(BlockNum to) {
 
         // Get the body and its transactions
         auto body_rlp{db::from_slice(body_data.value)};
-        auto block_body{db::detail::decode_stored_block_body(body_rlp)};
+        auto block_body{db::detail::decode_stored_block_body_view(body_rlp)};
         if (block_body.txn_count) {
-            std::vector<Transaction> transactions{
-                db::read_transactions(transactions_table, block_body.base_txn_id, block_body.txn_count)};
+            std::vector<TransactionView> transactions{
+                db::read_transaction_views(transactions_table, block_body.base_txn_id, block_body.txn_count)};
             stage_result = transform_and_fill_batch(chain_config.value(), reached_block_num, transactions);
             if (stage_result != StageResult::kSuccess) {
                 break;
@@ -264,6 +283,8 @@ bool RecoveryFarm::collect_workers_results() {
                         for (const auto& [block_num, data] : worker_results) {
                             total_processed_blocks_++;
                             total_recovered_transactions_ += (data.length() / kAddressLength);
+                            recovery_metrics().blocks.inc();
+                            recovery_metrics().senders.inc(data.length() / kAddressLength);
                             auto etl_key{db::block_key(block_num, headers_.at(block_num - header_index_offset_).bytes)};
                             Bytes etl_data(data.data(), data.length());
                             collector_.collect(etl::Entry{etl_key, etl_data});
@@ -302,7 +323,7 @@ bool RecoveryFarm::collect_workers_results() {
 }
 
 StageResult RecoveryFarm::transform_and_fill_batch(const ChainConfig& config, uint64_t block_num,
-                                                   std::vector<Transaction>& transactions) {
+                                                   std::vector<TransactionView>& transactions) {
     if (transactions.empty()) {
         return StageResult::kSuccess;
     }
@@ -321,14 +342,15 @@ StageResult RecoveryFarm::transform_and_fill_batch(const ChainConfig& config, ui
     const bool has_london{rev >= EVMC_LONDON};
 
     uint32_t tx_id{0};
+    TransactionView::Signature signature;
     for (const auto& transaction : transactions) {
-        switch (transaction.type) {
+        switch (transaction.type()) {
             case Transaction::Type::kLegacy:
                 break;
             case Transaction::Type::kEip2930:
                 if (!has_berlin) {
                     SILKWORM_LOG(LogLevel::Error)
-                        << "Transaction type " << magic_enum::enum_name<Transaction::Type>(transaction.type)
+                        << "Transaction type " << magic_enum::enum_name<Transaction::Type>(transaction.type())
                         << " for transaction #" << tx_id << " in block #" << block_num << " before Berlin" << std::endl;
                     return StageResult::kInvalidTransaction;
                 }
@@ -336,38 +358,41 @@ StageResult RecoveryFarm::transform_and_fill_batch(const ChainConfig& config, ui
             case Transaction::Type::kEip1559:
                 if (!has_london) {
                     SILKWORM_LOG(LogLevel::Error)
-                        << "Transaction type " << magic_enum::enum_name<Transaction::Type>(transaction.type)
+                        << "Transaction type " << magic_enum::enum_name<Transaction::Type>(transaction.type())
                         << " for transaction #" << tx_id << " in block #" << block_num << " before London" << std::endl;
                     return StageResult::kInvalidTransaction;
                 }
                 break;
         }
 
-        if (!silkworm::ecdsa::is_valid_signature(transaction.r, transaction.s, has_homestead)) {
+        if (transaction.decode_signature(signature) != rlp::DecodingResult::kOk) {
+            SILKWORM_LOG(LogLevel::Error)
+                << "Got malformed signature for transaction #" << tx_id << " in block #" << block_num << std::endl;
+            return StageResult::kInvalidTransaction;
+        }
+
+        if (!silkworm::ecdsa::is_valid_signature(signature.r, signature.s, has_homestead)) {
             SILKWORM_LOG(LogLevel::Error)
                 << "Got invalid signature for transaction #" << tx_id << " in block #" << block_num << std::endl;
             return StageResult::kInvalidTransaction;
         }
 
-        if (transaction.chain_id.has_value()) {
+        if (signature.chain_id.has_value()) {
             if (!has_spurious_dragon) {
                 SILKWORM_LOG(LogLevel::Error) << "EIP-155 signature for transaction #" << tx_id << " in block #"
                                               << block_num << " before Spurious Dragon" << std::endl;
                 return StageResult::kInvalidTransaction;
-            } else if (transaction.chain_id.value() != config.chain_id) {
+            } else if (signature.chain_id.value() != config.chain_id) {
                 SILKWORM_LOG(LogLevel::Error) << "EIP-155 invalid signature for transaction #" << tx_id << " in block #"
                                               << block_num << std::endl;
                 return StageResult::kInvalidTransaction;
             }
         }
 
-        Bytes rlp{};
-        rlp::encode(rlp, transaction, /*for_signing=*/true, /*wrap_eip2718_into_array=*/false);
-
-        auto hash{keccak256(rlp)};
-        batch_.push_back(RecoveryPackage{block_num, hash, transaction.odd_y_parity});
-        intx::be::unsafe::store(batch_.back().signature, transaction.r);
-        intx::be::unsafe::store(batch_.back().signature + kHashLength, transaction.s);
+        auto hash{transaction.signing_hash(signature.chain_id)};
+        batch_.push_back(RecoveryPackage{block_num, hash, signature.odd_y_parity});
+        intx::be::unsafe::store(batch_.back().signature, signature.r);
+        intx::be::unsafe::store(batch_.back().signature + kHashLength, signature.s);
 
         tx_id++;
     }
@@ -398,6 +423,7 @@ bool RecoveryFarm::dispatch_batch() {
             it->first->set_work(batch_id_++, batch_);  // Worker will swap contents
             batch_.resize(0);
             workers_in_flight_++;
+            recovery_metrics().workers_in_flight.add(1);
             return true;
         } else {
             // Do we have ready results from workers that we need to harvest ?
@@ -523,6 +549,7 @@ void RecoveryFarm::worker_completed_handler(RecoveryWorker* sender) {
     harvest_pairs_.push(item);
     completed_batch_id_++;
     workers_in_flight_--;
+    recovery_metrics().workers_in_flight.add(-1);
 }
 
 }  // namespace silkworm::stagedsync::recovery
@@ -24,6 +24,7 @@
 #include <silkworm/etl/collector.hpp>
 #include <silkworm/stagedsync/recovery/recovery_worker.hpp>
 #include <silkworm/stagedsync/util.hpp>
+#include <silkworm/types/transaction_view.hpp>
 
 namespace silkworm::stagedsync::recovery {
 
@@ -75,7 +76,7 @@ class RecoveryFarm {
     //! \return A code indicating process status
     //! \remarks If detects a batch overflow it also dispatches
     StageResult transform_and_fill_batch(const ChainConfig& config, BlockNum block_num,
-                                         std::vector<Transaction>& transactions);
+                                         std::vector<TransactionView>& transactions);
 
     //! \brief Dispatches the collected batch of recovery packages to first available worker
     //! \returns True if operation succeeds, false otherwise
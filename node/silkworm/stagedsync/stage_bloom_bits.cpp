@@ -0,0 +1,168 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <filesystem>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <silkworm/common/endian.hpp>
+#include <silkworm/common/log.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/bloom_bits.hpp>
+#include <silkworm/db/stages.hpp>
+#include <silkworm/etl/collector.hpp>
+
+#include "stagedsync.hpp"
+
+namespace silkworm::stagedsync {
+
+namespace fs = std::filesystem;
+
+using db::bloom_bits::kSectionSize;
+
+// Only complete sections are indexed, so progress is the last block of the last one (or 0 if none)
+static BlockNum section_progress(uint64_t sections) { return sections ? sections * kSectionSize - 1 : 0; }
+
+static StageResult load_bloom_bits(TransactionManager& txn, etl::Collector& collector,
+                                   const std::vector<std::pair<uint64_t, evmc::bytes32>>& heads) {
+    if (heads.empty()) {
+        SILKWORM_LOG(LogLevel::Info) << "Nothing to process" << std::endl;
+        return StageResult::kSuccess;
+    }
+
+    SILKWORM_LOG(LogLevel::Info) << "Started Bloom Bits Loading" << std::endl;
+
+    // Keys are sorted by bit first, hence appending only works on an empty table
+    auto target_table{db::open_cursor(*txn, db::table::kBloomBits)};
+    auto target_table_rcount{txn->get_map_stat(target_table.map()).ms_entries};
+    MDBX_put_flags_t db_flags{target_table_rcount ? MDBX_put_flags_t::MDBX_UPSERT : MDBX_put_flags_t::MDBX_APPEND};
+    collector.load(target_table, nullptr, db_flags, /* log_every_percent = */ 10);
+
+    auto index_table{db::open_cursor(*txn, db::table::kBloomBitsIndex)};
+    for (const auto& [section, head_hash] : heads) {
+        index_table.upsert(db::to_slice(db::block_key(section)), db::to_slice(head_hash));
+    }
+
+    db::stages::write_stage_progress(*txn, db::stages::kBloomBitsKey, section_progress(heads.back().first + 1));
+    txn.commit();
+
+    SILKWORM_LOG(LogLevel::Info) << "All Done" << std::endl;
+    return StageResult::kSuccess;
+}
+
+StageResult extract_bloom_bits(mdbx::txn& ro_txn, const std::filesystem::path& etl_path, uint64_t,
+                               StageLoad& load) {
+    fs::create_directories(etl_path);
+    auto collector{std::make_shared<etl::Collector>(etl_path, /* flush size */ 512_Mebi)};
+    auto heads{std::make_shared<std::vector<std::pair<uint64_t, evmc::bytes32>>>()};
+
+    const BlockNum headers_progress{db::stages::read_stage_progress(ro_txn, db::stages::kHeadersKey)};
+    uint64_t section{(db::stages::read_stage_progress(ro_txn, db::stages::kBloomBitsKey) + 1) / kSectionSize};
+
+    SILKWORM_LOG(LogLevel::Info) << "Started Bloom Bits Extraction" << std::endl;
+
+    auto canonical_hashes_table{db::open_cursor(ro_txn, db::table::kCanonicalHashes)};
+    for (; (section + 1) * kSectionSize - 1 <= headers_progress; ++section) {
+        db::bloom_bits::SectionGenerator generator;
+        evmc::bytes32 hash;
+
+        const BlockNum first{section * kSectionSize};
+        auto data{canonical_hashes_table.find(db::to_slice(db::block_key(first)), /*throw_notfound*/ false)};
+        for (uint64_t i{0}; i < kSectionSize; ++i) {
+            if (!data || endian::load_big_u64(static_cast<uint8_t*>(data.key.iov_base)) != first + i) {
+                SILKWORM_LOG(LogLevel::Error) << "Bad headers sequence at block " << first + i << std::endl;
+                return StageResult::kBadChainSequence;
+            }
+            if (data.value.length() != kHashLength) {
+                SILKWORM_LOG(LogLevel::Error) << "Bad header hash for block " << first + i << std::endl;
+                return StageResult::kBadBlockHash;
+            }
+            hash = to_bytes32(db::from_slice(data.value));
+            const std::optional<BlockHeader> header{db::read_header(ro_txn, first + i, hash.bytes)};
+            if (!header) {
+                SILKWORM_LOG(LogLevel::Error) << "Missing header for block " << first + i << std::endl;
+                return StageResult::kBadChainSequence;
+            }
+            generator.add_bloom(i, header->logs_bloom);
+            data = canonical_hashes_table.to_next(/*throw_notfound*/ false);
+        }
+
+        for (size_t bit{0}; bit < db::bloom_bits::kBitLength; ++bit) {
+            Bytes compressed{db::bloom_bits::compress({generator.vector(bit).data(), db::bloom_bits::kVectorLength})};
+            if (!compressed.empty()) {  // all-zero vectors aren't stored
+                collector->collect(etl::Entry{db::bloom_bits::vector_key(static_cast<uint16_t>(bit), section, hash),
+                                              std::move(compressed)});
+            }
+        }
+        heads->emplace_back(section, hash);
+
+        if (section % 16 == 0) {
+            SILKWORM_LOG(LogLevel::Info) << "Bloom Bits Extraction Progress << " << first + kSectionSize - 1
+                                         << std::endl;
+        }
+    }
+
+    SILKWORM_LOG(LogLevel::Info) << "Sections Collected << " << heads->size() << std::endl;
+
+    load = [collector, heads](TransactionManager& txn) { return load_bloom_bits(txn, *collector, *heads); };
+    return StageResult::kSuccess;
+}
+
+StageResult stage_bloom_bits(TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t prune_from) {
+    StageLoad load;
+    if (const auto res{extract_bloom_bits(*txn, etl_path, prune_from, load)}; res != StageResult::kSuccess) {
+        return res;
+    }
+    return load(txn);
+}
+
+StageResult unwind_bloom_bits(TransactionManager& txn, const std::filesystem::path&, uint64_t unwind_to) {
+    if (unwind_to >= db::stages::read_stage_progress(*txn, db::stages::kBloomBitsKey)) {
+        return StageResult::kSuccess;
+    }
+
+    // Sections ending past unwind_to are dropped
+    const uint64_t kept_sections{(unwind_to + 1) / kSectionSize};
+
+    SILKWORM_LOG(LogLevel::Info) << "Started Bloom Bits Unwind, from: "
+                                 << db::stages::read_stage_progress(*txn, db::stages::kBloomBitsKey)
+                                 << " to: " << section_progress(kept_sections) << std::endl;
+
+    auto index_table{db::open_cursor(*txn, db::table::kBloomBitsIndex)};
+    auto vectors_table{db::open_cursor(*txn, db::table::kBloomBits)};
+    const Bytes first_dropped{db::block_key(kept_sections)};
+    for (auto index_data{index_table.lower_bound(db::to_slice(first_dropped), /*throw_notfound*/ false)}; index_data;
+         index_data = index_table.lower_bound(db::to_slice(first_dropped), /*throw_notfound*/ false)) {
+        const uint64_t section{endian::load_big_u64(static_cast<uint8_t*>(index_data.key.iov_base))};
+        const evmc::bytes32 head_hash{to_bytes32(db::from_slice(index_data.value))};
+        for (size_t bit{0}; bit < db::bloom_bits::kBitLength; ++bit) {
+            const Bytes key{db::bloom_bits::vector_key(static_cast<uint16_t>(bit), section, head_hash)};
+            if (vectors_table.seek(db::to_slice(key))) {
+                vectors_table.erase();
+            }
+        }
+        index_table.erase();
+    }
+
+    db::stages::write_stage_progress(*txn, db::stages::kBloomBitsKey, section_progress(kept_sections));
+    txn.commit();
+
+    SILKWORM_LOG(LogLevel::Info) << "All Done" << std::endl;
+    return StageResult::kSuccess;
+}
+
+}  // namespace silkworm::stagedsync
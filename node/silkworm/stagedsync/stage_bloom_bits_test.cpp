@@ -0,0 +1,108 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <algorithm>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/directories.hpp>
+#include <silkworm/common/endian.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/bloom_bits.hpp>
+#include <silkworm/db/stages.hpp>
+
+#include "stagedsync.hpp"
+
+namespace silkworm {
+
+using namespace evmc::literals;
+
+TEST_CASE("Stage Bloom Bits") {
+    using db::bloom_bits::kSectionSize;
+
+    TemporaryDirectory tmp_dir;
+    DataDirectory data_dir{tmp_dir.path()};
+    CHECK_NOTHROW(data_dir.deploy());
+
+    db::EnvConfig db_config{data_dir.chaindata().path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{db::open_env(db_config)};
+    stagedsync::TransactionManager txn{env};
+    db::table::create_all(*txn);
+
+    const auto address{0x06012c8cf97bead5deae237070f9587f8e7a266d_address};
+    const auto topic{0xddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef_bytes32};
+    const db::bloom_bits::Matcher matcher{{address}, {{topic}}};
+
+    // One section and a bit, with matching logs every 1000 blocks
+    const BlockNum head{kSectionSize + 1500};
+    std::vector<Bloom> blooms;
+    for (BlockNum n{0}; n <= head; ++n) {
+        BlockHeader header;
+        header.number = n;
+        evmc::address emitter;
+        endian::store_big_u64(&emitter.bytes[kAddressLength - 8], n + 1);
+        std::vector<Log> logs{Log{emitter}};
+        if (n % 1000 == 1) {
+            logs.push_back(Log{address, {topic}});
+        }
+        header.logs_bloom = logs_bloom(logs);
+        blooms.push_back(header.logs_bloom);
+        db::write_header(*txn, header);
+        db::write_canonical_header_hash(*txn, header.hash().bytes, n);
+    }
+    db::stages::write_stage_progress(*txn, db::stages::kHeadersKey, head);
+    txn.commit();
+
+    const auto expected_candidates{[&](BlockNum from, BlockNum to) {
+        std::vector<BlockNum> candidates;
+        for (BlockNum n{from}; n <= to; ++n) {
+            if (matcher.matches(blooms[n])) {
+                candidates.push_back(n);
+            }
+        }
+        return candidates;
+    }};
+
+    REQUIRE(stagedsync::stage_bloom_bits(txn, data_dir.etl().path()) == stagedsync::StageResult::kSuccess);
+    CHECK(db::stages::read_stage_progress(*txn, db::stages::kBloomBitsKey) == kSectionSize - 1);
+    CHECK(txn->get_map_stat(db::open_map(*txn, db::table::kBloomBitsIndex)).ms_entries == 1);
+    CHECK(txn->get_map_stat(db::open_map(*txn, db::table::kBloomBits)).ms_entries > 0);
+
+    // Nothing new to index until the next section is complete
+    REQUIRE(stagedsync::stage_bloom_bits(txn, data_dir.etl().path()) == stagedsync::StageResult::kSuccess);
+    CHECK(db::stages::read_stage_progress(*txn, db::stages::kBloomBitsKey) == kSectionSize - 1);
+
+    const auto candidates{db::bloom_bits::find_candidates(*txn, 0, head, matcher)};
+    CHECK(candidates == expected_candidates(0, head));
+    for (BlockNum n{1}; n <= head; n += 1000) {
+        CHECK(std::find(candidates.begin(), candidates.end(), n) != candidates.end());
+    }
+    CHECK(db::bloom_bits::find_candidates(*txn, 2000, kSectionSize + 10, matcher) ==
+          expected_candidates(2000, kSectionSize + 10));
+    CHECK(db::bloom_bits::find_candidates(*txn, 10, 5, matcher).empty());
+
+    REQUIRE(stagedsync::unwind_bloom_bits(txn, data_dir.etl().path(), kSectionSize - 2) ==
+            stagedsync::StageResult::kSuccess);
+    CHECK(db::stages::read_stage_progress(*txn, db::stages::kBloomBitsKey) == 0);
+    CHECK(txn->get_map_stat(db::open_map(*txn, db::table::kBloomBitsIndex)).ms_entries == 0);
+    CHECK(txn->get_map_stat(db::open_map(*txn, db::table::kBloomBits)).ms_entries == 0);
+
+    // Headers only
+    CHECK(db::bloom_bits::find_candidates(*txn, 0, head, matcher) == expected_candidates(0, head));
+}
+
+}  // namespace silkworm
@@ -0,0 +1,170 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <silkworm/common/endian.hpp>
+#include <silkworm/common/log.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/stages.hpp>
+#include <silkworm/etl/collector.hpp>
+#include <silkworm/stagedsync/bitmap_index.hpp>
+
+#include "stagedsync.hpp"
+
+namespace silkworm::stagedsync {
+
+namespace fs = std::filesystem;
+
+constexpr size_t kBitmapBufferSizeLimit = 512_Mebi;
+
+// CallTraceSet value flags (see db::Buffer::insert_call_traces)
+constexpr uint8_t kCallSenderFlag{1};
+constexpr uint8_t kCallRecipientFlag{2};
+
+static StageResult load_call_traces(TransactionManager& txn, etl::Collector& from_collector,
+                                    etl::Collector& to_collector, BlockNum last_processed_block_number,
+                                    BlockNum block_number) {
+    // if stage has never been touched then appending is safe
+    MDBX_put_flags_t db_flags{last_processed_block_number ? MDBX_put_flags_t::MDBX_UPSERT
+                                                          : MDBX_put_flags_t::MDBX_APPEND};
+
+    SILKWORM_LOG(LogLevel::Info) << "Started Call From Loading" << std::endl;
+    auto target{db::open_cursor(*txn, db::table::kCallFromIndex)};
+    from_collector.load(target, bitmap_index::load, db_flags, /* log_every_percent = */ 10);
+    target.close();
+
+    SILKWORM_LOG(LogLevel::Info) << "Started Call To Loading" << std::endl;
+    target = db::open_cursor(*txn, db::table::kCallToIndex);
+    to_collector.load(target, bitmap_index::load, db_flags, /* log_every_percent = */ 10);
+
+    db::stages::write_stage_progress(*txn, db::stages::kCallTracesKey, block_number);
+    txn.commit();
+
+    SILKWORM_LOG(LogLevel::Info) << "All Done" << std::endl;
+    return StageResult::kSuccess;
+}
+
+StageResult extract_call_traces(mdbx::txn& ro_txn, const std::filesystem::path& etl_path, uint64_t,
+                                StageLoad& load) {
+    fs::create_directories(etl_path);
+    auto from_collector{std::make_shared<etl::Collector>(etl_path, /* flush size */ 256_Mebi)};
+    auto to_collector{std::make_shared<etl::Collector>(etl_path, /* flush size */ 256_Mebi)};
+
+    const BlockNum last_processed_block_number{db::stages::read_stage_progress(ro_txn, db::stages::kCallTracesKey)};
+    const BlockNum block_number{db::stages::read_stage_progress(ro_txn, db::stages::kExecutionKey)};
+    if (last_processed_block_number >= block_number) {
+        SILKWORM_LOG(LogLevel::Info) << "Nothing to process" << std::endl;
+        load = [](TransactionManager&) { return StageResult::kSuccess; };
+        return StageResult::kSuccess;
+    }
+
+    SILKWORM_LOG(LogLevel::Info) << "Started Call Traces Extraction" << std::endl;
+
+    std::unordered_map<std::string, roaring::Roaring> from_bitmaps;
+    std::unordered_map<std::string, roaring::Roaring> to_bitmaps;
+    size_t allocated_space{0};
+
+    auto call_trace_table{db::open_cursor(ro_txn, db::table::kCallTraceSet)};
+    auto data{call_trace_table.lower_bound(db::to_slice(db::block_key(last_processed_block_number + 1)), false)};
+    while (data) {
+        const BlockNum current_block{endian::load_big_u64(static_cast<uint8_t*>(data.key.iov_base))};
+        if (current_block > block_number) {
+            break;
+        }
+        if (data.value.length() != kAddressLength + 1) {
+            SILKWORM_LOG(LogLevel::Error) << "Bad call trace at block " << current_block << std::endl;
+            return StageResult::kDecodingError;
+        }
+        const std::string address{data.value.char_ptr(), kAddressLength};
+        const uint8_t flags{data.value.byte_ptr()[kAddressLength]};
+        if (flags & kCallSenderFlag) {
+            from_bitmaps[address].add(static_cast<uint32_t>(current_block));
+        }
+        if (flags & kCallRecipientFlag) {
+            to_bitmaps[address].add(static_cast<uint32_t>(current_block));
+        }
+        allocated_space += kAddressLength;
+
+        if (allocated_space > kBitmapBufferSizeLimit) {
+            bitmap_index::flush(*from_collector, from_bitmaps);
+            bitmap_index::flush(*to_collector, to_bitmaps);
+            SILKWORM_LOG(LogLevel::Info) << "Current Block: " << current_block << std::endl;
+            allocated_space = 0;
+        }
+
+        data = call_trace_table.to_next(/*throw_notfound*/ false);
+    }
+
+    bitmap_index::flush(*from_collector, from_bitmaps);
+    bitmap_index::flush(*to_collector, to_bitmaps);
+
+    SILKWORM_LOG(LogLevel::Info) << "Latest Block: " << block_number << std::endl;
+
+    load = [from_collector, to_collector, last_processed_block_number, block_number](TransactionManager& txn) {
+        return load_call_traces(txn, *from_collector, *to_collector, last_processed_block_number, block_number);
+    };
+    return StageResult::kSuccess;
+}
+
+StageResult stage_call_traces(TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t prune_from) {
+    StageLoad load;
+    if (const auto res{extract_call_traces(*txn, etl_path, prune_from, load)}; res != StageResult::kSuccess) {
+        return res;
+    }
+    return load(txn);
+}
+
+StageResult unwind_call_traces(TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t unwind_to) {
+    if (unwind_to >= db::stages::read_stage_progress(*txn, db::stages::kCallTracesKey)) {
+        return StageResult::kSuccess;
+    }
+
+    etl::Collector collector(etl_path, /* flush size */ 256_Mebi);
+    for (const auto& table : {db::table::kCallFromIndex, db::table::kCallToIndex}) {
+        SILKWORM_LOG(LogLevel::Info) << "Started " << table.name << " Unwind" << std::endl;
+        auto index_table{db::open_cursor(*txn, table)};
+        bitmap_index::unwind(index_table, collector, unwind_to);
+        collector.clear();
+    }
+
+    db::stages::write_stage_progress(*txn, db::stages::kCallTracesKey, unwind_to);
+    txn.commit();
+
+    SILKWORM_LOG(LogLevel::Info) << "All Done" << std::endl;
+    return StageResult::kSuccess;
+}
+
+StageResult prune_call_traces(TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t prune_from) {
+    const BlockNum last_processed_block{db::stages::read_stage_progress(*txn, db::stages::kCallTracesKey)};
+
+    etl::Collector collector(etl_path, /* flush size */ 256_Mebi);
+    SILKWORM_LOG(LogLevel::Info) << "Pruning Call Traces from: " << prune_from << std::endl;
+    for (const auto& table : {db::table::kCallFromIndex, db::table::kCallToIndex}) {
+        auto index_table{db::open_cursor(*txn, table)};
+        bitmap_index::prune(index_table, collector, prune_from, last_processed_block);
+        collector.clear();
+    }
+    txn.commit();
+
+    SILKWORM_LOG(LogLevel::Info) << "Pruning Call Traces finished..." << std::endl;
+    return StageResult::kSuccess;
+}
+
+}  // namespace silkworm::stagedsync
@@ -0,0 +1,97 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/directories.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/bitmap.hpp>
+#include <silkworm/db/stages.hpp>
+
+#include "stagedsync.hpp"
+
+namespace silkworm {
+
+using namespace evmc::literals;
+
+TEST_CASE("Stage Call Traces") {
+    TemporaryDirectory tmp_dir;
+    DataDirectory data_dir{tmp_dir.path()};
+    CHECK_NOTHROW(data_dir.deploy());
+
+    db::EnvConfig db_config{data_dir.chaindata().path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{db::open_env(db_config)};
+    stagedsync::TransactionManager txn{env};
+    db::table::create_all(*txn);
+
+    const auto address_a{0x8e4d1ea201b908ab5e1f5a1c3f9f1b4f6c1e9cf1_address};
+    const auto address_b{0x3589d05a1ec4af9f65b0e5554e645707775ee43c_address};
+    const auto address_c{0xb4200db1ec87f1c55aa0d6f8d1f6fac8f3dc2d9c_address};
+
+    // As written by db::Buffer::insert_call_traces
+    const std::vector<std::tuple<BlockNum, evmc::address, uint8_t>> traces{
+        {1, address_a, 1}, {1, address_b, 2}, {2, address_a, 3}, {3, address_b, 1}, {3, address_c, 2},
+    };
+    auto call_trace_table{db::open_cursor(*txn, db::table::kCallTraceSet)};
+    for (const auto& [block_num, address, flags] : traces) {
+        Bytes value{full_view(address)};
+        value.push_back(flags);
+        call_trace_table.upsert(db::to_slice(db::block_key(block_num)), db::to_slice(value));
+    }
+    call_trace_table.close();
+    db::stages::write_stage_progress(*txn, db::stages::kExecutionKey, 3);
+    txn.commit();
+
+    // Blocks of the last chunk of an address
+    const auto read_blocks{[&](const db::MapConfig& table, const evmc::address& address) {
+        Bytes key{full_view(address)};
+        key.append(4, 0xff);
+        auto data{db::open_cursor(*txn, table).find(db::to_slice(key), /*throw_notfound*/ false)};
+        std::vector<uint32_t> blocks;
+        if (data) {
+            const auto bm{roaring::Roaring::readSafe(data.value.char_ptr(), data.value.length())};
+            for (uint32_t block : bm) {
+                blocks.push_back(block);
+            }
+        }
+        return blocks;
+    }};
+
+    REQUIRE(stagedsync::stage_call_traces(txn, data_dir.etl().path()) == stagedsync::StageResult::kSuccess);
+    CHECK(db::stages::read_stage_progress(*txn, db::stages::kCallTracesKey) == 3);
+
+    CHECK(read_blocks(db::table::kCallFromIndex, address_a) == std::vector<uint32_t>{1, 2});
+    CHECK(read_blocks(db::table::kCallFromIndex, address_b) == std::vector<uint32_t>{3});
+    CHECK(read_blocks(db::table::kCallFromIndex, address_c).empty());
+    CHECK(read_blocks(db::table::kCallToIndex, address_a) == std::vector<uint32_t>{2});
+    CHECK(read_blocks(db::table::kCallToIndex, address_b) == std::vector<uint32_t>{1});
+    CHECK(read_blocks(db::table::kCallToIndex, address_c) == std::vector<uint32_t>{3});
+
+    REQUIRE(stagedsync::unwind_call_traces(txn, data_dir.etl().path(), 1) == stagedsync::StageResult::kSuccess);
+    CHECK(db::stages::read_stage_progress(*txn, db::stages::kCallTracesKey) == 1);
+
+    CHECK(read_blocks(db::table::kCallFromIndex, address_a) == std::vector<uint32_t>{1});
+    CHECK(read_blocks(db::table::kCallFromIndex, address_b).empty());
+    CHECK(read_blocks(db::table::kCallToIndex, address_a).empty());
+    CHECK(read_blocks(db::table::kCallToIndex, address_b) == std::vector<uint32_t>{1});
+    CHECK(read_blocks(db::table::kCallToIndex, address_c).empty());
+}
+
+}  // namespace silkworm
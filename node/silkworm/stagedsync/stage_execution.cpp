@@ -20,6 +20,7 @@
 #include <silkworm/chain/config.hpp>
 #include <silkworm/common/endian.hpp>
 #include <silkworm/common/log.hpp>
+#include <silkworm/common/metrics.hpp>
 #include <silkworm/common/stopwatch.hpp>
 #include <silkworm/consensus/engine.hpp>
 #include <silkworm/db/access_layer.hpp>
@@ -31,6 +32,34 @@
 
 namespace silkworm::stagedsync {
 
+namespace {
+
+    // Throughput (Mgas/s, blocks/s) is the rate of the counters
+    struct ExecutionMetrics {
+        metrics::Counter& blocks{metrics::Registry::instance().counter("silkworm_execution_blocks_total",
+                                                                       "Blocks executed")};
+        metrics::Counter& transactions{metrics::Registry::instance().counter("silkworm_execution_transactions_total",
+                                                                             "Transactions executed")};
+        metrics::Counter& gas{metrics::Registry::instance().counter("silkworm_execution_gas_total", "Gas used")};
+        metrics::Gauge& progress{metrics::Registry::instance().gauge("silkworm_execution_progress",
+                                                                     "Last block executed and committed")};
+        metrics::Gauge& dirty_bytes{metrics::Registry::instance().gauge(
+            "silkworm_execution_dirty_bytes", "Dirty MDBX space of the last execution batch before commit")};
+        metrics::Histogram& commit{metrics::Registry::instance().histogram(
+            "silkworm_execution_commit_seconds", "Commit latency of an execution batch")};
+    };
+
+    ExecutionMetrics& execution_metrics() {
+        static ExecutionMetrics instance;
+        return instance;
+    }
+
+    EvmProfiler* execution_profiler{nullptr};
+
+}  // namespace
+
+void set_execution_profiler(EvmProfiler* profiler) noexcept { execution_profiler = profiler; }
+
 // block_num is input-output
 static StageResult execute_batch_of_blocks(mdbx::txn& txn, const ChainConfig& config, const BlockNum max_block,
                                            const db::StorageMode& storage_mode, const size_t batch_size,
@@ -39,7 +68,9 @@ static StageResult execute_batch_of_blocks(mdbx::txn& txn, const ChainConfig& co
         db::Buffer buffer{txn, prune_from};
         AnalysisCache analysis_cache;
         ExecutionStatePool state_pool;
+        PrecompileCache precompile_cache;
         std::vector<Receipt> receipts;
+        CallTraces call_traces;
         auto consensus_engine{consensus::engine_factory(config)};
         if (!consensus_engine) {
             return StageResult::kUnknownConsensusEngine;
@@ -53,6 +84,10 @@ static StageResult execute_batch_of_blocks(mdbx::txn& txn, const ChainConfig& co
             ExecutionProcessor processor{bh->block, *consensus_engine, buffer, config};
             processor.evm().advanced_analysis_cache = &analysis_cache;
             processor.evm().state_pool = &state_pool;
+            processor.evm().precompile_cache = &precompile_cache;
+            processor.evm().profiler = execution_profiler;
+            const bool write_call_traces{storage_mode.CallTraces && block_num >= prune_from};
+            processor.evm().call_traces = write_call_traces ? &call_traces : nullptr;
 
             if (const auto res{processor.execute_and_write_block(receipts)}; res != ValidationResult::kOk) {
                 SILKWORM_LOG(LogLevel::Error) << "Validation error " << magic_enum::enum_name<ValidationResult>(res)
@@ -60,14 +95,26 @@ static StageResult execute_batch_of_blocks(mdbx::txn& txn, const ChainConfig& co
                 return StageResult::kInvalidBlock;
             }
 
+            execution_metrics().blocks.inc();
+            execution_metrics().transactions.inc(bh->block.transactions.size());
+            execution_metrics().gas.inc(bh->block.header.gas_used);
+
             if (storage_mode.Receipts && block_num >= prune_from) {
                 buffer.insert_receipts(block_num, receipts);
             }
 
-            if (block_num % 1000 == 0) {
-                SILKWORM_LOG(LogLevel::Debug) << "Blocks <= " << block_num << " executed" << std::endl;
+            if (write_call_traces) {
+                // Mining rewards as in Erigon stage_execute
+                call_traces.recipients.insert(bh->block.header.beneficiary);
+                for (const BlockHeader& ommer : bh->block.ommers) {
+                    call_traces.recipients.insert(ommer.beneficiary);
+                }
+                buffer.insert_call_traces(block_num, call_traces);
+                call_traces.clear();
             }
 
+            SILKWORM_LOG_EVERY(LogLevel::Debug, 5'000) << "Blocks <= " << block_num << " executed" << std::endl;
+
             if (buffer.current_batch_size() >= batch_size || block_num >= max_block) {
                 buffer.write_to_db();
                 return StageResult::kSuccess;
@@ -133,7 +180,12 @@ StageResult stage_execution(TransactionManager& txn, const std::filesystem::path
 
             db::stages::write_stage_progress(*txn, db::stages::kExecutionKey, block_num);
 
-            txn.commit();
+            execution_metrics().dirty_bytes.set(static_cast<int64_t>(txn->get_info().txn_space_dirty));
+            {
+                metrics::ScopedTimer timer{execution_metrics().commit};
+                txn.commit();
+            }
+            execution_metrics().progress.set(static_cast<int64_t>(block_num));
 
             (void)sw.lap();
             SILKWORM_LOG(LogLevel::Info) << (block_num == max_block ? "All blocks" : "Blocks") << " <= " << block_num
@@ -14,6 +14,7 @@
    limitations under the License.
 */
 
+#include <memory>
 #include <unordered_map>
 
 #include <silkworm/common/cast.hpp>
@@ -31,17 +32,80 @@ constexpr size_t kBitmapBufferSizeLimit = 256_Mebi;
 
 namespace fs = std::filesystem;
 
-static StageResult history_index_stage(TransactionManager& txn, const std::filesystem::path& etl_path, bool storage) {
+static StageResult history_index_load(TransactionManager& txn, etl::Collector& collector, bool storage,
+                                      BlockNum last_processed_block_number, BlockNum block_number) {
+    db::MapConfig index_config = storage ? db::table::kStorageHistory : db::table::kAccountHistory;
+    const char* stage_key = storage ? db::stages::kStorageHistoryIndexKey : db::stages::kAccountHistoryIndexKey;
+
+    // Proceed only if we've done something
+    if (!collector.empty()) {
+        SILKWORM_LOG(LogLevel::Info) << "Started Loading" << std::endl;
+
+        MDBX_put_flags_t db_flags{last_processed_block_number ? MDBX_put_flags_t::MDBX_UPSERT
+                                                              : MDBX_put_flags_t::MDBX_APPEND};
+
+        // Eventually load collected items WITH transform (may throw)
+        auto target{db::open_cursor(*txn, index_config)};
+        collector.load(
+            target,
+            [](const etl::Entry& entry, mdbx::cursor& history_index_table, MDBX_put_flags_t put_flags) {
+                auto bm{roaring::Roaring64Map::readSafe(byte_ptr_cast(entry.value.data()), entry.value.size())};
+                // Check whether we still need to rework the previous entry
+                Bytes last_chunk_index(entry.key.size() + 8, '\0');
+                std::memcpy(&last_chunk_index[0], &entry.key[0], entry.key.size());
+                endian::store_big_u64(&last_chunk_index[entry.key.size()], UINT64_MAX);
+                auto previous_bitmap_bytes{history_index_table.find(db::to_slice(last_chunk_index), false)};
+                // If we have an unfinished bitmap for the current location then continue working on it
+                if (previous_bitmap_bytes) {
+                    // Merge previous and current bitmap
+                    bm |= roaring::Roaring64Map::readSafe(previous_bitmap_bytes.value.char_ptr(),
+                                                          previous_bitmap_bytes.value.length());
+                    put_flags = MDBX_put_flags_t::MDBX_UPSERT;
+                }
+                while (bm.cardinality() > 0) {
+                    // Divide in different bitmaps of different (chunks) and push all of them individually
+                    auto current_chunk{db::bitmap::cut_left(bm, db::bitmap::kBitmapChunkLimit)};
+                    // Make chunk index (Location + Suffix )
+                    Bytes chunk_index(entry.key.size() + 8, '\0');
+                    std::memcpy(&chunk_index[0], &entry.key[0], entry.key.size());
+                    // Suffix is either the maximum Block Number of the bitmap or if it's the last chunk: UINT64_MAX
+                    BlockNum suffix{bm.cardinality() == 0 ? UINT64_MAX : current_chunk.maximum()};
+                    endian::store_big_u64(&chunk_index[entry.key.size()], suffix);
+                    // Push chunk to database
+                    Bytes current_chunk_bytes(current_chunk.getSizeInBytes(), '\0');
+                    current_chunk.write(byte_ptr_cast(&current_chunk_bytes[0]));
+                    mdbx::slice k{db::to_slice(chunk_index)};
+                    mdbx::slice v{db::to_slice(current_chunk_bytes)};
+                    mdbx::error::success_or_throw(history_index_table.put(k, &v, put_flags));
+                }
+            },
+            db_flags, /* log_every_percent = */ 20);
+
+        // Update progress height with last processed block
+        db::stages::write_stage_progress(*txn, stage_key, block_number);
+        txn.commit();
+
+    } else {
+        SILKWORM_LOG(LogLevel::Info) << "Nothing to process" << std::endl;
+    }
+
+    SILKWORM_LOG(LogLevel::Info) << "All Done" << std::endl;
+
+    return StageResult::kSuccess;
+}
+
+static StageResult history_index_extract(mdbx::txn& ro_txn, const std::filesystem::path& etl_path, bool storage,
+                                         StageLoad& load) {
     fs::create_directories(etl_path);
 
-    etl::Collector collector(etl_path, /* flush size */ 512_Mebi);
+    auto collector{std::make_shared<etl::Collector>(etl_path, /* flush size */ 512_Mebi)};
     std::unordered_map<std::string, roaring::Roaring64Map> bitmaps;
 
     auto flush_bitmaps_to_etl = [&collector, &bitmaps] {
         for (const auto& [bitmap_key, bitmap] : bitmaps) {
             Bytes bitmap_bytes(bitmap.getSizeInBytes(), '\0');
             bitmap.write(byte_ptr_cast(bitmap_bytes.data()));
-            collector.collect(etl::Entry{Bytes(byte_ptr_cast(bitmap_key.c_str()), bitmap_key.size()), bitmap_bytes});
+            collector->collect(etl::Entry{Bytes(byte_ptr_cast(bitmap_key.c_str()), bitmap_key.size()), bitmap_bytes});
         }
         bitmaps.clear();
     };
@@ -49,11 +113,10 @@ static StageResult history_index_stage(TransactionManager& txn, const std::files
     // We take data from changesets and turn it to indexes, so from [Block Number => Location] to [Location => Block
     // Number]
     db::MapConfig changeset_config = storage ? db::table::kStorageChangeSet : db::table::kAccountChangeSet;
-    db::MapConfig index_config = storage ? db::table::kStorageHistory : db::table::kAccountHistory;
     const char* stage_key = storage ? db::stages::kStorageHistoryIndexKey : db::stages::kAccountHistoryIndexKey;
 
-    auto changeset_table{db::open_cursor(*txn, changeset_config)};
-    auto last_processed_block_number{db::stages::read_stage_progress(*txn, stage_key)};
+    auto changeset_table{db::open_cursor(ro_txn, changeset_config)};
+    auto last_processed_block_number{db::stages::read_stage_progress(ro_txn, stage_key)};
     Bytes start{db::block_key(last_processed_block_number + 1)};
 
     // Extract
@@ -101,60 +164,9 @@ static StageResult history_index_stage(TransactionManager& txn, const std::files
 
     SILKWORM_LOG(LogLevel::Info) << "Latest Block: " << block_number << std::endl;
 
-    // Proceed only if we've done something
-    if (!collector.empty()) {
-        SILKWORM_LOG(LogLevel::Info) << "Started Loading" << std::endl;
-
-        MDBX_put_flags_t db_flags{last_processed_block_number ? MDBX_put_flags_t::MDBX_UPSERT
-                                                              : MDBX_put_flags_t::MDBX_APPEND};
-
-        // Eventually load collected items WITH transform (may throw)
-        auto target{db::open_cursor(*txn, index_config)};
-        collector.load(
-            target,
-            [](const etl::Entry& entry, mdbx::cursor& history_index_table, MDBX_put_flags_t put_flags) {
-                auto bm{roaring::Roaring64Map::readSafe(byte_ptr_cast(entry.value.data()), entry.value.size())};
-                // Check whether we still need to rework the previous entry
-                Bytes last_chunk_index(entry.key.size() + 8, '\0');
-                std::memcpy(&last_chunk_index[0], &entry.key[0], entry.key.size());
-                endian::store_big_u64(&last_chunk_index[entry.key.size()], UINT64_MAX);
-                auto previous_bitmap_bytes{history_index_table.find(db::to_slice(last_chunk_index), false)};
-                // If we have an unfinished bitmap for the current location then continue working on it
-                if (previous_bitmap_bytes) {
-                    // Merge previous and current bitmap
-                    bm |= roaring::Roaring64Map::readSafe(previous_bitmap_bytes.value.char_ptr(),
-                                                          previous_bitmap_bytes.value.length());
-                    put_flags = MDBX_put_flags_t::MDBX_UPSERT;
-                }
-                while (bm.cardinality() > 0) {
-                    // Divide in different bitmaps of different (chunks) and push all of them individually
-                    auto current_chunk{db::bitmap::cut_left(bm, db::bitmap::kBitmapChunkLimit)};
-                    // Make chunk index (Location + Suffix )
-                    Bytes chunk_index(entry.key.size() + 8, '\0');
-                    std::memcpy(&chunk_index[0], &entry.key[0], entry.key.size());
-                    // Suffix is either the maximum Block Number of the bitmap or if it's the last chunk: UINT64_MAX
-                    BlockNum suffix{bm.cardinality() == 0 ? UINT64_MAX : current_chunk.maximum()};
-                    endian::store_big_u64(&chunk_index[entry.key.size()], suffix);
-                    // Push chunk to database
-                    Bytes current_chunk_bytes(current_chunk.getSizeInBytes(), '\0');
-                    current_chunk.write(byte_ptr_cast(&current_chunk_bytes[0]));
-                    mdbx::slice k{db::to_slice(chunk_index)};
-                    mdbx::slice v{db::to_slice(current_chunk_bytes)};
-                    mdbx::error::success_or_throw(history_index_table.put(k, &v, put_flags));
-                }
-            },
-            db_flags, /* log_every_percent = */ 20);
-
-        // Update progress height with last processed block
-        db::stages::write_stage_progress(*txn, stage_key, block_number);
-        txn.commit();
-
-    } else {
-        SILKWORM_LOG(LogLevel::Info) << "Nothing to process" << std::endl;
-    }
-
-    SILKWORM_LOG(LogLevel::Info) << "All Done" << std::endl;
-
+    load = [collector, storage, last_processed_block_number, block_number](TransactionManager& txn) {
+        return history_index_load(txn, *collector, storage, last_processed_block_number, block_number);
+    };
     return StageResult::kSuccess;
 }
 
@@ -256,6 +268,14 @@ StageResult history_index_prune(TransactionManager& txn, const std::filesystem::
     return StageResult::kSuccess;
 }
 
+static StageResult history_index_stage(TransactionManager& txn, const std::filesystem::path& etl_path, bool storage) {
+    StageLoad load;
+    if (const auto res{history_index_extract(*txn, etl_path, storage, load)}; res != StageResult::kSuccess) {
+        return res;
+    }
+    return load(txn);
+}
+
 StageResult stage_account_history(TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t) {
     return history_index_stage(txn, etl_path, false);
 }
@@ -263,6 +283,15 @@ StageResult stage_storage_history(TransactionManager& txn, const std::filesystem
     return history_index_stage(txn, etl_path, true);
 }
 
+StageResult extract_account_history(mdbx::txn& ro_txn, const std::filesystem::path& etl_path, uint64_t,
+                                    StageLoad& load) {
+    return history_index_extract(ro_txn, etl_path, false, load);
+}
+StageResult extract_storage_history(mdbx::txn& ro_txn, const std::filesystem::path& etl_path, uint64_t,
+                                    StageLoad& load) {
+    return history_index_extract(ro_txn, etl_path, true, load);
+}
+
 StageResult unwind_account_history(TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t unwind_to) {
     return history_index_unwind(txn, etl_path, unwind_to, false);
 }
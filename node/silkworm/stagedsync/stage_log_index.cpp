@@ -15,6 +15,7 @@
 */
 
 #include <filesystem>
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -25,6 +26,7 @@
 #include <silkworm/db/bitmap.hpp>
 #include <silkworm/db/stages.hpp>
 #include <silkworm/etl/collector.hpp>
+#include <silkworm/stagedsync/bitmap_index.hpp>
 #include <silkworm/stagedsync/listener_log_index.hpp>
 
 #include "stagedsync.hpp"
@@ -35,48 +37,43 @@ namespace fs = std::filesystem;
 
 constexpr size_t kBitmapBufferSizeLimit = 512_Mebi;
 
-static void loader_function(const etl::Entry& entry, mdbx::cursor& target_table, MDBX_put_flags_t db_flags) {
-    auto bm{roaring::Roaring::readSafe(byte_ptr_cast(entry.value.data()), entry.value.size())};
-    Bytes last_chunk_index(entry.key.size() + 4, '\0');
-    std::memcpy(&last_chunk_index[0], &entry.key[0], entry.key.size());
-    endian::store_big_u32(&last_chunk_index[entry.key.size()], UINT32_MAX);
-    auto previous_bitmap_bytes{target_table.find(db::to_slice(last_chunk_index), false)};
-    if (previous_bitmap_bytes) {
-        bm |= roaring::Roaring::readSafe(previous_bitmap_bytes.value.char_ptr(), previous_bitmap_bytes.value.length());
-        db_flags = MDBX_put_flags_t::MDBX_UPSERT;
-    }
-    while (bm.cardinality() > 0) {
-        auto current_chunk{db::bitmap::cut_left(bm, db::bitmap::kBitmapChunkLimit)};
-        // make chunk index
-        Bytes chunk_index(entry.key.size() + 4, '\0');
-        std::memcpy(&chunk_index[0], &entry.key[0], entry.key.size());
-        uint64_t suffix{bm.cardinality() == 0 ? UINT32_MAX : current_chunk.maximum()};
-        endian::store_big_u32(&chunk_index[entry.key.size()], suffix);
-        Bytes current_chunk_bytes(current_chunk.getSizeInBytes(), '\0');
-        current_chunk.write(byte_ptr_cast(&current_chunk_bytes[0]));
-
-        mdbx::slice k{db::to_slice(chunk_index)};
-        mdbx::slice v{db::to_slice(current_chunk_bytes)};
-        mdbx::error::success_or_throw(target_table.put(k, &v, db_flags));
-    }
-}
+static StageResult load_log_index(TransactionManager& txn, etl::Collector& topic_collector,
+                                  etl::Collector& addresses_collector, BlockNum last_processed_block_number,
+                                  BlockNum block_number) {
+    // Proceed only if we've done something
+    SILKWORM_LOG(LogLevel::Info) << "Started Topics Loading" << std::endl;
+    // if stage has never been touched then appending is safe
+    MDBX_put_flags_t db_flags{last_processed_block_number ? MDBX_put_flags_t::MDBX_UPSERT
+                                                          : MDBX_put_flags_t::MDBX_APPEND};
 
-static void flush_bitmaps(etl::Collector& collector, std::unordered_map<std::string, roaring::Roaring>& map) {
-    for (const auto& [key, bm] : map) {
-        Bytes bitmap_bytes(bm.getSizeInBytes(), '\0');
-        bm.write(byte_ptr_cast(bitmap_bytes.data()));
-        collector.collect(etl::Entry{Bytes(byte_ptr_cast(key.c_str()), key.size()), bitmap_bytes});
-    }
-    map.clear();
+    // Eventually load collected items WITH transform (may throw)
+    auto target{db::open_cursor(*txn, db::table::kLogTopicIndex)};
+
+    topic_collector.load(target, bitmap_index::load, db_flags,
+                         /* log_every_percent = */ 10);
+    target.close();
+    target = db::open_cursor(*txn, db::table::kLogAddressIndex);
+    SILKWORM_LOG(LogLevel::Info) << "Started Address Loading" << std::endl;
+    addresses_collector.load(target, bitmap_index::load, db_flags,
+                             /* log_every_percent = */ 10);
+
+    // Update progress height with last processed block
+    db::stages::write_stage_progress(*txn, db::stages::kLogIndexKey, block_number);
+
+    txn.commit();
+
+    SILKWORM_LOG(LogLevel::Info) << "All Done" << std::endl;
+
+    return StageResult::kSuccess;
 }
 
-StageResult stage_log_index(TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t) {
+StageResult extract_log_index(mdbx::txn& ro_txn, const std::filesystem::path& etl_path, uint64_t, StageLoad& load) {
     fs::create_directories(etl_path);
-    etl::Collector topic_collector(etl_path, /* flush size */ 256_Mebi);
-    etl::Collector addresses_collector(etl_path, /* flush size */ 256_Mebi);
+    auto topic_collector{std::make_shared<etl::Collector>(etl_path, /* flush size */ 256_Mebi)};
+    auto addresses_collector{std::make_shared<etl::Collector>(etl_path, /* flush size */ 256_Mebi)};
 
-    auto log_table{db::open_cursor(*txn, db::table::kLogs)};
-    auto last_processed_block_number{db::stages::read_stage_progress(*txn, db::stages::kLogIndexKey)};
+    auto log_table{db::open_cursor(ro_txn, db::table::kLogs)};
+    auto last_processed_block_number{db::stages::read_stage_progress(ro_txn, db::stages::kLogIndexKey)};
 
     // Extract
     SILKWORM_LOG(LogLevel::Info) << "Started Log Index Extraction" << std::endl;
@@ -103,13 +100,13 @@ StageResult stage_log_index(TransactionManager& txn, const std::filesystem::path
         decoder.run();
         // Flushes
         if (topics_allocated_space > kBitmapBufferSizeLimit) {
-            flush_bitmaps(topic_collector, topic_bitmaps);
+            bitmap_index::flush(*topic_collector, topic_bitmaps);
             SILKWORM_LOG(LogLevel::Info) << "Current Block: " << block_number << std::endl;
             topics_allocated_space = 0;
         }
 
         if (addresses_allocated_space > kBitmapBufferSizeLimit) {
-            flush_bitmaps(addresses_collector, addresses_bitmaps);
+            bitmap_index::flush(*addresses_collector, addresses_bitmaps);
             SILKWORM_LOG(LogLevel::Info) << "Current Block: " << block_number << std::endl;
             addresses_allocated_space = 0;
         }
@@ -119,37 +116,25 @@ StageResult stage_log_index(TransactionManager& txn, const std::filesystem::path
 
     log_table.close();
     // Flush once it is done
-    flush_bitmaps(topic_collector, topic_bitmaps);
-    flush_bitmaps(addresses_collector, addresses_bitmaps);
+    bitmap_index::flush(*topic_collector, topic_bitmaps);
+    bitmap_index::flush(*addresses_collector, addresses_bitmaps);
 
     SILKWORM_LOG(LogLevel::Info) << "Latest Block: " << block_number << std::endl;
-    // Proceed only if we've done something
-    SILKWORM_LOG(LogLevel::Info) << "Started Topics Loading" << std::endl;
-    // if stage has never been touched then appending is safe
-    MDBX_put_flags_t db_flags{last_processed_block_number ? MDBX_put_flags_t::MDBX_UPSERT
-                                                          : MDBX_put_flags_t::MDBX_APPEND};
-
-    // Eventually load collected items WITH transform (may throw)
-    auto target{db::open_cursor(*txn, db::table::kLogTopicIndex)};
-
-    topic_collector.load(target, loader_function, db_flags,
-                         /* log_every_percent = */ 10);
-    target.close();
-    target = db::open_cursor(*txn, db::table::kLogAddressIndex);
-    SILKWORM_LOG(LogLevel::Info) << "Started Address Loading" << std::endl;
-    addresses_collector.load(target, loader_function, db_flags,
-                             /* log_every_percent = */ 10);
-
-    // Update progress height with last processed block
-    db::stages::write_stage_progress(*txn, db::stages::kLogIndexKey, block_number);
-
-    txn.commit();
-
-    SILKWORM_LOG(LogLevel::Info) << "All Done" << std::endl;
 
+    load = [topic_collector, addresses_collector, last_processed_block_number, block_number](TransactionManager& txn) {
+        return load_log_index(txn, *topic_collector, *addresses_collector, last_processed_block_number, block_number);
+    };
     return StageResult::kSuccess;
 }
 
+StageResult stage_log_index(TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t prune_from) {
+    StageLoad load;
+    if (const auto res{extract_log_index(*txn, etl_path, prune_from, load)}; res != StageResult::kSuccess) {
+        return res;
+    }
+    return load(txn);
+}
+
 static StageResult unwind_log_index(TransactionManager& txn, etl::Collector& collector, uint64_t unwind_to,
                                     bool topics) {
     auto index_table{topics ? db::open_cursor(*txn, db::table::kLogTopicIndex)
@@ -158,38 +143,7 @@ static StageResult unwind_log_index(TransactionManager& txn, etl::Collector& col
         return StageResult::kSuccess;
     }
 
-    // Latest bitmap
-    auto data{index_table.to_first(/*throw_notfound=*/false)};
-    while (data) {
-        // Get bitmap data of current element
-        auto key{db::from_slice(data.key)};
-        auto bitmap_data{db::from_slice(data.value)};
-
-        auto bm{roaring::Roaring::readSafe(byte_ptr_cast(bitmap_data.data()), bitmap_data.size())};
-        // Check for keys that can be skipped
-        if (bm.maximum() <= unwind_to) {
-            data = index_table.to_next(/*throw_notfound*/ false);
-            continue;
-        }
-        // adjust bitmaps
-        if (bm.minimum() <= unwind_to) {
-            // Erase elements that are > unwind_to
-            bm &= roaring::Roaring(roaring::api::roaring_bitmap_from_range(0, unwind_to + 1, 1));
-            auto new_bitmap{Bytes(bm.getSizeInBytes(), '\0')};
-            bm.write(byte_ptr_cast(&new_bitmap[0]));
-            // make new key
-            Bytes new_key(key.size(), '\0');
-            std::memcpy(&new_key[0], key.data(), key.size());
-            endian::store_big_u32(&new_key[new_key.size() - 4], UINT32_MAX);
-            // collect higher bitmap
-            collector.collect(etl::Entry{new_key, new_bitmap});
-        }
-        // erase index
-        index_table.erase(true);
-        data = index_table.to_next(/*throw_notfound*/ false);
-    }
-
-    collector.load(index_table, nullptr, MDBX_put_flags_t::MDBX_UPSERT, /* log_every_percent = */ 100);
+    bitmap_index::unwind(index_table, collector, unwind_to);
     txn.commit();
 
     return StageResult::kSuccess;
@@ -221,35 +175,7 @@ void prune_log_index(TransactionManager& txn, etl::Collector& collector, uint64_
     auto index_table{topics ? db::open_cursor(*txn, db::table::kLogTopicIndex)
                             : db::open_cursor(*txn, db::table::kLogAddressIndex)};
 
-    if (index_table.to_first(/* throw_notfound = */ false)) {
-        auto data{index_table.current()};
-        while (data) {
-            // Get bitmap data of current element
-            auto key{db::from_slice(data.key)};
-            auto bitmap_data{db::from_slice(data.value)};
-            auto bm{roaring::Roaring::readSafe(byte_ptr_cast(bitmap_data.data()), bitmap_data.size())};
-            // Check whether we should skip the current bitmap
-            if (bm.minimum() >= prune_from) {
-                data = index_table.to_next(/*throw_notfound*/ false);
-                continue;
-            }
-            // check if prune can be applied
-            if (bm.maximum() >= prune_from) {
-                // Erase elements that are below prune_from
-                bm &=
-                    roaring::Roaring(roaring::api::roaring_bitmap_from_range(prune_from, last_processed_block + 1, 1));
-                Bytes new_bitmap(bm.getSizeInBytes(), '\0');
-                bm.write(byte_ptr_cast(&new_bitmap[0]));
-                // replace with new index
-                etl::Entry entry{Bytes{key}, new_bitmap};
-                collector.collect(entry);
-            }
-            index_table.erase(/* whole_multivalue = */ true);
-            data = index_table.to_next(/*throw_notfound*/ false);
-        }
-    }
-
-    collector.load(index_table, nullptr, MDBX_put_flags_t::MDBX_UPSERT, /* log_every_percent = */ 100);
+    bitmap_index::prune(index_table, collector, prune_from, last_processed_block);
     txn.commit();
 }
 
@@ -0,0 +1,149 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "stage_pipeline.hpp"
+
+#include <exception>
+#include <future>
+#include <utility>
+
+#include <silkworm/common/log.hpp>
+#include <silkworm/common/stopwatch.hpp>
+
+namespace silkworm::stagedsync {
+
+static bool intersect(const std::vector<std::string_view>& a, const std::vector<std::string_view>& b) {
+    return std::any_of(a.begin(), a.end(),
+                       [&b](std::string_view x) { return std::find(b.begin(), b.end(), x) != b.end(); });
+}
+
+StagePipeline::StagePipeline(mdbx::env& env, std::vector<Stage> stages, std::filesystem::path etl_path,
+                             size_t max_threads)
+    : env_{env}, stages_{std::move(stages)}, etl_path_{std::move(etl_path)}, pool_{max_threads} {
+    build_graph();
+}
+
+void StagePipeline::build_graph() {
+    std::vector<StageTables> tables;
+    for (const auto& stage : stages_) {
+        tables.push_back(get_stage_tables(stage.id));
+    }
+
+    dependencies_.assign(stages_.size(), {});
+    for (size_t j{0}; j < stages_.size(); ++j) {
+        for (size_t i{0}; i < j; ++i) {
+            if (intersect(tables[i].writes, tables[j].reads) || intersect(tables[i].writes, tables[j].writes) ||
+                intersect(tables[i].reads, tables[j].writes)) {
+                dependencies_[j].push_back(i);
+            }
+        }
+    }
+
+    // Each step takes the first ready stage, along with all of the other ready ones if it can be split
+    std::vector<bool> done(stages_.size(), false);
+    for (size_t scheduled{0}; scheduled < stages_.size();) {
+        std::vector<size_t> ready;
+        for (size_t i{0}; i < stages_.size(); ++i) {
+            if (!done[i] && std::all_of(dependencies_[i].begin(), dependencies_[i].end(),
+                                        [&done](size_t dep) { return done[dep]; })) {
+                ready.push_back(i);
+            }
+        }
+        std::vector<size_t> step{ready.front()};
+        if (stages_[ready.front()].extract_func) {
+            for (auto it{ready.begin() + 1}; it != ready.end(); ++it) {
+                if (stages_[*it].extract_func) {
+                    step.push_back(*it);
+                }
+            }
+        }
+        for (size_t i : step) {
+            done[i] = true;
+        }
+        scheduled += step.size();
+        schedule_.push_back(std::move(step));
+    }
+}
+
+StageResult StagePipeline::run(uint64_t prune_from) {
+    TransactionManager txn{env_};
+
+    for (const auto& step : schedule_) {
+        StopWatch sw;
+        sw.start();
+
+        if (!stages_[step.front()].extract_func) {
+            const Stage& stage{stages_[step.front()]};
+            SILKWORM_LOG(LogLevel::Info) << "Running stage " << stage.id << std::endl;
+            if (const auto res{stage.stage_func(txn, etl_path_, prune_from)}; res != StageResult::kSuccess) {
+                return res;
+            }
+            txn.commit();
+            db::checkpoint(env_);
+            SILKWORM_LOG(LogLevel::Info) << "Stage " << stage.id << " done in " << StopWatch::format(sw.lap().second)
+                                         << std::endl;
+            continue;
+        }
+
+        // Extractions must see what previous stages have written
+        txn.commit();
+
+        std::vector<std::future<std::pair<StageResult, StageLoad>>> extractions;
+        for (size_t i : step) {
+            SILKWORM_LOG(LogLevel::Info) << "Extracting stage " << stages_[i].id << std::endl;
+            extractions.push_back(pool_.submit([this, i, prune_from]() {
+                auto ro_txn{env_.start_read()};
+                StageLoad load;
+                StageResult res{stages_[i].extract_func(ro_txn, etl_path_, prune_from, load)};
+                return std::make_pair(res, std::move(load));
+            }));
+        }
+
+        // Loads are serialized in stage order, each one committing. All extractions are waited for, even after a
+        // failure, so that none is left running on a read transaction
+        StageResult result{StageResult::kSuccess};
+        std::exception_ptr error;
+        for (size_t k{0}; k < step.size(); ++k) {
+            try {
+                auto [res, load]{extractions[k].get()};
+                if (result != StageResult::kSuccess || error) {
+                    continue;
+                }
+                result = res == StageResult::kSuccess ? load(txn) : res;
+                if (result != StageResult::kSuccess) {
+                    continue;
+                }
+                db::checkpoint(env_);
+                SILKWORM_LOG(LogLevel::Info) << "Stage " << stages_[step[k]].id << " done in "
+                                             << StopWatch::format(sw.lap().second) << std::endl;
+            } catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        if (result != StageResult::kSuccess) {
+            return result;
+        }
+    }
+
+    return StageResult::kSuccess;
+}
+
+}  // namespace silkworm::stagedsync
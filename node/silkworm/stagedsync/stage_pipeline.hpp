@@ -0,0 +1,67 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_STAGEDSYNC_STAGE_PIPELINE_HPP_
+#define SILKWORM_STAGEDSYNC_STAGE_PIPELINE_HPP_
+
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#include <silkworm/concurrency/thread_pool.hpp>
+#include <silkworm/stagedsync/stagedsync.hpp>
+
+namespace silkworm::stagedsync {
+
+// Runs a list of stages (e.g. get_archive_node_stages()) as a dependency graph instead of strictly in order.
+// A stage depends on every previous one it conflicts with, i.e. when one writes a table the other reads or writes
+// (see get_stage_tables). Stages having all of their dependencies done are ready: those that can be split in two
+// (see ExtractFunc) are extracted concurrently, each on a read-only transaction of its own, and then loaded one after
+// the other on the write transaction in list order. Stages that can't be split run on their own. Every stage done is
+// committed and checkpointed (see db::checkpoint), so it survives a crash even with a no-sync mode.
+class StagePipeline {
+  public:
+    StagePipeline(mdbx::env& env, std::vector<Stage> stages, std::filesystem::path etl_path,
+                  size_t max_threads = std::max(std::thread::hardware_concurrency(), 1u));
+
+    // Not copyable nor movable
+    StagePipeline(const StagePipeline&) = delete;
+    StagePipeline& operator=(const StagePipeline&) = delete;
+
+    // Runs every stage once; stops at the first one not succeeding and returns its result
+    StageResult run(uint64_t prune_from = 0);
+
+    // Indices of the previous stages the i-th one depends on
+    [[nodiscard]] const std::vector<std::vector<size_t>>& dependencies() const { return dependencies_; }
+
+    // Steps run() goes through: each one holds the indices of the stages it runs (more than one if concurrent)
+    [[nodiscard]] const std::vector<std::vector<size_t>>& schedule() const { return schedule_; }
+
+  private:
+    void build_graph();
+
+    mdbx::env& env_;
+    std::vector<Stage> stages_;
+    std::filesystem::path etl_path_;
+    std::vector<std::vector<size_t>> dependencies_;
+    std::vector<std::vector<size_t>> schedule_;
+    ThreadPool pool_;  // last, so that it's joined before anything else is destroyed
+};
+
+}  // namespace silkworm::stagedsync
+
+#endif  // SILKWORM_STAGEDSYNC_STAGE_PIPELINE_HPP_
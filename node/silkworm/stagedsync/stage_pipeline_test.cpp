@@ -0,0 +1,125 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "stage_pipeline.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/directories.hpp>
+#include <silkworm/db/stages.hpp>
+
+namespace silkworm::stagedsync {
+
+static StageResult fake_execution(TransactionManager& txn, const std::filesystem::path&, uint64_t) {
+    Bytes key{db::block_key(1)};
+    Bytes value(20, '\x11');
+    db::open_cursor(*txn, db::table::kAccountChangeSet).upsert(db::to_slice(key), db::to_slice(value));
+    db::open_cursor(*txn, db::table::kLogs).upsert(db::to_slice(key), db::to_slice(value));
+    db::stages::write_stage_progress(*txn, db::stages::kExecutionKey, 1);
+    txn.commit();
+    return StageResult::kSuccess;
+}
+
+// Records in stage progress how many entries the extraction has seen
+static StageResult count_entries(mdbx::txn& ro_txn, const db::MapConfig& table, const char* stage_key,
+                                 StageLoad& load) {
+    const auto entries{ro_txn.get_map_stat(db::open_map(ro_txn, table)).ms_entries};
+    load = [stage_key, entries](TransactionManager& txn) {
+        db::stages::write_stage_progress(*txn, stage_key, entries);
+        txn.commit();
+        return StageResult::kSuccess;
+    };
+    return StageResult::kSuccess;
+}
+
+static StageResult fake_extract_account_history(mdbx::txn& ro_txn, const std::filesystem::path&, uint64_t,
+                                                StageLoad& load) {
+    return count_entries(ro_txn, db::table::kAccountChangeSet, db::stages::kAccountHistoryIndexKey, load);
+}
+
+static StageResult fake_extract_log_index(mdbx::txn& ro_txn, const std::filesystem::path&, uint64_t,
+                                          StageLoad& load) {
+    return count_entries(ro_txn, db::table::kLogs, db::stages::kLogIndexKey, load);
+}
+
+static StageResult failing_extract(mdbx::txn&, const std::filesystem::path&, uint64_t, StageLoad&) {
+    return StageResult::kDbError;
+}
+
+TEST_CASE("StagePipeline") {
+    TemporaryDirectory tmp_dir;
+    DataDirectory data_dir{tmp_dir.path()};
+    db::EnvConfig db_config{data_dir.chaindata().path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{db::open_env(db_config)};
+    {
+        auto txn{env.start_write()};
+        db::table::create_all(txn);
+        txn.commit();
+    }
+
+    SECTION("Archive node schedule") {
+        StagePipeline pipeline{env, get_archive_node_stages(), data_dir.etl().path()};
+
+        const auto& dependencies{pipeline.dependencies()};
+        REQUIRE(dependencies.size() == 13);
+        CHECK(dependencies[7] == std::vector<size_t>{4});   // AccountHistoryIndex after Execution
+        CHECK(dependencies[9] == std::vector<size_t>{4});   // LogIndex after Execution
+        CHECK(dependencies[10] == std::vector<size_t>{2});  // TxLookup after Bodies
+        CHECK(dependencies[11] == std::vector<size_t>{0});  // BloomBits after Headers
+        CHECK(dependencies[12] == std::vector<size_t>{4});  // CallTraces after Execution
+
+        const auto& schedule{pipeline.schedule()};
+        REQUIRE(schedule.size() == 8);
+        for (size_t i{0}; i < 7; ++i) {
+            CHECK(schedule[i] == std::vector<size_t>{i});
+        }
+        CHECK(schedule[7] == std::vector<size_t>{7, 8, 9, 10, 11, 12});
+    }
+
+    SECTION("Extractions see previous stages") {
+        std::vector<Stage> stages{
+            {fake_execution, no_unwind, no_prune, 5, nullptr},
+            {stage_account_history, no_unwind, no_prune, 8, fake_extract_account_history},
+            {stage_log_index, no_unwind, no_prune, 10, fake_extract_log_index},
+        };
+        StagePipeline pipeline{env, stages, data_dir.etl().path(), /*max_threads=*/2};
+        REQUIRE(pipeline.schedule().size() == 2);
+        CHECK(pipeline.schedule()[1] == std::vector<size_t>{1, 2});
+
+        CHECK(pipeline.run() == StageResult::kSuccess);
+
+        auto txn{env.start_read()};
+        CHECK(db::stages::read_stage_progress(txn, db::stages::kExecutionKey) == 1);
+        CHECK(db::stages::read_stage_progress(txn, db::stages::kAccountHistoryIndexKey) == 1);
+        CHECK(db::stages::read_stage_progress(txn, db::stages::kLogIndexKey) == 1);
+    }
+
+    SECTION("Failed extraction") {
+        std::vector<Stage> stages{
+            {stage_account_history, no_unwind, no_prune, 8, failing_extract},
+            {stage_log_index, no_unwind, no_prune, 10, fake_extract_log_index},
+        };
+        StagePipeline pipeline{env, stages, data_dir.etl().path(), /*max_threads=*/2};
+        CHECK(pipeline.run() == StageResult::kDbError);
+
+        // Loads after the failed stage are skipped
+        auto txn{env.start_read()};
+        CHECK(db::stages::read_stage_progress(txn, db::stages::kLogIndexKey) == 0);
+    }
+}
+
+}  // namespace silkworm::stagedsync
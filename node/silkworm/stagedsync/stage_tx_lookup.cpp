@@ -15,6 +15,7 @@
 */
 
 #include <filesystem>
+#include <memory>
 
 #include <silkworm/common/endian.hpp>
 #include <silkworm/common/log.hpp>
@@ -28,15 +29,51 @@ namespace silkworm::stagedsync {
 
 namespace fs = std::filesystem;
 
-StageResult stage_tx_lookup(TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t prune_from) {
+static StageResult load_tx_lookup(TransactionManager& txn, etl::Collector& collector, BlockNum block_number) {
+    // Proceed only if we've done something
+    if (collector.size()) {
+        SILKWORM_LOG(LogLevel::Info) << "Started tx Hashes Loading" << std::endl;
+
+        /*
+         * If we're on first sync then we shouldn't have any records in target
+         * table. For this reason we can apply MDB_APPEND to load as
+         * collector (with no transform) ensures collected entries
+         * are already sorted. If instead target table contains already
+         * some data the only option is to load in upsert mode as we
+         * cannot guarantee keys are sorted amongst different calls
+         * of this stage
+         */
+        auto target_table{db::open_cursor(*txn, db::table::kTxLookup)};
+        auto target_table_rcount{txn->get_map_stat(target_table.map()).ms_entries};
+        MDBX_put_flags_t db_flags{target_table_rcount ? MDBX_put_flags_t::MDBX_UPSERT : MDBX_put_flags_t::MDBX_APPEND};
+
+        // Eventually load collected items with no transform (may throw)
+        collector.load(target_table, nullptr, db_flags, /* log_every_percent = */ 10);
+
+        // Update progress height with last processed block
+        db::stages::write_stage_progress(*txn, db::stages::kTxLookupKey, block_number);
+
+        txn.commit();
+
+    } else {
+        SILKWORM_LOG(LogLevel::Info) << "Nothing to process" << std::endl;
+    }
+
+    SILKWORM_LOG(LogLevel::Info) << "All Done" << std::endl;
+
+    return StageResult::kSuccess;
+}
+
+StageResult extract_tx_lookup(mdbx::txn& ro_txn, const std::filesystem::path& etl_path, uint64_t prune_from,
+                              StageLoad& load) {
     fs::create_directories(etl_path);
-    etl::Collector collector(etl_path, /* flush size */ 512_Mebi);
+    auto collector{std::make_shared<etl::Collector>(etl_path, /* flush size */ 512_Mebi)};
 
-    auto expected_block_number{db::stages::read_stage_progress(*txn, db::stages::kTxLookupKey) + 1};
+    auto expected_block_number{db::stages::read_stage_progress(ro_txn, db::stages::kTxLookupKey) + 1};
 
     // We take number from bodies table, and hash from transaction table
-    auto bodies_table{db::open_cursor(*txn, db::table::kBlockBodies)};
-    auto transactions_table{db::open_cursor(*txn, db::table::kEthTx)};
+    auto bodies_table{db::open_cursor(ro_txn, db::table::kBlockBodies)};
+    auto transactions_table{db::open_cursor(ro_txn, db::table::kEthTx)};
 
     if (expected_block_number < prune_from) {
         expected_block_number = prune_from;
@@ -53,7 +90,7 @@ StageResult stage_tx_lookup(TransactionManager& txn, const std::filesystem::path
 
     while (bodies_data) {
         auto body_rlp{db::from_slice(bodies_data.value)};
-        auto body{db::detail::decode_stored_block_body(body_rlp)};
+        auto body{db::detail::decode_stored_block_body_view(body_rlp)};
         // Block number is computed here in order to record accurate stage progress
         block_number = endian::load_big_u64(static_cast<uint8_t*>(bodies_data.key.iov_base));
         // Iterate over transactions in current block
@@ -74,7 +111,7 @@ StageResult stage_tx_lookup(TransactionManager& txn, const std::filesystem::path
                 auto hash{keccak256(tx_view)};
                 // Collect hash => compacted block number mapping
                 etl::Entry entry{Bytes(hash.bytes, 32), block_compact_data};
-                collector.collect(entry);
+                collector->collect(entry);
                 ++tx_count;
                 tx_data = transactions_table.to_next(/*throw_notfound*/ false);
             }
@@ -88,40 +125,18 @@ StageResult stage_tx_lookup(TransactionManager& txn, const std::filesystem::path
         bodies_data = bodies_table.to_next(/*throw_notfound*/ false);
     }
 
-    SILKWORM_LOG(LogLevel::Info) << "Entries Collected << " << collector.size() << std::endl;
+    SILKWORM_LOG(LogLevel::Info) << "Entries Collected << " << collector->size() << std::endl;
 
-    // Proceed only if we've done something
-    if (collector.size()) {
-        SILKWORM_LOG(LogLevel::Info) << "Started tx Hashes Loading" << std::endl;
-
-        /*
-         * If we're on first sync then we shouldn't have any records in target
-         * table. For this reason we can apply MDB_APPEND to load as
-         * collector (with no transform) ensures collected entries
-         * are already sorted. If instead target table contains already
-         * some data the only option is to load in upsert mode as we
-         * cannot guarantee keys are sorted amongst different calls
-         * of this stage
-         */
-        auto target_table{db::open_cursor(*txn, db::table::kTxLookup)};
-        auto target_table_rcount{txn->get_map_stat(target_table.map()).ms_entries};
-        MDBX_put_flags_t db_flags{target_table_rcount ? MDBX_put_flags_t::MDBX_UPSERT : MDBX_put_flags_t::MDBX_APPEND};
-
-        // Eventually load collected items with no transform (may throw)
-        collector.load(target_table, nullptr, db_flags, /* log_every_percent = */ 10);
-
-        // Update progress height with last processed block
-        db::stages::write_stage_progress(*txn, db::stages::kTxLookupKey, block_number);
-
-        txn.commit();
+    load = [collector, block_number](TransactionManager& txn) { return load_tx_lookup(txn, *collector, block_number); };
+    return StageResult::kSuccess;
+}
 
-    } else {
-        SILKWORM_LOG(LogLevel::Info) << "Nothing to process" << std::endl;
+StageResult stage_tx_lookup(TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t prune_from) {
+    StageLoad load;
+    if (const auto res{extract_tx_lookup(*txn, etl_path, prune_from, load)}; res != StageResult::kSuccess) {
+        return res;
     }
-
-    SILKWORM_LOG(LogLevel::Info) << "All Done" << std::endl;
-
-    return StageResult::kSuccess;
+    return load(txn);
 }
 
 StageResult unwind_tx_lookup(TransactionManager& txn, const std::filesystem::path&, uint64_t unwind_to) {
@@ -144,7 +159,7 @@ StageResult unwind_tx_lookup(TransactionManager& txn, const std::filesystem::pat
     auto bodies_data{bodies_table.lower_bound(db::to_slice(start), /*throw_notfound*/ false)};
     while (bodies_data) {
         auto body_rlp{db::from_slice(bodies_data.value)};
-        auto body{db::detail::decode_stored_block_body(body_rlp)};
+        auto body{db::detail::decode_stored_block_body_view(body_rlp)};
 
         if (body.txn_count) {
             Bytes tx_base_id(8, '\0');
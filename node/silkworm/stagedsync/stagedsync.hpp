@@ -20,9 +20,12 @@
 // See https://github.com/ledgerwatch/erigon/blob/devel/eth/stagedsync/README.md
 
 #include <filesystem>
+#include <functional>
+#include <string_view>
 #include <vector>
 
 #include <silkworm/db/tables.hpp>
+#include <silkworm/execution/profiler.hpp>
 #include <silkworm/stagedsync/transaction_manager.hpp>
 #include <silkworm/stagedsync/util.hpp>
 
@@ -35,13 +38,31 @@ typedef StageResult (*StageFunc)(TransactionManager&, const std::filesystem::pat
 typedef StageResult (*UnwindFunc)(TransactionManager&, const std::filesystem::path& etl_path, uint64_t unwind_to );
 typedef StageResult (*PruneFunc)(TransactionManager&, const std::filesystem::path& etl_path,  uint64_t prune_from);
 
+// Second half of a stage split in two: loads what has been extracted, moves forward stage progress and commits
+using StageLoad = std::function<StageResult(TransactionManager&)>;
+
+// First half of a stage split in two: reads committed data through ro_txn (possibly on a thread of its own, alongside
+// other extractions) into ETL collectors, and hands back in load the function writing them into the db
+typedef StageResult (*ExtractFunc)(mdbx::txn& ro_txn, const std::filesystem::path& etl_path, uint64_t prune_from,
+                                   StageLoad& load);
+
 struct Stage {
-    StageFunc   stage_func;
-    UnwindFunc unwind_func;
-    PruneFunc   prune_func;
-    uint64_t            id;
+    StageFunc     stage_func;
+    UnwindFunc   unwind_func;
+    PruneFunc     prune_func;
+    uint64_t              id;
+    ExtractFunc extract_func;  // nullptr if the stage can't be split
+};
+
+// Tables a stage reads and writes (progress in kSyncStageProgress aside), from which StagePipeline infers which
+// stages can overlap
+struct StageTables {
+    std::vector<std::string_view> reads;
+    std::vector<std::string_view> writes;
 };
 
+StageTables get_stage_tables(uint64_t stage_id);
+
 // Stage functions
 StageResult stage_headers    (TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t prune_from = 0);
 StageResult stage_blockhashes(TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t prune_from = 0);
@@ -52,6 +73,9 @@ inline StageResult stage_execution(TransactionManager& txn, const std::filesyste
     return stage_execution(txn, etl_path, kDefaultBatchSize, prune_from);
 }
 
+// Makes stage_execution record an EVM profile of the blocks it executes into profiler; nullptr stops profiling
+void set_execution_profiler(EvmProfiler* profiler) noexcept;
+
 /* HashState Promotion Functions*/
 
 /*
@@ -78,6 +102,22 @@ StageResult stage_account_history(TransactionManager& txn, const std::filesystem
 StageResult stage_storage_history(TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t prune_from = 0);
 StageResult stage_log_index      (TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t prune_from = 0);
 StageResult stage_tx_lookup      (TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t prune_from = 0);
+StageResult stage_bloom_bits     (TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t prune_from = 0);
+StageResult stage_call_traces    (TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t prune_from = 0);
+
+// Extract functions (see ExtractFunc)
+StageResult extract_account_history(mdbx::txn& ro_txn, const std::filesystem::path& etl_path, uint64_t prune_from,
+                                    StageLoad& load);
+StageResult extract_storage_history(mdbx::txn& ro_txn, const std::filesystem::path& etl_path, uint64_t prune_from,
+                                    StageLoad& load);
+StageResult extract_log_index      (mdbx::txn& ro_txn, const std::filesystem::path& etl_path, uint64_t prune_from,
+                                    StageLoad& load);
+StageResult extract_tx_lookup      (mdbx::txn& ro_txn, const std::filesystem::path& etl_path, uint64_t prune_from,
+                                    StageLoad& load);
+StageResult extract_bloom_bits     (mdbx::txn& ro_txn, const std::filesystem::path& etl_path, uint64_t prune_from,
+                                    StageLoad& load);
+StageResult extract_call_traces    (mdbx::txn& ro_txn, const std::filesystem::path& etl_path, uint64_t prune_from,
+                                    StageLoad& load);
 
 // Unwind functions
 StageResult no_unwind             (TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t unwind_to);
@@ -90,6 +130,8 @@ StageResult unwind_account_history(TransactionManager& txn, const std::filesyste
 StageResult unwind_storage_history(TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t unwind_to);
 StageResult unwind_log_index      (TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t unwind_to);
 StageResult unwind_tx_lookup      (TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t unwind_to);
+StageResult unwind_bloom_bits     (TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t unwind_to);
+StageResult unwind_call_traces    (TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t unwind_to);
 // Prune functions
 StageResult no_prune             (TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t prune_from);
 StageResult prune_senders        (TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t prune_from);
@@ -98,6 +140,7 @@ StageResult prune_account_history(TransactionManager& txn, const std::filesystem
 StageResult prune_storage_history(TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t prune_from);
 StageResult prune_log_index      (TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t prune_from);
 StageResult prune_tx_lookup      (TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t prune_from);
+StageResult prune_call_traces    (TransactionManager& txn, const std::filesystem::path& etl_path, uint64_t prune_from);
 
 std::vector<Stage> get_archive_node_stages();
 std::vector<Stage> get_pruned_node_stages ();
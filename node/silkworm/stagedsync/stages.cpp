@@ -23,46 +23,95 @@ StageResult no_prune(TransactionManager&, const std::filesystem::path&, uint64_t
 
 std::vector<Stage> get_archive_node_stages() {
     return {
-        {stage_headers,         no_unwind,              no_prune, 1},
-        {stage_blockhashes,     unwind_blockhashes,     no_prune, 2},
-        {stage_bodies,          no_unwind,              no_prune, 3},
-        {stage_senders,         unwind_senders,         no_prune, 4},
-        {stage_execution,       unwind_execution,       no_prune, 5},
-        {stage_hashstate,       unwind_hashstate,       no_prune, 6},
-        {stage_interhashes,     unwind_interhashes,     no_prune, 7},
-        {stage_account_history, unwind_account_history, no_prune, 8},
-        {stage_storage_history, unwind_storage_history, no_prune, 9},
-        {stage_log_index,       unwind_log_index,       no_prune, 10},
-        {stage_tx_lookup,       unwind_tx_lookup,       no_prune, 11},
+        {stage_headers,         no_unwind,              no_prune,  1, nullptr},
+        {stage_blockhashes,     unwind_blockhashes,     no_prune,  2, nullptr},
+        {stage_bodies,          no_unwind,              no_prune,  3, nullptr},
+        {stage_senders,         unwind_senders,         no_prune,  4, nullptr},
+        {stage_execution,       unwind_execution,       no_prune,  5, nullptr},
+        {stage_hashstate,       unwind_hashstate,       no_prune,  6, nullptr},
+        {stage_interhashes,     unwind_interhashes,     no_prune,  7, nullptr},
+        {stage_account_history, unwind_account_history, no_prune,  8, extract_account_history},
+        {stage_storage_history, unwind_storage_history, no_prune,  9, extract_storage_history},
+        {stage_log_index,       unwind_log_index,       no_prune, 10, extract_log_index},
+        {stage_tx_lookup,       unwind_tx_lookup,       no_prune, 11, extract_tx_lookup},
+        {stage_bloom_bits,      unwind_bloom_bits,      no_prune, 12, extract_bloom_bits},
+        {stage_call_traces,     unwind_call_traces,     no_prune, 13, extract_call_traces},
     };
 }
 
 std::vector<Stage> get_pruned_node_stages() {
     return {
-        {stage_headers,         no_unwind,              no_prune,              1},
-        {stage_blockhashes,     unwind_blockhashes,     no_prune,              2},
-        {stage_bodies,          no_unwind,              no_prune,              3},
-        {stage_senders,         unwind_senders,         prune_senders,         4},
-        {stage_execution,       unwind_execution,       prune_execution,       5},
-        {stage_hashstate,       unwind_hashstate,       no_prune,              6},
-        {stage_interhashes,     unwind_interhashes,     no_prune,              7},
-        {stage_account_history, unwind_account_history, prune_account_history, 8},
-        {stage_storage_history, unwind_storage_history, prune_storage_history, 9},
-        {stage_log_index,       unwind_log_index,       prune_log_index,      10},
-        {stage_tx_lookup,       unwind_tx_lookup,       prune_tx_lookup,      11},
+        {stage_headers,         no_unwind,              no_prune,              1, nullptr},
+        {stage_blockhashes,     unwind_blockhashes,     no_prune,              2, nullptr},
+        {stage_bodies,          no_unwind,              no_prune,              3, nullptr},
+        {stage_senders,         unwind_senders,         prune_senders,         4, nullptr},
+        {stage_execution,       unwind_execution,       prune_execution,       5, nullptr},
+        {stage_hashstate,       unwind_hashstate,       no_prune,              6, nullptr},
+        {stage_interhashes,     unwind_interhashes,     no_prune,              7, nullptr},
+        {stage_account_history, unwind_account_history, prune_account_history, 8, extract_account_history},
+        {stage_storage_history, unwind_storage_history, prune_storage_history, 9, extract_storage_history},
+        {stage_log_index,       unwind_log_index,       prune_log_index,      10, extract_log_index},
+        {stage_tx_lookup,       unwind_tx_lookup,       prune_tx_lookup,      11, extract_tx_lookup},
+        {stage_bloom_bits,      unwind_bloom_bits,      no_prune,             12, extract_bloom_bits},
+        {stage_call_traces,     unwind_call_traces,     prune_call_traces,    13, extract_call_traces},
     };
 }
 
 std::vector<Stage> get_miner_mode_stages() {
     return {
-        {stage_headers,         no_unwind,              no_prune,        1},
-        {stage_blockhashes,     unwind_blockhashes,     no_prune,        2},
-        {stage_bodies,          no_unwind,              no_prune,        3},
-        {stage_senders,         unwind_senders,         prune_senders,   4},
-        {stage_execution,       unwind_execution,       prune_execution, 5},
-        {stage_hashstate,       unwind_hashstate,       no_prune,        6},
-        {stage_interhashes,     unwind_interhashes,     no_prune,        7},
+        {stage_headers,         no_unwind,              no_prune,        1, nullptr},
+        {stage_blockhashes,     unwind_blockhashes,     no_prune,        2, nullptr},
+        {stage_bodies,          no_unwind,              no_prune,        3, nullptr},
+        {stage_senders,         unwind_senders,         prune_senders,   4, nullptr},
+        {stage_execution,       unwind_execution,       prune_execution, 5, nullptr},
+        {stage_hashstate,       unwind_hashstate,       no_prune,        6, nullptr},
+        {stage_interhashes,     unwind_interhashes,     no_prune,        7, nullptr},
     };
 }
 
+StageTables get_stage_tables(uint64_t stage_id) {
+    using namespace db::table;
+    switch (stage_id) {
+        case 1:  // Headers
+            return {{}, {kHeaders.name, kCanonicalHashes.name, kDifficulty.name, kHeadHeader.name}};
+        case 2:  // BlockHashes
+            return {{kCanonicalHashes.name}, {kHeaderNumbers.name}};
+        case 3:  // Bodies
+            return {{kCanonicalHashes.name, kHeaders.name}, {kBlockBodies.name, kEthTx.name}};
+        case 4:  // Senders
+            return {{kCanonicalHashes.name, kBlockBodies.name, kEthTx.name}, {kSenders.name}};
+        case 5:  // Execution
+            return {{kConfig.name, kCanonicalHashes.name, kHeaders.name, kBlockBodies.name, kEthTx.name,
+                     kSenders.name, kPlainState.name, kPlainContractCode.name, kCode.name, kIncarnationMap.name},
+                    {kPlainState.name, kPlainContractCode.name, kCode.name, kIncarnationMap.name,
+                     kAccountChangeSet.name, kStorageChangeSet.name, kBlockReceipts.name, kLogs.name,
+                     kCallTraceSet.name}};
+        case 6:  // HashState
+            return {{kPlainState.name, kPlainContractCode.name, kAccountChangeSet.name, kStorageChangeSet.name},
+                    {kHashedAccounts.name, kHashedStorage.name, kContractCode.name}};
+        case 7:  // IntermediateHashes
+            return {{kHashedAccounts.name, kHashedStorage.name}, {kTrieOfAccounts.name, kTrieOfStorage.name}};
+        case 8:  // AccountHistoryIndex
+            return {{kAccountChangeSet.name}, {kAccountHistory.name}};
+        case 9:  // StorageHistoryIndex
+            return {{kStorageChangeSet.name}, {kStorageHistory.name}};
+        case 10:  // LogIndex
+            return {{kLogs.name}, {kLogTopicIndex.name, kLogAddressIndex.name}};
+        case 11:  // TxLookup
+            return {{kBlockBodies.name, kEthTx.name}, {kTxLookup.name}};
+        case 12:  // BloomBits
+            return {{kCanonicalHashes.name, kHeaders.name}, {kBloomBits.name, kBloomBitsIndex.name}};
+        case 13:  // CallTraces
+            return {{kCallTraceSet.name}, {kCallFromIndex.name, kCallToIndex.name}};
+        default: {
+            // Unknown stages conflict with any other
+            std::vector<std::string_view> all;
+            for (const auto& table : kTables) {
+                all.emplace_back(table.name);
+            }
+            return {all, all};
+        }
+    }
+}
+
 }  // namespace silkworm::stagedsync